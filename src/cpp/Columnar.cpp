@@ -0,0 +1,418 @@
+/**
+ * @file Columnar.cpp
+ * @brief Reading, writing and evaluation of the columnar binary datasets of Columnar.h
+ *
+ * The header is decoded byte by byte, so its integers are little-endian on any host; the columns
+ * are used in place and are only valid as doubles on a little-endian host (x86, ARM, WebAssembly).
+ * The rows of BatchColumnar are shared by threads in chunks of consecutive rows, which keeps the
+ * per-thread caches of GERG2008.cpp, Detail.cpp and Gross.cpp warm when consecutive rows share a
+ * composition or a temperature.
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "Columnar.h"
+#include "Detail.h"
+#include "GERG2008.h"
+#include "Gross.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#error "The columns of Columnar.h are little-endian doubles used in place: big-endian hosts are not supported"
+#endif
+
+static const uint64_t ChunkColumnar = 256; // Rows taken at once by a thread of BatchColumnar
+
+const char *const InputNamesColumnar[NInputsColumnar] = {
+    "methane", "nitrogen", "carbon_dioxide", "ethane", "propane", "isobutane", "n_butane", "isopentane",
+    "n_pentane", "n_hexane", "n_heptane", "n_octane", "n_nonane", "n_decane", "hydrogen", "oxygen",
+    "carbon_monoxide", "water", "hydrogen_sulfide", "helium", "argon", "T", "P"};
+
+const ColumnarProperty ColumnarProperties[NPropertiesColumnar] = {
+    {"D", "molar density (mol/l)", true, true, true},
+    {"Z", "compressibility factor", true, true, true},
+    {"Mm", "molar mass (g/mol)", true, true, true},
+    {"Rho", "mass density (kg/m3)", true, true, true},
+    {"dPdD", "dP/dD (kPa-l/mol)", true, true, false},
+    {"d2PdD2", "d2P/dD2 [kPa-(l/mol)^2]", true, true, false},
+    {"d2PdTD", "d2P/dTdD [kPa-l/(mol-K)], 0 with DETAIL", true, true, false},
+    {"dPdT", "dP/dT (kPa/K)", true, true, false},
+    {"U", "internal energy (J/mol)", true, true, false},
+    {"H", "enthalpy (J/mol)", true, true, false},
+    {"S", "entropy [J/(mol-K)]", true, true, false},
+    {"Cv", "isochoric heat capacity [J/(mol-K)]", true, true, false},
+    {"Cp", "isobaric heat capacity [J/(mol-K)]", true, true, false},
+    {"W", "speed of sound (m/s)", true, true, false},
+    {"G", "Gibbs energy (J/mol)", true, true, false},
+    {"JT", "Joule-Thomson coefficient (K/kPa)", true, true, false},
+    {"Kappa", "isentropic exponent", true, true, false},
+    {"A", "Helmholtz energy (J/mol)", true, false, false},
+    {"Cf", "critical flow factor", true, true, false},
+    {"Gr", "relative density at T and P", false, false, true},
+    {"HN", "molar ideal gross heating value at 298.15 K (kJ/mol)", false, false, true},
+};
+
+static uint64_t LoadLE(const unsigned char *p, const int n)
+{
+    uint64_t v = 0;
+    for (int k = n - 1; k >= 0; --k) { v = (v << 8) | p[k]; }
+    return v;
+}
+
+static void StoreLE(unsigned char *p, const int n, uint64_t v)
+{
+    for (int k = 0; k < n; ++k, v >>= 8) { p[k] = (unsigned char)(v & 0xFF); }
+}
+
+/**
+ * @brief Header of a dataset, up to its first column
+ */
+static void HeaderColumnar(const std::vector<std::string> &names, const uint64_t rows, std::vector<unsigned char> &header)
+{
+    const std::size_t n = names.size();
+    const std::size_t offset = (ColumnarHeaderSize + n * ColumnarNameSize + ColumnarAlignment - 1) / ColumnarAlignment * ColumnarAlignment;
+    header.assign(offset, 0);
+    std::memcpy(&header[0], ColumnarMagic, sizeof(ColumnarMagic));
+    StoreLE(&header[8], 4, ColumnarVersion);
+    StoreLE(&header[12], 4, n);
+    StoreLE(&header[16], 8, rows);
+    StoreLE(&header[24], 8, offset);
+    for (std::size_t c = 0; c < n; ++c)
+    {
+        std::memcpy(&header[ColumnarHeaderSize + c * ColumnarNameSize], names[c].data(), std::min(names[c].size(), ColumnarNameSize));
+    }
+}
+
+int ColumnarTable::Find(const std::string &name) const
+{
+    for (std::size_t c = 0; c < names.size(); ++c)
+    {
+        if (names[c] == name) { return (int)c; }
+    }
+    return -1;
+}
+
+bool IsColumnar(const void *data, const std::size_t size)
+{
+    return size >= sizeof(ColumnarMagic) && std::memcmp(data, ColumnarMagic, sizeof(ColumnarMagic)) == 0;
+}
+
+/**
+ * @brief Views the columns of a dataset held in memory, without copying them
+ *
+ * @param data Bytes of the dataset, aligned on 8 bytes
+ * @param size Number of bytes
+ * @param[out] table Names and columns, pointing into data
+ * @param[out] ierr Error flag: 0 - successful, 2 - not a columnar dataset, 3 - unsupported version,
+ *                  4 - truncated or invalid header, 5 - the first columns are not x[1..21], T and P,
+ *                  6 - data not aligned on 8 bytes
+ * @param[out] herr Error message if ierr is not 0
+ */
+void ViewColumnar(const void *data, const std::size_t size, ColumnarTable &table, int &ierr, const char *&herr)
+{
+    const unsigned char *p = static_cast<const unsigned char *>(data);
+    table.rows = 0;
+    table.names.clear();
+    table.columns.clear();
+    ierr = 0;
+    herr = "";
+    if (!IsColumnar(data, size) || size < ColumnarHeaderSize) { ierr = 2; herr = "Not a columnar dataset"; return; }
+    if (LoadLE(p + 8, 4) != ColumnarVersion) { ierr = 3; herr = "Unsupported version of the columnar format"; return; }
+    const uint64_t n = LoadLE(p + 12, 4), rows = LoadLE(p + 16, 8), offset = LoadLE(p + 24, 8);
+    const uint64_t values = size / sizeof(double);
+    if (n < (uint64_t)NInputsColumnar || offset % ColumnarAlignment != 0 || offset < ColumnarHeaderSize + n * ColumnarNameSize ||
+        offset > size || (rows > 0 && n > (values - offset / sizeof(double)) / rows))
+    {
+        ierr = 4;
+        herr = "Truncated or invalid columnar header";
+        return;
+    }
+    if (reinterpret_cast<std::uintptr_t>(p) % alignof(double) != 0) { ierr = 6; herr = "Columnar data not aligned on 8 bytes"; return; }
+
+    for (uint64_t c = 0; c < n; ++c)
+    {
+        const char *name = reinterpret_cast<const char *>(p + ColumnarHeaderSize + c * ColumnarNameSize);
+        table.names.emplace_back(name, std::find(name, name + ColumnarNameSize, '\0') - name);
+        table.columns.push_back(reinterpret_cast<const double *>(p + offset) + c * rows);
+    }
+    for (int c = 0; c < NInputsColumnar; ++c)
+    {
+        if (table.names[c] != InputNamesColumnar[c])
+        {
+            table.names.clear();
+            table.columns.clear();
+            ierr = 5;
+            herr = "The first columns of a columnar dataset must be methane ... argon, T and P";
+            return;
+        }
+    }
+    table.rows = rows;
+}
+
+ColumnarFile::~ColumnarFile()
+{
+#if !defined(_WIN32)
+    if (map) { munmap(map, size); }
+#endif
+}
+
+/**
+ * @brief Maps a columnar file in memory and views its columns
+ *
+ * The columns are read in place from the mapping, which lasts as long as file or until the next
+ * OpenColumnar with it. Without memory mapping (Windows), the file is read into file.buffer.
+ *
+ * @param[out] ierr Error flag: 0 - successful, 1 - cannot read the file, or an error of ViewColumnar
+ */
+void OpenColumnar(const char *path, ColumnarFile &file, int &ierr, const char *&herr)
+{
+    const void *data = nullptr;
+    std::size_t size = 0;
+#if !defined(_WIN32)
+    if (file.map) { munmap(file.map, file.size); }
+    file.map = nullptr;
+    file.size = 0;
+    const int fd = open(path, O_RDONLY);
+    struct stat st;
+    if (fd >= 0 && fstat(fd, &st) == 0 && st.st_size > 0)
+    {
+        void *map = mmap(nullptr, (std::size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED)
+        {
+            file.map = map;
+            file.size = (std::size_t)st.st_size;
+            data = map;
+            size = file.size;
+        }
+    }
+    if (fd >= 0) { close(fd); }
+#else
+    FILE *f = std::fopen(path, "rb");
+    if (f && std::fseek(f, 0, SEEK_END) == 0)
+    {
+        const long n = std::ftell(f);
+        std::rewind(f);
+        file.buffer.resize((std::size_t)std::max(n, 0L) / sizeof(double) + 1);
+        if (n > 0 && std::fread(file.buffer.data(), 1, (std::size_t)n, f) == (std::size_t)n)
+        {
+            data = file.buffer.data();
+            size = (std::size_t)n;
+        }
+    }
+    if (f) { std::fclose(f); }
+#endif
+    if (!data) { ierr = 1; herr = "Cannot read the columnar file"; return; }
+    ViewColumnar(data, size, file.table, ierr, herr);
+}
+
+/**
+ * @brief Dataset of the given columns, each of rows values, in memory
+ */
+void SerializeColumnar(const std::vector<std::string> &names, const std::vector<const double *> &columns, const uint64_t rows, std::vector<unsigned char> &bytes)
+{
+    HeaderColumnar(names, rows, bytes);
+    const std::size_t offset = bytes.size(), column = rows * sizeof(double);
+    bytes.resize(offset + columns.size() * column);
+    for (std::size_t c = 0; c < columns.size(); ++c)
+    {
+        if (column > 0) { std::memcpy(&bytes[offset + c * column], columns[c], column); }
+    }
+}
+
+/**
+ * @brief Writes a dataset column by column
+ *
+ * @param f Output stream, opened in binary mode
+ * @param names Column names, the first NInputsColumnar ones being InputNamesColumnar for a dataset readable by ViewColumnar
+ * @param columns Columns of rows values each
+ * @param[out] ierr Error flag: 0 - successful, 1 - write error
+ */
+void WriteColumnar(FILE *f, const std::vector<std::string> &names, const std::vector<const double *> &columns, const uint64_t rows, int &ierr, const char *&herr)
+{
+    std::vector<unsigned char> header;
+    HeaderColumnar(names, rows, header);
+    bool ok = std::fwrite(header.data(), 1, header.size(), f) == header.size();
+    for (std::size_t c = 0; c < columns.size() && ok; ++c) { ok = std::fwrite(columns[c], sizeof(double), rows, f) == rows; }
+    ierr = ok ? 0 : 1;
+    herr = ok ? "" : "Cannot write the columnar file";
+}
+
+void WriteColumnar(const char *path, const std::vector<std::string> &names, const std::vector<const double *> &columns, const uint64_t rows, int &ierr, const char *&herr)
+{
+    FILE *f = std::fopen(path, "wb");
+    if (!f) { ierr = 1; herr = "Cannot write the columnar file"; return; }
+    WriteColumnar(f, names, columns, rows, ierr, herr);
+    if (std::fclose(f) != 0 && ierr == 0) { ierr = 1; herr = "Cannot write the columnar file"; }
+}
+
+/**
+ * @brief Index of a property in ColumnarProperties, -1 if unknown or not calculated by the method
+ */
+int FindPropertyColumnar(const int method, const std::string &name)
+{
+    for (int p = 0; p < NPropertiesColumnar; ++p)
+    {
+        const ColumnarProperty &prop = ColumnarProperties[p];
+        if (name == prop.name)
+        {
+            const bool available = method == ColumnarGERG ? prop.gerg : method == ColumnarDetail ? prop.detail : prop.gross;
+            return available ? p : -1;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Properties of one state
+ *
+ * SetupGERG, SetupDetail or SetupGross must have been called. The density is solved from T and P,
+ * then the properties of ColumnarProperties are stored in v; without full, only the first
+ * NDensityPropertiesColumnar ones are calculated. Properties the method does not calculate are 0.
+ *
+ * @param method ColumnarGERG, ColumnarDetail or ColumnarGross
+ * @param full Whether to calculate the properties beyond D, Z, Mm and Rho
+ * @param T Temperature (K)
+ * @param P Pressure (kPa)
+ * @param x Composition (mole fractions)
+ * @param[out] v Values of the properties, in the order of ColumnarProperties
+ * @param[out] ierr Error flag: 0 - successful, -1 - invalid T or P, else the error of the density solver
+ */
+void EvaluateColumnar(const int method, const bool full, const double T, const double P, const CompositionView &x, double v[NPropertiesColumnar], int &ierr)
+{
+    static thread_local std::vector<double> xGrs(3 + 1, 0);
+    const char *herr;
+    double D = 0, Z = 0, P2, Mm = 0, HCH;
+    std::fill(v, v + NPropertiesColumnar, 0.0);
+    if (!(T > 0 && P >= 0 && std::isfinite(T) && std::isfinite(P))) { ierr = -1; return; }
+    if (method == ColumnarGross)
+    {
+        GrossInputs(T, P, x, xGrs, v[19], v[20], HCH, ierr, herr);
+        if (ierr == 0) { DensityGross(T, P, xGrs, HCH, D, ierr, herr); }
+        if (ierr == 0) { PressureGross(T, D, xGrs, HCH, P2, Z, ierr, herr); }
+        MolarMassGross(x, Mm);
+    }
+    else if (method == ColumnarDetail)
+    {
+        DensityDetail(T, P, x, D, ierr, herr);
+        if (ierr == 0 && full) { PropertiesDetail(T, D, x, P2, Z, v[4], v[5], v[6], v[7], v[8], v[9], v[10], v[11], v[12], v[13], v[14], v[15], v[16], v[18]); }
+        else if (ierr == 0) { PressureDetail(T, D, x, P2, Z); }
+        MolarMassDetail(x, Mm);
+    }
+    else
+    {
+        DensityGERG(0, T, P, x, D, ierr, herr);
+        if (ierr == 0 && full) { PropertiesGERG(T, D, x, P2, Z, v[4], v[5], v[6], v[7], v[8], v[9], v[10], v[11], v[12], v[13], v[14], v[15], v[16], v[17], v[18]); }
+        else if (ierr == 0) { PressureGERG(T, D, x, P2, Z); }
+        MolarMassGERG(x, Mm);
+    }
+    v[0] = D;
+    v[1] = Z;
+    v[2] = Mm;
+    v[3] = D * Mm;
+}
+
+/**
+ * @brief Properties of every row of a dataset, read in place
+ *
+ * SetupGERG, SetupDetail or SetupGross must have been called. The rows are spread over threads;
+ * each output only depends on its row, so the results do not depend on the number of threads.
+ *
+ * @param method ColumnarGERG, ColumnarDetail or ColumnarGross
+ * @param table Dataset, its mole fractions are used as given
+ * @param properties Indexes in ColumnarProperties of the outputs
+ * @param threads Number of threads, 0 for one per core
+ * @param[out] outputs One column of table.rows values per property, NaN where ierr is not 0
+ * @param[out] ierr Error flag of each row (see EvaluateColumnar), as a double to be written as a column
+ */
+void BatchColumnar(const int method, const ColumnarTable &table, const std::vector<int> &properties, const int threads, std::vector<std::vector<double>> &outputs, std::vector<double> &ierr)
+{
+    const uint64_t N = table.rows;
+    bool full = false;
+    for (const int p : properties) { full = full || p >= NDensityPropertiesColumnar; }
+    outputs.resize(properties.size());
+    for (std::vector<double> &out : outputs) { out.resize(N); }
+    ierr.resize(N);
+
+    std::atomic<uint64_t> next(0);
+    auto worker = [&]()
+    {
+        double v[NPropertiesColumnar];
+        for (uint64_t k0; (k0 = next.fetch_add(ChunkColumnar)) < N;)
+        {
+            for (uint64_t k = k0; k < std::min(k0 + ChunkColumnar, N); ++k)
+            {
+                int e;
+                EvaluateColumnar(method, full, table.columns[ColumnarT][k], table.columns[ColumnarP][k], table.x(k), v, e);
+                for (std::size_t o = 0; o < properties.size(); ++o) { outputs[o][k] = e == 0 ? v[properties[o]] : NAN; }
+                ierr[k] = e;
+            }
+        }
+    };
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    worker();
+#else
+    const int n = threads > 0 ? threads : std::max(1, (int)std::thread::hardware_concurrency());
+    std::vector<std::thread> pool;
+    for (int t = 1; t < n; ++t) { pool.emplace_back(worker); }
+    worker();
+    for (std::thread &th : pool) { th.join(); }
+#endif
+}
+
+/**
+ * @brief Columns of the result of BatchColumnar, to be written by WriteColumnar or SerializeColumnar
+ *
+ * The result holds the inputs of table, its other columns except those replaced by the new outputs
+ * (same name, or ierr), the outputs and ierr. The columns point into table, outputs and ierr.
+ */
+void ResultColumnar(const ColumnarTable &table, const std::vector<int> &properties, const std::vector<std::vector<double>> &outputs, const std::vector<double> &ierr,
+                    std::vector<std::string> &names, std::vector<const double *> &columns)
+{
+    names.assign(table.names.begin(), table.names.begin() + NInputsColumnar);
+    columns.assign(table.columns.begin(), table.columns.begin() + NInputsColumnar);
+    for (std::size_t c = NInputsColumnar; c < table.names.size(); ++c)
+    {
+        bool replaced = table.names[c] == "ierr";
+        for (const int p : properties) { replaced = replaced || table.names[c] == ColumnarProperties[p].name; }
+        if (!replaced)
+        {
+            names.push_back(table.names[c]);
+            columns.push_back(table.columns[c]);
+        }
+    }
+    for (std::size_t o = 0; o < properties.size(); ++o)
+    {
+        names.push_back(ColumnarProperties[properties[o]].name);
+        columns.push_back(outputs[o].data());
+    }
+    names.push_back("ierr");
+    columns.push_back(ierr.data());
+}
@@ -0,0 +1,131 @@
+/**
+ * @file Columnar.h
+ * @brief Columnar binary datasets of states and properties, and their evaluation by GERG-2008, DETAIL or GROSS
+ *
+ * A columnar dataset is a header followed by contiguous columns of little-endian doubles (all
+ * integers of the header are little-endian too):
+ *
+ *   offset  size     content
+ *        0  8        magic "AGA8COL" followed by a NUL
+ *        8  4        version, ColumnarVersion
+ *       12  4        number of columns n, at least NInputsColumnar
+ *       16  8        number of rows
+ *       24  8        offset of the first column, a multiple of ColumnarAlignment
+ *       32  32       zero
+ *       64  n x 32   column names, UTF-8 padded with NUL
+ *                    zero up to the first column
+ *           n x rows column c at (offset of the first column) + c * rows * 8
+ *
+ * The first NInputsColumnar columns are the inputs, named by InputNamesColumnar: the mole fractions
+ * of methane ... argon in the order of x[1..21], T (K) and P (kPa). The 21 composition columns are
+ * therefore a column-major matrix, and the composition of a row is read in place through a
+ * CompositionView. The other columns are outputs, named after ColumnarProperties, and ierr.
+ *
+ * The same bytes are written by WriteColumnar and SerializeColumnar, read by OpenColumnar (memory
+ * mapped, without copy) and ViewColumnar, and exchanged with aga8-calc and the WebAssembly module.
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef AGA8COLUMNAR_H_
+#define AGA8COLUMNAR_H_
+
+#include "Composition.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Layout of the header
+const char ColumnarMagic[8] = {'A', 'G', 'A', '8', 'C', 'O', 'L', '\0'};
+const uint32_t ColumnarVersion = 1;
+const std::size_t ColumnarHeaderSize = 64, ColumnarNameSize = 32, ColumnarAlignment = 64;
+
+// Input columns: x[1..21], T, P
+const int NInputsColumnar = 23;
+const int ColumnarT = 21, ColumnarP = 22;
+extern const char *const InputNamesColumnar[NInputsColumnar];
+
+// Equation of state of an evaluation
+const int ColumnarGERG = 0, ColumnarDetail = 1, ColumnarGross = 2;
+
+/**
+ * @brief Output property: its column name, description and the equations that calculate it
+ */
+struct ColumnarProperty
+{
+    const char *name;
+    const char *description;
+    bool gerg, detail, gross;
+};
+
+// Output properties, in the order of the values of EvaluateColumnar. The first NDensityPropertiesColumnar
+// ones (D, Z, Mm, Rho) only need the density; the others need PropertiesGERG or PropertiesDetail.
+const int NPropertiesColumnar = 21;
+const int NDensityPropertiesColumnar = 4;
+extern const ColumnarProperty ColumnarProperties[NPropertiesColumnar];
+
+/**
+ * @brief Read-only view of a columnar dataset
+ *
+ * The columns point into the viewed bytes or the mapped file, which must outlive the view.
+ * columns[0] .. columns[20] are consecutive, so x(row) views the composition of a row.
+ */
+struct ColumnarTable
+{
+    uint64_t rows = 0;
+    std::vector<std::string> names;
+    std::vector<const double *> columns;
+
+    CompositionView x(const uint64_t row) const { return CompositionView(columns[0] + row, (std::ptrdiff_t)rows); }
+    int Find(const std::string &name) const;
+};
+
+/**
+ * @brief Columnar file mapped in memory, unmapped by the destructor
+ */
+struct ColumnarFile
+{
+    ColumnarTable table;
+    void *map = nullptr;         // Mapped file
+    std::size_t size = 0;        // Size of the mapped file
+    std::vector<double> buffer;  // Contents of the file where memory mapping is not available
+
+    ColumnarFile() = default;
+    ColumnarFile(const ColumnarFile &) = delete;
+    ColumnarFile &operator=(const ColumnarFile &) = delete;
+    ~ColumnarFile();
+};
+
+bool IsColumnar(const void *data, const std::size_t size);
+void ViewColumnar(const void *data, const std::size_t size, ColumnarTable &table, int &ierr, const char *&herr);
+void OpenColumnar(const char *path, ColumnarFile &file, int &ierr, const char *&herr);
+void SerializeColumnar(const std::vector<std::string> &names, const std::vector<const double *> &columns, const uint64_t rows, std::vector<unsigned char> &bytes);
+void WriteColumnar(FILE *f, const std::vector<std::string> &names, const std::vector<const double *> &columns, const uint64_t rows, int &ierr, const char *&herr);
+void WriteColumnar(const char *path, const std::vector<std::string> &names, const std::vector<const double *> &columns, const uint64_t rows, int &ierr, const char *&herr);
+
+int FindPropertyColumnar(const int method, const std::string &name);
+void EvaluateColumnar(const int method, const bool full, const double T, const double P, const CompositionView &x, double v[NPropertiesColumnar], int &ierr);
+void BatchColumnar(const int method, const ColumnarTable &table, const std::vector<int> &properties, const int threads, std::vector<std::vector<double>> &outputs, std::vector<double> &ierr);
+void ResultColumnar(const ColumnarTable &table, const std::vector<int> &properties, const std::vector<std::vector<double>> &outputs, const std::vector<double> &ierr,
+                    std::vector<std::string> &names, std::vector<const double *> &columns);
+
+#endif
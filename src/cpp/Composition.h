@@ -0,0 +1,79 @@
+/**
+ * @file Composition.h
+ * @brief Fixed-size and strided composition types accepted by the DETAIL, GERG-2008 and GROSS routines
+ *
+ * Both types are indexed like the std::vector compositions, from 1 (methane) to 21 (argon) in the
+ * order given at the top of Detail.cpp and GERG2008.cpp, but they have no placeholder at index 0
+ * and do not allocate. The number of components is a compile-time constant.
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef AGA8COMPOSITION_H_
+#define AGA8COMPOSITION_H_
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+// Number of components of a composition
+constexpr int NcComposition = 21;
+
+/**
+ * @brief Mole fractions of the 21 components stored in a std::array
+ *
+ * x[i] is the mole fraction of component i, i = 1 to NcComposition.
+ */
+struct Composition
+{
+    std::array<double, NcComposition> values{};
+
+    Composition() = default;
+
+    /**
+     * @brief Copy a std::vector composition (placeholder at index 0)
+     */
+    explicit Composition(const std::vector<double> &x)
+    {
+        for (int i = 1; i <= NcComposition; ++i) { values[i - 1] = x[i]; }
+    }
+
+    double &operator[](int i) { return values[i - 1]; }
+    const double &operator[](int i) const { return values[i - 1]; }
+};
+
+/**
+ * @brief Read-only view of 21 mole fractions spaced by a constant stride
+ *
+ * With a row-major composition matrix (one mixture per row), a row is viewed with
+ * CompositionView(&m[row * 21], 1); with a column-major matrix of n mixtures, with
+ * CompositionView(&m[row], n). x[i] is the mole fraction of component i, i = 1 to NcComposition.
+ */
+struct CompositionView
+{
+    const double *data;      // Mole fraction of component 1
+    std::ptrdiff_t stride;   // Distance between two consecutive components
+
+    CompositionView(const double *data, std::ptrdiff_t stride = 1) : data(data), stride(stride) {}
+    CompositionView(const Composition &x) : data(x.values.data()), stride(1) {}
+
+    double operator[](int i) const { return data[(i - 1) * stride]; }
+};
+
+#endif
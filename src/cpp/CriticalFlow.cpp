@@ -0,0 +1,354 @@
+/**
+ * @file CriticalFlow.cpp
+ * @brief Real-gas critical flow function C* of sonic nozzles (ISO 9300)
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "CriticalFlow.h"
+#include "Detail.h"
+#include "Flash.h"
+#include "GERG2008.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Equation of state of a throat solve
+static const int CriticalGERG = 0, CriticalDetail = 1;
+
+static const int MaxIterCritical = 30;
+static const double tolCritical = 1e-8;    // Tolerance on ln(Pt)
+static const double MaxStepCritical = 0.5; // Largest change of ln(Pt) in one iteration
+
+// Properties of a state of the isentrope
+struct IsentropeState
+{
+    double T, D, P, H, W, Kappa;
+};
+
+template <typename X>
+static void PropertiesCritical(const int method, const double T, const double D, const X &x, IsentropeState &st)
+{
+    double Z, dPdD, d2PdD2, d2PdTD, dPdT, U, S, Cv, Cp, G, JT, A, Cf;
+    st.T = T;
+    st.D = D;
+    if (method == CriticalDetail)
+    {
+        PropertiesDetail(T, D, x, st.P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, st.H, S, Cv, Cp, st.W, G, JT, st.Kappa, Cf);
+    }
+    else
+    {
+        PropertiesGERG(T, D, x, st.P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, st.H, S, Cv, Cp, st.W, G, JT, st.Kappa, A, Cf);
+    }
+}
+
+/**
+ * @brief State of the isentrope S0 at pressure P, from the estimate st.T, st.D
+ *
+ * @return false if the PS flash fails, from the estimate and without it
+ */
+template <typename X>
+static bool IsentropeCritical(const int method, const double P, const double S0, const X &x, IsentropeState &st)
+{
+    double T = st.T, D = -st.D;
+    int ierr;
+    const char *herr;
+    for (int attempt = 0; attempt < 2; ++attempt)
+    {
+        if (method == CriticalDetail) { FlashDetail(FlashPS, P, S0, x, T, D, ierr, herr); }
+        else { FlashGERG(FlashPS, P, S0, x, T, D, ierr, herr); }
+        if (ierr == 0) { break; }
+        // Once more without the estimate
+        T = D = 0;
+    }
+    if (ierr != 0) { return false; }
+    PropertiesCritical(method, T, D, x, st);
+    return true;
+}
+
+// CriticalFlowFunctionGERG and CriticalFlowFunctionDetail for any composition type X (std::vector, Composition, CompositionView)
+template <typename X>
+static void CriticalFlowImpl(const int method, const double T0, const double P0, const X &x, double &Cstar, double &Tt, double &Pt, double &Dt, int &ierr, const char *&herr)
+{
+    ierr = 0;
+    herr = "";
+    const bool warm = Dt < 0 && Tt > 0 && Pt > 0 && Pt < P0;
+    Cstar = 0;
+    if (!(T0 > 0 && P0 > 0)) { ierr = 1; herr = "Invalid stagnation state"; Tt = Pt = Dt = 0; return; }
+
+    // Stagnation state
+    double D0 = 0, Mm, R;
+    if (method == CriticalDetail)
+    {
+        R = 8.31451;
+        MolarMassDetail(x, Mm);
+        DensityDetail(T0, P0, x, D0, ierr, herr);
+    }
+    else
+    {
+        R = 8.314472;
+        MolarMassGERG(x, Mm);
+        DensityGERG(0, T0, P0, x, D0, ierr, herr);
+    }
+    if (ierr != 0) { Tt = Pt = Dt = 0; return; }
+    IsentropeState st0, st;
+    double S0, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, Cv, Cp, G, JT, A, Cf;
+    if (method == CriticalDetail) { PropertiesDetail(T0, D0, x, st0.P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, st0.H, S0, Cv, Cp, st0.W, G, JT, st0.Kappa, Cf); }
+    else { PropertiesGERG(T0, D0, x, st0.P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, st0.H, S0, Cv, Cp, st0.W, G, JT, st0.Kappa, A, Cf); }
+
+    // Initial estimate: the input throat state, or the ideal gas throat with the stagnation isentropic exponent
+    if (warm)
+    {
+        st.T = Tt;
+        st.D = -Dt;
+        st.P = Pt;
+    }
+    else
+    {
+        const double k = st0.Kappa > 1 && std::isfinite(st0.Kappa) ? st0.Kappa : 1.3;
+        const double ratio = std::pow(2 / (k + 1), k / (k - 1));
+        st.T = T0 * 2 / (k + 1);
+        st.D = D0 * std::pow(ratio, 1 / k);
+        st.P = P0 * ratio;
+    }
+
+    // Newton iterations on ln(P) of g = h0 - h - w^2/2, with the ideal gas derivative for the first step and secants afterwards
+    const double lnP0 = std::log(P0);
+    double lnP = std::log(st.P), g = 0, lnPold = 0, gold = 0;
+    bool ok = false;
+    for (int it = 0; it <= MaxIterCritical && !ok; ++it)
+    {
+        double dlnP = 0;
+        if (it > 0)
+        {
+            const double W2 = Mm * st.W * st.W / 2000; // J/mol
+            const double dgdlnP = it == 1 || g == gold ? -st.P / st.D - W2 * (st.Kappa - 1) / st.Kappa : (g - gold) / (lnP - lnPold);
+            dlnP = -g / dgdlnP;
+            if (!std::isfinite(dlnP)) { break; }
+            dlnP = std::max(-MaxStepCritical, std::min(MaxStepCritical, dlnP));
+            if (lnP + dlnP >= lnP0) { dlnP = (lnP0 - lnP) / 2; }
+            ok = std::abs(dlnP) < tolCritical;
+        }
+        IsentropeState trial = st;
+        bool found = false;
+        for (int half = 0; half < 10 && !found; ++half, dlnP /= 2)
+        {
+            trial = st;
+            found = IsentropeCritical(method, std::exp(lnP + dlnP), S0, x, trial);
+        }
+        if (!found) { break; }
+        lnPold = lnP;
+        gold = g;
+        lnP = std::log(trial.P);
+        st = trial;
+        g = st0.H - st.H - Mm * st.W * st.W / 2000;
+    }
+    if (!ok) { ierr = 2; herr = "Throat state did not converge"; Tt = Pt = Dt = 0; return; }
+
+    Tt = st.T;
+    Pt = st.P;
+    Dt = st.D;
+    Cstar = Dt * Mm * st.W * std::sqrt(R * T0 / (Mm / 1000)) / (P0 * 1000);
+}
+
+// CriticalFlowBatchGERG and CriticalFlowBatchDetail: each throat starts from the previous one, scaled to the new stagnation state
+template <typename X>
+static void CriticalFlowBatchImpl(const int method, const std::vector<double> &T0, const std::vector<double> &P0, const X &x, std::vector<double> &Cstar, std::vector<double> &Tt, std::vector<double> &Pt, std::vector<double> &Dt, std::vector<int> &ierr)
+{
+    const std::size_t n = std::min(T0.size(), P0.size());
+    Cstar.resize(n);
+    Tt.resize(n);
+    Pt.resize(n);
+    Dt.resize(n);
+    ierr.resize(n);
+    const char *herr;
+    for (std::size_t k = 0; k < n; ++k)
+    {
+        double T = 0, P = 0, D = 0;
+        const bool warm = k > 0 && ierr[k - 1] == 0 && T0[k - 1] > 0 && P0[k - 1] > 0;
+        if (warm)
+        {
+            const double fT = T0[k] / T0[k - 1], fP = P0[k] / P0[k - 1];
+            T = Tt[k - 1] * fT;
+            P = Pt[k - 1] * fP;
+            D = -Dt[k - 1] * fP / fT;
+        }
+        CriticalFlowImpl(method, T0[k], P0[k], x, Cstar[k], T, P, D, ierr[k], herr);
+        if (ierr[k] != 0 && warm)
+        {
+            // Retry without the estimate of the previous throat
+            T = P = D = 0;
+            CriticalFlowImpl(method, T0[k], P0[k], x, Cstar[k], T, P, D, ierr[k], herr);
+        }
+        Tt[k] = T;
+        Pt[k] = P;
+        Dt[k] = D;
+    }
+}
+
+/**
+ * @brief Real-gas critical flow function of a sonic nozzle with the GERG-2008 equation
+ *
+ * Solves the throat state on the isentrope of the stagnation state (T0, P0), where the velocity
+ * from the enthalpy drop equals the speed of sound, and returns C* = rho_t*W_t*sqrt(R*T0/M)/P0 as
+ * defined by ISO 9300, so that the mass flow rate is A*Cd*C*P0/sqrt(R*T0/M).
+ * SetupGERG must have been called.
+ *
+ * @param T0 Stagnation temperature (K)
+ * @param P0 Stagnation pressure (kPa)
+ * @param x Composition (mole fraction)
+ * @param[out] Cstar Critical flow function (dimensionless)
+ * @param[in,out] Tt Throat temperature (K); with Dt < 0 on input, Tt, Pt and -Dt are used as the initial estimate
+ * @param[in,out] Pt Throat pressure (kPa)
+ * @param[in,out] Dt Throat density (mol/l)
+ * @param[out] ierr Error number (0 indicates no error)
+ * @param[out] herr Error message if ierr is not equal to zero
+ */
+void CriticalFlowFunctionGERG(const double T0, const double P0, const std::vector<double> &x, double &Cstar, double &Tt, double &Pt, double &Dt, int &ierr, const char *&herr)
+{
+    CriticalFlowImpl(CriticalGERG, T0, P0, x, Cstar, Tt, Pt, Dt, ierr, herr);
+}
+
+/**
+ * @brief CriticalFlowFunctionGERG for a fixed-size Composition
+ * @see CriticalFlowFunctionGERG
+ */
+void CriticalFlowFunctionGERG(const double T0, const double P0, const Composition &x, double &Cstar, double &Tt, double &Pt, double &Dt, int &ierr, const char *&herr)
+{
+    CriticalFlowImpl(CriticalGERG, T0, P0, x, Cstar, Tt, Pt, Dt, ierr, herr);
+}
+
+/**
+ * @brief CriticalFlowFunctionGERG for a CompositionView, e.g. a row of a composition matrix
+ * @see CriticalFlowFunctionGERG
+ */
+void CriticalFlowFunctionGERG(const double T0, const double P0, const CompositionView &x, double &Cstar, double &Tt, double &Pt, double &Dt, int &ierr, const char *&herr)
+{
+    CriticalFlowImpl(CriticalGERG, T0, P0, x, Cstar, Tt, Pt, Dt, ierr, herr);
+}
+
+/**
+ * @brief Real-gas critical flow function of a sonic nozzle with the DETAIL equation
+ *
+ * Same as CriticalFlowFunctionGERG. SetupDetail must have been called.
+ *
+ * @param T0 Stagnation temperature (K)
+ * @param P0 Stagnation pressure (kPa)
+ * @param x Composition (mole fraction)
+ * @param[out] Cstar Critical flow function (dimensionless)
+ * @param[in,out] Tt Throat temperature (K); with Dt < 0 on input, Tt, Pt and -Dt are used as the initial estimate
+ * @param[in,out] Pt Throat pressure (kPa)
+ * @param[in,out] Dt Throat density (mol/l)
+ * @param[out] ierr Error number (0 indicates no error)
+ * @param[out] herr Error message if ierr is not equal to zero
+ */
+void CriticalFlowFunctionDetail(const double T0, const double P0, const std::vector<double> &x, double &Cstar, double &Tt, double &Pt, double &Dt, int &ierr, const char *&herr)
+{
+    CriticalFlowImpl(CriticalDetail, T0, P0, x, Cstar, Tt, Pt, Dt, ierr, herr);
+}
+
+/**
+ * @brief CriticalFlowFunctionDetail for a fixed-size Composition
+ * @see CriticalFlowFunctionDetail
+ */
+void CriticalFlowFunctionDetail(const double T0, const double P0, const Composition &x, double &Cstar, double &Tt, double &Pt, double &Dt, int &ierr, const char *&herr)
+{
+    CriticalFlowImpl(CriticalDetail, T0, P0, x, Cstar, Tt, Pt, Dt, ierr, herr);
+}
+
+/**
+ * @brief CriticalFlowFunctionDetail for a CompositionView, e.g. a row of a composition matrix
+ * @see CriticalFlowFunctionDetail
+ */
+void CriticalFlowFunctionDetail(const double T0, const double P0, const CompositionView &x, double &Cstar, double &Tt, double &Pt, double &Dt, int &ierr, const char *&herr)
+{
+    CriticalFlowImpl(CriticalDetail, T0, P0, x, Cstar, Tt, Pt, Dt, ierr, herr);
+}
+
+/**
+ * @brief CriticalFlowFunctionGERG of many stagnation states, e.g. a pressure sweep of a nozzle curve
+ *
+ * Each throat solve starts from the previous throat state scaled to the new stagnation state.
+ *
+ * @param T0 Stagnation temperatures (K)
+ * @param P0 Stagnation pressures (kPa)
+ * @param x Composition (mole fraction)
+ * @param[out] Cstar Critical flow functions
+ * @param[out] Tt Throat temperatures (K)
+ * @param[out] Pt Throat pressures (kPa)
+ * @param[out] Dt Throat densities (mol/l)
+ * @param[out] ierr Error numbers (0 indicates no error)
+ */
+void CriticalFlowBatchGERG(const std::vector<double> &T0, const std::vector<double> &P0, const std::vector<double> &x, std::vector<double> &Cstar, std::vector<double> &Tt, std::vector<double> &Pt, std::vector<double> &Dt, std::vector<int> &ierr)
+{
+    CriticalFlowBatchImpl(CriticalGERG, T0, P0, x, Cstar, Tt, Pt, Dt, ierr);
+}
+
+/**
+ * @brief CriticalFlowBatchGERG for a fixed-size Composition
+ * @see CriticalFlowBatchGERG
+ */
+void CriticalFlowBatchGERG(const std::vector<double> &T0, const std::vector<double> &P0, const Composition &x, std::vector<double> &Cstar, std::vector<double> &Tt, std::vector<double> &Pt, std::vector<double> &Dt, std::vector<int> &ierr)
+{
+    CriticalFlowBatchImpl(CriticalGERG, T0, P0, x, Cstar, Tt, Pt, Dt, ierr);
+}
+
+/**
+ * @brief CriticalFlowBatchGERG for a CompositionView, e.g. a row of a composition matrix
+ * @see CriticalFlowBatchGERG
+ */
+void CriticalFlowBatchGERG(const std::vector<double> &T0, const std::vector<double> &P0, const CompositionView &x, std::vector<double> &Cstar, std::vector<double> &Tt, std::vector<double> &Pt, std::vector<double> &Dt, std::vector<int> &ierr)
+{
+    CriticalFlowBatchImpl(CriticalGERG, T0, P0, x, Cstar, Tt, Pt, Dt, ierr);
+}
+
+/**
+ * @brief CriticalFlowFunctionDetail of many stagnation states
+ *
+ * @param T0 Stagnation temperatures (K)
+ * @param P0 Stagnation pressures (kPa)
+ * @param x Composition (mole fraction)
+ * @param[out] Cstar Critical flow functions
+ * @param[out] Tt Throat temperatures (K)
+ * @param[out] Pt Throat pressures (kPa)
+ * @param[out] Dt Throat densities (mol/l)
+ * @param[out] ierr Error numbers (0 indicates no error)
+ */
+void CriticalFlowBatchDetail(const std::vector<double> &T0, const std::vector<double> &P0, const std::vector<double> &x, std::vector<double> &Cstar, std::vector<double> &Tt, std::vector<double> &Pt, std::vector<double> &Dt, std::vector<int> &ierr)
+{
+    CriticalFlowBatchImpl(CriticalDetail, T0, P0, x, Cstar, Tt, Pt, Dt, ierr);
+}
+
+/**
+ * @brief CriticalFlowBatchDetail for a fixed-size Composition
+ * @see CriticalFlowBatchDetail
+ */
+void CriticalFlowBatchDetail(const std::vector<double> &T0, const std::vector<double> &P0, const Composition &x, std::vector<double> &Cstar, std::vector<double> &Tt, std::vector<double> &Pt, std::vector<double> &Dt, std::vector<int> &ierr)
+{
+    CriticalFlowBatchImpl(CriticalDetail, T0, P0, x, Cstar, Tt, Pt, Dt, ierr);
+}
+
+/**
+ * @brief CriticalFlowBatchDetail for a CompositionView, e.g. a row of a composition matrix
+ * @see CriticalFlowBatchDetail
+ */
+void CriticalFlowBatchDetail(const std::vector<double> &T0, const std::vector<double> &P0, const CompositionView &x, std::vector<double> &Cstar, std::vector<double> &Tt, std::vector<double> &Pt, std::vector<double> &Dt, std::vector<int> &ierr)
+{
+    CriticalFlowBatchImpl(CriticalDetail, T0, P0, x, Cstar, Tt, Pt, Dt, ierr);
+}
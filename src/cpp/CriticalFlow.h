@@ -0,0 +1,49 @@
+/**
+ * @file CriticalFlow.h
+ * @brief Real-gas critical flow function C* of sonic nozzles (ISO 9300)
+ *
+ * The throat state is found on the isentrope of the stagnation state, where the flow velocity from
+ * the enthalpy drop, w = sqrt(2*(h0 - h)), equals the local speed of sound. Each point of the
+ * isentrope is a PS flash (see Flash.h), started from the previous one, so a throat solve costs a few
+ * Helmholtz energy evaluations. C* is then rho_t*W_t*sqrt(R*T0/M)/P0, which reduces to the ideal gas
+ * formula of PropertiesGERG's Cf for a perfect gas.
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef AGA8CRITICALFLOW_H_
+#define AGA8CRITICALFLOW_H_
+
+#include <vector>
+#include "Composition.h"
+
+void CriticalFlowFunctionGERG(const double T0, const double P0, const std::vector<double> &x, double &Cstar, double &Tt, double &Pt, double &Dt, int &ierr, const char *&herr);
+void CriticalFlowFunctionGERG(const double T0, const double P0, const Composition &x, double &Cstar, double &Tt, double &Pt, double &Dt, int &ierr, const char *&herr);
+void CriticalFlowFunctionGERG(const double T0, const double P0, const CompositionView &x, double &Cstar, double &Tt, double &Pt, double &Dt, int &ierr, const char *&herr);
+void CriticalFlowFunctionDetail(const double T0, const double P0, const std::vector<double> &x, double &Cstar, double &Tt, double &Pt, double &Dt, int &ierr, const char *&herr);
+void CriticalFlowFunctionDetail(const double T0, const double P0, const Composition &x, double &Cstar, double &Tt, double &Pt, double &Dt, int &ierr, const char *&herr);
+void CriticalFlowFunctionDetail(const double T0, const double P0, const CompositionView &x, double &Cstar, double &Tt, double &Pt, double &Dt, int &ierr, const char *&herr);
+void CriticalFlowBatchGERG(const std::vector<double> &T0, const std::vector<double> &P0, const std::vector<double> &x, std::vector<double> &Cstar, std::vector<double> &Tt, std::vector<double> &Pt, std::vector<double> &Dt, std::vector<int> &ierr);
+void CriticalFlowBatchGERG(const std::vector<double> &T0, const std::vector<double> &P0, const Composition &x, std::vector<double> &Cstar, std::vector<double> &Tt, std::vector<double> &Pt, std::vector<double> &Dt, std::vector<int> &ierr);
+void CriticalFlowBatchGERG(const std::vector<double> &T0, const std::vector<double> &P0, const CompositionView &x, std::vector<double> &Cstar, std::vector<double> &Tt, std::vector<double> &Pt, std::vector<double> &Dt, std::vector<int> &ierr);
+void CriticalFlowBatchDetail(const std::vector<double> &T0, const std::vector<double> &P0, const std::vector<double> &x, std::vector<double> &Cstar, std::vector<double> &Tt, std::vector<double> &Pt, std::vector<double> &Dt, std::vector<int> &ierr);
+void CriticalFlowBatchDetail(const std::vector<double> &T0, const std::vector<double> &P0, const Composition &x, std::vector<double> &Cstar, std::vector<double> &Tt, std::vector<double> &Pt, std::vector<double> &Dt, std::vector<int> &ierr);
+void CriticalFlowBatchDetail(const std::vector<double> &T0, const std::vector<double> &P0, const CompositionView &x, std::vector<double> &Cstar, std::vector<double> &Tt, std::vector<double> &Pt, std::vector<double> &Dt, std::vector<int> &ierr);
+
+#endif
@@ -0,0 +1,283 @@
+/**
+ * @file DensityGuess.cpp
+ * @brief Initial density estimates of DensityGERG and DensityDetail from a precomputed (T,P) grid
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "DensityGuess.h"
+#include "Detail.h"
+#include "GERG2008.h"
+
+#include <algorithm>
+#include <cmath>
+
+static const int MaxCellsGuess = 4096;       // Largest number of cells per direction
+static const double MaxCorrectionGuess = 0.05; // Largest change of ln(1/D) from the estimate, otherwise the root is not trusted
+static const double tolrGuess = 1e-7;        // Tolerance on ln(1/D) of DensityGERG and DensityDetail
+static thread_local DensityGuessStats guessStats; // Counters of the calling thread
+
+template <typename X> static void BuildDensityGuessImpl(const int method, const int iFlag, const X &x, const double Tmin, const double Tmax, const double Pmin, const double Pmax, const int nT, const int nP, DensityGuessGrid &grid, int &ierr, const char *&herr);
+
+// Density from the solver of the grid; D < 0 on input is the initial estimate
+static void SolveGuess(const DensityGuessGrid &grid, const double T, const double P, double &D, int &ierr, const char *&herr, int &iter)
+{
+    if (grid.method == DensityGuessDetail)
+    {
+        DensityDetail(T, P, grid.x, D, ierr, herr);
+        iter = DensityIterationsDetail();
+    }
+    else
+    {
+        DensityGERG(grid.iFlag, T, P, grid.x, D, ierr, herr);
+        iter = DensityIterationsGERG();
+    }
+}
+
+/**
+ * @brief Check that the solver reaches D from its own estimate with plain Newton steps
+ *
+ * Replays the iterations of DensityGERG and DensityDetail from their initial estimate, the ideal gas
+ * density or 3 times the pseudo-critical density Dcx for DensityGERG with iFlag = 2. Where they go
+ * through the 2-phase search (dP/dD <= 0 on the way, typically in the liquid), the root found
+ * depends on the path and cannot be predicted from the neighbouring states.
+ */
+static bool RegularGuess(const DensityGuessGrid &grid, const double Dcx, const double T, const double P, const double D)
+{
+    const double epsilon = 1e-15;
+    PreparedIsothermGERG isoGERG;
+    PreparedIsothermDetail isoDetail;
+    double R, P2, Z, dPdD;
+    if (grid.method == DensityGuessDetail)
+    {
+        R = 8.31451;
+        PrepareIsothermDetail(T, grid.x, isoDetail);
+    }
+    else
+    {
+        R = 8.314472;
+        PrepareIsothermGERG(T, grid.x, isoGERG);
+    }
+    const double plog = std::log(P);
+    double vlog = -std::log(grid.method == DensityGuessGERG && grid.iFlag == 2 ? Dcx * 3 : P / R / T);
+    for (int it = 1; it <= 20; ++it)
+    {
+        const double Dk = std::exp(-vlog);
+        if (grid.method == DensityGuessDetail) { PressureIsothermDetail(isoDetail, Dk, P2, Z, dPdD); }
+        else { PressureIsothermGERG(isoGERG, Dk, P2, Z, dPdD); }
+        if (dPdD < epsilon || P2 < epsilon) { return false; }
+        const double vdiff = (std::log(P2) - plog) * P2 / (-Dk * dPdD);
+        vlog -= vdiff;
+        if (std::abs(vdiff) < tolrGuess) { return std::abs(vlog + std::log(D)) <= 10 * tolrGuess; }
+    }
+    return false;
+}
+
+// Bilinear interpolation of ln(1/D) in cell (iT, iP) at the local coordinates 0 <= u, w <= 1
+static inline double InterpolateGuess(const DensityGuessGrid &grid, const int iT, const int iP, const double u, const double w)
+{
+    const double *v0 = &grid.lnv[(std::size_t)iT * (grid.nP + 1) + iP];
+    const double *v1 = v0 + grid.nP + 1;
+    return (1 - u) * ((1 - w) * v0[0] + w * v0[1]) + u * ((1 - w) * v1[0] + w * v1[1]);
+}
+
+/**
+ * @brief Build the density estimate grid of a composition
+ *
+ * The density is solved without an estimate at each node. A cell is used only if the solver reaches
+ * its four nodes and 3 x 3 states inside it by plain Newton steps (see RegularGuess), and if at these
+ * states the solver started from the estimate finds the same root as without it.
+ * SetupGERG (or SetupDetail) must have been called.
+ *
+ * @param method DensityGuessGERG or DensityGuessDetail
+ * @param iFlag iFlag of DensityGERG (ignored for DETAIL)
+ * @param x Composition (mole fraction)
+ * @param Tmin, Tmax Temperature range (K)
+ * @param Pmin, Pmax Pressure range (kPa), Pmin > 0
+ * @param nT, nP Number of cells in T and ln P (e.g. 32 x 32)
+ * @param[out] grid Grid
+ * @param[out] ierr Error number (0 indicates no error)
+ * @param[out] herr Error message if ierr is not equal to zero
+ */
+void BuildDensityGuess(const int method, const int iFlag, const std::vector<double> &x, const double Tmin, const double Tmax, const double Pmin, const double Pmax, const int nT, const int nP, DensityGuessGrid &grid, int &ierr, const char *&herr)
+{
+    BuildDensityGuessImpl(method, iFlag, x, Tmin, Tmax, Pmin, Pmax, nT, nP, grid, ierr, herr);
+}
+
+/**
+ * @brief BuildDensityGuess for a fixed-size Composition
+ * @see BuildDensityGuess
+ */
+void BuildDensityGuess(const int method, const int iFlag, const Composition &x, const double Tmin, const double Tmax, const double Pmin, const double Pmax, const int nT, const int nP, DensityGuessGrid &grid, int &ierr, const char *&herr)
+{
+    BuildDensityGuessImpl(method, iFlag, x, Tmin, Tmax, Pmin, Pmax, nT, nP, grid, ierr, herr);
+}
+
+/**
+ * @brief BuildDensityGuess for a CompositionView, e.g. a row of a composition matrix
+ * @see BuildDensityGuess
+ */
+void BuildDensityGuess(const int method, const int iFlag, const CompositionView &x, const double Tmin, const double Tmax, const double Pmin, const double Pmax, const int nT, const int nP, DensityGuessGrid &grid, int &ierr, const char *&herr)
+{
+    BuildDensityGuessImpl(method, iFlag, x, Tmin, Tmax, Pmin, Pmax, nT, nP, grid, ierr, herr);
+}
+
+// BuildDensityGuess for any composition type X (std::vector, Composition, CompositionView)
+template <typename X>
+static void BuildDensityGuessImpl(const int method, const int iFlag, const X &x, const double Tmin, const double Tmax, const double Pmin, const double Pmax, const int nT, const int nP, DensityGuessGrid &grid, int &ierr, const char *&herr)
+{
+    ierr = 0;
+    herr = "";
+    if (method != DensityGuessGERG && method != DensityGuessDetail) { ierr = 1; herr = "Unknown density estimate method"; return; }
+    if (!(Tmin > 0 && Tmax > Tmin && Pmin > 0 && Pmax > Pmin)) { ierr = 2; herr = "Invalid density estimate domain"; return; }
+    if (nT < 1 || nP < 1 || nT > MaxCellsGuess || nP > MaxCellsGuess) { ierr = 3; herr = "Invalid number of density estimate cells"; return; }
+
+    grid.method = method;
+    grid.iFlag = iFlag;
+    for (int i = 1; i <= NcComposition; ++i) { grid.x[i] = x[i]; }
+    grid.Tmin = Tmin;
+    grid.Tmax = Tmax;
+    grid.lnPmin = std::log(Pmin);
+    grid.lnPmax = std::log(Pmax);
+    grid.nT = nT;
+    grid.nP = nP;
+    grid.lnv.assign((std::size_t)(nT + 1) * (nP + 1), 0);
+    grid.iter.assign((std::size_t)nT * nP, 0);
+    grid.valid.assign((std::size_t)nT * nP, 0);
+
+    // Pseudo-critical density, the liquid estimate of DensityGERG
+    double Dcx = 0;
+    if (method == DensityGuessGERG)
+    {
+        double Tcx;
+        PseudoCriticalPointGERG(grid.x, Tcx, Dcx);
+    }
+
+    std::vector<int> nodeIter((std::size_t)(nT + 1) * (nP + 1));
+    std::vector<unsigned char> nodeOk((std::size_t)(nT + 1) * (nP + 1));
+    double D;
+    int ierrs, iter;
+    const char *herrs;
+    for (int iT = 0; iT <= nT; ++iT)
+    {
+        const double T = Tmin + (Tmax - Tmin) * iT / nT;
+        for (int iP = 0; iP <= nP; ++iP)
+        {
+            const double P = std::exp(grid.lnPmin + (grid.lnPmax - grid.lnPmin) * iP / nP);
+            const std::size_t k = (std::size_t)iT * (nP + 1) + iP;
+            D = 0;
+            SolveGuess(grid, T, P, D, ierrs, herrs, iter);
+            nodeOk[k] = ierrs == 0 && D > 0 && RegularGuess(grid, Dcx, T, P, D);
+            grid.lnv[k] = nodeOk[k] ? -std::log(D) : 0;
+            nodeIter[k] = iter;
+        }
+    }
+
+    for (int iT = 0; iT < nT; ++iT)
+    {
+        for (int iP = 0; iP < nP; ++iP)
+        {
+            const std::size_t k = (std::size_t)iT * (nP + 1) + iP, cell = (std::size_t)iT * nP + iP;
+            if (!nodeOk[k] || !nodeOk[k + 1] || !nodeOk[k + nP + 1] || !nodeOk[k + nP + 2]) { continue; }
+            grid.iter[cell] = (nodeIter[k] + nodeIter[k + 1] + nodeIter[k + nP + 1] + nodeIter[k + nP + 2]) / 4.0;
+
+            bool valid = true;
+            for (int a = 1; a <= 3 && valid; ++a)
+            {
+                for (int b = 1; b <= 3 && valid; ++b)
+                {
+                    const double T = Tmin + (Tmax - Tmin) * (iT + a / 4.0) / nT;
+                    const double P = std::exp(grid.lnPmin + (grid.lnPmax - grid.lnPmin) * (iP + b / 4.0) / nP);
+                    double Ds = -std::exp(-InterpolateGuess(grid, iT, iP, a / 4.0, b / 4.0)), Du = 0;
+                    int ierru;
+                    SolveGuess(grid, T, P, Du, ierru, herrs, iter);
+                    SolveGuess(grid, T, P, Ds, ierrs, herrs, iter);
+                    valid = ierrs == 0 && ierru == 0 && std::abs(std::log(Ds / Du)) <= tolrGuess && RegularGuess(grid, Dcx, T, P, Du);
+                }
+            }
+            grid.valid[cell] = valid;
+        }
+    }
+}
+
+/**
+ * @brief Density from temperature and pressure, started from the grid estimate when possible
+ *
+ * Same result as DensityGERG (with the iFlag of the grid) or DensityDetail within the solver
+ * tolerance. Outside the grid, in cells where the estimate was not validated, or if the solver
+ * moves too far from the estimate, the solver starts from its own estimate.
+ *
+ * @param grid Grid from BuildDensityGuess
+ * @param T Temperature (K)
+ * @param P Pressure (kPa)
+ * @param[out] D Density (mol/l)
+ * @param[out] ierr Error number (0 indicates no error)
+ * @param[out] herr Error message if ierr is not equal to zero
+ */
+void DensityGuess(const DensityGuessGrid &grid, const double T, const double P, double &D, int &ierr, const char *&herr)
+{
+    int iter;
+    ++guessStats.calls;
+    if (T >= grid.Tmin && T <= grid.Tmax && P > 0)
+    {
+        const double L = std::log(P);
+        if (L >= grid.lnPmin && L <= grid.lnPmax)
+        {
+            const double ft = (T - grid.Tmin) / (grid.Tmax - grid.Tmin) * grid.nT;
+            const double fp = (L - grid.lnPmin) / (grid.lnPmax - grid.lnPmin) * grid.nP;
+            const int iT = std::min((int)ft, grid.nT - 1), iP = std::min((int)fp, grid.nP - 1);
+            const std::size_t cell = (std::size_t)iT * grid.nP + iP;
+            if (grid.valid[cell])
+            {
+                const double lnv = InterpolateGuess(grid, iT, iP, ft - iT, fp - iP);
+                D = -std::exp(-lnv);
+                SolveGuess(grid, T, P, D, ierr, herr, iter);
+                guessStats.iterations += iter;
+                if (ierr == 0 && D > 0 && std::abs(-std::log(D) - lnv) <= MaxCorrectionGuess)
+                {
+                    ++guessStats.hits;
+                    guessStats.iterationsSaved += grid.iter[cell] - iter;
+                    return;
+                }
+                guessStats.iterationsSaved -= iter;
+            }
+        }
+    }
+    D = 0;
+    SolveGuess(grid, T, P, D, ierr, herr, iter);
+    guessStats.iterations += iter;
+}
+
+/**
+ * @brief Counters of the DensityGuess calls of the calling thread since its last ResetDensityGuessStats
+ *
+ * @param[out] stats Calls, hits, solver iterations and estimated iterations saved
+ */
+void GetDensityGuessStats(DensityGuessStats &stats)
+{
+    stats = guessStats;
+}
+
+/**
+ * @brief Reset the counters of DensityGuess of the calling thread
+ */
+void ResetDensityGuessStats()
+{
+    guessStats = DensityGuessStats();
+}
@@ -0,0 +1,74 @@
+/**
+ * @file DensityGuess.h
+ * @brief Initial density estimates of DensityGERG and DensityDetail from a precomputed (T,P) grid
+ *
+ * The grid holds ln(1/D) of one composition at the nodes of a uniform (T, ln P) grid. A state inside
+ * the grid starts DensityGERG (or DensityDetail) from the interpolated density, passed as a negative
+ * D input, so that the usual Newton iterations only polish it. The result is the one of the solver
+ * started from its own estimate, within the solver tolerance (1e-7 on ln(1/D)).
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef AGA8DENSITYGUESS_H_
+#define AGA8DENSITYGUESS_H_
+
+#include <vector>
+#include "Composition.h"
+
+// Equation of state of a grid
+const int DensityGuessGERG = 0, DensityGuessDetail = 1;
+
+/**
+ * @brief ln(1/D) of one composition at (nT + 1) x (nP + 1) nodes over Tmin <= T <= Tmax, Pmin <= P <= Pmax
+ *
+ * Node (iT, iP) is stored at iT*(nP + 1) + iP and cell (iT, iP) at iT*nP + iP.
+ */
+struct DensityGuessGrid
+{
+    int method;                  // DensityGuessGERG or DensityGuessDetail
+    int iFlag;                   // iFlag of DensityGERG
+    Composition x;               // Composition
+    double Tmin, Tmax;           // Temperature range (K)
+    double lnPmin, lnPmax;       // Natural logarithm of the pressure range (kPa)
+    int nT, nP;                  // Number of cells in T and ln P
+    std::vector<double> lnv;     // ln(1/D) at the nodes, D in mol/l
+    std::vector<double> iter;    // Iterations of the solver without estimate, mean of the four nodes of each cell
+    std::vector<unsigned char> valid; // 1 if the cell may seed the solver
+};
+
+/**
+ * @brief Counters of DensityGuess since the last ResetDensityGuessStats
+ */
+struct DensityGuessStats
+{
+    long long calls;             // Number of DensityGuess calls
+    long long hits;              // Calls started from the grid
+    long long iterations;        // Iterations of the density solver
+    double iterationsSaved;      // Estimated iterations saved by the hits, from the iterations of the grid nodes
+};
+
+void BuildDensityGuess(const int method, const int iFlag, const std::vector<double> &x, const double Tmin, const double Tmax, const double Pmin, const double Pmax, const int nT, const int nP, DensityGuessGrid &grid, int &ierr, const char *&herr);
+void BuildDensityGuess(const int method, const int iFlag, const Composition &x, const double Tmin, const double Tmax, const double Pmin, const double Pmax, const int nT, const int nP, DensityGuessGrid &grid, int &ierr, const char *&herr);
+void BuildDensityGuess(const int method, const int iFlag, const CompositionView &x, const double Tmin, const double Tmax, const double Pmin, const double Pmax, const int nT, const int nP, DensityGuessGrid &grid, int &ierr, const char *&herr);
+void DensityGuess(const DensityGuessGrid &grid, const double T, const double P, double &D, int &ierr, const char *&herr);
+void GetDensityGuessStats(DensityGuessStats &stats);
+void ResetDensityGuessStats();
+
+#endif
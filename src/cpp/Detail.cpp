@@ -48,11 +48,14 @@ OR USE OF, THE SOFTWARE OR SERVICES PROVIDED HEREUNDER.
 */
 
 #include "Detail.h"
+#include "Scalar.h"
+#include "Trace.h"
 // We add both math headers to placate some non-standards-compliant compilers
 #include <math.h>
 #include <cmath>
 #include <iostream>
 #include <cstdlib>
+#include <algorithm>
 
 //  **********  This code is preliminary, and will be updated.  **********
 //  **********  Use only for beta testing.  **********
@@ -89,12 +92,30 @@ OR USE OF, THE SOFTWARE OR SERVICES PROVIDED HEREUNDER.
 // Sub PressureDetail(T, D, x, P, Z)
 // Sub DensityDetail(T, P, x, D, ierr, herr)
 // Sub PropertiesDetail(T, D, x, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa)
+// Sub PrepareIsothermDetail(T, x, iso)
+// Sub PressureIsothermDetail(iso, D, P, Z, dPdD)
+// Sub PrepareFixedGasDetail(x, fg)
+// Sub CompositionDerivativesDetail(T, D, x, P, Z, W, dZdx, dDdx, dWdx)
+// Sub CompositionDerivativesBatchDetail(T, P, x, D, Z, W, dZdx, dDdx, dWdx, ierr)
+// PressureDetail and PropertiesDetail are also templates on the scalar type of T, D and x (float, double, Dual<N>)
 // Sub SetupDetail()
 
 // Function prototypes (not exported)
-static void xTermsDetail(const std::vector<double> &x);
-static void Alpha0Detail(const double T, const double D, const std::vector<double> &x, double a0[3]);
+template <typename X> static void xTermsDetail(const X &x);
+template <typename X> static void Alpha0Detail(const double T, const double D, const X &x, double a0[3]);
 static void AlpharDetail(const int itau, const int idel, const double T, const double D, double ar[4][4]);
+template <typename V, typename Wide> static void AlpharTermsDetail(const int itau, const V &T, const V &D, const Wide &K3x, const Wide Bsx[], const Wide Csnx[], const Wide Tun[], V ar[4][4]);
+template <typename V, typename X> static void MixtureTermsDetail(const X &x, V &K3x, V Bsx[], V Csnx[], V &xLnx);
+template <typename V> static void Alpha0ScalarDetail(const V &T, const V &D, const std::vector<V> &x, const V &xLnx, V a0[3]);
+static const double *TunDetail(const double T);
+template <typename V> static void IdealTermsDetail(const V &T, const int i, V &c0, V &c1, V &c2);
+template <typename X, typename V> static void MolarMassDetailImpl(const X &x, V &Mm);
+template <typename X> static void PressureDetailImpl(const double T, const double D, const X &x, double &P, double &Z);
+template <typename X> static void DensityDetailImpl(const double T, const double P, const X &x, double &D, int &ierr, const char *&herr);
+template <typename X> static void PropertiesDetailImpl(const double T, const double D, const X &x, double &P, double &Z, double &dPdD, double &d2PdD2, double &d2PdTD, double &dPdT, double &U, double &H, double &S, double &Cv, double &Cp, double &W, double &G, double &JT, double &Kappa, double &Cf);
+template <typename X> static void PrepareIsothermDetailImpl(const double T, const X &x, PreparedIsothermDetail &iso);
+template <typename X, typename Y> static void CompositionDerivativesDetailImpl(const double T, const double D, const X &x, double &P, double &Z, double &W, Y &dZdx, Y &dDdx, Y &dWdx);
+template <typename X> static void CompositionDerivativesBatchDetailImpl(const std::vector<double> &T, const std::vector<double> &P, const X &x, std::vector<double> &D, std::vector<double> &Z, std::vector<double> &W, std::vector<double> &dZdx, std::vector<double> &dDdx, std::vector<double> &dWdx, std::vector<int> &ierr);
 
 // The compositions in the x() array use the following order and must be sent as mole fractions:
 //     0 - PLACEHOLDER
@@ -130,32 +151,36 @@ static const double epsilon = 1e-15;
 static int fn[NTerms + 1], gn[NTerms + 1], qn[NTerms + 1];
 static double an[NTerms + 1], un[NTerms + 1];
 static int bn[NTerms + 1], kn[NTerms + 1]; // TODO: update VB
-static double Bsnij2[MaxFlds + 1][MaxFlds + 1][18 + 1], Bs[18 + 1], Csn[NTerms + 1];
+// Packed per-term data for AlpharDetail, filled in SetupDetail: exponents as doubles, kn^2, R*(un-1) and R*(un-1)*un
+static double bnd[NTerms + 1], knd[NTerms + 1], kn2d[NTerms + 1], CoefT1[NTerms + 1], CoefT2[NTerms + 1];
+static double Bsnij2[MaxFlds + 1][MaxFlds + 1][18 + 1];
 static double Fi[MaxFlds + 1], Gi[MaxFlds + 1], Qi[MaxFlds + 1];
 static double Ki25[MaxFlds + 1], Ei25[MaxFlds + 1];
 static double Kij5[MaxFlds + 1][MaxFlds + 1], Uij5[MaxFlds + 1][MaxFlds + 1], Gij5[MaxFlds + 1][MaxFlds + 1];
-static double Tun[NTerms + 1], Told;
 static double n0i[MaxFlds + 1][7 + 1], th0i[MaxFlds + 1][7 + 1];
-static double MMiDetail[MaxFlds + 1], K3, xold[MaxFlds + 1];
-static double dPdDsave; // Calculated in the Pressure subroutine, but not included as an argument since it is only used internally in the density algorithm.
-
-inline double sq(double x) { return x * x; }
-
-/**
- * @brief Calculate molar mass of a mixture based on composition
- *
- * This function calculates the molar mass of a mixture using the mole fractions
- * of each component provided in the composition array.
- *
- * @param x Vector of mole fractions for each component in the mixture.
- *          Must sum to 1.0. Use mole fractions only (not mass fractions or mole percents).
- *          Components must be ordered according to the fluid order defined in the implementation.
- * @param[out] Mm Calculated molar mass of the mixture in g/mol
- *
- * @note The composition array x must contain valid mole fractions that sum to 1.0
- * @see MolarMassDetail_wrapper for the Emscripten wrapped version of this function
- */
-void MolarMassDetail(const std::vector<double> &x, double &Mm)
+static double MMiDetail[MaxFlds + 1];
+// Composition terms K3, Bs and Csn of each pure fluid with x[i] = 1, filled at the end of SetupDetail
+static double K3Pure[MaxFlds + 1], BsPure[MaxFlds + 1][18 + 1], CsnPure[MaxFlds + 1][NTerms + 1];
+static bool PureSetDetail = false;
+
+// The variables below are the caches and results of the last calls, kept per thread: once SetupDetail has filled the
+// constants above, the functions of this module may be called from several threads at once
+static thread_local double Bs[18 + 1], Csn[NTerms + 1], K3, SumxLnx, xold[MaxFlds + 1];
+// Temperature-only terms at the last NTSlots temperatures (see TemperatureSlotDetail)
+static const int NTSlots = 4;
+static thread_local double TSlot[NTSlots], TunT[NTSlots][NTerms + 1], a0T[NTSlots][3][MaxFlds + 1];
+static thread_local bool TunTset[NTSlots], a0Tset[NTSlots][MaxFlds + 1];
+static thread_local int TSlotNext;
+// Component number when x is a pure fluid (a single non-zero mole fraction), 0 for a mixture; set by xTermsDetail on every call
+static thread_local int iPureDetail;
+static thread_local double dPdDsave; // Calculated in the Pressure subroutine, but not included as an argument since it is only used internally in the density algorithm.
+static thread_local int nIterDetail;   // Iterations of the last DensityDetail call, see DensityIterationsDetail
+
+template <typename V> inline V sq(const V &x) { return x * x; }
+
+// MolarMassDetail for any composition type with x[i], i = 1 to NcDetail (std::vector, Composition, CompositionView)
+template <typename X, typename V>
+static void MolarMassDetailImpl(const X &x, V &Mm)
 {
     // Calculate molar mass of the mixture with the compositions contained in the x() input array
 
@@ -176,24 +201,45 @@ void MolarMassDetail(const std::vector<double> &x, double &Mm)
 }
 
 /**
- * @brief Calculates pressure and compressibility factor as a function of temperature and density
+ * @brief Calculate molar mass of a mixture based on composition
  *
- * This function computes the pressure and compressibility factor for a gas mixture
- * using the GERG-2008 equation of state. It also calculates d(P)/d(D) which is cached
- * for use in iterative density calculations.
+ * This function calculates the molar mass of a mixture using the mole fractions
+ * of each component provided in the composition array.
  *
- * @param T Temperature in Kelvin (K)
- * @param D Density in moles per liter (mol/l)
- * @param x Vector of composition mole fractions (must sum to 1.0)
- * @param[out] P Pressure in kiloPascals (kPa)
- * @param[out] Z Compressibility factor (dimensionless)
+ * @param x Vector of mole fractions for each component in the mixture.
+ *          Must sum to 1.0. Use mole fractions only (not mass fractions or mole percents).
+ *          Components must be ordered according to the fluid order defined in the implementation.
+ * @param[out] Mm Calculated molar mass of the mixture in g/mol
  *
- * @note The composition vector x must contain mole fractions, not mole percents or mass fractions
- * @note The sum of all mole fractions in x must equal 1.0
- * @note The derivative d(P)/d(D) is cached internally but not returned as an argument
- * @see PressureDetail_wrapper for the Emscripten wrapped version of this function
+ * @note The composition array x must contain valid mole fractions that sum to 1.0
+ * @see MolarMassDetail_wrapper for the Emscripten wrapped version of this function
  */
-void PressureDetail(const double T, const double D, const std::vector<double> &x, double &P, double &Z)
+void MolarMassDetail(const std::vector<double> &x, double &Mm)
+{
+    MolarMassDetailImpl(x, Mm);
+}
+
+/**
+ * @brief MolarMassDetail for a fixed-size Composition
+ * @see MolarMassDetail
+ */
+void MolarMassDetail(const Composition &x, double &Mm)
+{
+    MolarMassDetailImpl(x, Mm);
+}
+
+/**
+ * @brief MolarMassDetail for a CompositionView, e.g. a row of a composition matrix
+ * @see MolarMassDetail
+ */
+void MolarMassDetail(const CompositionView &x, double &Mm)
+{
+    MolarMassDetailImpl(x, Mm);
+}
+
+// PressureDetail for any composition type with x[i], i = 1 to NcDetail (std::vector, Composition, CompositionView)
+template <typename X>
+static void PressureDetailImpl(const double T, const double D, const X &x, double &P, double &Z)
 {
     // Sub Pressure(T, D, x, P, Z)
 
@@ -222,28 +268,49 @@ void PressureDetail(const double T, const double D, const std::vector<double> &x
 }
 
 /**
- * @brief Calculates density as a function of temperature and pressure using an iterative method.
+ * @brief Calculates pressure and compressibility factor as a function of temperature and density
  *
- * This function uses an iterative Newton's method that calls PressureDetail to find the correct state point.
- * Generally only 6 iterations at most are required. If the iteration fails to converge, the ideal gas density
- * and an error message are returned. No checks are made to determine the phase boundary, which would have
- * guaranteed that the output is in the gas phase. It is up to the user to locate the phase boundary, and
- * thus identify the phase of the T and P inputs. If the state point is 2-phase, the output density will
- * represent a metastable state.
+ * This function computes the pressure and compressibility factor for a gas mixture
+ * using the GERG-2008 equation of state. It also calculates d(P)/d(D) which is cached
+ * for use in iterative density calculations.
  *
  * @param T Temperature in Kelvin (K)
- * @param P Pressure in kiloPascals (kPa)
- * @param x Vector of mole fractions representing composition
- * @param D Density in mol/l (can be negative to use as initial guess)
- * @param ierr Error number (0 indicates no error)
- * @param herr Error message string (empty if no error)
+ * @param D Density in moles per liter (mol/l)
+ * @param x Vector of composition mole fractions (must sum to 1.0)
+ * @param[out] P Pressure in kiloPascals (kPa)
+ * @param[out] Z Compressibility factor (dimensionless)
  *
- * @note If D is passed as negative, its absolute value will be used as initial estimate
- * @note If P is zero (or very close to zero), D will be set to 0
- * @note If calculation fails to converge, ideal gas density is returned with error message
- * @see DensityDetail_wrapper for the Emscripten wrapped version of this function
+ * @note The composition vector x must contain mole fractions, not mole percents or mass fractions
+ * @note The sum of all mole fractions in x must equal 1.0
+ * @note The derivative d(P)/d(D) is cached internally but not returned as an argument
+ * @see PressureDetail_wrapper for the Emscripten wrapped version of this function
  */
-void DensityDetail(const double T, const double P, const std::vector<double> &x, double &D, int &ierr, std::string &herr)
+void PressureDetail(const double T, const double D, const std::vector<double> &x, double &P, double &Z)
+{
+    PressureDetailImpl(T, D, x, P, Z);
+}
+
+/**
+ * @brief PressureDetail for a fixed-size Composition
+ * @see PressureDetail
+ */
+void PressureDetail(const double T, const double D, const Composition &x, double &P, double &Z)
+{
+    PressureDetailImpl(T, D, x, P, Z);
+}
+
+/**
+ * @brief PressureDetail for a CompositionView, e.g. a row of a composition matrix
+ * @see PressureDetail
+ */
+void PressureDetail(const double T, const double D, const CompositionView &x, double &P, double &Z)
+{
+    PressureDetailImpl(T, D, x, P, Z);
+}
+
+// DensityDetail for any composition type with x[i], i = 1 to NcDetail (std::vector, Composition, CompositionView)
+template <typename X>
+static void DensityDetailImpl(const double T, const double P, const X &x, double &D, int &ierr, const char *&herr)
 {
     // Sub DensityDetail(T, P, x, D, ierr, herr)
 
@@ -268,6 +335,7 @@ void DensityDetail(const double T, const double P, const std::vector<double> &x,
 
     ierr = 0;
     herr = "";
+    nIterDetail = 0;
     if (std::abs(P) < epsilon)
     {
         D = 0;
@@ -282,10 +350,16 @@ void DensityDetail(const double T, const double P, const std::vector<double> &x,
     {
         D = std::abs(D); // If D<0, then use as initial estimate
     }
+    // The temperature and composition are fixed during the iterations, so evaluate the pressure from the prepared isotherm
+    static thread_local PreparedIsothermDetail iso;
+    PrepareIsothermDetailImpl(T, x, iso);
+
     plog = log(P);
     vlog = -log(D);
     for (int it = 1; it <= 20; ++it)
     {
+        AGA8_TRACE_SCOPE_ARG("DensityDetail iteration", it);
+        nIterDetail = it;
         if (vlog < -7 || vlog > 100)
         {
             ierr = 1;
@@ -294,7 +368,7 @@ void DensityDetail(const double T, const double P, const std::vector<double> &x,
             return;
         }
         D = exp(-vlog);
-        PressureDetail(T, D, x, P2, Z);
+        PressureIsothermDetail(iso, D, P2, Z, dPdDsave);
         if (dPdDsave < epsilon || P2 < epsilon)
         {
             vlog += 0.1;
@@ -321,33 +395,119 @@ void DensityDetail(const double T, const double P, const std::vector<double> &x,
 }
 
 /**
- * @brief Calculates thermodynamic properties as a function of temperature and density.
+ * @brief Calculates density as a function of temperature and pressure using an iterative method.
  *
- * If density is unknown, call DensityDetail first with known pressure and temperature values.
- * Makes calls to Molarmass, Alpha0Detail, and AlpharDetail subroutines.
+ * This function uses an iterative Newton's method that calls PressureDetail to find the correct state point.
+ * Generally only 6 iterations at most are required. If the iteration fails to converge, the ideal gas density
+ * and an error message are returned. No checks are made to determine the phase boundary, which would have
+ * guaranteed that the output is in the gas phase. It is up to the user to locate the phase boundary, and
+ * thus identify the phase of the T and P inputs. If the state point is 2-phase, the output density will
+ * represent a metastable state.
  *
  * @param T Temperature in Kelvin (K)
- * @param D Density in mol/l
+ * @param P Pressure in kiloPascals (kPa)
  * @param x Vector of mole fractions representing composition
- * @param[out] P Pressure in kPa
- * @param[out] Z Compressibility factor
- * @param[out] dPdD First derivative of pressure with respect to density at constant temperature [kPa/(mol/l)]
- * @param[out] d2PdD2 Second derivative of pressure with respect to density at constant temperature [kPa/(mol/l)^2]
- * @param[out] d2PdTD Second derivative of pressure with respect to temperature and density [kPa/(mol/l)/K]
- * @param[out] dPdT First derivative of pressure with respect to temperature at constant density (kPa/K)
- * @param[out] U Internal energy in J/mol
- * @param[out] H Enthalpy in J/mol
- * @param[out] S Entropy in J/(mol-K)
- * @param[out] Cv Isochoric heat capacity in J/(mol-K)
- * @param[out] Cp Isobaric heat capacity in J/(mol-K)
- * @param[out] W Speed of sound in m/s
- * @param[out] G Gibbs energy in J/mol
- * @param[out] JT Joule-Thomson coefficient in K/kPa
- * @param[out] Kappa Isentropic Exponent
- * @param[out] Cf Critical Flow Factor (dimensionless)
- * @see PropertiesDetail_wrapper for the Emscripten wrapped version of this function
+ * @param D Density in mol/l (can be negative to use as initial guess)
+ * @param ierr Error number (0 indicates no error)
+ * @param herr Error message string (empty if no error)
+ *
+ * @note If D is passed as negative, its absolute value will be used as initial estimate
+ * @note If P is zero (or very close to zero), D will be set to 0
+ * @note If calculation fails to converge, ideal gas density is returned with error message
+ * @see DensityDetail_wrapper for the Emscripten wrapped version of this function
  */
-void PropertiesDetail(const double T, const double D, const std::vector<double> &x, double &P, double &Z, double &dPdD, double &d2PdD2, double &d2PdTD, double &dPdT, double &U, double &H, double &S, double &Cv, double &Cp, double &W, double &G, double &JT, double &Kappa, double &Cf)
+void DensityDetail(const double T, const double P, const std::vector<double> &x, double &D, int &ierr, const char *&herr)
+{
+    DensityDetailImpl(T, P, x, D, ierr, herr);
+}
+
+/**
+ * @brief DensityDetail for a fixed-size Composition
+ * @see DensityDetail
+ */
+void DensityDetail(const double T, const double P, const Composition &x, double &D, int &ierr, const char *&herr)
+{
+    DensityDetailImpl(T, P, x, D, ierr, herr);
+}
+
+/**
+ * @brief DensityDetail for a CompositionView, e.g. a row of a composition matrix
+ * @see DensityDetail
+ */
+void DensityDetail(const double T, const double P, const CompositionView &x, double &D, int &ierr, const char *&herr)
+{
+    DensityDetailImpl(T, P, x, D, ierr, herr);
+}
+
+/**
+ * @brief Number of iterations of the last DensityDetail call
+ *
+ * 0 when the pressure is zero, the maximum number of iterations when the calculation failed to converge.
+ * Used to measure the effect of an initial density estimate (negative D input).
+ */
+int DensityIterationsDetail()
+{
+    return nIterDetail;
+}
+
+/**
+ * @brief DensityDetail with the error message returned as a std::string
+ * @see DensityDetail
+ */
+void DensityDetail(const double T, const double P, const std::vector<double> &x, double &D, int &ierr, std::string &herr)
+{
+    const char *msg = "";
+    DensityDetail(T, P, x, D, ierr, msg);
+    herr = msg;
+}
+
+// Properties from the ideal gas and residual Helmholtz derivatives of Alpha0Detail and AlpharDetail, for any scalar type
+template <typename V>
+static void PropertiesFromAlphaDetail(const V &T, const V &D, const V &Mm, const V a0[3], const V ar[4][4], V &P, V &Z, V &dPdD, V &d2PdD2, V &d2PdTD, V &dPdT, V &U, V &H, V &S, V &Cv, V &Cp, V &W, V &G, V &JT, V &Kappa, V &Cf)
+{
+    double R;
+    V A, RT;
+
+    R = RDetail;
+    RT = R * T;
+    Z = 1 + ar[0][1] / RT;
+    P = D * RT * Z;
+    dPdD = RT + 2 * ar[0][1] + ar[0][2];
+    dPdT = D * R + D * ar[1][1];
+    A = a0[0] + ar[0][0];
+    S = -a0[1] - ar[1][0];
+    U = A + T * S;
+    Cv = -(a0[2] + ar[2][0]);
+    if (D > epsilon)
+    {
+        H = U + P / D;
+        G = A + P / D;
+        Cp = Cv + T * sq(dPdT / D) / dPdD;
+        d2PdD2 = (2 * ar[0][1] + 4 * ar[0][2] + ar[0][3]) / D;
+        JT = (T / D * dPdT / dPdD - 1) / Cp / D;
+    }
+    else
+    {
+        H = U + RT;
+        G = A + RT;
+        Cp = Cv + R;
+        d2PdD2 = 0;
+        JT = 1E+20; //=(dB/dT*T-B)/Cp for an ideal gas, but dB/dT is not calculated here
+    }
+    W = 1000 * Cp / Cv * dPdD / Mm;
+    if (W < 0)
+    {
+        W = 0;
+    }
+    W = sqrt(W);
+    Kappa = W * W * Mm / (RT * 1000 * Z);
+    Cf = sqrt(Kappa * pow( (2 / (Kappa + 1)), ((Kappa + 1) / (Kappa - 1))));
+    d2PdTD = 0;
+}
+
+// PropertiesDetail for any composition type with x[i], i = 1 to NcDetail (std::vector, Composition, CompositionView)
+template <typename X>
+static void PropertiesDetailImpl(const double T, const double D, const X &x, double &P, double &Z, double &dPdD, double &d2PdD2, double &d2PdTD, double &dPdT, double &U, double &H, double &S, double &Cv, double &Cp, double &W, double &G, double &JT, double &Kappa, double &Cf)
 {
     // Sub Properties(T, D, x, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa)
 
@@ -378,9 +538,9 @@ void PropertiesDetail(const double T, const double D, const std::vector<double>
     //  Kappa - Isentropic Exponent
     //     Cf - Critical Flow Factor (dimensionless)
 
-    double a0[2 + 1], ar[3 + 1][3 + 1], Mm, A, R, RT;
+    double a0[2 + 1], ar[3 + 1][3 + 1], Mm;
 
-    MolarMassDetail(x, Mm);
+    MolarMassDetailImpl(x, Mm);
     xTermsDetail(x);
 
     // Calculate the ideal gas Helmholtz energy, and its first and second derivatives with respect to temperature.
@@ -389,77 +549,647 @@ void PropertiesDetail(const double T, const double D, const std::vector<double>
     // Calculate the real gas Helmholtz energy, and its derivatives with respect to temperature and/or density.
     AlpharDetail(2, 3, T, D, ar);
 
-    R = RDetail;
-    RT = R * T;
-    Z = 1 + ar[0][1] / RT;
+    PropertiesFromAlphaDetail(T, D, Mm, a0, ar, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, Cf);
+}
+
+/**
+ * @brief Calculates thermodynamic properties as a function of temperature and density.
+ *
+ * If density is unknown, call DensityDetail first with known pressure and temperature values.
+ * Makes calls to Molarmass, Alpha0Detail, and AlpharDetail subroutines.
+ *
+ * @param T Temperature in Kelvin (K)
+ * @param D Density in mol/l
+ * @param x Vector of mole fractions representing composition
+ * @param[out] P Pressure in kPa
+ * @param[out] Z Compressibility factor
+ * @param[out] dPdD First derivative of pressure with respect to density at constant temperature [kPa/(mol/l)]
+ * @param[out] d2PdD2 Second derivative of pressure with respect to density at constant temperature [kPa/(mol/l)^2]
+ * @param[out] d2PdTD Second derivative of pressure with respect to temperature and density [kPa/(mol/l)/K]
+ * @param[out] dPdT First derivative of pressure with respect to temperature at constant density (kPa/K)
+ * @param[out] U Internal energy in J/mol
+ * @param[out] H Enthalpy in J/mol
+ * @param[out] S Entropy in J/(mol-K)
+ * @param[out] Cv Isochoric heat capacity in J/(mol-K)
+ * @param[out] Cp Isobaric heat capacity in J/(mol-K)
+ * @param[out] W Speed of sound in m/s
+ * @param[out] G Gibbs energy in J/mol
+ * @param[out] JT Joule-Thomson coefficient in K/kPa
+ * @param[out] Kappa Isentropic Exponent
+ * @param[out] Cf Critical Flow Factor (dimensionless)
+ * @see PropertiesDetail_wrapper for the Emscripten wrapped version of this function
+ */
+void PropertiesDetail(const double T, const double D, const std::vector<double> &x, double &P, double &Z, double &dPdD, double &d2PdD2, double &d2PdTD, double &dPdT, double &U, double &H, double &S, double &Cv, double &Cp, double &W, double &G, double &JT, double &Kappa, double &Cf)
+{
+    PropertiesDetailImpl(T, D, x, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, Cf);
+}
+
+/**
+ * @brief PropertiesDetail for a fixed-size Composition
+ * @see PropertiesDetail
+ */
+void PropertiesDetail(const double T, const double D, const Composition &x, double &P, double &Z, double &dPdD, double &d2PdD2, double &d2PdTD, double &dPdT, double &U, double &H, double &S, double &Cv, double &Cp, double &W, double &G, double &JT, double &Kappa, double &Cf)
+{
+    PropertiesDetailImpl(T, D, x, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, Cf);
+}
+
+/**
+ * @brief PropertiesDetail for a CompositionView, e.g. a row of a composition matrix
+ * @see PropertiesDetail
+ */
+void PropertiesDetail(const double T, const double D, const CompositionView &x, double &P, double &Z, double &dPdD, double &d2PdD2, double &d2PdTD, double &dPdT, double &U, double &H, double &S, double &Cv, double &Cp, double &W, double &G, double &JT, double &Kappa, double &Cf)
+{
+    PropertiesDetailImpl(T, D, x, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, Cf);
+}
+
+/**
+ * @brief PressureDetail for any scalar type V (float, double, Dual<N>)
+ *
+ * Same equations as PressureDetail, evaluated in V without the composition and temperature caches,
+ * so that T, D and every x[i] may carry derivatives (see Scalar.h). The composition and temperature
+ * factors are held in WideScalar<V>, as they exceed the range of float. Instantiated for float,
+ * double, Dual<1>, Dual<2> and Dual<23>. The double overload of PressureDetail is faster for plain values.
+ *
+ * @param T Temperature in Kelvin (K)
+ * @param D Density in mol/l
+ * @param x Vector of mole fractions representing composition
+ * @param[out] P Pressure in kPa
+ * @param[out] Z Compressibility factor
+ */
+template <typename V>
+void PressureDetail(const V &T, const V &D, const std::vector<V> &x, V &P, V &Z)
+{
+    typedef typename WideScalar<V>::type Wide;
+    Wide K3x, Bsx[18 + 1], Csnx[NTerms + 1], xLnx, Tun[NTerms + 1];
+    V ar[3 + 1][3 + 1];
+
+    MixtureTermsDetail(x, K3x, Bsx, Csnx, xLnx);
+    for (int n = 1; n <= 58; ++n)
+    {
+        Tun[n] = pow(Wide(T), -un[n]);
+    }
+    AlpharTermsDetail(0, T, D, K3x, Bsx, Csnx, Tun, ar);
+    Z = 1 + ar[0][1] / RDetail / T;
+    P = D * RDetail * T * Z;
+}
+
+/**
+ * @brief PropertiesDetail for any scalar type V (float, double, Dual<N>)
+ *
+ * Same equations as PropertiesDetail, evaluated in V without the composition and temperature caches.
+ * With Dual<N> inputs, every output carries its derivatives with respect to the seeded variables,
+ * e.g. T and D, the mole fractions, or both with Dual<23>.
+ * @see PressureDetail<V> for the instantiated types, PropertiesDetail for the outputs
+ */
+template <typename V>
+void PropertiesDetail(const V &T, const V &D, const std::vector<V> &x, V &P, V &Z, V &dPdD, V &d2PdD2, V &d2PdTD, V &dPdT, V &U, V &H, V &S, V &Cv, V &Cp, V &W, V &G, V &JT, V &Kappa, V &Cf)
+{
+    typedef typename WideScalar<V>::type Wide;
+    Wide K3x, Bsx[18 + 1], Csnx[NTerms + 1], xLnx, Tun[NTerms + 1];
+    V a0[2 + 1], ar[3 + 1][3 + 1], Mm;
+
+    MolarMassDetailImpl(x, Mm);
+    MixtureTermsDetail(x, K3x, Bsx, Csnx, xLnx);
+    for (int n = 1; n <= 58; ++n)
+    {
+        Tun[n] = pow(Wide(T), -un[n]);
+    }
+    Alpha0ScalarDetail(T, D, x, V(xLnx), a0);
+    AlpharTermsDetail(2, T, D, K3x, Bsx, Csnx, Tun, ar);
+    PropertiesFromAlphaDetail(T, D, Mm, a0, ar, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, Cf);
+}
+
+// PrepareIsothermDetail for any composition type with x[i], i = 1 to NcDetail (std::vector, Composition, CompositionView)
+template <typename X>
+static void PrepareIsothermDetailImpl(const double T, const X &x, PreparedIsothermDetail &iso)
+{
+    AGA8_TRACE_SCOPE("PrepareIsothermDetail");
+    double agroup[9 + 1][4 + 1];
+    const double *Tun;
+
+    xTermsDetail(x);
+    Tun = TunDetail(T);
+    iso.T = T;
+    iso.K3 = K3;
+    iso.B = 0;
+    iso.C = 0;
+    for (int n = 1; n <= 18; ++n)
+    {
+        iso.B += Bs[n] * Tun[n];
+    }
+    for (int b = 0; b <= 9; ++b)
+    {
+        for (int k = 0; k <= 4; ++k)
+        {
+            agroup[b][k] = 0;
+        }
+    }
+    for (int n = 13; n <= 58; ++n)
+    {
+        if (n <= 18)
+        {
+            iso.C += Csn[n] * Tun[n];
+        }
+        agroup[bn[n]][kn[n]] += Csn[n] * Tun[n];
+    }
+    iso.ngroups = 0;
+    for (int b = 0; b <= 9; ++b)
+    {
+        for (int k = 0; k <= 4; ++k)
+        {
+            if (agroup[b][k] != 0)
+            {
+                iso.bgroup[iso.ngroups] = b;
+                iso.kgroup[iso.ngroups] = k;
+                iso.agroup[iso.ngroups] = agroup[b][k];
+                ++iso.ngroups;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Prepares the residual pressure terms of an isotherm
+ *
+ * At fixed temperature and composition only the reduced density Dred = K3*D changes. This routine
+ * freezes Bs[n]*Tun[n] (summed into one second virial coefficient) and Csn[n]*Tun[n] (summed per
+ * (bn, kn) exponent pair), so that PressureIsothermDetail can be called for any number of densities.
+ *
+ * @param T Temperature in Kelvin (K)
+ * @param x Vector of mole fractions representing composition
+ * @param[out] iso Prepared isotherm
+ * @see PressureIsothermDetail, IsothermDetail_wrapper for the Emscripten wrapped version of this function
+ */
+void PrepareIsothermDetail(const double T, const std::vector<double> &x, PreparedIsothermDetail &iso)
+{
+    PrepareIsothermDetailImpl(T, x, iso);
+}
+
+/**
+ * @brief PrepareIsothermDetail for a fixed-size Composition
+ * @see PrepareIsothermDetail
+ */
+void PrepareIsothermDetail(const double T, const Composition &x, PreparedIsothermDetail &iso)
+{
+    PrepareIsothermDetailImpl(T, x, iso);
+}
+
+/**
+ * @brief PrepareIsothermDetail for a CompositionView, e.g. a row of a composition matrix
+ * @see PrepareIsothermDetail
+ */
+void PrepareIsothermDetail(const double T, const CompositionView &x, PreparedIsothermDetail &iso)
+{
+    PrepareIsothermDetailImpl(T, x, iso);
+}
+
+/**
+ * @brief Calculates pressure, compressibility factor and d(P)/d(D) on a prepared isotherm
+ *
+ * Gives the same results as PressureDetail at the temperature and composition of the isotherm.
+ *
+ * @param iso Isotherm prepared by PrepareIsothermDetail
+ * @param D Density in mol/l
+ * @param[out] P Pressure in kPa
+ * @param[out] Z Compressibility factor
+ * @param[out] dPdD First derivative of pressure with respect to density at constant temperature [kPa/(mol/l)]
+ * @see PrepareIsothermDetail
+ */
+void PressureIsothermDetail(const PreparedIsothermDetail &iso, const double D, double &P, double &Z, double &dPdD)
+{
+    double Dred, Dknn[9 + 1], Expn[4 + 1], s0, s1, s2, bkd, RT;
+    int b, k;
+
+    Dred = iso.K3 * D;
+    Dknn[0] = 1;
+    for (int n = 1; n <= 9; ++n)
+    {
+        Dknn[n] = Dred * Dknn[n - 1];
+    }
+    Expn[0] = 1;
+    for (int n = 1; n <= 4; ++n)
+    {
+        Expn[n] = exp(-Dknn[n]);
+    }
+
+    s1 = iso.B * D - iso.C * Dred;
+    s2 = 0;
+    for (int g = 0; g < iso.ngroups; ++g)
+    {
+        b = iso.bgroup[g];
+        k = iso.kgroup[g];
+        s0 = iso.agroup[g] * Dknn[b] * Expn[k];
+        bkd = b - k * Dknn[k];
+        s1 += s0 * bkd;
+        s2 += s0 * (bkd * (bkd - 1) - k * k * Dknn[k]);
+    }
+
+    RT = RDetail * iso.T;
+    Z = 1 + s1;
     P = D * RT * Z;
-    dPdD = RT + 2 * ar[0][1] + ar[0][2];
-    dPdT = D * R + D * ar[1][1];
-    A = a0[0] + ar[0][0];
-    S = -a0[1] - ar[1][0];
-    U = A + T * S;
-    Cv = -(a0[2] + ar[2][0]);
-    if (D > epsilon)
+    dPdD = RT * (1 + 2 * s1 + s2);
+}
+
+/**
+ * @brief Fold the composition terms of the DETAIL equation into the coefficients of a fixed gas
+ *
+ * The terms are those of MixtureTermsDetail and IdealTermsDetail, see FixedGasTermsDetail.
+ * SetupDetail must have been called.
+ *
+ * @param x Vector of mole fractions representing composition
+ * @param[out] fg Terms of the composition
+ */
+void PrepareFixedGasDetail(const std::vector<double> &x, FixedGasTermsDetail &fg)
+{
+    MixtureTermsDetail(x, fg.K3, fg.B, fg.C, fg.SumxLnx);
+    MolarMassDetailImpl(x, fg.Mm);
+    fg.R = RDetail;
+    fg.Sumx = 0;
+    fg.n01 = 0;
+    fg.n02 = 0;
+    fg.n03 = 0;
+    fg.nhyp = 0;
+    for (int i = 1; i <= NcDetail; ++i)
+    {
+        if (x[i] > 0)
+        {
+            fg.Sumx += x[i];
+            fg.n01 += x[i] * n0i[i][1];
+            fg.n02 += x[i] * n0i[i][2];
+            fg.n03 += x[i] * n0i[i][3];
+            for (int j = 4; j <= 7; ++j)
+            {
+                if (th0i[i][j] > 0)
+                {
+                    fg.sinhhyp[fg.nhyp] = (j == 4 || j == 6) ? 1 : 0;
+                    fg.ahyp[fg.nhyp] = x[i] * n0i[i][j];
+                    fg.thhyp[fg.nhyp] = th0i[i][j];
+                    ++fg.nhyp;
+                }
+            }
+        }
+    }
+    for (int n = 1; n <= NTerms; ++n)
+    {
+        fg.u[n] = un[n];
+        fg.b[n] = bn[n];
+        fg.k[n] = kn[n];
+    }
+}
+
+/**
+ * @brief Derivatives of Z, D and W with respect to the mole fractions at constant temperature and pressure
+ *
+ * The derivatives are analytic. The composition enters the equation through the mixing rules of
+ * xTermsDetail: the second virial coefficients Bs (quadratic in x), the size parameter K3, and U, G,
+ * Q and F in the coefficients Csn of the higher order terms, plus x_i*c2_i(T) in the ideal gas heat
+ * capacity. Their derivatives at constant T and D are combined with the density derivatives of the
+ * same properties, dD/dx_i being -(dP/dx_i)/(dP/dD).
+ *
+ * Each mole fraction is varied alone, the other ones being held constant (x is not normalized), so
+ * that the derivative for replacing component j by component i is dZdx[i] - dZdx[j]. Components
+ * absent from x have derivatives too, those of adding a trace of them.
+ *
+ * @param T Temperature in Kelvin (K)
+ * @param D Density in mol/l, from DensityDetail at the pressure of interest
+ * @param x Vector of mole fractions representing composition
+ * @param[out] P Pressure in kPa
+ * @param[out] Z Compressibility factor
+ * @param[out] W Speed of sound in m/s
+ * @param[out] dZdx dZ/dx_i (NcDetail + 1 elements, index 0 unused)
+ * @param[out] dDdx dD/dx_i in mol/l
+ * @param[out] dWdx dW/dx_i in m/s
+ * @see PropertiesDetail for P, Z and W; CompositionDerivativesDetail_wrapper for the Emscripten wrapped version
+ */
+void CompositionDerivativesDetail(const double T, const double D, const std::vector<double> &x, double &P, double &Z, double &W, std::vector<double> &dZdx, std::vector<double> &dDdx, std::vector<double> &dWdx)
+{
+    dZdx.assign(NcDetail + 1, 0);
+    dDdx.assign(NcDetail + 1, 0);
+    dWdx.assign(NcDetail + 1, 0);
+    CompositionDerivativesDetailImpl(T, D, x, P, Z, W, dZdx, dDdx, dWdx);
+}
+
+/**
+ * @brief CompositionDerivativesDetail for a fixed-size Composition, with fixed-size derivatives
+ * @see CompositionDerivativesDetail
+ */
+void CompositionDerivativesDetail(const double T, const double D, const Composition &x, double &P, double &Z, double &W, Composition &dZdx, Composition &dDdx, Composition &dWdx)
+{
+    CompositionDerivativesDetailImpl(T, D, x, P, Z, W, dZdx, dDdx, dWdx);
+}
+
+/**
+ * @brief CompositionDerivativesDetail for a CompositionView, e.g. a row of a composition matrix
+ * @see CompositionDerivativesDetail
+ */
+void CompositionDerivativesDetail(const double T, const double D, const CompositionView &x, double &P, double &Z, double &W, Composition &dZdx, Composition &dDdx, Composition &dWdx)
+{
+    CompositionDerivativesDetailImpl(T, D, x, P, Z, W, dZdx, dDdx, dWdx);
+}
+
+// CompositionDerivativesDetail for any composition type X, writing dZdx[i], dDdx[i] and dWdx[i], i = 1 to NcDetail, of any type Y
+template <typename X, typename Y>
+static void CompositionDerivativesDetailImpl(const double T, const double D, const X &x, double &P, double &Z, double &W, Y &dZdx, Y &dDdx, Y &dWdx)
+{
+    AGA8_TRACE_SCOPE("CompositionDerivativesDetail");
+    double SumK, SumE, K5, U5, G, Q, F, K3x, U, Q2, Mm, a02, c0, c1, xij;
+    double Bx[18 + 1], Cx[NTerms + 1], Uun[NTerms + 1], e0[NTerms + 1], bk[NTerms + 1], c2n[NTerms + 1], c3n[NTerms + 1];
+    double dK5[MaxFlds + 1], dU5[MaxFlds + 1], dG[MaxFlds + 1], dB[MaxFlds + 1][18 + 1], c2i[MaxFlds + 1];
+    double Dknn[9 + 1], Expn[4 + 1], Dred, Dk, ckd, sb;
+
+    // Composition terms as in xTermsDetail (before the 0.6 and 0.2 powers of K and U), and their derivatives with respect to each x[k]
+    SumK = 0;
+    SumE = 0;
+    K5 = 0;
+    U5 = 0;
+    G = 0;
+    Q = 0;
+    F = 0;
+    for (int n = 1; n <= 18; ++n)
+    {
+        Bx[n] = 0;
+    }
+    for (int k = 1; k <= NcDetail; ++k)
+    {
+        dK5[k] = 0;
+        dU5[k] = 0;
+        dG[k] = Gi[k];
+        for (int n = 1; n <= 18; ++n)
+        {
+            dB[k][n] = 0;
+        }
+    }
+    for (int i = 1; i <= NcDetail; ++i)
+    {
+        if (x[i] <= 0)
+        {
+            continue;
+        }
+        SumK += x[i] * Ki25[i];
+        SumE += x[i] * Ei25[i];
+        G += x[i] * Gi[i];
+        Q += x[i] * Qi[i];
+        F += sq(x[i]) * Fi[i];
+        for (int j = 1; j <= NcDetail; ++j)
+        {
+            const int a = i < j ? i : j, b = i < j ? j : i;
+            for (int n = 1; n <= 18; ++n)
+            {
+                dB[j][n] += 2 * x[i] * Bsnij2[a][b][n];
+            }
+            if (j == i)
+            {
+                continue;
+            }
+            dK5[j] += 2 * x[i] * Kij5[a][b];
+            dU5[j] += 2 * x[i] * Uij5[a][b];
+            dG[j] += 2 * x[i] * Gij5[a][b];
+            if (j > i && x[j] > 0)
+            {
+                xij = 2 * x[i] * x[j];
+                K5 += xij * Kij5[i][j];
+                U5 += xij * Uij5[i][j];
+                G += xij * Gij5[i][j];
+            }
+        }
+        for (int j = i; j <= NcDetail; ++j)
+        {
+            if (x[j] > 0)
+            {
+                xij = j == i ? sq(x[i]) : 2 * x[i] * x[j];
+                for (int n = 1; n <= 18; ++n)
+                {
+                    Bx[n] += xij * Bsnij2[i][j][n];
+                }
+            }
+        }
+    }
+    K5 += sq(SumK);
+    U5 += sq(SumE);
+    for (int k = 1; k <= NcDetail; ++k)
+    {
+        dK5[k] += 2 * SumK * Ki25[k];
+        dU5[k] += 2 * SumE * Ei25[k];
+    }
+    K3x = pow(K5, 0.6);
+    U = pow(U5, 0.2);
+    Q2 = sq(Q);
+    for (int n = 13; n <= 58; ++n)
+    {
+        Uun[n] = pow(U, un[n]);
+        Cx[n] = an[n] * Uun[n] * (gn[n] == 1 ? G : 1) * (qn[n] == 1 ? Q2 : 1) * (fn[n] == 1 ? F : 1);
+    }
+
+    // Residual sums as in AlpharDetail, with the density derivatives of ar(1,1)/R (T12) and ar(2,0)/R (T21)
+    const double *Tun = TunDetail(T);
+    Dred = K3x * D;
+    Dknn[0] = 1;
+    for (int n = 1; n <= 9; ++n)
+    {
+        Dknn[n] = Dred * Dknn[n - 1];
+    }
+    Expn[0] = 1;
+    for (int n = 1; n <= 4; ++n)
+    {
+        Expn[n] = exp(-Dknn[n]);
+    }
+    double S1 = 0, S2 = 0, S3 = 0, T11 = 0, T12 = 0, T20 = 0, T21 = 0;
+    for (int n = 1; n <= 18; ++n)
+    {
+        sb = (Bx[n] * D - (n >= 13 ? Cx[n] * Dred : 0)) * Tun[n];
+        S1 += sb;
+        T11 += CoefT1[n] * sb;
+        T20 += CoefT2[n] * sb;
+        T21 += CoefT2[n] * sb;
+    }
+    for (int n = 13; n <= 58; ++n)
     {
-        H = U + P / D;
-        G = A + P / D;
-        Cp = Cv + T * sq(dPdT / D) / dPdD;
-        d2PdD2 = (2 * ar[0][1] + 4 * ar[0][2] + ar[0][3]) / D;
-        JT = (T / D * dPdT / dPdD - 1) / Cp / D;
+        e0[n] = Tun[n] * Dknn[bn[n]] * Expn[kn[n]];
+        Dk = Dknn[kn[n]];
+        bk[n] = bnd[n] - knd[n] * Dk;
+        ckd = kn2d[n] * Dk;
+        c2n[n] = bk[n] * (bk[n] - 1) - ckd;
+        c3n[n] = (bk[n] - 2) * c2n[n] + ckd * (1 - knd[n] - 2 * bk[n]);
+        sb = Cx[n] * e0[n];
+        S1 += sb * bk[n];
+        S2 += sb * c2n[n];
+        S3 += sb * c3n[n];
+        T11 += CoefT1[n] * sb * bk[n];
+        T12 += CoefT1[n] * sb * c2n[n];
+        T20 += CoefT2[n] * sb;
+        T21 += CoefT2[n] * sb * bk[n];
     }
-    else
+
+    Mm = 0;
+    a02 = 0;
+    for (int i = 1; i <= NcDetail; ++i)
     {
-        H = U + RT;
-        G = A + RT;
-        Cp = Cv + R;
-        d2PdD2 = 0;
-        JT = 1E+20; //=(dB/dT*T-B)/Cp for an ideal gas, but dB/dT is not calculated here
+        IdealTermsDetail(T, i, c0, c1, c2i[i]);
+        Mm += x[i] * MMiDetail[i];
+        if (x[i] > 0)
+        {
+            a02 += -x[i] * c2i[i];
+        }
     }
-    W = 1000 * Cp / Cv * dPdD / Mm;
-    if (W < 0)
+
+    // Properties (as in PropertiesDetail), and the relative derivative of W^2 along any direction from those of the sums, a0(2) and Mm
+    const double R = RDetail, RT = R * T;
+    Z = 1 + S1;
+    P = D * RT * Z;
+    const double dPdD = RT * (1 + 2 * S1 + S2);
+    const double y = R - T11; // dP/dT divided by D
+    const double Cv = -(R * a02 + T20);
+    const double Cp = Cv + T * sq(y) / dPdD;
+    const double W2 = 1000 * Cp / Cv * dPdD / Mm;
+    W = W2 > 0 ? sqrt(W2) : 0;
+    auto dlnW2 = [&](const double dS1, const double dS2, const double dT11, const double dT20, const double da02, const double dMm)
     {
-        W = 0;
+        const double ddPdD = RT * (2 * dS1 + dS2), dy = -dT11, dCv = -(R * da02 + dT20);
+        const double dCp = dCv + T * y * (2 * dy - y * ddPdD / dPdD) / dPdD;
+        return dCp / Cp - dCv / Cv + ddPdD / dPdD - dMm / Mm;
+    };
+
+    // Derivatives with respect to ln(D) at constant T and x
+    const double dZdlnD = S1 + S2;
+    const double dW2dlnD = dlnW2(S1 + S2, 2 * S2 + S3, T11 + T12, T21, 0, 0);
+
+    // Derivatives with respect to x[k] at constant T and D, then at constant T and P
+    for (int k = 1; k <= NcDetail; ++k)
+    {
+        const double dlnK3 = 0.6 * dK5[k] / K5, dU = 0.2 * U * dU5[k] / U5, dQ2 = 2 * Q * Qi[k], dF = 2 * x[k] * Fi[k];
+        double dS1 = 0, dS2 = 0, dT11 = 0, dT20 = 0, dC, d0, d1, d2;
+        for (int n = 13; n <= 58; ++n)
+        {
+            const double gf = gn[n] == 1 ? G : 1, qf = qn[n] == 1 ? Q2 : 1, ff = fn[n] == 1 ? F : 1;
+            dC = an[n] * (un[n] * Uun[n] / U * dU * gf * qf * ff + Uun[n] * ((gn[n] == 1 ? dG[k] : 0) * qf * ff + gf * (qn[n] == 1 ? dQ2 : 0) * ff + gf * qf * (fn[n] == 1 ? dF : 0)));
+            if (n <= 18)
+            {
+                sb = -(dC * K3x + Cx[n] * K3x * dlnK3) * D * Tun[n];
+                dS1 += sb;
+                dT11 += CoefT1[n] * sb;
+                dT20 += CoefT2[n] * sb;
+            }
+            d0 = e0[n] * (dC + Cx[n] * dlnK3 * bk[n]);
+            d1 = e0[n] * (dC * bk[n] + Cx[n] * dlnK3 * (bk[n] + c2n[n]));
+            d2 = e0[n] * (dC * c2n[n] + Cx[n] * dlnK3 * (2 * c2n[n] + c3n[n]));
+            dS1 += d1;
+            dS2 += d2;
+            dT11 += CoefT1[n] * d1;
+            dT20 += CoefT2[n] * d0;
+        }
+        for (int n = 1; n <= 18; ++n)
+        {
+            sb = dB[k][n] * D * Tun[n];
+            dS1 += sb;
+            dT11 += CoefT1[n] * sb;
+            dT20 += CoefT2[n] * sb;
+        }
+        const double dlnD = -RT * dS1 / dPdD;
+        dDdx[k] = D * dlnD;
+        dZdx[k] = dS1 + dlnD * dZdlnD;
+        dWdx[k] = W > 0 ? W / 2 * (dlnW2(dS1, dS2, dT11, dT20, -c2i[k], MMiDetail[k]) + dlnD * dW2dlnD) : 0;
     }
-    W = sqrt(W);
-    Kappa = W * W * Mm / (RT * 1000 * Z);
-    Cf = sqrt(Kappa * pow( (2 / (Kappa + 1)), ((Kappa + 1) / (Kappa - 1))));
-    d2PdTD = 0;
 }
 
-// The following routines are low-level routines that should not be called outside of this code.
-static void xTermsDetail(const std::vector<double> &x)
+/**
+ * @brief Density, Z and W with their derivatives with respect to the mole fractions at many (T, P) states
+ *
+ * DensityDetail then CompositionDerivativesDetail at each state. The derivatives of state k with
+ * respect to x_i are at index k * NcDetail + i - 1 (methane first); those of a state whose density
+ * solve fails are 0, as are its D, Z and W.
+ *
+ * @param T Temperatures in Kelvin (K)
+ * @param P Pressures in kPa, as many as T (the extra values of the longer vector are ignored)
+ * @param x Vector of mole fractions representing composition
+ * @param[out] D Densities in mol/l
+ * @param[out] Z Compressibility factors
+ * @param[out] W Speeds of sound in m/s
+ * @param[out] dZdx dZ/dx_i of each state (n * NcDetail elements)
+ * @param[out] dDdx dD/dx_i in mol/l
+ * @param[out] dWdx dW/dx_i in m/s
+ * @param[out] ierr Error numbers of DensityDetail (0 indicates no error)
+ * @see CompositionDerivativesBatchDetail_wrapper for the Emscripten wrapped version
+ */
+void CompositionDerivativesBatchDetail(const std::vector<double> &T, const std::vector<double> &P, const std::vector<double> &x, std::vector<double> &D, std::vector<double> &Z, std::vector<double> &W, std::vector<double> &dZdx, std::vector<double> &dDdx, std::vector<double> &dWdx, std::vector<int> &ierr)
 {
-    // Calculate terms dependent only on composition
-    //
-    // Inputs:
-    //    x() - Composition (mole fraction)
+    CompositionDerivativesBatchDetailImpl(T, P, x, D, Z, W, dZdx, dDdx, dWdx, ierr);
+}
+
+/**
+ * @brief CompositionDerivativesBatchDetail for a fixed-size Composition
+ * @see CompositionDerivativesBatchDetail
+ */
+void CompositionDerivativesBatchDetail(const std::vector<double> &T, const std::vector<double> &P, const Composition &x, std::vector<double> &D, std::vector<double> &Z, std::vector<double> &W, std::vector<double> &dZdx, std::vector<double> &dDdx, std::vector<double> &dWdx, std::vector<int> &ierr)
+{
+    CompositionDerivativesBatchDetailImpl(T, P, x, D, Z, W, dZdx, dDdx, dWdx, ierr);
+}
 
-    double G, Q, F, U, Q2, xij, xi2;
-    int icheck;
+/**
+ * @brief CompositionDerivativesBatchDetail for a CompositionView, e.g. a row of a composition matrix
+ * @see CompositionDerivativesBatchDetail
+ */
+void CompositionDerivativesBatchDetail(const std::vector<double> &T, const std::vector<double> &P, const CompositionView &x, std::vector<double> &D, std::vector<double> &Z, std::vector<double> &W, std::vector<double> &dZdx, std::vector<double> &dDdx, std::vector<double> &dWdx, std::vector<int> &ierr)
+{
+    CompositionDerivativesBatchDetailImpl(T, P, x, D, Z, W, dZdx, dDdx, dWdx, ierr);
+}
 
-    // Check to see if a component fraction has changed.  If x is the same as the previous call, then exit.
-    icheck = 0;
-    for (std::size_t i = 1; i <= NcDetail; ++i)
+// CompositionDerivativesBatchDetail for any composition type X, the derivatives of each state in a Composition
+template <typename X>
+static void CompositionDerivativesBatchDetailImpl(const std::vector<double> &T, const std::vector<double> &P, const X &x, std::vector<double> &D, std::vector<double> &Z, std::vector<double> &W, std::vector<double> &dZdx, std::vector<double> &dDdx, std::vector<double> &dWdx, std::vector<int> &ierr)
+{
+    const std::size_t n = std::min(T.size(), P.size());
+    Composition dZ, dD, dW;
+    double P2;
+    const char *herr;
+
+    D.assign(n, 0);
+    Z.assign(n, 0);
+    W.assign(n, 0);
+    ierr.assign(n, 0);
+    dZdx.assign(n * NcDetail, 0);
+    dDdx.assign(n * NcDetail, 0);
+    dWdx.assign(n * NcDetail, 0);
+    for (std::size_t k = 0; k < n; ++k)
     {
-        if (std::abs(x[i] - xold[i]) > 0.0000001)
+        DensityDetailImpl(T[k], P[k], x, D[k], ierr[k], herr);
+        if (ierr[k] != 0)
         {
-            icheck = 1;
+            D[k] = 0;
+            continue;
+        }
+        CompositionDerivativesDetailImpl(T[k], D[k], x, P2, Z[k], W[k], dZ, dD, dW);
+        for (int i = 1; i <= NcDetail; ++i)
+        {
+            dZdx[k * NcDetail + i - 1] = dZ[i];
+            dDdx[k * NcDetail + i - 1] = dD[i];
+            dWdx[k * NcDetail + i - 1] = dW[i];
         }
-        xold[i] = x[i];
-    }
-    if (icheck == 0)
-    {
-        return;
     }
+}
+
+// The following routines are low-level routines that should not be called outside of this code.
+/**
+ * @brief Terms of the DETAIL mixing rules depending only on composition, for any scalar type
+ *
+ * @param x Composition (mole fraction)
+ * @param[out] K3x Mixture size parameter K^3
+ * @param[out] Bsx Composition part of the second virial coefficient terms (indexed 1 to 18)
+ * @param[out] Csnx Composition part of the terms 13 to 58
+ * @param[out] xLnx Sum(x*ln(x))
+ */
+template <typename V, typename X>
+static void MixtureTermsDetail(const X &x, V &K3x, V Bsx[], V Csnx[], V &xLnx)
+{
+    V G, Q, F, U, Q2, xij, xi2;
 
-    K3 = 0;
+    K3x = 0;
     U = 0;
     G = 0;
     Q = 0;
     F = 0;
     for (int n = 1; n <= 18; ++n)
     {
-        Bs[n] = 0;
+        Bsx[n] = 0;
     }
 
     // Calculate pure fluid contributions
@@ -468,20 +1198,29 @@ static void xTermsDetail(const std::vector<double> &x)
         if (x[i] > 0)
         {
             xi2 = sq(x[i]);
-            K3 += x[i] * Ki25[i]; // K, U, and G are the sums of a pure fluid contribution and a
+            K3x += x[i] * Ki25[i]; // K, U, and G are the sums of a pure fluid contribution and a
             U += x[i] * Ei25[i];  // binary pair contribution
             G += x[i] * Gi[i];
             Q += x[i] * Qi[i]; // Q and F depend only on the pure fluid parts
             F += xi2 * Fi[i];
             for (int n = 1; n <= 18; ++n)
             {
-                Bs[n] = Bs[n] + xi2 * Bsnij2[i][i][n]; // Pure fluid contributions to second virial coefficient
+                Bsx[n] = Bsx[n] + xi2 * Bsnij2[i][i][n]; // Pure fluid contributions to second virial coefficient
             }
         }
     }
-    K3 = sq(K3);
+    K3x = sq(K3x);
     U = sq(U);
 
+    xLnx = 0;
+    for (std::size_t i = 1; i <= NcDetail; ++i)
+    {
+        if (x[i] > 0)
+        {
+            xLnx += x[i] * log(x[i]);
+        }
+    }
+
     // Binary pair contributions
     for (std::size_t i = 1; i <= NcDetail - 1; ++i)
     {
@@ -492,38 +1231,191 @@ static void xTermsDetail(const std::vector<double> &x)
                 if (x[j] > 0)
                 {
                     xij = 2 * x[i] * x[j];
-                    K3 = K3 + xij * Kij5[i][j];
+                    K3x = K3x + xij * Kij5[i][j];
                     U = U + xij * Uij5[i][j];
                     G = G + xij * Gij5[i][j];
                     for (int n = 1; n <= 18; ++n)
                     {
-                        Bs[n] = Bs[n] + xij * Bsnij2[i][j][n]; // Second virial coefficients of mixture
+                        Bsx[n] = Bsx[n] + xij * Bsnij2[i][j][n]; // Second virial coefficients of mixture
                     }
                 }
             }
         }
     }
-    K3 = pow(K3, 0.6);
+    K3x = pow(K3x, 0.6);
     U = pow(U, 0.2);
 
     // Third virial and higher coefficients
     Q2 = sq(Q);
     for (int n = 13; n <= 58; ++n)
     {
-        Csn[n] = an[n] * pow(U, un[n]);
+        Csnx[n] = an[n] * pow(U, un[n]);
         if (gn[n] == 1)
         {
-            Csn[n] = Csn[n] * G;
+            Csnx[n] = Csnx[n] * G;
         }
         if (qn[n] == 1)
         {
-            Csn[n] = Csn[n] * Q2;
+            Csnx[n] = Csnx[n] * Q2;
         }
         if (fn[n] == 1)
         {
-            Csn[n] = Csn[n] * F;
+            Csnx[n] = Csnx[n] * F;
+        }
+    }
+}
+
+template <typename X>
+static void xTermsDetail(const X &x)
+{
+    AGA8_TRACE_SCOPE("xTermsDetail");
+    // Calculate terms dependent only on composition
+    //
+    // Inputs:
+    //    x() - Composition (mole fraction)
+
+    int icheck, nx, ix;
+
+    // Check to see if a component fraction has changed.  If x is the same as the previous call, then exit.
+    // The number of non-zero fractions is counted on the way to detect a pure fluid.
+    icheck = 0;
+    nx = 0;
+    ix = 0;
+    for (std::size_t i = 1; i <= NcDetail; ++i)
+    {
+        if (std::abs(x[i] - xold[i]) > 0.0000001)
+        {
+            icheck = 1;
+        }
+        xold[i] = x[i];
+        if (x[i] != 0)
+        {
+            ++nx;
+            ix = i;
+        }
+    }
+    iPureDetail = (nx == 1 && x[ix] > 0) ? ix : 0;
+    if (icheck == 0)
+    {
+        return;
+    }
+
+    // Pure fluid with x[i] = 1: the terms were calculated once in SetupDetail
+    if (PureSetDetail && iPureDetail > 0 && x[ix] == 1)
+    {
+        K3 = K3Pure[ix];
+        SumxLnx = 0;
+        for (int n = 1; n <= 18; ++n)
+        {
+            Bs[n] = BsPure[ix][n];
+        }
+        for (int n = 13; n <= 58; ++n)
+        {
+            Csn[n] = CsnPure[ix][n];
+        }
+        return;
+    }
+
+    MixtureTermsDetail(x, K3, Bs, Csn, SumxLnx);
+}
+
+/**
+ * @brief Temperature dependent part of the ideal gas Helmholtz energy of one pure component
+ *
+ * @param T Temperature in Kelvin (K)
+ * @param i Component number (1 to 21)
+ * @param c0 Output: n0i1 + n0i2/T - n0i3*ln(T) + Sum(hyperbolic terms), the part of a0/RT not depending on x and D
+ * @param c1 Output: the corresponding part of (∂(a0)/∂T)/R
+ * @param c2 Output: the corresponding part of -(T*∂²(a0)/∂T²)/R
+ */
+template <typename V>
+static void IdealTermsDetail(const V &T, const int i, V &c0, V &c1, V &c2)
+{
+    using std::abs;
+    V LogT, LogHyp, th0T, em, ep, hcn, hsn;
+    V SumHyp0 = 0, SumHyp1 = 0, SumHyp2 = 0;
+
+    LogT = log(T);
+    for (int j = 4; j <= 7; ++j)
+    {
+        if (th0i[i][j] > 0)
+        {
+            th0T = th0i[i][j] / T;
+            ep = exp(th0T);
+            em = 1 / ep;
+            hsn = (ep - em) / 2;
+            hcn = (ep + em) / 2;
+            if (j == 4 || j == 6)
+            {
+                LogHyp = log(abs(hsn));
+                SumHyp0 += n0i[i][j] * LogHyp;
+                SumHyp1 += n0i[i][j] * (LogHyp - th0T * hcn / hsn);
+                SumHyp2 += n0i[i][j] * sq(th0T / hsn);
+            }
+            else
+            {
+                LogHyp = log(abs(hcn));
+                SumHyp0 += -n0i[i][j] * LogHyp;
+                SumHyp1 += -n0i[i][j] * (LogHyp - th0T * hsn / hcn);
+                SumHyp2 += +n0i[i][j] * sq(th0T / hcn);
+            }
+        }
+    }
+    c0 = n0i[i][1] + n0i[i][2] / T - n0i[i][3] * LogT + SumHyp0;
+    c1 = n0i[i][1] - n0i[i][3] * (1 + LogT) + SumHyp1;
+    c2 = n0i[i][3] + SumHyp2;
+}
+
+/**
+ * @brief Find (or claim) the cache slot holding the temperature-only terms at T
+ *
+ * A slot holds the ideal gas terms of each component (filled the first time the component is
+ * needed at T) and the T^(-un) powers used by AlpharDetail. The slots are shared by every
+ * composition evaluated at the same temperature. Temperatures are matched exactly so that cached
+ * values are bit-identical to a fresh evaluation.
+ *
+ * @param T Temperature in Kelvin (K)
+ * @return Slot index in TSlot, TunT, a0T and a0Tset
+ */
+static int TemperatureSlotDetail(const double T)
+{
+    for (int s = 0; s < NTSlots; ++s)
+    {
+        if (TSlot[s] == T)
+        {
+            return s;
+        }
+    }
+    int s = TSlotNext;
+    TSlotNext = (TSlotNext + 1) % NTSlots;
+    TSlot[s] = T;
+    TunTset[s] = false;
+    for (int i = 1; i <= NcDetail; ++i)
+    {
+        a0Tset[s][i] = false;
+    }
+    return s;
+}
+
+/**
+ * @brief Powers T^(-un[n]) of the 58 terms of the equation, kept in the temperature-keyed cache
+ *
+ * @param T Temperature in Kelvin (K)
+ * @return Tun array indexed 1 to 58
+ */
+static const double *TunDetail(const double T)
+{
+    int s = TemperatureSlotDetail(T);
+    double *Tun = TunT[s];
+    if (!TunTset[s])
+    {
+        for (int n = 1; n <= 58; ++n)
+        {
+            Tun[n] = pow(T, -un[n]);
         }
+        TunTset[s] = true;
     }
+    return Tun;
 }
 
 /**
@@ -541,13 +1433,15 @@ static void xTermsDetail(const std::vector<double> &x)
  *        - a0[1]: First temperature derivative ∂(a0)/∂T [J/(mol-K)]
  *        - a0[2]: Second temperature derivative T*∂²(a0)/∂T² [J/(mol-K)]
  *
- * @note The function uses hyperbolic functions and logarithmic terms to compute
- *       the ideal gas contributions for each component in the mixture.
+ * @note The per-component temperature terms (hyperbolic functions and logarithms) are taken from
+ *       the temperature-keyed cache (see TemperatureSlotDetail) and Sum(x*ln(x)) from xTermsDetail,
+ *       so xTermsDetail must be called before this routine with the same x (it also sets iPureDetail).
  *
  * @warning Input array x must be of sufficient size to handle all components (NcDetail)
  * @warning Output array a0 must be of size 3 to store all computed values
  */
-static void Alpha0Detail(const double T, const double D, const std::vector<double> &x, double a0[3])
+template <typename X>
+static void Alpha0Detail(const double T, const double D, const X &x, double a0[3])
 {
     // Private Sub Alpha0Detail(T, D, x, a0)
 
@@ -564,12 +1458,12 @@ static void Alpha0Detail(const double T, const double D, const std::vector<doubl
     // a0(1) -   partial  (a0)/partial(T) [J/(mol-K)]
     // a0(2) - T*partial^2(a0)/partial(T)^2 [J/(mol-K)]
 
-    double LogT, LogD, LogHyp, th0T, LogxD;
-    double SumHyp0, SumHyp1, SumHyp2;
-    double em, ep, hcn, hsn;
+    AGA8_TRACE_SCOPE("Alpha0Detail");
+    double LogD;
+    int s = TemperatureSlotDetail(T);
 
-    a0[0] = 0;
-    a0[1] = 0;
+    a0[0] = SumxLnx;
+    a0[1] = SumxLnx;
     a0[2] = 0;
     if (D > epsilon)
     {
@@ -579,43 +1473,59 @@ static void Alpha0Detail(const double T, const double D, const std::vector<doubl
     {
         LogD = log(epsilon);
     }
-    LogT = log(T);
-    for (std::size_t i = 1; i <= NcDetail; ++i)
+    const std::size_t i0 = iPureDetail > 0 ? iPureDetail : 1, i1 = iPureDetail > 0 ? iPureDetail : NcDetail;
+    for (std::size_t i = i0; i <= i1; ++i)
     {
         if (x[i] > 0)
         {
-            LogxD = LogD + log(x[i]);
-            SumHyp0 = 0;
-            SumHyp1 = 0;
-            SumHyp2 = 0;
-            for (int j = 4; j <= 7; ++j)
+            if (!a0Tset[s][i])
             {
-                if (th0i[i][j] > 0)
-                {
-                    th0T = th0i[i][j] / T;
-                    ep = exp(th0T);
-                    em = 1 / ep;
-                    hsn = (ep - em) / 2;
-                    hcn = (ep + em) / 2;
-                    if (j == 4 || j == 6)
-                    {
-                        LogHyp = log(std::abs(hsn));
-                        SumHyp0 += n0i[i][j] * LogHyp;
-                        SumHyp1 += n0i[i][j] * (LogHyp - th0T * hcn / hsn);
-                        SumHyp2 += n0i[i][j] * sq(th0T / hsn);
-                    }
-                    else
-                    {
-                        LogHyp = log(std::abs(hcn));
-                        SumHyp0 += -n0i[i][j] * LogHyp;
-                        SumHyp1 += -n0i[i][j] * (LogHyp - th0T * hsn / hcn);
-                        SumHyp2 += +n0i[i][j] * sq(th0T / hcn);
-                    }
-                }
+                IdealTermsDetail(T, i, a0T[s][0][i], a0T[s][1][i], a0T[s][2][i]);
+                a0Tset[s][i] = true;
             }
-            a0[0] += x[i] * (LogxD + n0i[i][1] + n0i[i][2] / T - n0i[i][3] * LogT + SumHyp0);
-            a0[1] += x[i] * (LogxD + n0i[i][1] - n0i[i][3] * (1 + LogT) + SumHyp1);
-            a0[2] += -x[i] * (n0i[i][3] + SumHyp2);
+            a0[0] += x[i] * (LogD + a0T[s][0][i]);
+            a0[1] += x[i] * (LogD + a0T[s][1][i]);
+            a0[2] += -x[i] * a0T[s][2][i];
+        }
+    }
+    a0[0] = a0[0] * RDetail * T;
+    a0[1] = a0[1] * RDetail;
+    a0[2] = a0[2] * RDetail;
+}
+
+/**
+ * @brief Alpha0Detail for any scalar type, without the temperature cache
+ *
+ * @param T Temperature in Kelvin (K)
+ * @param D Density in moles per liter (mol/l)
+ * @param x Vector of mole fractions representing composition
+ * @param xLnx Sum(x*ln(x)) (see MixtureTermsDetail)
+ * @param a0 Output: ideal gas Helmholtz energy and derivatives (see Alpha0Detail)
+ */
+template <typename V>
+static void Alpha0ScalarDetail(const V &T, const V &D, const std::vector<V> &x, const V &xLnx, V a0[3])
+{
+    V LogD, c0, c1, c2;
+
+    a0[0] = xLnx;
+    a0[1] = xLnx;
+    a0[2] = 0;
+    if (D > epsilon)
+    {
+        LogD = log(D);
+    }
+    else
+    {
+        LogD = log(epsilon);
+    }
+    for (int i = 1; i <= NcDetail; ++i)
+    {
+        if (x[i] > 0)
+        {
+            IdealTermsDetail(T, i, c0, c1, c2);
+            a0[0] += x[i] * (LogD + c0);
+            a0[1] += x[i] * (LogD + c1);
+            a0[2] += -x[i] * c2;
         }
     }
     a0[0] = a0[0] * RDetail * T;
@@ -643,7 +1553,7 @@ static void Alpha0Detail(const double T, const double D, const std::vector<doubl
  *        - ar[2][0]: T*∂²(ar)/∂T² [J/(mol-K)]
  *
  * @note This function is part of the GERG-2008 equation of state calculations
- * @note The function assumes that global variables Told, Tun, K3, RDetail, un, Bs, Csn, bn, kn
+ * @note The function assumes that global variables K3, RDetail, Bs, Csn, bn, kn, bnd, knd, kn2d, CoefT1, CoefT2
  *       are properly initialized
  */
 static void AlpharDetail(const int itau, const int idel, const double T, const double D, double ar[4][4])
@@ -670,11 +1580,28 @@ static void AlpharDetail(const int itau, const int idel, const double T, const d
     // ar(1,1) -   D*partial^2(ar)/partial(D)/partial(T) [J/(mol-K)]
     // ar(2,0) -   T*partial^2(ar)/partial(T)^2 [J/(mol-K)]
 
-    double ckd, bkd, Dred;
-    double Sum, s0, s1, s2, s3, RT;
-    double Sum0[NTerms + 1], SumB[NTerms + 1], Dknn[9 + 1], Expn[4 + 1];
-    double CoefD1[NTerms + 1], CoefD2[NTerms + 1], CoefD3[NTerms + 1];
-    double CoefT1[NTerms + 1], CoefT2[NTerms + 1];
+    AGA8_TRACE_SCOPE("AlpharDetail");
+    AlpharTermsDetail(itau, T, D, K3, Bs, Csn, TunDetail(T), ar);
+}
+
+/**
+ * @brief Residual Helmholtz derivatives of AlpharDetail from the composition and temperature terms, for any scalar type
+ *
+ * The composition and temperature terms are of type Wide, WideScalar<V> for the scalar templates.
+ *
+ * @param itau Set to 1 to calculate the derivatives with respect to T, 0 otherwise
+ * @param T Temperature in Kelvin
+ * @param D Density in mol/l
+ * @param K3x, Bsx, Csnx Composition terms (see MixtureTermsDetail)
+ * @param Tun Powers T^(-un[n]), indexed 1 to 58
+ * @param[out] ar Residual Helmholtz derivatives (see AlpharDetail)
+ */
+template <typename V, typename Wide>
+static void AlpharTermsDetail(const int itau, const V &T, const V &D, const Wide &K3x, const Wide Bsx[], const Wide Csnx[], const Wide Tun[], V ar[4][4])
+{
+    V ckd, bkd, Dred, Dk, sb, s0, c2, c3, RT;
+    V S0, S1, S2, S3, T10, T11, T20;
+    V Dknn[9 + 1], Expn[4 + 1];
 
     for (int i = 0; i <= 3; ++i)
     {
@@ -683,17 +1610,9 @@ static void AlpharDetail(const int itau, const int idel, const double T, const d
             ar[i][j] = 0;
         }
     }
-    if (std::abs(T - Told) > 0.0000001)
-    {
-        for (int n = 1; n <= 58; ++n)
-        {
-            Tun[n] = pow(T, -un[n]);
-        }
-    }
-    Told = T;
 
     // Precalculation of common powers and exponents of density
-    Dred = K3 * D;
+    Dred = K3x * D;
     Dknn[0] = 1;
     for (int n = 1; n <= 9; ++n)
     {
@@ -706,69 +1625,71 @@ static void AlpharDetail(const int itau, const int idel, const double T, const d
     }
     RT = RDetail * T;
 
-    for (int n = 1; n <= 58; ++n)
+    // Each term contributes s0 to ar(0,0)/RT, s1 to ar(0,1)/RT, s2 to ar(0,2)/RT and s3 to ar(0,3)/RT,
+    // and -CoefT1*s0, -CoefT1*s1 and CoefT2*s0 to the temperature derivatives.
+    // The terms are split into branch-free segments that only read the packed arrays.
+    S0 = 0;
+    S1 = 0;
+    S2 = 0;
+    S3 = 0;
+    T10 = 0;
+    T11 = 0;
+    T20 = 0;
+
+    // Terms 1-12: second virial coefficient only (s0 = s1)
+    for (int n = 1; n <= 12; ++n)
     {
-        // Contributions to the Helmholtz energy and its derivatives with respect to temperature
-        CoefT1[n] = RDetail * (un[n] - 1);
-        CoefT2[n] = CoefT1[n] * un[n];
-        // Contributions to the virial coefficients
-        SumB[n] = 0;
-        Sum0[n] = 0;
-        if (n <= 18)
-        {
-            Sum = Bs[n] * D;
-            if (n >= 13)
-            {
-                Sum += -Csn[n] * Dred;
-            }
-            SumB[n] = Sum * Tun[n];
-        }
-        if (n >= 13)
-        {
-            // Contributions to the residual part of the Helmholtz energy
-            Sum0[n] = Csn[n] * Dknn[bn[n]] * Tun[n] * Expn[kn[n]];
-            // Contributions to the derivatives of the Helmholtz energy with respect to density
-            bkd = bn[n] - kn[n] * Dknn[kn[n]];
-            ckd = kn[n] * kn[n] * Dknn[kn[n]];
-            CoefD1[n] = bkd;
-            CoefD2[n] = bkd * (bkd - 1) - ckd;
-            CoefD3[n] = (bkd - 2) * CoefD2[n] + ckd * (1 - kn[n] - 2 * bkd);
-        }
-        else
-        {
-            CoefD1[n] = 0;
-            CoefD2[n] = 0;
-            CoefD3[n] = 0;
-        }
+        sb = Bsx[n] * D * Tun[n];
+        S0 += sb;
+        T10 += CoefT1[n] * sb;
+        T20 += CoefT2[n] * sb;
     }
+    S1 = S0;
+    T11 = T10;
 
-    for (int n = 1; n <= 58; ++n)
+    // Terms 13-18: second virial part, with the third virial part already included in Csnx
+    for (int n = 13; n <= 18; ++n)
     {
-        // Density derivatives
-        s0 = Sum0[n] + SumB[n];
-        s1 = Sum0[n] * CoefD1[n] + SumB[n];
-        s2 = Sum0[n] * CoefD2[n];
-        s3 = Sum0[n] * CoefD3[n];
-        ar[0][0] = ar[0][0] + RT * s0;
-        ar[0][1] = ar[0][1] + RT * s1;
-        ar[0][2] = ar[0][2] + RT * s2;
-        ar[0][3] = ar[0][3] + RT * s3;
-        // Temperature derivatives
-        if (itau > 0)
-        {
-            ar[1][0] = ar[1][0] - CoefT1[n] * s0;
-            ar[1][1] = ar[1][1] - CoefT1[n] * s1;
-            ar[2][0] = ar[2][0] + CoefT2[n] * s0;
-            // The following are not used, but fully functional
-            // ar(1, 2) = ar(1, 2) - CoefT1(n) * s2;
-            // ar(1, 3) = ar(1, 3) - CoefT1(n) * s3;
-            // ar(2, 1) = ar(2, 1) + CoefT2(n) * s1;
-            // ar(2, 2) = ar(2, 2) + CoefT2(n) * s2;
-            // ar(2, 3) = ar(2, 3) + CoefT2(n) * s3;
-        }
+        sb = (Bsx[n] * D - Csnx[n] * Dred) * Tun[n];
+        S0 += sb;
+        S1 += sb;
+        T10 += CoefT1[n] * sb;
+        T11 += CoefT1[n] * sb;
+        T20 += CoefT2[n] * sb;
+    }
+
+    // Terms 13-58: density exponential part
+    for (int n = 13; n <= 58; ++n)
+    {
+        s0 = Csnx[n] * Tun[n] * Dknn[bn[n]] * Expn[kn[n]];
+        Dk = Dknn[kn[n]];
+        bkd = bnd[n] - knd[n] * Dk;
+        ckd = kn2d[n] * Dk;
+        c2 = bkd * (bkd - 1) - ckd;
+        c3 = (bkd - 2) * c2 + ckd * (1 - knd[n] - 2 * bkd);
+        S0 += s0;
+        S1 += s0 * bkd;
+        S2 += s0 * c2;
+        S3 += s0 * c3;
+        T10 += CoefT1[n] * s0;
+        T11 += CoefT1[n] * s0 * bkd;
+        T20 += CoefT2[n] * s0;
+    }
+
+    ar[0][0] = RT * S0;
+    ar[0][1] = RT * S1;
+    ar[0][2] = RT * S2;
+    ar[0][3] = RT * S3;
+    // Temperature derivatives
+    if (itau > 0)
+    {
+        ar[1][0] = -T10;
+        ar[1][1] = -T11;
+        ar[2][0] = T20;
     }
 }
 
+
 /// The following routine must be called once before any other routine.
 /**
  * @brief Initializes all constants and parameters for the DETAIL model equations of state
@@ -839,7 +1760,11 @@ void SetupDetail()
     MMiDetail[21] = 39.948;  // Argon
 
     // Initialize constants
-    Told = 0;
+    for (int s = 0; s < NTSlots; ++s)
+    {
+        TSlot[s] = 0;
+    }
+    TSlotNext = 0;
     for (int i = 1; i <= NTerms; ++i)
     {
         an[i] = 0;
@@ -1613,6 +2538,15 @@ void SetupDetail()
             Gij5[i][j] = (Gij[i][j] - 1) * (Gi[i] + Gi[j]) / 2;
         }
     }
+    for (int n = 1; n <= NTerms; ++n)
+    {
+        bnd[n] = bn[n];
+        knd[n] = kn[n];
+        kn2d[n] = kn[n] * kn[n];
+        CoefT1[n] = RDetail * (un[n] - 1);
+        CoefT2[n] = CoefT1[n] * un[n];
+    }
+
     // Ideal gas terms
     d0 = 101.325 / RDetail / 298.15;
     for (int i = 1; i <= MaxFlds; ++i)
@@ -1620,6 +2554,29 @@ void SetupDetail()
         n0i[i][3] = n0i[i][3] - 1;
         n0i[i][1] = n0i[i][1] - log(d0);
     }
+
+    // Composition terms of the pure fluids, copied by xTermsDetail instead of being recalculated
+    PureSetDetail = false;
+    for (int i = 1; i <= MaxFlds; ++i)
+    {
+        Composition xi;
+        xi[i] = 1;
+        xTermsDetail(xi);
+        K3Pure[i] = K3;
+        for (int n = 1; n <= 18; ++n)
+        {
+            BsPure[i][n] = Bs[n];
+        }
+        for (int n = 13; n <= 58; ++n)
+        {
+            CsnPure[i][n] = Csn[n];
+        }
+    }
+    for (int i = 1; i <= MaxFlds; ++i)
+    {
+        xold[i] = 0;
+    }
+    PureSetDetail = true;
     return;
 
     // Code to produce nearly exact values for n0[1] and n0[2]
@@ -1638,6 +2595,17 @@ void SetupDetail()
     // }
 }
 
+// Scalar types of PressureDetail<V> and PropertiesDetail<V>
+#define AGA8_DETAIL_SCALAR(V) \
+    template void PressureDetail<V>(const V &T, const V &D, const std::vector<V> &x, V &P, V &Z); \
+    template void PropertiesDetail<V>(const V &T, const V &D, const std::vector<V> &x, V &P, V &Z, V &dPdD, V &d2PdD2, V &d2PdTD, V &dPdT, V &U, V &H, V &S, V &Cv, V &Cp, V &W, V &G, V &JT, V &Kappa, V &Cf);
+AGA8_DETAIL_SCALAR(float)
+AGA8_DETAIL_SCALAR(double)
+AGA8_DETAIL_SCALAR(Dual<1>)
+AGA8_DETAIL_SCALAR(Dual<2>)
+AGA8_DETAIL_SCALAR(Dual<23>)
+#undef AGA8_DETAIL_SCALAR
+
 #ifdef TEST_DETAIL
 #include <cstdio>
 int main()
@@ -22,11 +22,78 @@ OR USE OF, THE SOFTWARE OR SERVICES PROVIDED HEREUNDER.
 
 #include <vector>
 #include <string>
+#include "Composition.h"
 
 void MolarMassDetail(const std::vector<double> &x, double &Mm);
+void MolarMassDetail(const Composition &x, double &Mm);
+void MolarMassDetail(const CompositionView &x, double &Mm);
 void PressureDetail(const double T, const double D, const std::vector<double> &x, double &P, double &Z);
+void PressureDetail(const double T, const double D, const Composition &x, double &P, double &Z);
+void PressureDetail(const double T, const double D, const CompositionView &x, double &P, double &Z);
 void DensityDetail(const double T, const double P, const std::vector<double> &x, double &D, int &ierr, std::string &herr);
+void DensityDetail(const double T, const double P, const std::vector<double> &x, double &D, int &ierr, const char *&herr);
+void DensityDetail(const double T, const double P, const Composition &x, double &D, int &ierr, const char *&herr);
+void DensityDetail(const double T, const double P, const CompositionView &x, double &D, int &ierr, const char *&herr);
+int DensityIterationsDetail();
 void PropertiesDetail(const double T, const double D, const std::vector<double> &x, double &P, double &Z, double &dPdD, double &dPdD2, double &d2PdTD, double &dPdT, double &U, double &H, double &S, double &Cv, double &Cp, double &W, double &G, double &JT, double &Kappa, double &Cf);
+void PropertiesDetail(const double T, const double D, const Composition &x, double &P, double &Z, double &dPdD, double &dPdD2, double &d2PdTD, double &dPdT, double &U, double &H, double &S, double &Cv, double &Cp, double &W, double &G, double &JT, double &Kappa, double &Cf);
+void PropertiesDetail(const double T, const double D, const CompositionView &x, double &P, double &Z, double &dPdD, double &dPdD2, double &d2PdTD, double &dPdT, double &U, double &H, double &S, double &Cv, double &Cp, double &W, double &G, double &JT, double &Kappa, double &Cf);
+void CompositionDerivativesDetail(const double T, const double D, const std::vector<double> &x, double &P, double &Z, double &W, std::vector<double> &dZdx, std::vector<double> &dDdx, std::vector<double> &dWdx);
+void CompositionDerivativesDetail(const double T, const double D, const Composition &x, double &P, double &Z, double &W, Composition &dZdx, Composition &dDdx, Composition &dWdx);
+void CompositionDerivativesDetail(const double T, const double D, const CompositionView &x, double &P, double &Z, double &W, Composition &dZdx, Composition &dDdx, Composition &dWdx);
+void CompositionDerivativesBatchDetail(const std::vector<double> &T, const std::vector<double> &P, const std::vector<double> &x, std::vector<double> &D, std::vector<double> &Z, std::vector<double> &W, std::vector<double> &dZdx, std::vector<double> &dDdx, std::vector<double> &dWdx, std::vector<int> &ierr);
+void CompositionDerivativesBatchDetail(const std::vector<double> &T, const std::vector<double> &P, const Composition &x, std::vector<double> &D, std::vector<double> &Z, std::vector<double> &W, std::vector<double> &dZdx, std::vector<double> &dDdx, std::vector<double> &dWdx, std::vector<int> &ierr);
+void CompositionDerivativesBatchDetail(const std::vector<double> &T, const std::vector<double> &P, const CompositionView &x, std::vector<double> &D, std::vector<double> &Z, std::vector<double> &W, std::vector<double> &dZdx, std::vector<double> &dDdx, std::vector<double> &dWdx, std::vector<int> &ierr);
+// Scalar templates without caches, instantiated for float, double, Dual<1>, Dual<2> and Dual<23> (see Scalar.h)
+template <typename V> void PressureDetail(const V &T, const V &D, const std::vector<V> &x, V &P, V &Z);
+template <typename V> void PropertiesDetail(const V &T, const V &D, const std::vector<V> &x, V &P, V &Z, V &dPdD, V &d2PdD2, V &d2PdTD, V &dPdT, V &U, V &H, V &S, V &Cv, V &Cp, V &W, V &G, V &JT, V &Kappa, V &Cf);
 void SetupDetail();
 
+/**
+ * @brief DETAIL residual terms at a fixed temperature and composition, grouped by their density exponents
+ *
+ * The second virial terms collapse into one coefficient B, and the Csn*Tun products of the
+ * higher order terms are summed per (bn, kn) exponent pair.
+ * @see PrepareIsothermDetail, PressureIsothermDetail
+ */
+struct PreparedIsothermDetail
+{
+    static const int MaxGroups = 10 * 5;
+    double T, K3;             // Temperature (K) and size parameter K^3 of the mixture
+    double B;                 // Sum(Bs[n]*Tun[n]) for n = 1 to 18
+    double C;                 // Sum(Csn[n]*Tun[n]) for n = 13 to 18 (density derivative of the virial part)
+    int ngroups;              // Number of Dred^b*exp(-Dred^k) groups
+    int bgroup[MaxGroups], kgroup[MaxGroups];
+    double agroup[MaxGroups];
+};
+
+void PrepareIsothermDetail(const double T, const std::vector<double> &x, PreparedIsothermDetail &iso);
+void PrepareIsothermDetail(const double T, const Composition &x, PreparedIsothermDetail &iso);
+void PrepareIsothermDetail(const double T, const CompositionView &x, PreparedIsothermDetail &iso);
+void PressureIsothermDetail(const PreparedIsothermDetail &iso, const double D, double &P, double &Z, double &dPdD);
+
+/**
+ * @brief DETAIL equation of a fixed composition, with all the composition dependent factors folded into the coefficients
+ *
+ * The second virial terms are B[n]*D*T^(-u[n]) (n = 1 to 18) and the higher order terms
+ * C[n]*T^(-u[n])*Dred^b[n]*exp(-Dred^k[n]) (n = 13 to 58), with Dred = K3*D.
+ * @see PrepareFixedGasDetail
+ */
+struct FixedGasTermsDetail
+{
+    static const int MaxHyp = 21 * 4;
+    double R, Mm, K3;                 // Gas constant, molar mass and size parameter K^3 of the mixture
+    double Sumx, SumxLnx;             // Sum(x) and Sum(x*ln(x)) of the components used
+    double n01, n02, n03;             // Sum(x*n0i[1..3]) of the ideal gas part
+    int nhyp;                         // Number of x*n0*ln|sinh(th0/T)| or -x*n0*ln|cosh(th0/T)| ideal gas terms
+    int sinhhyp[MaxHyp];
+    double ahyp[MaxHyp], thhyp[MaxHyp];
+    double u[58 + 1];                 // Temperature exponents of the terms 1 to 58
+    double B[18 + 1];                 // Second virial coefficients of the terms 1 to 18
+    double C[58 + 1];                 // Coefficients of the terms 13 to 58
+    int b[58 + 1], k[58 + 1];         // Density exponents of the terms 13 to 58
+};
+
+void PrepareFixedGasDetail(const std::vector<double> &x, FixedGasTermsDetail &fg);
+
 #endif
@@ -0,0 +1,387 @@
+/**
+ * @file FixedGasGERG.h
+ * @brief GERG-2008 kernels for one fixed composition whose terms are compile-time constants
+ *
+ * The constants are generated by aga8-fixedgas (src/tools/fixedgas.cpp) from PrepareFixedGasGERG:
+ * a generated header defines a struct with the members read below and calls the kernels with it,
+ * e.g. DensityFixedGasGERG<Gas>(T, P, D, ierr, herr). The kernels only depend on <cmath>, so the
+ * generated header compiles without the rest of the library, natively or with Emscripten.
+ * The results agree with DensityGERG (iFlag = 0) and PropertiesGERG to rounding.
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef AGA8FIXEDGASGERG_H_
+#define AGA8FIXEDGASGERG_H_
+
+#include <cmath>
+
+/**
+ * @brief Temperature dependent coefficients of the residual terms of a fixed gas
+ *
+ * @tparam Gas Generated constants: NTau distinct tau exponents tTau; NPol terms aPol*del^dPol*tau^tTau[iPol];
+ *         NExp terms aExp*del^dExp*tau^tTau[iExp]*exp(-del^cExp), in NExpGroup groups of the same
+ *         (dExpGroup, cExpGroup) given by gExp; NGauss departure terms
+ *         aGauss*del^dGauss*tau^tTau[iGauss]*exp(cGauss*del^2 + eGauss*del)
+ */
+template <class Gas>
+struct FixedGasTauGERG
+{
+    double T;
+    double apol[Gas::NPol > 0 ? Gas::NPol : 1];
+    double aexp[Gas::NExp > 0 ? Gas::NExp : 1];
+    double agauss[Gas::NGauss > 0 ? Gas::NGauss : 1];
+};
+
+/**
+ * @brief Residual pressure terms of a fixed gas at one temperature, grouped by their density exponents
+ * @see PreparedIsothermGERG for the generic equivalent
+ */
+template <class Gas>
+struct FixedGasIsothermGERG
+{
+    double T;
+    double apol[7 + 1];
+    double aexp[Gas::NExpGroup > 0 ? Gas::NExpGroup : 1];
+    double agauss[Gas::NGauss > 0 ? Gas::NGauss : 1];
+};
+
+/**
+ * @brief Calculate the coefficients coef*tau^t of the residual terms at temperature T
+ */
+template <class Gas>
+inline void TauTermsFixedGasGERG(const double T, FixedGasTauGERG<Gas> &tt)
+{
+    double taut[Gas::NTau > 0 ? Gas::NTau : 1];
+    const double lntau = std::log(Gas::Tr / T);
+    tt.T = T;
+    for (int j = 0; j < Gas::NTau; ++j) { taut[j] = std::exp(Gas::tTau[j] * lntau); }
+    for (int k = 0; k < Gas::NPol; ++k) { tt.apol[k] = Gas::aPol[k] * taut[Gas::iPol[k]]; }
+    for (int k = 0; k < Gas::NExp; ++k) { tt.aexp[k] = Gas::aExp[k] * taut[Gas::iExp[k]]; }
+    for (int k = 0; k < Gas::NGauss; ++k) { tt.agauss[k] = Gas::aGauss[k] * taut[Gas::iGauss[k]]; }
+}
+
+/**
+ * @brief Sum the temperature terms sharing the same density exponents, for PressureFixedGasGERG
+ */
+template <class Gas>
+inline void IsothermFixedGasGERG(const FixedGasTauGERG<Gas> &tt, FixedGasIsothermGERG<Gas> &iso)
+{
+    iso.T = tt.T;
+    for (int d = 0; d <= 7; ++d) { iso.apol[d] = 0; }
+    for (int g = 0; g < Gas::NExpGroup; ++g) { iso.aexp[g] = 0; }
+    for (int k = 0; k < Gas::NPol; ++k) { iso.apol[Gas::dPol[k]] += tt.apol[k]; }
+    for (int k = 0; k < Gas::NExp; ++k) { iso.aexp[Gas::gExp[k]] += tt.aexp[k]; }
+    for (int k = 0; k < Gas::NGauss; ++k) { iso.agauss[k] = tt.agauss[k]; }
+}
+
+/**
+ * @brief Residual Helmholtz energy and derivatives of a fixed gas, with the same ar[][] layout as AlpharGERG
+ *
+ * @param itau Calculate the tau derivatives and ar[0][0], ar[0][3] if > 0
+ * @param tt Temperature terms from TauTermsFixedGasGERG
+ * @param D Density (mol/l)
+ * @param[out] ar Dimensionless residual Helmholtz derivatives
+ */
+template <class Gas>
+inline void AlpharFixedGasGERG(const int itau, const FixedGasTauGERG<Gas> &tt, const double D, double ar[4][4])
+{
+    double del, delp[7 + 1], Expd[7 + 1], ndt, ndtd, ndtt, ex, ex2, ex3, cij0, eij0;
+    int d, c;
+    double t;
+
+    for (int i = 0; i <= 3; ++i) { for (int j = 0; j <= 3; ++j) { ar[i][j] = 0; } }
+    del = D / Gas::Dr;
+    delp[0] = 1;
+    Expd[0] = 1;
+    for (int i = 1; i <= 7; ++i)
+    {
+        delp[i] = delp[i - 1] * del;
+        Expd[i] = std::exp(-delp[i]);
+    }
+
+    for (int k = 0; k < Gas::NPol; ++k)
+    {
+        d = Gas::dPol[k];
+        t = Gas::tTau[Gas::iPol[k]];
+        ndt = tt.apol[k] * delp[d];
+        ndtd = ndt * d;
+        ar[0][1] += ndtd;
+        ar[0][2] += ndtd * (d - 1);
+        if (itau > 0)
+        {
+            ndtt = ndt * t;
+            ar[0][0] += ndt;
+            ar[1][0] += ndtt;
+            ar[2][0] += ndtt * (t - 1);
+            ar[1][1] += ndtt * d;
+            ar[1][2] += ndtt * d * (d - 1);
+            ar[0][3] += ndtd * (d - 1) * (d - 2);
+        }
+    }
+    for (int k = 0; k < Gas::NExp; ++k)
+    {
+        d = Gas::dExp[k];
+        c = Gas::cExp[k];
+        t = Gas::tTau[Gas::iExp[k]];
+        ndt = tt.aexp[k] * delp[d] * Expd[c];
+        ex = c * delp[c];
+        ex2 = d - ex;
+        ex3 = ex2 * (ex2 - 1);
+        ar[0][1] += ndt * ex2;
+        ar[0][2] += ndt * (ex3 - c * ex);
+        if (itau > 0)
+        {
+            ndtt = ndt * t;
+            ar[0][0] += ndt;
+            ar[1][0] += ndtt;
+            ar[2][0] += ndtt * (t - 1);
+            ar[1][1] += ndtt * ex2;
+            ar[1][2] += ndtt * (ex3 - c * ex);
+            ar[0][3] += ndt * (ex3 * (ex2 - 2) - ex * (3 * ex2 - 3 + c) * c);
+        }
+    }
+    for (int k = 0; k < Gas::NGauss; ++k)
+    {
+        d = Gas::dGauss[k];
+        t = Gas::tTau[Gas::iGauss[k]];
+        cij0 = Gas::cGauss[k] * delp[2];
+        eij0 = Gas::eGauss[k] * del;
+        ndt = tt.agauss[k] * delp[d] * std::exp(cij0 + eij0);
+        ex = d + 2 * cij0 + eij0;
+        ex2 = (ex * ex - d + 2 * cij0);
+        ar[0][1] += ndt * ex;
+        ar[0][2] += ndt * ex2;
+        if (itau > 0)
+        {
+            ndtt = ndt * t;
+            ar[0][0] += ndt;
+            ar[1][0] += ndtt;
+            ar[2][0] += ndtt * (t - 1);
+            ar[1][1] += ndtt * ex;
+            ar[1][2] += ndtt * ex2;
+            ar[0][3] += ndt * (ex * (ex2 - 2 * (d - 2 * cij0)) + 2 * d);
+        }
+    }
+}
+
+/**
+ * @brief Ideal gas Helmholtz energy and derivatives of a fixed gas, with the same a0[] layout as Alpha0GERG
+ */
+template <class Gas>
+inline void Alpha0FixedGasGERG(const double T, const double D, double a0[3])
+{
+    double th0T, ep, em, hsn, hcn;
+    double SumHyp0 = 0, SumHyp1 = 0, SumHyp2 = 0;
+
+    for (int k = 0; k < Gas::NHyp; ++k)
+    {
+        th0T = Gas::thHyp[k] / T;
+        ep = std::exp(th0T);
+        em = 1 / ep;
+        hsn = (ep - em) / 2;
+        hcn = (ep + em) / 2;
+        if (Gas::sinhHyp[k])
+        {
+            SumHyp0 += Gas::aHyp[k] * std::log(std::abs(hsn));
+            SumHyp1 += Gas::aHyp[k] * th0T * hcn / hsn;
+            SumHyp2 += Gas::aHyp[k] * (th0T / hsn) * (th0T / hsn);
+        }
+        else
+        {
+            SumHyp0 -= Gas::aHyp[k] * std::log(std::abs(hcn));
+            SumHyp1 -= Gas::aHyp[k] * th0T * hsn / hcn;
+            SumHyp2 += Gas::aHyp[k] * (th0T / hcn) * (th0T / hcn);
+        }
+    }
+    const double LogD = std::log(D > 1e-15 ? D : 1e-15);
+    a0[0] = Gas::SumxLnx + Gas::Sumx * LogD + Gas::n01 + Gas::n02 / T - Gas::n03 * std::log(T) + SumHyp0;
+    a0[1] = Gas::n03 + Gas::n02 / T + SumHyp1;
+    a0[2] = -(Gas::n03 + SumHyp2);
+}
+
+/**
+ * @brief Pressure, compressibility factor and d(P)/d(D) of a fixed gas on an isotherm, see PressureIsothermGERG
+ */
+template <class Gas>
+inline void PressureFixedGasGERG(const FixedGasIsothermGERG<Gas> &iso, const double D, double &P, double &Z, double &dPdD)
+{
+    double del, delp[7 + 1], Expd[7 + 1], ar01 = 0, ar02 = 0, ndt, ex, ex2, cij0, eij0;
+    int d, c;
+
+    del = D / Gas::Dr;
+    delp[0] = 1;
+    Expd[0] = 1;
+    for (int i = 1; i <= 7; ++i)
+    {
+        delp[i] = delp[i - 1] * del;
+        Expd[i] = std::exp(-delp[i]);
+    }
+    for (d = 1; d <= 7; ++d)
+    {
+        ndt = iso.apol[d] * delp[d] * d;
+        ar01 += ndt;
+        ar02 += ndt * (d - 1);
+    }
+    for (int g = 0; g < Gas::NExpGroup; ++g)
+    {
+        d = Gas::dExpGroup[g];
+        c = Gas::cExpGroup[g];
+        ndt = iso.aexp[g] * delp[d] * Expd[c];
+        ex = c * delp[c];
+        ex2 = d - ex;
+        ar01 += ndt * ex2;
+        ar02 += ndt * (ex2 * (ex2 - 1) - c * ex);
+    }
+    for (int k = 0; k < Gas::NGauss; ++k)
+    {
+        d = Gas::dGauss[k];
+        cij0 = Gas::cGauss[k] * delp[2];
+        eij0 = Gas::eGauss[k] * del;
+        ndt = iso.agauss[k] * delp[d] * std::exp(cij0 + eij0);
+        ex = d + 2 * cij0 + eij0;
+        ex2 = (ex * ex - d + 2 * cij0);
+        ar01 += ndt * ex;
+        ar02 += ndt * ex2;
+    }
+    Z = 1 + ar01;
+    P = D * Gas::R * iso.T * Z;
+    dPdD = Gas::R * iso.T * (1 + 2 * ar01 + ar02);
+}
+
+/**
+ * @brief Density of a fixed gas from temperature and pressure, see DensityGERG with iFlag = 0
+ *
+ * @param T Temperature (K)
+ * @param P Pressure (kPa)
+ * @param[in,out] D Density (mol/l). A negative value is used as the initial estimate
+ * @param[out] ierr Error code (0 = no error, 1 = not converged, ideal gas density returned)
+ * @param[out] herr Error message
+ */
+template <class Gas>
+inline void DensityFixedGasGERG(const double T, const double P, double &D, int &ierr, const char *&herr)
+{
+    int nFail = 0;
+    double plog, vlog, P2, Z, dPdD, dpdlv, vdiff, vinc;
+    const double tolr = 0.0000001;
+    FixedGasTauGERG<Gas> tt;
+    FixedGasIsothermGERG<Gas> iso;
+
+    ierr = 0;
+    herr = "";
+    if (P < 1e-15) { D = 0; return; }
+    TauTermsFixedGasGERG<Gas>(T, tt);
+    IsothermFixedGasGERG<Gas>(tt, iso);
+
+    if (D > -1e-15) { D = P / Gas::R / T; }   // Ideal gas estimate for vapor phase
+    else { D = std::abs(D); }               // If D<0, then use as initial estimate
+
+    plog = std::log(P);
+    vlog = -std::log(D);
+    for (int it = 1; it <= 50; ++it)
+    {
+        if (vlog < -7 || vlog > 100 || it == 20 || it == 30 || it == 40)
+        {
+            // Current state is bad or iteration is taking too long.  Restart with completely different initial state
+            if (nFail > 2)
+            {
+                ierr = 1;
+                herr = "Calculation failed to converge in GERG method, ideal gas density returned.";
+                D = P / Gas::R / T;
+            }
+            nFail++;
+            if (nFail == 1) { D = Gas::Dcx * 3; }          // Liquid region
+            else if (nFail == 2) { D = Gas::Dcx * 2.5; }   // Between liquid and critical regions
+            else if (nFail == 3) { D = Gas::Dcx * 2; }     // Critical region
+            vlog = -std::log(D);
+        }
+        D = std::exp(-vlog);
+        PressureFixedGasGERG<Gas>(iso, D, P2, Z, dPdD);
+        if (dPdD < 1e-15 || P2 < 1e-15)
+        {
+            // Current state is 2-phase, try locating a different state that is single phase
+            vinc = 0.1;
+            if (D > Gas::Dcx) { vinc = -0.1; }
+            if (it > 5) { vinc = vinc / 2; }
+            if (it > 10 && it < 20) { vinc = vinc / 5; }
+            vlog += vinc;
+        }
+        else
+        {
+            // Newton step with log(P) as the known variable and log(v) as the unknown property
+            dpdlv = -D * dPdD;
+            vdiff = (std::log(P2) - plog) * P2 / dpdlv;
+            vlog += -vdiff;
+            if (std::abs(vdiff) < tolr)
+            {
+                D = std::exp(-vlog);
+                return;
+            }
+        }
+    }
+    ierr = 1;
+    herr = "Calculation failed to converge in GERG method, ideal gas density returned.";
+    D = P / Gas::R / T;
+}
+
+/**
+ * @brief Thermodynamic properties of a fixed gas from temperature and density, see PropertiesGERG
+ */
+template <class Gas>
+inline void PropertiesFixedGasGERG(const double T, const double D, double &P, double &Z, double &dPdD, double &d2PdD2, double &d2PdTD, double &dPdT, double &U, double &H, double &S, double &Cv, double &Cp, double &W, double &G, double &JT, double &Kappa, double &A, double &Cf)
+{
+    double a0[3], ar[4][4];
+    FixedGasTauGERG<Gas> tt;
+
+    TauTermsFixedGasGERG<Gas>(T, tt);
+    Alpha0FixedGasGERG<Gas>(T, D, a0);
+    AlpharFixedGasGERG<Gas>(1, tt, D, ar);
+
+    const double R = Gas::R, RT = R * T, Mm = Gas::Mm;
+    Z = 1 + ar[0][1];
+    P = D * RT * Z;
+    dPdD = RT * (1 + 2 * ar[0][1] + ar[0][2]);
+    dPdT = D * R * (1 + ar[0][1] - ar[1][1]);
+    d2PdTD = R * (1 + 2 * ar[0][1] + ar[0][2] - 2 * ar[1][1] - ar[1][2]);
+    A = RT * (a0[0] + ar[0][0]);
+    G = RT * (1 + ar[0][1] + a0[0] + ar[0][0]);
+    U = RT * (a0[1] + ar[1][0]);
+    H = RT * (1 + ar[0][1] + a0[1] + ar[1][0]);
+    S = R * (a0[1] + ar[1][0] - a0[0] - ar[0][0]);
+    Cv = -R * (a0[2] + ar[2][0]);
+    if (D > 1e-15)
+    {
+        Cp = Cv + T * (dPdT / D) * (dPdT / D) / dPdD;
+        d2PdD2 = RT * (2 * ar[0][1] + 4 * ar[0][2] + ar[0][3]) / D;
+        JT = (T / D * dPdT / dPdD - 1) / Cp / D;
+    }
+    else
+    {
+        Cp = Cv + R;
+        d2PdD2 = 0;
+        JT = 1E+20;
+    }
+    W = 1000 * Cp / Cv * dPdD / Mm;
+    if (W < 0) { W = 0; }
+    W = std::sqrt(W);
+    Kappa = W * W * Mm / (RT * 1000 * Z);
+    Cf = std::sqrt(Kappa * std::pow((2 / (Kappa + 1)), ((Kappa + 1) / (Kappa - 1))));
+}
+
+#endif
@@ -0,0 +1,427 @@
+/**
+ * @file Flash.cpp
+ * @brief Temperature and density from two known properties (PH, PS, PU, TH, TS, DH, DS, UV flashes)
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "Flash.h"
+#include "Detail.h"
+#include "GERG2008.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Equation of state of a flash
+static const int FlashGERGMethod = 0, FlashDetailMethod = 1;
+
+// Properties of the flash equations
+static const int PropT = 0, PropD = 1, PropP = 2, PropH = 3, PropS = 4, PropU = 5;
+
+// Properties known in each pair, in the order of the flash constants (UV is solved as U and D = 1/V)
+static const int pairProps[8][2] = {{PropP, PropH}, {PropP, PropS}, {PropP, PropU}, {PropT, PropH},
+                                    {PropT, PropS}, {PropD, PropH}, {PropD, PropS}, {PropU, PropD}};
+
+static const int MaxIterFlash = 50;
+static const double tolFlash = 1e-9;       // Tolerance on the Newton steps of ln(T) and ln(D), above the 1e-7 K resolution of the GERG-2008 temperature terms
+static const double MaxStepLnT = 0.2;      // Largest change of ln(T) in one iteration
+static const double MaxStepLnD = 1;        // Largest change of ln(D) in one iteration
+static const double RFlash = 8.314472;     // Scale of the energy equations (J/(mol-K)), any value close to R
+static const double DensePressureFlash = 30000; // Pressure of the liquid-like initial estimate (kPa)
+static thread_local int nIterFlash;        // Iterations of the last flash of the calling thread, see FlashIterations
+
+// Properties of a (T, D) state used by the flash equations
+struct FlashState
+{
+    double T, D, P, dPdD, dPdT, U, H, S, Cv;
+};
+
+template <typename X>
+static void EvaluateFlash(const int method, const double T, const double D, const X &x, FlashState &st)
+{
+    double Z, d2PdD2, d2PdTD, Cp, W, G, JT, Kappa, A, Cf;
+    st.T = T;
+    st.D = D;
+    if (method == FlashDetailMethod)
+    {
+        PropertiesDetail(T, D, x, st.P, Z, st.dPdD, d2PdD2, d2PdTD, st.dPdT, st.U, st.H, st.S, st.Cv, Cp, W, G, JT, Kappa, Cf);
+    }
+    else
+    {
+        PropertiesGERG(T, D, x, st.P, Z, st.dPdD, d2PdD2, d2PdTD, st.dPdT, st.U, st.H, st.S, st.Cv, Cp, W, G, JT, Kappa, A, Cf);
+    }
+}
+
+/**
+ * @brief Scaled residual of one flash equation and its derivatives with respect to ln(T) and ln(D)
+ *
+ * T, D and P are compared by their logarithms, which are nearly linear in (ln T, ln D) in the gas,
+ * H and U are divided by RT and S by R.
+ * @return false if the residual is not defined (P <= 0) or not finite
+ */
+static bool ResidualFlash(const int prop, const double target, const FlashState &st, double &r, double &drdlnT, double &drdlnD)
+{
+    const double RT = RFlash * st.T;
+    switch (prop)
+    {
+    case PropT:
+        r = std::log(st.T / target);
+        drdlnT = 1;
+        drdlnD = 0;
+        break;
+    case PropD:
+        r = std::log(st.D / target);
+        drdlnT = 0;
+        drdlnD = 1;
+        break;
+    case PropP:
+        if (!(st.P > 0)) { return false; }
+        r = std::log(st.P / target);
+        drdlnT = st.T * st.dPdT / st.P;
+        drdlnD = st.D * st.dPdD / st.P;
+        break;
+    case PropH:
+        r = (st.H - target) / RT;
+        drdlnT = st.T * (st.Cv + st.dPdT / st.D) / RT;
+        drdlnD = (st.dPdD - st.T * st.dPdT / st.D) / RT;
+        break;
+    case PropS:
+        r = (st.S - target) / RFlash;
+        drdlnT = st.Cv / RFlash;
+        drdlnD = -st.dPdT / st.D / RFlash;
+        break;
+    default:
+        r = (st.U - target) / RT;
+        drdlnT = st.T * st.Cv / RT;
+        drdlnD = (st.P - st.T * st.dPdT) / st.D / RT;
+        break;
+    }
+    return std::isfinite(r) && std::isfinite(drdlnT) && std::isfinite(drdlnD);
+}
+
+// Residuals and Jacobian of both flash equations at st
+static bool SystemFlash(const int pair, const double t1, const double t2, const FlashState &st, double r[2], double J[2][2])
+{
+    return ResidualFlash(pairProps[pair][0], t1, st, r[0], J[0][0], J[0][1]) &&
+           ResidualFlash(pairProps[pair][1], t2, st, r[1], J[1][0], J[1][1]);
+}
+
+/**
+ * @brief 2-D Newton iterations on (ln T, ln D) from (T, D)
+ *
+ * The steps are limited to MaxStepLnT and MaxStepLnD, and halved while they do not reduce the
+ * residuals. On success, T and D are the solution.
+ */
+template <typename X>
+static bool NewtonFlash(const int method, const int pair, const double t1, const double t2, const X &x, double &T, double &D)
+{
+    FlashState st, trial;
+    double r[2], J[2][2], rt[2], Jt[2][2];
+    EvaluateFlash(method, T, D, x, st);
+    if (!SystemFlash(pair, t1, t2, st, r, J)) { return false; }
+    for (int it = 1; it <= MaxIterFlash; ++it)
+    {
+        ++nIterFlash;
+        const double det = J[0][0] * J[1][1] - J[0][1] * J[1][0];
+        if (!(std::abs(det) > 1e-300)) { return false; }
+        double dlnT = (-r[0] * J[1][1] + r[1] * J[0][1]) / det;
+        double dlnD = (-r[1] * J[0][0] + r[0] * J[1][0]) / det;
+        if (std::max(std::abs(dlnT), std::abs(dlnD)) < tolFlash)
+        {
+            T = st.T * std::exp(dlnT);
+            D = st.D * std::exp(dlnD);
+            return st.dPdD > 0;
+        }
+        const double limit = std::max(1.0, std::max(std::abs(dlnT) / MaxStepLnT, std::abs(dlnD) / MaxStepLnD));
+        dlnT /= limit;
+        dlnD /= limit;
+
+        const double norm = r[0] * r[0] + r[1] * r[1];
+        bool accepted = false;
+        for (double h = 1; h > 1e-3 && !accepted; h /= 2)
+        {
+            EvaluateFlash(method, st.T * std::exp(h * dlnT), st.D * std::exp(h * dlnD), x, trial);
+            if (!SystemFlash(pair, t1, t2, trial, rt, Jt)) { continue; }
+            // The smallest step is taken even if it does not reduce the residuals
+            accepted = rt[0] * rt[0] + rt[1] * rt[1] < norm || h < 2e-3;
+        }
+        if (!accepted) { return false; }
+        st = trial;
+        std::copy(&rt[0], &rt[0] + 2, &r[0]);
+        std::copy(&Jt[0][0], &Jt[0][0] + 4, &J[0][0]);
+    }
+    return false;
+}
+
+// Density at (T, P) from DensityGERG with iFlag (or DensityDetail), or the ideal gas density if the solver fails
+template <typename X>
+static double StartDensityFlash(const int method, const int iFlag, const double T, const double P, const X &x)
+{
+    double D = 0;
+    int ierr;
+    const char *herr;
+    if (method == FlashDetailMethod) { DensityDetail(T, P, x, D, ierr, herr); }
+    else { DensityGERG(iFlag, T, P, x, D, ierr, herr); }
+    return ierr == 0 && D > 0 ? D : P / (RFlash * T);
+}
+
+// T, D and P must be positive, H, S and U finite
+static bool ValidFlashInput(const int prop, const double v)
+{
+    return std::isfinite(v) && (v > 0 || prop == PropH || prop == PropS || prop == PropU);
+}
+
+// FlashGERG and FlashDetail for any composition type X with x[i], i = 1 to 21 (std::vector, Composition, CompositionView)
+template <typename X>
+static void FlashImpl(const int method, const int pair, const double v1, const double v2, const X &x, double &T, double &D, int &ierr, const char *&herr)
+{
+    ierr = 0;
+    herr = "";
+    nIterFlash = 0;
+    if (pair < FlashPH || pair > FlashUV) { ierr = 1; herr = "Unknown flash pair"; return; }
+    const int prop1 = pairProps[pair][0];
+    const double t1 = v1, t2 = pair == FlashUV ? 1 / v2 : v2;
+    if (!ValidFlashInput(prop1, t1) || !ValidFlashInput(pairProps[pair][1], t2))
+    {
+        ierr = 2; herr = "Invalid flash input"; T = 0; D = 0; return;
+    }
+
+    // Initial estimates: the input (T, -D), or the known temperature (300 K otherwise) and the known
+    // density or the gas density at the known pressure (1 atm otherwise)
+    const bool warm = D < 0 && T > 0;
+    const bool knownD = prop1 == PropD || pairProps[pair][1] == PropD;
+    const double P0 = prop1 == PropP ? t1 : 101.325;
+    double T0 = warm ? T : 300, D0 = warm ? -D : 0;
+    if (prop1 == PropT) { T0 = t1; }
+    if (knownD) { D0 = prop1 == PropD ? t1 : t2; }
+    if (D0 <= 0) { D0 = StartDensityFlash(method, 0, T0, P0, x); }
+
+    T = T0;
+    D = D0;
+    bool ok = NewtonFlash(method, pair, t1, t2, x, T, D);
+    if (!ok && !warm && !knownD)
+    {
+        // Once more from a liquid-like density, for states beyond the 2-phase region of the path
+        T = T0;
+        D = StartDensityFlash(method, 2, T0, std::max(P0, DensePressureFlash), x);
+        ok = NewtonFlash(method, pair, t1, t2, x, T, D);
+    }
+    if (!ok)
+    {
+        ierr = 3; herr = "Flash did not converge to a stable single-phase state"; T = 0; D = 0; return;
+    }
+    if (prop1 == PropT) { T = t1; }
+    if (prop1 == PropD) { D = t1; }
+    if (pairProps[pair][1] == PropD) { D = t2; }
+}
+
+// FlashBatchGERG and FlashBatchDetail: each state starts from the previous solution
+template <typename X>
+static void FlashBatchImpl(const int method, const int pair, const std::vector<double> &v1, const std::vector<double> &v2, const X &x, std::vector<double> &T, std::vector<double> &D, std::vector<int> &ierr)
+{
+    const std::size_t n = std::min(v1.size(), v2.size());
+    T.resize(n);
+    D.resize(n);
+    ierr.resize(n);
+    const char *herr;
+    for (std::size_t k = 0; k < n; ++k)
+    {
+        double Tk = 0, Dk = 0;
+        const bool warm = k > 0 && ierr[k - 1] == 0;
+        if (warm) { Tk = T[k - 1]; Dk = -D[k - 1]; }
+        FlashImpl(method, pair, v1[k], v2[k], x, Tk, Dk, ierr[k], herr);
+        if (ierr[k] != 0 && warm)
+        {
+            // Retry without the estimate of the previous state
+            Tk = 0;
+            Dk = 0;
+            FlashImpl(method, pair, v1[k], v2[k], x, Tk, Dk, ierr[k], herr);
+        }
+        T[k] = Tk;
+        D[k] = Dk;
+    }
+}
+
+/**
+ * @brief Temperature and density from two known properties with the GERG-2008 equation
+ *
+ * The known properties v1 and v2 are, depending on pair:
+ *   FlashPH  pressure (kPa) and enthalpy (J/mol)
+ *   FlashPS  pressure (kPa) and entropy [J/(mol-K)]
+ *   FlashPU  pressure (kPa) and internal energy (J/mol)
+ *   FlashTH  temperature (K) and enthalpy (J/mol)
+ *   FlashTS  temperature (K) and entropy [J/(mol-K)]
+ *   FlashDH  density (mol/l) and enthalpy (J/mol)
+ *   FlashDS  density (mol/l) and entropy [J/(mol-K)]
+ *   FlashUV  internal energy (J/mol) and molar volume (l/mol)
+ * with the reference state of PropertiesGERG. Without an initial estimate, the iterations start at
+ * the known temperature or 300 K, and at the known density or the density at the known pressure
+ * (or 101.325 kPa), then once more from a liquid-like density if they fail. Pairs such as TH can
+ * have several solutions; the one found is the one reached from the initial estimate.
+ * SetupGERG must have been called.
+ *
+ * @param pair FlashPH, FlashPS, FlashPU, FlashTH, FlashTS, FlashDH, FlashDS or FlashUV
+ * @param v1 First known property
+ * @param v2 Second known property
+ * @param x Composition (mole fraction)
+ * @param[in,out] T Temperature (K); with D < 0 on input, T and -D are used as the initial estimate
+ * @param[in,out] D Density (mol/l)
+ * @param[out] ierr Error number (0 indicates no error)
+ * @param[out] herr Error message if ierr is not equal to zero
+ */
+void FlashGERG(const int pair, const double v1, const double v2, const std::vector<double> &x, double &T, double &D, int &ierr, const char *&herr)
+{
+    FlashImpl(FlashGERGMethod, pair, v1, v2, x, T, D, ierr, herr);
+}
+
+/**
+ * @brief FlashGERG for a fixed-size Composition
+ * @see FlashGERG
+ */
+void FlashGERG(const int pair, const double v1, const double v2, const Composition &x, double &T, double &D, int &ierr, const char *&herr)
+{
+    FlashImpl(FlashGERGMethod, pair, v1, v2, x, T, D, ierr, herr);
+}
+
+/**
+ * @brief FlashGERG for a CompositionView, e.g. a row of a composition matrix
+ * @see FlashGERG
+ */
+void FlashGERG(const int pair, const double v1, const double v2, const CompositionView &x, double &T, double &D, int &ierr, const char *&herr)
+{
+    FlashImpl(FlashGERGMethod, pair, v1, v2, x, T, D, ierr, herr);
+}
+
+/**
+ * @brief Temperature and density from two known properties with the DETAIL equation
+ *
+ * Same as FlashGERG, with the reference state of PropertiesDetail. SetupDetail must have been called.
+ *
+ * @param pair FlashPH, FlashPS, FlashPU, FlashTH, FlashTS, FlashDH, FlashDS or FlashUV
+ * @param v1 First known property
+ * @param v2 Second known property
+ * @param x Composition (mole fraction)
+ * @param[in,out] T Temperature (K); with D < 0 on input, T and -D are used as the initial estimate
+ * @param[in,out] D Density (mol/l)
+ * @param[out] ierr Error number (0 indicates no error)
+ * @param[out] herr Error message if ierr is not equal to zero
+ */
+void FlashDetail(const int pair, const double v1, const double v2, const std::vector<double> &x, double &T, double &D, int &ierr, const char *&herr)
+{
+    FlashImpl(FlashDetailMethod, pair, v1, v2, x, T, D, ierr, herr);
+}
+
+/**
+ * @brief FlashDetail for a fixed-size Composition
+ * @see FlashDetail
+ */
+void FlashDetail(const int pair, const double v1, const double v2, const Composition &x, double &T, double &D, int &ierr, const char *&herr)
+{
+    FlashImpl(FlashDetailMethod, pair, v1, v2, x, T, D, ierr, herr);
+}
+
+/**
+ * @brief FlashDetail for a CompositionView, e.g. a row of a composition matrix
+ * @see FlashDetail
+ */
+void FlashDetail(const int pair, const double v1, const double v2, const CompositionView &x, double &T, double &D, int &ierr, const char *&herr)
+{
+    FlashImpl(FlashDetailMethod, pair, v1, v2, x, T, D, ierr, herr);
+}
+
+/**
+ * @brief FlashGERG of many states, each started from the solution of the previous one
+ *
+ * Suited to states along a path (an isentropic compression, a valve characteristic...). A state that
+ * fails from the previous solution is solved again without estimate.
+ *
+ * @param pair Flash pair, see FlashGERG
+ * @param v1 First known property of each state
+ * @param v2 Second known property of each state
+ * @param x Composition (mole fraction)
+ * @param[out] T Temperatures (K)
+ * @param[out] D Densities (mol/l)
+ * @param[out] ierr Error numbers (0 indicates no error)
+ */
+void FlashBatchGERG(const int pair, const std::vector<double> &v1, const std::vector<double> &v2, const std::vector<double> &x, std::vector<double> &T, std::vector<double> &D, std::vector<int> &ierr)
+{
+    FlashBatchImpl(FlashGERGMethod, pair, v1, v2, x, T, D, ierr);
+}
+
+/**
+ * @brief FlashBatchGERG for a fixed-size Composition
+ * @see FlashBatchGERG
+ */
+void FlashBatchGERG(const int pair, const std::vector<double> &v1, const std::vector<double> &v2, const Composition &x, std::vector<double> &T, std::vector<double> &D, std::vector<int> &ierr)
+{
+    FlashBatchImpl(FlashGERGMethod, pair, v1, v2, x, T, D, ierr);
+}
+
+/**
+ * @brief FlashBatchGERG for a CompositionView, e.g. a row of a composition matrix
+ * @see FlashBatchGERG
+ */
+void FlashBatchGERG(const int pair, const std::vector<double> &v1, const std::vector<double> &v2, const CompositionView &x, std::vector<double> &T, std::vector<double> &D, std::vector<int> &ierr)
+{
+    FlashBatchImpl(FlashGERGMethod, pair, v1, v2, x, T, D, ierr);
+}
+
+/**
+ * @brief FlashDetail of many states, each started from the solution of the previous one
+ *
+ * @param pair Flash pair, see FlashGERG
+ * @param v1 First known property of each state
+ * @param v2 Second known property of each state
+ * @param x Composition (mole fraction)
+ * @param[out] T Temperatures (K)
+ * @param[out] D Densities (mol/l)
+ * @param[out] ierr Error numbers (0 indicates no error)
+ */
+void FlashBatchDetail(const int pair, const std::vector<double> &v1, const std::vector<double> &v2, const std::vector<double> &x, std::vector<double> &T, std::vector<double> &D, std::vector<int> &ierr)
+{
+    FlashBatchImpl(FlashDetailMethod, pair, v1, v2, x, T, D, ierr);
+}
+
+/**
+ * @brief FlashBatchDetail for a fixed-size Composition
+ * @see FlashBatchDetail
+ */
+void FlashBatchDetail(const int pair, const std::vector<double> &v1, const std::vector<double> &v2, const Composition &x, std::vector<double> &T, std::vector<double> &D, std::vector<int> &ierr)
+{
+    FlashBatchImpl(FlashDetailMethod, pair, v1, v2, x, T, D, ierr);
+}
+
+/**
+ * @brief FlashBatchDetail for a CompositionView, e.g. a row of a composition matrix
+ * @see FlashBatchDetail
+ */
+void FlashBatchDetail(const int pair, const std::vector<double> &v1, const std::vector<double> &v2, const CompositionView &x, std::vector<double> &T, std::vector<double> &D, std::vector<int> &ierr)
+{
+    FlashBatchImpl(FlashDetailMethod, pair, v1, v2, x, T, D, ierr);
+}
+
+/**
+ * @brief Newton iterations of the last FlashGERG or FlashDetail call of the calling thread
+ *
+ * @return Number of iterations
+ */
+int FlashIterations()
+{
+    return nIterFlash;
+}
@@ -0,0 +1,54 @@
+/**
+ * @file Flash.h
+ * @brief Temperature and density from two known properties (PH, PS, PU, TH, TS, DH, DS, UV flashes)
+ *
+ * The flash solves for (T, D) directly with a 2-D Newton method on (ln T, ln D). The Jacobian is
+ * analytic, from the Helmholtz energy derivatives already calculated by PropertiesGERG and
+ * PropertiesDetail (dP/dT, dP/dD and Cv), so that each iteration costs one property call instead of
+ * one density solve. The equation of state is treated as single-phase: the result is a homogeneous
+ * state with dP/dD > 0, and no phase split is calculated.
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef AGA8FLASH_H_
+#define AGA8FLASH_H_
+
+#include <vector>
+#include "Composition.h"
+
+// Known properties (v1, v2) of a flash: pressure (kPa), temperature (K), density (mol/l), enthalpy (J/mol),
+// entropy [J/(mol-K)], internal energy (J/mol) and molar volume (l/mol)
+const int FlashPH = 0, FlashPS = 1, FlashPU = 2, FlashTH = 3, FlashTS = 4, FlashDH = 5, FlashDS = 6, FlashUV = 7;
+
+void FlashGERG(const int pair, const double v1, const double v2, const std::vector<double> &x, double &T, double &D, int &ierr, const char *&herr);
+void FlashGERG(const int pair, const double v1, const double v2, const Composition &x, double &T, double &D, int &ierr, const char *&herr);
+void FlashGERG(const int pair, const double v1, const double v2, const CompositionView &x, double &T, double &D, int &ierr, const char *&herr);
+void FlashDetail(const int pair, const double v1, const double v2, const std::vector<double> &x, double &T, double &D, int &ierr, const char *&herr);
+void FlashDetail(const int pair, const double v1, const double v2, const Composition &x, double &T, double &D, int &ierr, const char *&herr);
+void FlashDetail(const int pair, const double v1, const double v2, const CompositionView &x, double &T, double &D, int &ierr, const char *&herr);
+void FlashBatchGERG(const int pair, const std::vector<double> &v1, const std::vector<double> &v2, const std::vector<double> &x, std::vector<double> &T, std::vector<double> &D, std::vector<int> &ierr);
+void FlashBatchGERG(const int pair, const std::vector<double> &v1, const std::vector<double> &v2, const Composition &x, std::vector<double> &T, std::vector<double> &D, std::vector<int> &ierr);
+void FlashBatchGERG(const int pair, const std::vector<double> &v1, const std::vector<double> &v2, const CompositionView &x, std::vector<double> &T, std::vector<double> &D, std::vector<int> &ierr);
+void FlashBatchDetail(const int pair, const std::vector<double> &v1, const std::vector<double> &v2, const std::vector<double> &x, std::vector<double> &T, std::vector<double> &D, std::vector<int> &ierr);
+void FlashBatchDetail(const int pair, const std::vector<double> &v1, const std::vector<double> &v2, const Composition &x, std::vector<double> &T, std::vector<double> &D, std::vector<int> &ierr);
+void FlashBatchDetail(const int pair, const std::vector<double> &v1, const std::vector<double> &v2, const CompositionView &x, std::vector<double> &T, std::vector<double> &D, std::vector<int> &ierr);
+int FlashIterations();
+
+#endif
@@ -0,0 +1,723 @@
+/**
+ * @file Float32.cpp
+ * @brief Single-precision batch mode of PressureGERG/PropertiesGERG and PressureDetail/PropertiesDetail
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "Float32.h"
+#include "Detail.h"
+#include "GERG2008.h"
+#include "Trace.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+static const int L = LanesFloat;
+static const double epsilon = 1e-15;
+
+// Reference temperature of the DETAIL terms: T^(-u) is split into Tref^(-u), folded into the
+// coefficients in double, and (Tref/T)^u, both within the float range for u <= 23
+static const double TrefFloatDetail = 300;
+
+/**
+ * @brief exp(x) in float without branches, so that the loops over the lanes vectorize
+ *
+ * Cody-Waite reduction to x = k*ln(2) + r and the polynomial of Cephes expf, relative error below
+ * 2e-7. x is clamped to [-87, 88]. The rounding of k relies on IEEE arithmetic (no -ffast-math).
+ */
+static inline float ExpFloat(float x)
+{
+    x = x < -87.0f ? -87.0f : (x > 88.0f ? 88.0f : x);
+    const float k = (x * 1.44269504f + 12582912.0f) - 12582912.0f;
+    const float r = x - k * 0.693359375f + k * 2.12194440e-4f;
+    const float y = (((((1.9875691500e-4f * r + 1.3981999507e-3f) * r + 8.3334519073e-3f) * r + 4.1665795894e-2f) * r
+                      + 1.6666665459e-1f) * r + 5.0000001201e-1f) * r * r + r + 1;
+    const std::int32_t bits = ((std::int32_t)k + 127) << 23;
+    float scale;
+    std::memcpy(&scale, &bits, sizeof(scale));
+    return y * scale;
+}
+
+/**
+ * @brief ln(x) in float without branches, for a positive normal x
+ *
+ * x = m*2^e with sqrt(1/2) <= m < sqrt(2), and ln(m) = 2*atanh((m - 1)/(m + 1)) from its series,
+ * relative error below 2e-7.
+ */
+static inline float LogFloat(const float x)
+{
+    std::int32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    std::int32_t e = (bits >> 23) - 127;
+    bits = (bits & 0x007fffff) | 0x3f800000;
+    float m;
+    std::memcpy(&m, &bits, sizeof(m));
+    const bool big = m > 1.41421356f;
+    m = big ? m * 0.5f : m;
+    e = big ? e + 1 : e;
+    const float s = (m - 1) / (m + 1), s2 = s * s;
+    return e * 0.693147181f + 2 * s * (1 + s2 * (0.333333343f + s2 * (0.2f + s2 * (0.142857149f + s2 * 0.111111112f))));
+}
+
+/**
+ * @brief GERG-2008 terms of the composition of the last batch, from PrepareFixedGasGERG
+ *
+ * The tau exponents are stored once in ttau, and the terms refer to them by index, so that tau^t is
+ * calculated once per distinct exponent. exp(g) of the departure terms is folded into agauss.
+ */
+struct TermsFloatGERG
+{
+    static const int MaxTerms = FixedGasTermsGERG::MaxTerms, MaxGauss = FixedGasTermsGERG::MaxGauss;
+    static const int MaxTau = 2 * MaxTerms + MaxGauss, MaxHyp = FixedGasTermsGERG::MaxHyp;
+    std::vector<double> x;
+    double R, Mm, Tr, Dr, Sumx, SumxLnx, n01, n02, n03;
+    int nhyp, sinhhyp[MaxHyp];
+    double ahyp[MaxHyp];
+    float thhyp[MaxHyp];
+    int ntau;
+    float ttau[MaxTau];
+    int npol, dpol[MaxTerms], ipol[MaxTerms];
+    float apol[MaxTerms];
+    int nexp, dexp[MaxTerms], cexp[MaxTerms], iexp[MaxTerms];
+    float aexp[MaxTerms];
+    int ngauss, dgauss[MaxGauss], igauss[MaxGauss];
+    float cgauss[MaxGauss], egauss[MaxGauss], agauss[MaxGauss];
+};
+
+/**
+ * @brief DETAIL terms of the composition of the last batch, from PrepareFixedGasDetail
+ *
+ * B and C include TrefFloatDetail^(-u), CoefT1 and CoefT2 are R*(u - 1) and R*(u - 1)*u.
+ */
+struct TermsFloatDetail
+{
+    static const int MaxHyp = FixedGasTermsDetail::MaxHyp;
+    std::vector<double> x;
+    double R, Mm, Sumx, SumxLnx, n01, n02, n03;
+    int nhyp, sinhhyp[MaxHyp];
+    double ahyp[MaxHyp];
+    float thhyp[MaxHyp];
+    float K3, u[58 + 1], B[18 + 1], C[58 + 1];
+    double CoefT1[58 + 1], CoefT2[58 + 1];
+    int b[58 + 1], k[58 + 1];
+};
+
+// Terms of the last batch composition, kept per thread like the caches of GERG2008.cpp and Detail.cpp so that
+// the batch functions may be called from several threads at once
+static thread_local TermsFloatGERG termsGERG;
+static thread_local TermsFloatDetail termsDetail;
+
+// Index of tau exponent t in ttau, added if new
+static int TauIndexFloatGERG(TermsFloatGERG &tf, const double t)
+{
+    for (int j = 0; j < tf.ntau; ++j)
+    {
+        if (tf.ttau[j] == (float)t) { return j; }
+    }
+    tf.ttau[tf.ntau] = (float)t;
+    return tf.ntau++;
+}
+
+// Fold the composition x into termsGERG, unless it is the composition of the previous batch
+static void PrepareTermsFloatGERG(const std::vector<double> &x)
+{
+    static thread_local FixedGasTermsGERG fg;
+    TermsFloatGERG &tf = termsGERG;
+    if (tf.x == x) { return; }
+    AGA8_TRACE_SCOPE("PrepareTermsFloatGERG");
+    PrepareFixedGasGERG(x, fg);
+    tf.x = x;
+    tf.R = fg.R;
+    tf.Mm = fg.Mm;
+    tf.Tr = fg.Tr;
+    tf.Dr = fg.Dr;
+    tf.Sumx = fg.Sumx;
+    tf.SumxLnx = fg.SumxLnx;
+    tf.n01 = fg.n01;
+    tf.n02 = fg.n02;
+    tf.n03 = fg.n03;
+    tf.nhyp = fg.nhyp;
+    for (int k = 0; k < fg.nhyp; ++k)
+    {
+        tf.sinhhyp[k] = fg.sinhhyp[k];
+        tf.ahyp[k] = fg.ahyp[k];
+        tf.thhyp[k] = (float)fg.thhyp[k];
+    }
+    tf.ntau = 0;
+    tf.npol = fg.npol;
+    for (int k = 0; k < fg.npol; ++k)
+    {
+        tf.dpol[k] = fg.dpol[k];
+        tf.ipol[k] = TauIndexFloatGERG(tf, fg.tpol[k]);
+        tf.apol[k] = (float)fg.apol[k];
+    }
+    tf.nexp = fg.nexp;
+    for (int k = 0; k < fg.nexp; ++k)
+    {
+        tf.dexp[k] = fg.dexp[k];
+        tf.cexp[k] = fg.cexp[k];
+        tf.iexp[k] = TauIndexFloatGERG(tf, fg.texp[k]);
+        tf.aexp[k] = (float)fg.aexp[k];
+    }
+    tf.ngauss = fg.ngauss;
+    for (int k = 0; k < fg.ngauss; ++k)
+    {
+        tf.dgauss[k] = fg.dgauss[k];
+        tf.igauss[k] = TauIndexFloatGERG(tf, fg.tgauss[k]);
+        tf.cgauss[k] = (float)fg.cgauss[k];
+        tf.egauss[k] = (float)fg.egauss[k];
+        tf.agauss[k] = (float)(fg.agauss[k] * std::exp(fg.ggauss[k]));
+    }
+}
+
+// Fold the composition x into termsDetail, unless it is the composition of the previous batch
+static void PrepareTermsFloatDetail(const std::vector<double> &x)
+{
+    static thread_local FixedGasTermsDetail fg;
+    TermsFloatDetail &tf = termsDetail;
+    if (tf.x == x) { return; }
+    AGA8_TRACE_SCOPE("PrepareTermsFloatDetail");
+    PrepareFixedGasDetail(x, fg);
+    tf.x = x;
+    tf.R = fg.R;
+    tf.Mm = fg.Mm;
+    tf.Sumx = fg.Sumx;
+    tf.SumxLnx = fg.SumxLnx;
+    tf.n01 = fg.n01;
+    tf.n02 = fg.n02;
+    tf.n03 = fg.n03;
+    tf.nhyp = fg.nhyp;
+    for (int k = 0; k < fg.nhyp; ++k)
+    {
+        tf.sinhhyp[k] = fg.sinhhyp[k];
+        tf.ahyp[k] = fg.ahyp[k];
+        tf.thhyp[k] = (float)fg.thhyp[k];
+    }
+    tf.K3 = (float)fg.K3;
+    for (int n = 1; n <= 58; ++n)
+    {
+        const double Tref = std::pow(TrefFloatDetail, -fg.u[n]);
+        tf.u[n] = (float)fg.u[n];
+        tf.CoefT1[n] = fg.R * (fg.u[n] - 1);
+        tf.CoefT2[n] = fg.R * (fg.u[n] - 1) * fg.u[n];
+        if (n <= 18) { tf.B[n] = (float)(fg.B[n] * Tref); }
+        tf.C[n] = n >= 13 ? (float)(fg.C[n] * Tref) : 0;
+        tf.b[n] = fg.b[n];
+        tf.k[n] = fg.k[n];
+    }
+}
+
+/**
+ * @brief Sums of the hyperbolic ideal gas terms of a batch composition at the lanes' temperatures
+ *
+ * With y = th0/T and e = exp(-2*y): ln(sinh(y)) = y + ln((1 - e)/2), y*coth(y) = y*(1 + e)/(1 - e)
+ * and y/sinh(y) = 2*y*exp(-y)/(1 - e), and the same with 1 + e for cosh, so that sinh and cosh
+ * themselves, which overflow float for y > 89, are not needed.
+ *
+ * @param[out] lnh Sum(a*ln(sinh(y))) - Sum(a*ln(cosh(y)))
+ * @param[out] yth Sum(a*y*coth(y)) - Sum(a*y*tanh(y))
+ * @param[out] ysh Sum(a*(y/sinh(y))^2) + Sum(a*(y/cosh(y))^2)
+ */
+template <class Terms>
+static void HyperbolicLanesFloat(const Terms &tf, const float T[], double lnh[], double yth[], double ysh[])
+{
+    for (int s = 0; s < L; ++s)
+    {
+        lnh[s] = 0;
+        yth[s] = 0;
+        ysh[s] = 0;
+    }
+    for (int k = 0; k < tf.nhyp; ++k)
+    {
+        const float th = tf.thhyp[k];
+        const double a = tf.ahyp[k];
+        const float sign = tf.sinhhyp[k] ? -1.0f : 1.0f;
+        const double asign = tf.sinhhyp[k] ? a : -a;
+        for (int s = 0; s < L; ++s)
+        {
+            const float y = th / T[s], em = ExpFloat(-y), e = em * em;
+            const float den = 1 + sign * e, num = 1 - sign * e, ys = 2 * y * em / den;
+            lnh[s] += asign * (y + LogFloat(den * 0.5f));
+            yth[s] += asign * (y * num / den);
+            ysh[s] += a * (ys * ys);
+        }
+    }
+}
+
+// Ideal gas Helmholtz energy and derivatives of GERG-2008 at the lanes, with the a0[] layout of Alpha0GERG
+static void Alpha0LanesFloatGERG(const TermsFloatGERG &tf, const float T[], const float D[], double a0[3][LanesFloat])
+{
+    double lnh[L], yth[L], ysh[L];
+    HyperbolicLanesFloat(tf, T, lnh, yth, ysh);
+    for (int s = 0; s < L; ++s)
+    {
+        const double LogD = LogFloat(D[s] > (float)epsilon ? D[s] : (float)epsilon), LogT = LogFloat(T[s]);
+        a0[0][s] = tf.SumxLnx + tf.Sumx * LogD + tf.n01 + tf.n02 / T[s] - tf.n03 * LogT + lnh[s];
+        a0[1][s] = tf.n03 + tf.n02 / T[s] + yth[s];
+        a0[2][s] = -(tf.n03 + ysh[s]);
+    }
+}
+
+// Ideal gas Helmholtz energy and derivatives of DETAIL at the lanes, with the a0[] layout of Alpha0Detail
+static void Alpha0LanesFloatDetail(const TermsFloatDetail &tf, const float T[], const float D[], double a0[3][LanesFloat])
+{
+    double lnh[L], yth[L], ysh[L];
+    HyperbolicLanesFloat(tf, T, lnh, yth, ysh);
+    for (int s = 0; s < L; ++s)
+    {
+        const double LogD = LogFloat(D[s] > (float)epsilon ? D[s] : (float)epsilon), LogT = LogFloat(T[s]);
+        const double x0 = tf.SumxLnx + tf.Sumx * LogD + tf.n01;
+        a0[0][s] = tf.R * T[s] * (x0 + tf.n02 / T[s] - tf.n03 * LogT + lnh[s]);
+        a0[1][s] = tf.R * (x0 - tf.n03 * (1 + LogT) + lnh[s] - yth[s]);
+        a0[2][s] = -tf.R * (tf.n03 + ysh[s]);
+    }
+}
+
+/**
+ * @brief Residual Helmholtz derivatives of GERG-2008 at the lanes, with the ar[][] layout of AlpharGERG
+ *
+ * Each term is calculated in float and added in double.
+ *
+ * @param itau Calculate the tau derivatives and ar[0][0], ar[0][3] if > 0
+ */
+static void AlpharLanesFloatGERG(const TermsFloatGERG &tf, const int itau, const float T[], const float D[], double ar[4][4][LanesFloat])
+{
+    static thread_local float taut[TermsFloatGERG::MaxTau][LanesFloat];
+    float del[L], lntau[L], delp[7 + 1][L], Expd[7 + 1][L];
+    const float Tr = (float)tf.Tr, Dr = (float)tf.Dr;
+
+    for (int i = 0; i <= 3; ++i)
+    {
+        for (int j = 0; j <= 3; ++j)
+        {
+            for (int s = 0; s < L; ++s) { ar[i][j][s] = 0; }
+        }
+    }
+    for (int s = 0; s < L; ++s)
+    {
+        del[s] = D[s] / Dr;
+        lntau[s] = LogFloat(Tr / T[s]);
+        delp[0][s] = 1;
+        Expd[0][s] = 1;
+    }
+    for (int i = 1; i <= 7; ++i)
+    {
+        for (int s = 0; s < L; ++s)
+        {
+            delp[i][s] = delp[i - 1][s] * del[s];
+            Expd[i][s] = ExpFloat(-delp[i][s]);
+        }
+    }
+    for (int j = 0; j < tf.ntau; ++j)
+    {
+        const float t = tf.ttau[j];
+        for (int s = 0; s < L; ++s) { taut[j][s] = ExpFloat(t * lntau[s]); }
+    }
+
+    for (int k = 0; k < tf.npol; ++k)
+    {
+        const int d = tf.dpol[k];
+        const float a = tf.apol[k], *tp = taut[tf.ipol[k]], *dp = delp[d];
+        const double t = tf.ttau[tf.ipol[k]];
+        for (int s = 0; s < L; ++s)
+        {
+            const double ndt = a * tp[s] * dp[s], ndtd = ndt * d, ndtt = ndt * t;
+            ar[0][1][s] += ndtd;
+            ar[0][2][s] += ndtd * (d - 1);
+            if (itau > 0)
+            {
+                ar[0][0][s] += ndt;
+                ar[1][0][s] += ndtt;
+                ar[2][0][s] += ndtt * (t - 1);
+                ar[1][1][s] += ndtt * d;
+                ar[1][2][s] += ndtt * d * (d - 1);
+                ar[0][3][s] += ndtd * (d - 1) * (d - 2);
+            }
+        }
+    }
+    for (int k = 0; k < tf.nexp; ++k)
+    {
+        const int d = tf.dexp[k], c = tf.cexp[k];
+        const float a = tf.aexp[k], *tp = taut[tf.iexp[k]], *dp = delp[d], *cp = delp[c], *ep = Expd[c];
+        const double t = tf.ttau[tf.iexp[k]];
+        for (int s = 0; s < L; ++s)
+        {
+            const float ex = c * cp[s], ex2 = d - ex, ex3 = ex2 * (ex2 - 1), e2 = ex3 - c * ex;
+            const double ndt = a * tp[s] * dp[s] * ep[s], ndtt = ndt * t;
+            ar[0][1][s] += ndt * ex2;
+            ar[0][2][s] += ndt * e2;
+            if (itau > 0)
+            {
+                ar[0][0][s] += ndt;
+                ar[1][0][s] += ndtt;
+                ar[2][0][s] += ndtt * (t - 1);
+                ar[1][1][s] += ndtt * ex2;
+                ar[1][2][s] += ndtt * e2;
+                ar[0][3][s] += ndt * (ex3 * (ex2 - 2) - ex * (3 * ex2 - 3 + c) * c);
+            }
+        }
+    }
+    for (int k = 0; k < tf.ngauss; ++k)
+    {
+        const int d = tf.dgauss[k];
+        const float a = tf.agauss[k], cg = tf.cgauss[k], eg = tf.egauss[k], *tp = taut[tf.igauss[k]], *dp = delp[d];
+        const double t = tf.ttau[tf.igauss[k]];
+        for (int s = 0; s < L; ++s)
+        {
+            const float cij0 = cg * delp[2][s], eij0 = eg * del[s], ex = d + 2 * cij0 + eij0, ex2 = ex * ex - d + 2 * cij0;
+            const double ndt = a * tp[s] * dp[s] * ExpFloat(cij0 + eij0), ndtt = ndt * t;
+            ar[0][1][s] += ndt * ex;
+            ar[0][2][s] += ndt * ex2;
+            if (itau > 0)
+            {
+                ar[0][0][s] += ndt;
+                ar[1][0][s] += ndtt;
+                ar[2][0][s] += ndtt * (t - 1);
+                ar[1][1][s] += ndtt * ex;
+                ar[1][2][s] += ndtt * ex2;
+                ar[0][3][s] += ndt * (ex * (ex2 - 2 * (d - 2 * cij0)) + 2 * d);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Residual Helmholtz derivatives of DETAIL at the lanes, with the ar[][] layout of AlpharDetail
+ *
+ * Same segments as AlpharTermsDetail, each term calculated in float and added in double.
+ *
+ * @param itau Calculate the temperature derivatives if > 0
+ */
+static void AlpharLanesFloatDetail(const TermsFloatDetail &tf, const int itau, const float T[], const float D[], double ar[4][4][LanesFloat])
+{
+    float lnT[L], Dred[L], Dknn[9 + 1][L], Expn[4 + 1][L], Tun[58 + 1][L];
+    double S0[L], S1[L], S2[L], S3[L], T10[L], T11[L], T20[L];
+    const float K3 = tf.K3;
+
+    for (int s = 0; s < L; ++s)
+    {
+        lnT[s] = LogFloat((float)TrefFloatDetail / T[s]);
+        Dred[s] = K3 * D[s];
+        Dknn[0][s] = 1;
+        Expn[0][s] = 1;
+        S0[s] = 0;
+        S2[s] = 0;
+        S3[s] = 0;
+        T10[s] = 0;
+        T20[s] = 0;
+    }
+    for (int n = 1; n <= 9; ++n)
+    {
+        for (int s = 0; s < L; ++s) { Dknn[n][s] = Dred[s] * Dknn[n - 1][s]; }
+    }
+    for (int n = 1; n <= 4; ++n)
+    {
+        for (int s = 0; s < L; ++s) { Expn[n][s] = ExpFloat(-Dknn[n][s]); }
+    }
+    for (int n = 1; n <= 58; ++n)
+    {
+        const float u = tf.u[n];
+        for (int s = 0; s < L; ++s) { Tun[n][s] = ExpFloat(u * lnT[s]); }
+    }
+
+    // Terms 1-12: second virial coefficient only (s0 = s1)
+    for (int n = 1; n <= 12; ++n)
+    {
+        const float B = tf.B[n];
+        const double c1 = tf.CoefT1[n], c2 = tf.CoefT2[n];
+        for (int s = 0; s < L; ++s)
+        {
+            const double sb = B * D[s] * Tun[n][s];
+            S0[s] += sb;
+            T10[s] += c1 * sb;
+            T20[s] += c2 * sb;
+        }
+    }
+    for (int s = 0; s < L; ++s)
+    {
+        S1[s] = S0[s];
+        T11[s] = T10[s];
+    }
+
+    // Terms 13-18: second virial part, with the third virial part already included in C
+    for (int n = 13; n <= 18; ++n)
+    {
+        const float B = tf.B[n], C = tf.C[n];
+        const double c1 = tf.CoefT1[n], c2 = tf.CoefT2[n];
+        for (int s = 0; s < L; ++s)
+        {
+            const double sb = (B * D[s] - C * Dred[s]) * Tun[n][s];
+            S0[s] += sb;
+            S1[s] += sb;
+            T10[s] += c1 * sb;
+            T11[s] += c1 * sb;
+            T20[s] += c2 * sb;
+        }
+    }
+
+    // Terms 13-58: density exponential part
+    for (int n = 13; n <= 58; ++n)
+    {
+        const int b = tf.b[n], k = tf.k[n];
+        const float C = tf.C[n], kf = (float)k, k2 = (float)(k * k), *tu = Tun[n], *db = Dknn[b], *dk = Dknn[k], *ek = Expn[k];
+        const double c1 = tf.CoefT1[n], c2 = tf.CoefT2[n];
+        for (int s = 0; s < L; ++s)
+        {
+            const float bkd = b - kf * dk[s], ckd = k2 * dk[s], cb2 = bkd * (bkd - 1) - ckd;
+            const float cb3 = (bkd - 2) * cb2 + ckd * (1 - kf - 2 * bkd);
+            const double s0 = C * tu[s] * db[s] * ek[s];
+            S0[s] += s0;
+            S1[s] += s0 * bkd;
+            S2[s] += s0 * cb2;
+            S3[s] += s0 * cb3;
+            T10[s] += c1 * s0;
+            T11[s] += c1 * s0 * bkd;
+            T20[s] += c2 * s0;
+        }
+    }
+
+    for (int s = 0; s < L; ++s)
+    {
+        const double RT = tf.R * T[s];
+        ar[0][0][s] = RT * S0[s];
+        ar[0][1][s] = RT * S1[s];
+        ar[0][2][s] = RT * S2[s];
+        ar[0][3][s] = RT * S3[s];
+        ar[1][0][s] = itau > 0 ? -T10[s] : 0;
+        ar[1][1][s] = itau > 0 ? -T11[s] : 0;
+        ar[2][0][s] = itau > 0 ? T20[s] : 0;
+    }
+}
+
+// Copy the states i to i + LanesFloat - 1 into the lanes, the lanes past the end repeating the last state
+static void LoadLanesFloat(const std::vector<float> &T, const std::vector<float> &D, const std::size_t i, const std::size_t n, float Tl[], float Dl[])
+{
+    for (int s = 0; s < L; ++s)
+    {
+        const std::size_t k = std::min(i + s, n - 1);
+        Tl[s] = T[k];
+        Dl[s] = D[k];
+    }
+}
+
+static void ResizePropertiesFloat(PropertiesFloat &p, const std::size_t n)
+{
+    for (std::vector<float> *v : {&p.P, &p.Z, &p.dPdD, &p.d2PdD2, &p.d2PdTD, &p.dPdT, &p.U, &p.H, &p.S, &p.Cv, &p.Cp,
+                                  &p.W, &p.G, &p.JT, &p.Kappa, &p.A, &p.Cf})
+    {
+        v->resize(n);
+    }
+}
+
+// Cp, d2PdD2, JT, W, Kappa and Cf of state k from the other properties, as in PropertiesGERG and PropertiesDetail
+static void DerivedPropertiesFloat(const double R, const double Mm, const double T, const double D, const double Z, const double dPdD, const double ar0123, const double dPdT, const double Cv, PropertiesFloat &p, const std::size_t k)
+{
+    double Cp, d2PdD2, JT, W, Kappa;
+    if (D > epsilon)
+    {
+        Cp = Cv + T * (dPdT / D) * (dPdT / D) / dPdD;
+        d2PdD2 = ar0123 / D;
+        JT = (T / D * dPdT / dPdD - 1) / Cp / D;
+    }
+    else
+    {
+        Cp = Cv + R;
+        d2PdD2 = 0;
+        JT = 1E+20;
+    }
+    W = 1000 * Cp / Cv * dPdD / Mm;
+    if (W < 0) { W = 0; }
+    W = std::sqrt(W);
+    Kappa = W * W * Mm / (R * T * 1000 * Z);
+    p.Cp[k] = (float)Cp;
+    p.d2PdD2[k] = (float)d2PdD2;
+    p.JT[k] = (float)JT;
+    p.W[k] = (float)W;
+    p.Kappa[k] = (float)Kappa;
+    p.Cf[k] = (float)std::sqrt(Kappa * std::pow(2 / (Kappa + 1), (Kappa + 1) / (Kappa - 1)));
+}
+
+/**
+ * @brief PressureGERG of many states of one composition, in single precision
+ *
+ * @param T Temperatures (K)
+ * @param D Densities (mol/l)
+ * @param x Composition (mole fraction)
+ * @param[out] P Pressures (kPa)
+ * @param[out] Z Compressibility factors
+ * @see Float32.h for the method, PressureGERG
+ */
+void PressureBatchFloatGERG(const std::vector<float> &T, const std::vector<float> &D, const std::vector<double> &x, std::vector<float> &P, std::vector<float> &Z)
+{
+    AGA8_TRACE_SCOPE("PressureBatchFloatGERG");
+    const std::size_t n = std::min(T.size(), D.size());
+    float Tl[L], Dl[L];
+    double ar[4][4][L];
+    P.resize(n);
+    Z.resize(n);
+    if (n == 0) { return; }
+    PrepareTermsFloatGERG(x);
+    const TermsFloatGERG &tf = termsGERG;
+    for (std::size_t i = 0; i < n; i += L)
+    {
+        LoadLanesFloat(T, D, i, n, Tl, Dl);
+        AlpharLanesFloatGERG(tf, 0, Tl, Dl, ar);
+        for (std::size_t s = 0; s < (std::size_t)L && i + s < n; ++s)
+        {
+            const double Zs = 1 + ar[0][1][s];
+            Z[i + s] = (float)Zs;
+            P[i + s] = (float)(Dl[s] * tf.R * Tl[s] * Zs);
+        }
+    }
+}
+
+/**
+ * @brief PropertiesGERG of many states of one composition, in single precision
+ *
+ * @param T Temperatures (K)
+ * @param D Densities (mol/l)
+ * @param x Composition (mole fraction)
+ * @param[out] props Properties of the states, see PropertiesGERG for the units
+ * @see Float32.h for the method, PropertiesGERG
+ */
+void PropertiesBatchFloatGERG(const std::vector<float> &T, const std::vector<float> &D, const std::vector<double> &x, PropertiesFloat &props)
+{
+    AGA8_TRACE_SCOPE("PropertiesBatchFloatGERG");
+    const std::size_t n = std::min(T.size(), D.size());
+    float Tl[L], Dl[L];
+    double a0[3][L], ar[4][4][L];
+    ResizePropertiesFloat(props, n);
+    if (n == 0) { return; }
+    PrepareTermsFloatGERG(x);
+    const TermsFloatGERG &tf = termsGERG;
+    const double R = tf.R;
+    for (std::size_t i = 0; i < n; i += L)
+    {
+        LoadLanesFloat(T, D, i, n, Tl, Dl);
+        Alpha0LanesFloatGERG(tf, Tl, Dl, a0);
+        AlpharLanesFloatGERG(tf, 1, Tl, Dl, ar);
+        for (std::size_t s = 0; s < (std::size_t)L && i + s < n; ++s)
+        {
+            const std::size_t k = i + s;
+            const double Ts = Tl[s], Ds = Dl[s], RT = R * Ts;
+            const double ar01 = ar[0][1][s], ar02 = ar[0][2][s], ar11 = ar[1][1][s];
+            const double Zs = 1 + ar01, dPdD = RT * (1 + 2 * ar01 + ar02), dPdT = Ds * R * (1 + ar01 - ar11);
+            const double Cv = -R * (a0[2][s] + ar[2][0][s]);
+            props.Z[k] = (float)Zs;
+            props.P[k] = (float)(Ds * RT * Zs);
+            props.dPdD[k] = (float)dPdD;
+            props.dPdT[k] = (float)dPdT;
+            props.d2PdTD[k] = (float)(R * (1 + 2 * ar01 + ar02 - 2 * ar11 - ar[1][2][s]));
+            props.A[k] = (float)(RT * (a0[0][s] + ar[0][0][s]));
+            props.G[k] = (float)(RT * (1 + ar01 + a0[0][s] + ar[0][0][s]));
+            props.U[k] = (float)(RT * (a0[1][s] + ar[1][0][s]));
+            props.H[k] = (float)(RT * (1 + ar01 + a0[1][s] + ar[1][0][s]));
+            props.S[k] = (float)(R * (a0[1][s] + ar[1][0][s] - a0[0][s] - ar[0][0][s]));
+            props.Cv[k] = (float)Cv;
+            DerivedPropertiesFloat(R, tf.Mm, Ts, Ds, Zs, dPdD, RT * (2 * ar01 + 4 * ar02 + ar[0][3][s]), dPdT, Cv, props, k);
+        }
+    }
+}
+
+/**
+ * @brief PressureDetail of many states of one composition, in single precision
+ *
+ * @param T Temperatures (K)
+ * @param D Densities (mol/l)
+ * @param x Composition (mole fraction)
+ * @param[out] P Pressures (kPa)
+ * @param[out] Z Compressibility factors
+ * @see Float32.h for the method, PressureDetail
+ */
+void PressureBatchFloatDetail(const std::vector<float> &T, const std::vector<float> &D, const std::vector<double> &x, std::vector<float> &P, std::vector<float> &Z)
+{
+    AGA8_TRACE_SCOPE("PressureBatchFloatDetail");
+    const std::size_t n = std::min(T.size(), D.size());
+    float Tl[L], Dl[L];
+    double ar[4][4][L];
+    P.resize(n);
+    Z.resize(n);
+    if (n == 0) { return; }
+    PrepareTermsFloatDetail(x);
+    const TermsFloatDetail &tf = termsDetail;
+    for (std::size_t i = 0; i < n; i += L)
+    {
+        LoadLanesFloat(T, D, i, n, Tl, Dl);
+        AlpharLanesFloatDetail(tf, 0, Tl, Dl, ar);
+        for (std::size_t s = 0; s < (std::size_t)L && i + s < n; ++s)
+        {
+            const double RT = tf.R * Tl[s], Zs = 1 + ar[0][1][s] / RT;
+            Z[i + s] = (float)Zs;
+            P[i + s] = (float)(Dl[s] * RT * Zs);
+        }
+    }
+}
+
+/**
+ * @brief PropertiesDetail of many states of one composition, in single precision
+ *
+ * @param T Temperatures (K)
+ * @param D Densities (mol/l)
+ * @param x Composition (mole fraction)
+ * @param[out] props Properties of the states, see PropertiesDetail for the units
+ * @see Float32.h for the method, PropertiesDetail
+ */
+void PropertiesBatchFloatDetail(const std::vector<float> &T, const std::vector<float> &D, const std::vector<double> &x, PropertiesFloat &props)
+{
+    AGA8_TRACE_SCOPE("PropertiesBatchFloatDetail");
+    const std::size_t n = std::min(T.size(), D.size());
+    float Tl[L], Dl[L];
+    double a0[3][L], ar[4][4][L];
+    ResizePropertiesFloat(props, n);
+    if (n == 0) { return; }
+    PrepareTermsFloatDetail(x);
+    const TermsFloatDetail &tf = termsDetail;
+    const double R = tf.R;
+    for (std::size_t i = 0; i < n; i += L)
+    {
+        LoadLanesFloat(T, D, i, n, Tl, Dl);
+        Alpha0LanesFloatDetail(tf, Tl, Dl, a0);
+        AlpharLanesFloatDetail(tf, 1, Tl, Dl, ar);
+        for (std::size_t s = 0; s < (std::size_t)L && i + s < n; ++s)
+        {
+            const std::size_t k = i + s;
+            const double Ts = Tl[s], Ds = Dl[s], RT = R * Ts;
+            const double Zs = 1 + ar[0][1][s] / RT, Ps = Ds * RT * Zs;
+            const double dPdD = RT + 2 * ar[0][1][s] + ar[0][2][s], dPdT = Ds * R + Ds * ar[1][1][s];
+            const double A = a0[0][s] + ar[0][0][s], S = -a0[1][s] - ar[1][0][s], U = A + Ts * S;
+            const double PD = Ds > epsilon ? Ps / Ds : RT;
+            const double Cv = -(a0[2][s] + ar[2][0][s]);
+            props.Z[k] = (float)Zs;
+            props.P[k] = (float)Ps;
+            props.dPdD[k] = (float)dPdD;
+            props.dPdT[k] = (float)dPdT;
+            props.d2PdTD[k] = 0;
+            props.A[k] = (float)A;
+            props.S[k] = (float)S;
+            props.U[k] = (float)U;
+            props.H[k] = (float)(U + PD);
+            props.G[k] = (float)(A + PD);
+            props.Cv[k] = (float)Cv;
+            DerivedPropertiesFloat(R, tf.Mm, Ts, Ds, Zs, dPdD, 2 * ar[0][1][s] + 4 * ar[0][2][s] + ar[0][3][s], dPdT, Cv, props, k);
+        }
+    }
+}
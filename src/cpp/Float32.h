@@ -0,0 +1,59 @@
+/**
+ * @file Float32.h
+ * @brief Single-precision batch mode of PressureGERG/PropertiesGERG and PressureDetail/PropertiesDetail
+ *
+ * The states of a batch share one composition, whose terms are folded into the coefficients once
+ * (PrepareFixedGasGERG, PrepareFixedGasDetail). The states are then evaluated LanesFloat at a time,
+ * one term for all the lanes in each inner loop, so that the compiler maps the lanes to SIMD
+ * registers: 4 floats per 128-bit register (SSE, WebAssembly SIMD) instead of 2 doubles. The terms
+ * are calculated in float with branch-free exp and log; the sums of the terms, which cancel each
+ * other at high density, and the properties derived from them are accumulated in double. Inputs and
+ * outputs are float arrays, half the memory of the double batch functions.
+ *
+ * The error against the double functions is measured over the NIST composition corpus by
+ * aga8-float32-report (src/tools/float32report.cpp).
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef AGA8FLOAT32_H_
+#define AGA8FLOAT32_H_
+
+#include <vector>
+
+// Number of states evaluated together, a multiple of the SIMD width of float (4 for SSE and WebAssembly SIMD, 8 for AVX)
+const int LanesFloat = 16;
+
+/**
+ * @brief Outputs of PropertiesBatchFloatGERG and PropertiesBatchFloatDetail, one column per property of PropertiesGERG
+ *
+ * Units are those of PropertiesGERG. As in PropertiesDetail, d2PdTD is 0 for DETAIL; A is
+ * calculated for both equations.
+ */
+struct PropertiesFloat
+{
+    std::vector<float> P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf;
+};
+
+void PressureBatchFloatGERG(const std::vector<float> &T, const std::vector<float> &D, const std::vector<double> &x, std::vector<float> &P, std::vector<float> &Z);
+void PropertiesBatchFloatGERG(const std::vector<float> &T, const std::vector<float> &D, const std::vector<double> &x, PropertiesFloat &props);
+void PressureBatchFloatDetail(const std::vector<float> &T, const std::vector<float> &D, const std::vector<double> &x, std::vector<float> &P, std::vector<float> &Z);
+void PropertiesBatchFloatDetail(const std::vector<float> &T, const std::vector<float> &D, const std::vector<double> &x, PropertiesFloat &props);
+
+#endif
@@ -44,6 +44,10 @@
  * - PressureGERG() - Calculate pressure and compressibility factor
  * - DensityGERG() - Calculate density iteratively 
  * - PropertiesGERG() - Calculate thermodynamic properties
+ * - PrepareIsothermGERG(), PressureIsothermGERG() - Pressure along an isotherm from pre-multiplied terms
+ * - CompositionDerivativesGERG() - Derivatives of Z, D and W with respect to the mole fractions
+ * - CompositionDerivativesBatchGERG() - Same at many (T, P) states
+ * - PressureGERG<S>(), PropertiesGERG<S>() - Scalar templates without caches, e.g. for dual numbers (see Scalar.h)
  * - SetupGERG() - Initialize constants and parameters
  *
  * @authors Eric W. Lemmon (NIST), Ian H. Bell (NIST), Volker Heinemann (RMG), 
@@ -71,10 +75,13 @@ PERSONS OR PROPERTY OR OTHERWISE, AND WHETHER OR NOT LOSS WAS SUSTAINED FROM, OR
 OR USE OF, THE SOFTWARE OR SERVICES PROVIDED HEREUNDER.
 */
 #include "GERG2008.h"
+#include "Scalar.h"
+#include "Trace.h"
 // We add both math headers to placate some non-standards-compliant compilers
 #include <math.h>
 #include <cmath>
 #include <iostream>
+#include <algorithm>
 
 // Version 2.01 of routines for the calculation of thermodynamic
 // properties from the AGA 8 Part 2 GERG-2008 equation of state.
@@ -120,6 +127,9 @@ OR USE OF, THE SOFTWARE OR SERVICES PROVIDED HEREUNDER.
 // Sub PressureGERG(T, D, x, P, Z)
 // Sub DensityGERG(iFlag, T, P, x, D, ierr, herr)
 // Sub PropertiesGERG(T, D, x, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa)
+// Sub CompositionDerivativesGERG(T, D, x, P, Z, W, dZdx, dDdx, dWdx)
+// Sub CompositionDerivativesBatchGERG(T, P, x, D, Z, W, dZdx, dDdx, dWdx, ierr)
+// PressureGERG and PropertiesGERG are also templates on the scalar type of T, D and x (float, double, Dual<N>)
 // Sub SetupGERG()
 
 // The compositions in the x() array use the following order and must be sent as mole fractions:
@@ -150,17 +160,28 @@ OR USE OF, THE SOFTWARE OR SERVICES PROVIDED HEREUNDER.
 // x(1)=0.94, x(3)=0.05, x(20)=0.01
 
 // Function prototypes (not exported)
-static void Alpha0GERG(const double T, const double D, const std::vector<double> &x, double a0[3]);
-static void AlpharGERG(const int itau, const int idelta, const double T, const double D, const std::vector<double> &x, double ar[4][4]);
-static void PseudoCriticalPointGERG(const std::vector<double> &x, double &Tcx, double &Dcx);
-static void tTermsGERG(const double lntau, const std::vector<double> &x);
+template <typename X> static void ReducingParametersGERG(const X &x, double &Tr, double &Dr);
+template <typename V, typename X> static void ReducingValuesGERG(const X &x, V &Tr, V &Dr);
+template <typename X> static void Alpha0GERG(const double T, const double D, const X &x, double a0[3]);
+template <typename X> static void AlpharGERG(const int itau, const int idelta, const double T, const double D, const X &x, double ar[4][4]);
+template <typename X> static void PseudoCriticalPointGERGImpl(const X &x, double &Tcx, double &Dcx);
+template <typename X> static void tTermsGERG(const double lntau, const X &x);
+template <typename X, typename V> static void MolarMassGERGImpl(const X &x, V &Mm);
+template <typename X> static void PressureGERGImpl(const double T, const double D, const X &x, double &P, double &Z);
+template <typename X> static void DensityGERGImpl(const int iFlag, const double T, const double P, const X &x, double &D, int &ierr, const char *&herr);
+template <typename X> static void PropertiesGERGImpl(const double T, const double D, const X &x, double &P, double &Z, double &dPdD, double &d2PdD2, double &d2PdTD, double &dPdT, double &U, double &H, double &S, double &Cv, double &Cp, double &W, double &G, double &JT, double &Kappa, double &A, double &Cf);
+template <typename X> static void PrepareIsothermGERGImpl(const double T, const X &x, PreparedIsothermGERG &iso);
+template <typename X, typename Y> static void CompositionDerivativesGERGImpl(const double T, const double D, const X &x, double &P, double &Z, double &W, Y &dZdx, Y &dDdx, Y &dWdx);
+template <typename X> static void CompositionDerivativesBatchGERGImpl(const std::vector<double> &T, const std::vector<double> &P, const X &x, std::vector<double> &D, std::vector<double> &Z, std::vector<double> &W, std::vector<double> &dZdx, std::vector<double> &dDdx, std::vector<double> &dWdx, std::vector<int> &ierr);
+template <typename V> static void IdealTermsGERG(const V &T, const int i, V &c0, V &c1, V &c2);
+template <typename V> static void Alpha0ScalarGERG(const V &T, const V &D, const std::vector<V> &x, V a0[3]);
+template <typename V> static void AlpharScalarGERG(const int itau, const V &T, const V &D, const std::vector<V> &x, V ar[4][4]);
 
 // Variables containing the common parameters in the GERG-2008 equations
 static double RGERG;
 static const int NcGERG = 21, MaxFlds = 21, MaxMdl = 10, MaxTrmM = 12, MaxTrmP = 24;
 static const double epsilon = 1e-15;
 static int coik[MaxFlds+1][MaxTrmP+1], doik[MaxFlds+1][MaxTrmP+1], dijk[MaxMdl+1][MaxTrmM+1];
-static double Drold, Trold, Told, Trold2, xold[MaxFlds+1];
 static int mNumb[MaxFlds+1][MaxFlds+1], kpol[MaxFlds+1], kexp[MaxFlds+1], kpolij[MaxMdl+1], kexpij[MaxMdl+1];
 static double Dc[MaxFlds+1], Tc[MaxFlds+1], MMiGERG[MaxFlds+1], Vc3[MaxFlds+1], Tc2[MaxFlds+1];
 static double noik[MaxFlds+1][MaxTrmP+1], toik[MaxFlds+1][MaxTrmP+1];
@@ -168,13 +189,52 @@ static double cijk[MaxMdl+1][MaxTrmM+1];
 static double eijk[MaxMdl+1][MaxTrmM+1], gijk[MaxMdl+1][MaxTrmM+1], nijk[MaxMdl+1][MaxTrmM+1], tijk[MaxMdl+1][MaxTrmM+1];
 static double btij[MaxFlds+1][MaxFlds+1], bvij[MaxFlds+1][MaxFlds+1], gtij[MaxFlds+1][MaxFlds+1], gvij[MaxFlds+1][MaxFlds+1];
 static double fij[MaxFlds+1][MaxFlds+1], th0i[MaxFlds+1][7+1], n0i[MaxFlds+1][7+1];
-static double taup[MaxFlds+1][MaxTrmP+1], taupijk[MaxFlds+1][MaxTrmM+1];
-static double dPdDsave; //Calculated in the PressureGERG subroutine, but not included as an argument since it is only used internally in the density algorithm.
 
+// The variables below are the caches and results of the last calls, kept per thread: once SetupGERG has filled the
+// constants above, the functions of this module may be called from several threads at once
+static thread_local double Drold, Trold, Told, Trold2, xold[MaxFlds+1];
+static thread_local double taup[MaxFlds+1][MaxTrmP+1], taupijk[MaxFlds+1][MaxTrmM+1];
+// Components using the 12-term short form (same doik, coik and toik as propane) collapse into one pseudo-component
+// with coefficients noagg[k] = Sum(x[i]*noik[i][k]), updated in ReducingParametersGERG
+static thread_local double noagg[MaxTrmP+1], taupagg[MaxTrmP+1];
+static thread_local int nShortGERG;
+// Component number when x is a pure fluid (a single non-zero mole fraction), 0 for a mixture; set by ReducingParametersGERG
+// on every call. The pure fluid kernels then skip the mixing sums and the binary departure terms.
+static thread_local int iPureGERG;
+// Ideal gas terms of each component at the last NTSlots temperatures (see IdealSlotGERG), and Sum(x*ln(x)) of the current composition
+static const int NTSlots = 4;
+static thread_local double a0Told[NTSlots], a0T[NTSlots][3][MaxFlds+1], SumxLnx;
+static thread_local bool a0Tset[NTSlots][MaxFlds+1];
+static thread_local int a0Tnext;
+static thread_local double dPdDsave; //Calculated in the PressureGERG subroutine, but not included as an argument since it is only used internally in the density algorithm.
+static thread_local int nIterGERG;     // Iterations of the last DensityGERG call, see DensityIterationsGERG
+
+// Forget the composition and temperature of the last call, so that the next one recalculates the reducing parameters,
+// the composition terms and the temperature terms whatever its x and T
+static void InvalidateCacheGERG()
+{
+  for (int i = 1; i <= MaxFlds; ++i){
+    xold[i] = 0;
+  }
+  Told = 0;
+  Trold2 = 0;
+}
+
+inline bool IsShortFormGERG(int i){ return i > 4 && i != 15 && i != 18 && i != 20; }
 inline double Tanh(double xx){ return (exp(xx) - exp(-xx)) / (exp(xx) + exp(-xx)); }
 inline double Sinh(double xx){ return (exp(xx) - exp(-xx)) / 2; }
 inline double Cosh(double xx){ return (exp(xx) + exp(-xx)) / 2; }
 
+// MolarMassGERG for any composition type with x[i], i = 1 to NcGERG (std::vector, Composition, CompositionView)
+template <typename X, typename V>
+static void MolarMassGERGImpl(const X &x, V &Mm)
+{
+    Mm = 0;
+    for (int i = 1; i <= NcGERG; ++i){
+        Mm += x[i] * MMiGERG[i];
+    }
+}
+
 /**
  * @brief Calculate molar mass of a gas mixture
  * 
@@ -190,10 +250,37 @@ inline double Cosh(double xx){ return (exp(xx) + exp(-xx)) / 2; }
  */
 void MolarMassGERG(const std::vector<double> &x, double &Mm)
 {
-    Mm = 0;
-    for (int i = 1; i <= NcGERG; ++i){
-        Mm += x[i] * MMiGERG[i];
-    }
+    MolarMassGERGImpl(x, Mm);
+}
+
+/**
+ * @brief MolarMassGERG for a fixed-size Composition
+ * @see MolarMassGERG
+ */
+void MolarMassGERG(const Composition &x, double &Mm)
+{
+    MolarMassGERGImpl(x, Mm);
+}
+
+/**
+ * @brief MolarMassGERG for a CompositionView, e.g. a row of a composition matrix
+ * @see MolarMassGERG
+ */
+void MolarMassGERG(const CompositionView &x, double &Mm)
+{
+    MolarMassGERGImpl(x, Mm);
+}
+
+// PressureGERG for any composition type with x[i], i = 1 to NcGERG (std::vector, Composition, CompositionView)
+template <typename X>
+static void PressureGERGImpl(const double T, const double D, const X &x, double &P, double &Z)
+{
+    double ar[4][4];
+    AlpharGERG(0, 0, T, D,x,ar);
+
+    Z = 1 + ar[0][1];
+    P = D * RGERG * T * Z;
+    dPdDsave = RGERG * T * (1 + 2 * ar[0][1] + ar[0][2]);
 }
 
 /**
@@ -215,36 +302,30 @@ void MolarMassGERG(const std::vector<double> &x, double &Mm)
  */
 void PressureGERG(const double T, const double D, const std::vector<double> &x, double &P, double &Z)
 {
-    double ar[4][4];
-    AlpharGERG(0, 0, T, D,x,ar);
+    PressureGERGImpl(T, D, x, P, Z);
+}
 
-    Z = 1 + ar[0][1];
-    P = D * RGERG * T * Z;
-    dPdDsave = RGERG * T * (1 + 2 * ar[0][1] + ar[0][2]);
+/**
+ * @brief PressureGERG for a fixed-size Composition
+ * @see PressureGERG
+ */
+void PressureGERG(const double T, const double D, const Composition &x, double &P, double &Z)
+{
+    PressureGERGImpl(T, D, x, P, Z);
 }
 
 /**
- * @brief Calculate density from temperature and pressure
- * 
- * Iterative routine that calls PressureGERG to find the correct state point.
- * Generally only 6 iterations at most are required.
- * If iteration fails to converge, returns ideal gas density and error message.
- * No phase boundary checks - user must identify phase of T,P inputs.
- * For 2-phase states, output density represents metastable state.
- *
- * @param iFlag Solution mode:
- *        - 0: Strict pressure solver (gas phase, no checks, fastest)
- *        - 1: Check possible 2-phase states
- *        - 2: Search liquid phase (with 2-phase checks)
- * @param T Temperature (K)
- * @param P Pressure (kPa)
- * @param x Composition array (mole fraction)
- * @param[out] D Density (mol/l). Can provide initial guess as negative value
- * @param[out] ierr Error code
- * @param[out] herr Error message
- * @see DensityGERG_wrapper for the Emscripten wrapped version of this function
+ * @brief PressureGERG for a CompositionView, e.g. a row of a composition matrix
+ * @see PressureGERG
  */
-void DensityGERG(const int iFlag, const double T, const double P, const std::vector<double> &x, double &D, int &ierr, std::string &herr)
+void PressureGERG(const double T, const double D, const CompositionView &x, double &P, double &Z)
+{
+    PressureGERGImpl(T, D, x, P, Z);
+}
+
+// DensityGERG for any composition type with x[i], i = 1 to NcGERG (std::vector, Composition, CompositionView)
+template <typename X>
+static void DensityGERGImpl(const int iFlag, const double T, const double P, const X &x, double &D, int &ierr, const char *&herr)
 {
     int nFail, iFail;
     double plog, vlog, P2, Z, dpdlv, vdiff, tolr, vinc;
@@ -257,9 +338,14 @@ void DensityGERG(const int iFlag, const double T, const double P, const std::vec
     herr = "";
     nFail = 0;
     iFail = 0;
+    nIterGERG = 0;
     if (P < epsilon) { D = 0; return; }
     tolr = 0.0000001;
-    PseudoCriticalPointGERG(x, Tcx, Dcx);
+
+    // The temperature and composition are fixed during the iterations, so evaluate the pressure from the prepared isotherm
+    static thread_local PreparedIsothermGERG iso;
+    PrepareIsothermGERGImpl(T, x, iso);
+    PseudoCriticalPointGERGImpl(x, Tcx, Dcx);
 
     if (D > -epsilon){
         D = P / RGERG / T;                // Ideal gas estimate for vapor phase
@@ -272,6 +358,8 @@ void DensityGERG(const int iFlag, const double T, const double P, const std::vec
     plog = log(P);
     vlog = -log(D);
     for (int it = 1; it <= 50; ++it){
+        AGA8_TRACE_SCOPE_ARG("DensityGERG iteration", it);
+        nIterGERG = it;
         if (vlog < -7 || vlog > 100 || it == 20 || it == 30 || it == 40 || iFail == 1){
             //Current state is bad or iteration is taking too long.  Restart with completely different initial state
             iFail = 0;
@@ -294,7 +382,7 @@ void DensityGERG(const int iFlag, const double T, const double P, const std::vec
             vlog = -log(D);
         }
         D = exp(-vlog);
-        PressureGERG(T, D, x, P2, Z);
+        PressureIsothermGERG(iso, D, P2, Z, dPdDsave);
         if (dPdDsave < epsilon || P2 < epsilon){
             // Current state is 2-phase, try locating a different state that is single phase
             vinc = 0.1;
@@ -320,7 +408,7 @@ void DensityGERG(const int iFlag, const double T, const double P, const std::vec
 
                     // If requested, check to see if point is possibly 2-phase
                     if (iFlag > 0){
-                        PropertiesGERG(T, D, x, PP, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf);
+                        PropertiesGERGImpl(T, D, x, PP, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf);
                         if ((PP <= 0 || dPdD <= 0 || d2PdTD <= 0) || (Cv <= 0 || Cp <= 0 || W <= 0)) {
                             // Iteration failed (above loop did find a solution or checks made below indicate possible 2-phase state)
                             ierr = 1;
@@ -341,78 +429,818 @@ void DensityGERG(const int iFlag, const double T, const double P, const std::vec
 }
 
 /**
- * @brief Calculate thermodynamic properties as a function of temperature and density
- * 
- * Calls are made to the subroutines ReducingParametersGERG, IdealGERG, and ResidualGERG.
- * If the density is not known, call subroutine DENSITY first with the known values of pressure and temperature.
- * 
- * @param T Temperature (K)
- * @param D Density (mol/l)
- * @param x Composition (mole fraction)
- * @param[out] P Pressure (kPa)
- * @param[out] Z Compressibility factor
- * @param[out] dPdD First derivative of pressure with respect to density at constant temperature [kPa/(mol/l)]
- * @param[out] d2PdD2 Second derivative of pressure with respect to density at constant temperature [kPa/(mol/l)^2]
- * @param[out] d2PdTD Second derivative of pressure with respect to temperature and density [kPa/(mol/l)/K]
- * @param[out] dPdT First derivative of pressure with respect to temperature at constant density (kPa/K)
- * @param[out] U Internal energy (J/mol)
- * @param[out] H Enthalpy (J/mol)
- * @param[out] S Entropy [J/(mol-K)]
- * @param[out] Cv Isochoric heat capacity [J/(mol-K)]
- * @param[out] Cp Isobaric heat capacity [J/(mol-K)]
- * @param[out] W Speed of sound (m/s)
- * @param[out] G Gibbs energy (J/mol)
- * @param[out] JT Joule-Thomson coefficient (K/kPa)
- * @param[out] Kappa Isentropic Exponent
- * @param[out] A Helmholtz energy (J/mol)
- * @param[out] Cf Critical Flow Factor (dimensionless)
- * @see PropertiesGERG_wrapper for the Emscripten wrapped version of this function
+ * @brief Calculate density from temperature and pressure
+ * 
+ * Iterative routine that calls PressureGERG to find the correct state point.
+ * Generally only 6 iterations at most are required.
+ * If iteration fails to converge, returns ideal gas density and error message.
+ * No phase boundary checks - user must identify phase of T,P inputs.
+ * For 2-phase states, output density represents metastable state.
+ *
+ * @param iFlag Solution mode:
+ *        - 0: Strict pressure solver (gas phase, no checks, fastest)
+ *        - 1: Check possible 2-phase states
+ *        - 2: Search liquid phase (with 2-phase checks)
+ * @param T Temperature (K)
+ * @param P Pressure (kPa)
+ * @param x Composition array (mole fraction)
+ * @param[out] D Density (mol/l). Can provide initial guess as negative value
+ * @param[out] ierr Error code
+ * @param[out] herr Error message
+ * @see DensityGERG_wrapper for the Emscripten wrapped version of this function
+ */
+void DensityGERG(const int iFlag, const double T, const double P, const std::vector<double> &x, double &D, int &ierr, const char *&herr)
+{
+    DensityGERGImpl(iFlag, T, P, x, D, ierr, herr);
+}
+
+/**
+ * @brief DensityGERG for a fixed-size Composition
+ * @see DensityGERG
+ */
+void DensityGERG(const int iFlag, const double T, const double P, const Composition &x, double &D, int &ierr, const char *&herr)
+{
+    DensityGERGImpl(iFlag, T, P, x, D, ierr, herr);
+}
+
+/**
+ * @brief DensityGERG for a CompositionView, e.g. a row of a composition matrix
+ * @see DensityGERG
+ */
+void DensityGERG(const int iFlag, const double T, const double P, const CompositionView &x, double &D, int &ierr, const char *&herr)
+{
+    DensityGERGImpl(iFlag, T, P, x, D, ierr, herr);
+}
+
+/**
+ * @brief Number of iterations of the last DensityGERG call
+ *
+ * 0 when the pressure is zero, the maximum number of iterations when the calculation failed to converge.
+ * Used to measure the effect of an initial density estimate (negative D input).
+ */
+int DensityIterationsGERG()
+{
+    return nIterGERG;
+}
+
+/**
+ * @brief DensityGERG with the error message returned as a std::string
+ * @see DensityGERG
+ */
+void DensityGERG(const int iFlag, const double T, const double P, const std::vector<double> &x, double &D, int &ierr, std::string &herr)
+{
+    const char *msg = "";
+    DensityGERG(iFlag, T, P, x, D, ierr, msg);
+    herr = msg;
+}
+
+// Properties from the ideal gas and residual Helmholtz derivatives of Alpha0GERG and AlpharGERG, for any scalar type
+template <typename V>
+static void PropertiesFromAlphaGERG(const V &T, const V &D, const V &Mm, const V a0[3], const V ar[4][4], V &P, V &Z, V &dPdD, V &d2PdD2, V &d2PdTD, V &dPdT, V &U, V &H, V &S, V &Cv, V &Cp, V &W, V &G, V &JT, V &Kappa, V &A, V &Cf)
+{
+    double R;
+    V RT;
+
+    R = RGERG;
+    RT = R * T;
+    Z = 1 + ar[0][1];
+    P = D * RT * Z;
+    dPdD = RT * (1 + 2 * ar[0][1] + ar[0][2]);
+    dPdT = D * R * (1 + ar[0][1] - ar[1][1]);
+    d2PdTD = R * (1 + 2 * ar[0][1] + ar[0][2] - 2 * ar[1][1] - ar[1][2]);
+    A = RT * (a0[0] + ar[0][0]);
+    G = RT * (1 + ar[0][1] + a0[0] + ar[0][0]);
+    U = RT * (a0[1] + ar[1][0]);
+    H = RT * (1 + ar[0][1] + a0[1] + ar[1][0]);
+    S = R * (a0[1] + ar[1][0] - a0[0] - ar[0][0]);
+    Cv = -R * (a0[2] + ar[2][0]);
+    if (D > epsilon){
+        Cp = Cv + T * (dPdT / D) * (dPdT / D) / dPdD;
+        d2PdD2 = RT * (2 * ar[0][1] + 4 * ar[0][2] + ar[0][3]) / D;
+        JT = (T / D * dPdT / dPdD - 1) / Cp / D; //  '=(dB/dT*T-B)/Cp for an ideal gas, but dB/dT is not known
+    }
+    else{
+        Cp = Cv + R;
+        d2PdD2 = 0;
+        JT = 1E+20;
+    }
+    W = 1000 * Cp / Cv * dPdD / Mm;
+    if (W < 0) { W = 0; }
+    W = sqrt(W);
+    Kappa = pow(W, 2) * Mm / (RT * 1000 * Z);
+    Cf = sqrt(Kappa * pow( (2 / (Kappa + 1)), ((Kappa + 1) / (Kappa - 1))));
+}
+
+// PropertiesGERG for any composition type with x[i], i = 1 to NcGERG (std::vector, Composition, CompositionView)
+template <typename X>
+static void PropertiesGERGImpl(const double T, const double D, const X &x, double &P, double &Z, double &dPdD, double &d2PdD2, double &d2PdTD, double &dPdT, double &U, double &H, double &S, double &Cv, double &Cp, double &W, double &G, double &JT, double &Kappa, double &A, double &Cf)
+{
+    double a0[2+1], ar[3+1][3+1], Mm;
+
+    // Calculate molar mass
+    MolarMassGERGImpl(x, Mm);
+
+    // Calculate the ideal gas Helmholtz energy, and its first and second derivatives with respect to temperature.
+    Alpha0GERG(T, D, x, a0);
+
+    // Calculate the real gas Helmholtz energy, and its derivatives with respect to temperature and/or density.
+    AlpharGERG(1, 0, T, D, x, ar);
+
+    PropertiesFromAlphaGERG(T, D, Mm, a0, ar, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf);
+}
+
+/**
+ * @brief Calculate thermodynamic properties as a function of temperature and density
+ * 
+ * Calls are made to the subroutines ReducingParametersGERG, IdealGERG, and ResidualGERG.
+ * If the density is not known, call subroutine DENSITY first with the known values of pressure and temperature.
+ * 
+ * @param T Temperature (K)
+ * @param D Density (mol/l)
+ * @param x Composition (mole fraction)
+ * @param[out] P Pressure (kPa)
+ * @param[out] Z Compressibility factor
+ * @param[out] dPdD First derivative of pressure with respect to density at constant temperature [kPa/(mol/l)]
+ * @param[out] d2PdD2 Second derivative of pressure with respect to density at constant temperature [kPa/(mol/l)^2]
+ * @param[out] d2PdTD Second derivative of pressure with respect to temperature and density [kPa/(mol/l)/K]
+ * @param[out] dPdT First derivative of pressure with respect to temperature at constant density (kPa/K)
+ * @param[out] U Internal energy (J/mol)
+ * @param[out] H Enthalpy (J/mol)
+ * @param[out] S Entropy [J/(mol-K)]
+ * @param[out] Cv Isochoric heat capacity [J/(mol-K)]
+ * @param[out] Cp Isobaric heat capacity [J/(mol-K)]
+ * @param[out] W Speed of sound (m/s)
+ * @param[out] G Gibbs energy (J/mol)
+ * @param[out] JT Joule-Thomson coefficient (K/kPa)
+ * @param[out] Kappa Isentropic Exponent
+ * @param[out] A Helmholtz energy (J/mol)
+ * @param[out] Cf Critical Flow Factor (dimensionless)
+ * @see PropertiesGERG_wrapper for the Emscripten wrapped version of this function
+ */
+void PropertiesGERG(const double T, const double D, const std::vector<double> &x, double &P, double &Z, double &dPdD, double &d2PdD2, double &d2PdTD, double &dPdT, double &U, double &H, double &S, double &Cv, double &Cp, double &W, double &G, double &JT, double &Kappa, double &A, double &Cf)
+{
+    PropertiesGERGImpl(T, D, x, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf);
+}
+
+/**
+ * @brief PropertiesGERG for a fixed-size Composition
+ * @see PropertiesGERG
+ */
+void PropertiesGERG(const double T, const double D, const Composition &x, double &P, double &Z, double &dPdD, double &d2PdD2, double &d2PdTD, double &dPdT, double &U, double &H, double &S, double &Cv, double &Cp, double &W, double &G, double &JT, double &Kappa, double &A, double &Cf)
+{
+    PropertiesGERGImpl(T, D, x, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf);
+}
+
+/**
+ * @brief PropertiesGERG for a CompositionView, e.g. a row of a composition matrix
+ * @see PropertiesGERG
+ */
+void PropertiesGERG(const double T, const double D, const CompositionView &x, double &P, double &Z, double &dPdD, double &d2PdD2, double &d2PdTD, double &dPdT, double &U, double &H, double &S, double &Cv, double &Cp, double &W, double &G, double &JT, double &Kappa, double &A, double &Cf)
+{
+    PropertiesGERGImpl(T, D, x, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf);
+}
+
+/**
+ * @brief PressureGERG for any scalar type V (float, double, Dual<N>)
+ *
+ * Same equations as PressureGERG, evaluated in V without the composition and temperature caches,
+ * so that T, D and every x[i] may carry derivatives (see Scalar.h). Instantiated for float, double,
+ * Dual<1>, Dual<2> and Dual<23>. The double overload of PressureGERG is faster for plain values.
+ *
+ * @param T Temperature (K)
+ * @param D Density (mol/l)
+ * @param x Composition (mole fraction)
+ * @param[out] P Pressure (kPa)
+ * @param[out] Z Compressibility factor
+ */
+template <typename V>
+void PressureGERG(const V &T, const V &D, const std::vector<V> &x, V &P, V &Z)
+{
+    V ar[3+1][3+1];
+    AlpharScalarGERG(0, T, D, x, ar);
+    Z = 1 + ar[0][1];
+    P = D * RGERG * T * Z;
+}
+
+/**
+ * @brief PropertiesGERG for any scalar type V (float, double, Dual<N>)
+ *
+ * Same equations as PropertiesGERG, evaluated in V without the composition and temperature caches.
+ * With Dual<N> inputs, every output carries its derivatives with respect to the seeded variables,
+ * e.g. T and D, the mole fractions, or both with Dual<23>.
+ * @see PressureGERG<V> for the instantiated types, PropertiesGERG for the outputs
+ */
+template <typename V>
+void PropertiesGERG(const V &T, const V &D, const std::vector<V> &x, V &P, V &Z, V &dPdD, V &d2PdD2, V &d2PdTD, V &dPdT, V &U, V &H, V &S, V &Cv, V &Cp, V &W, V &G, V &JT, V &Kappa, V &A, V &Cf)
+{
+    V a0[2+1], ar[3+1][3+1], Mm;
+
+    MolarMassGERGImpl(x, Mm);
+    Alpha0ScalarGERG(T, D, x, a0);
+    AlpharScalarGERG(1, T, D, x, ar);
+    PropertiesFromAlphaGERG(T, D, Mm, a0, ar, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf);
+}
+
+// PrepareIsothermGERG for any composition type with x[i], i = 1 to NcGERG (std::vector, Composition, CompositionView)
+template <typename X>
+static void PrepareIsothermGERGImpl(const double T, const X &x, PreparedIsothermGERG &iso)
+{
+  AGA8_TRACE_SCOPE("PrepareIsothermGERG");
+  int mn, d, c;
+  double Tr, Dr, lntau, xijf, ndt;
+  double aexp[PreparedIsothermGERG::MaxD+1][PreparedIsothermGERG::MaxD+1], xijm[MaxMdl+1];
+
+  ReducingParametersGERG(x, Tr, Dr);
+  lntau = log(Tr / T);
+  if (std::abs(T - Told) > 0.0000001 || std::abs(Tr - Trold2) > 0.0000001) {
+    tTermsGERG(lntau, x);
+  }
+  Told = T;
+  Trold2 = Tr;
+  iso.T = T;
+  iso.Tr = Tr;
+  iso.Dr = Dr;
+
+  for (d = 0; d <= PreparedIsothermGERG::MaxD; ++d){
+    iso.apol[d] = 0;
+    for (c = 0; c <= PreparedIsothermGERG::MaxD; ++c){ aexp[d][c] = 0; }
+  }
+
+  // Pure fluid contributions, with the short form components as one pseudo-component
+  for (int i = 1; i <= NcGERG + 1; ++i){
+    const double *tp;
+    double xi;
+    int ic;
+    if (i <= NcGERG){
+      if (x[i] <= epsilon || IsShortFormGERG(i)){ continue; }
+      tp = taup[i]; xi = x[i]; ic = i;
+    }
+    else{
+      if (nShortGERG == 0){ continue; }
+      tp = taupagg; xi = 1; ic = 5;
+    }
+    for (int k = 1; k <= kpol[ic]; ++k){
+      iso.apol[doik[ic][k]] += xi * tp[k];
+    }
+    for (int k = 1 + kpol[ic]; k <= kpol[ic] + kexp[ic]; ++k){
+      aexp[doik[ic][k]][coik[ic][k]] += xi * tp[k];
+    }
+  }
+
+  // Mixture contributions: the polynomial terms go with the pure fluid ones, the departure terms
+  // of all the binaries sharing the same departure function are summed
+  for (mn = 0; mn <= MaxMdl; ++mn){ xijm[mn] = 0; }
+  for (int i = 1; i <= (iPureGERG > 0 ? 0 : NcGERG - 1); ++i){
+    if (x[i] > epsilon){
+      for (int j = i + 1; j <= NcGERG; ++j){
+        if (x[j] > epsilon){
+          mn = mNumb[i][j];
+          if (mn >= 0){
+            xijf = x[i] * x[j] * fij[i][j];
+            xijm[mn] += xijf;
+            for (int k = 1; k <= kpolij[mn]; ++k){
+              iso.apol[dijk[mn][k]] += xijf * taupijk[mn][k];
+            }
+          }
+        }
+      }
+    }
+  }
+  iso.ngauss = 0;
+  for (mn = 0; mn <= MaxMdl; ++mn){
+    if (xijm[mn] == 0){ continue; }
+    for (int k = 1 + kpolij[mn]; k <= kpolij[mn] + kexpij[mn]; ++k){
+      ndt = xijm[mn] * nijk[mn][k] * exp(gijk[mn][k] + tijk[mn][k] * lntau);
+      iso.dgauss[iso.ngauss] = dijk[mn][k];
+      iso.cgauss[iso.ngauss] = cijk[mn][k];
+      iso.egauss[iso.ngauss] = eijk[mn][k];
+      iso.agauss[iso.ngauss] = ndt;
+      ++iso.ngauss;
+    }
+  }
+
+  iso.nexp = 0;
+  for (d = 0; d <= PreparedIsothermGERG::MaxD; ++d){
+    for (c = 1; c <= PreparedIsothermGERG::MaxD; ++c){
+      if (aexp[d][c] != 0){
+        iso.dexp[iso.nexp] = d;
+        iso.cexp[iso.nexp] = c;
+        iso.aexp[iso.nexp] = aexp[d][c];
+        ++iso.nexp;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Prepare the residual pressure terms of an isotherm
+ *
+ * At fixed temperature and composition, every residual term is coef*del^d*exp(-del^c) or a
+ * Gaussian-type departure term coef*del^d*exp(c*del^2 + e*del). This routine pre-multiplies the
+ * coefficients (x_i*taup, x_i*x_j*fij*taupijk, ...) and sums the terms sharing the same (d, c)
+ * exponents, so that PressureIsothermGERG can be called for any number of densities.
+ *
+ * @param T Temperature (K)
+ * @param x Composition (mole fraction)
+ * @param[out] iso Prepared isotherm
+ * @see PressureIsothermGERG, IsothermGERG_wrapper for the Emscripten wrapped version of this function
+ */
+void PrepareIsothermGERG(const double T, const std::vector<double> &x, PreparedIsothermGERG &iso)
+{
+    PrepareIsothermGERGImpl(T, x, iso);
+}
+
+/**
+ * @brief PrepareIsothermGERG for a fixed-size Composition
+ * @see PrepareIsothermGERG
+ */
+void PrepareIsothermGERG(const double T, const Composition &x, PreparedIsothermGERG &iso)
+{
+    PrepareIsothermGERGImpl(T, x, iso);
+}
+
+/**
+ * @brief PrepareIsothermGERG for a CompositionView, e.g. a row of a composition matrix
+ * @see PrepareIsothermGERG
+ */
+void PrepareIsothermGERG(const double T, const CompositionView &x, PreparedIsothermGERG &iso)
+{
+    PrepareIsothermGERGImpl(T, x, iso);
+}
+
+/**
+ * @brief Calculate pressure, compressibility factor and d(P)/d(D) on a prepared isotherm
+ *
+ * Gives the same results as PressureGERG at the temperature and composition of the isotherm.
+ *
+ * @param iso Isotherm prepared by PrepareIsothermGERG
+ * @param D Density (mol/l)
+ * @param[out] P Pressure (kPa)
+ * @param[out] Z Compressibility factor
+ * @param[out] dPdD First derivative of pressure with respect to density at constant temperature [kPa/(mol/l)]
+ * @see PrepareIsothermGERG
+ */
+void PressureIsothermGERG(const PreparedIsothermGERG &iso, const double D, double &P, double &Z, double &dPdD)
+{
+  int d, c;
+  double del, delp[7+1], Expd[7+1], ar01, ar02, ndt, ex, ex2, cij0, eij0;
+
+  del = D / iso.Dr;
+  delp[0] = 1;
+  Expd[0] = 1;
+  for (int i = 1; i <= 7; ++i){
+    delp[i] = delp[i - 1] * del;
+    Expd[i] = exp(-delp[i]);
+  }
+
+  ar01 = 0;
+  ar02 = 0;
+  for (d = 1; d <= PreparedIsothermGERG::MaxD; ++d){
+    ndt = iso.apol[d] * delp[d] * d;
+    ar01 += ndt;
+    ar02 += ndt * (d - 1);
+  }
+  for (int g = 0; g < iso.nexp; ++g){
+    d = iso.dexp[g];
+    c = iso.cexp[g];
+    ndt = iso.aexp[g] * delp[d] * Expd[c];
+    ex = c * delp[c];
+    ex2 = d - ex;
+    ar01 += ndt * ex2;
+    ar02 += ndt * (ex2 * (ex2 - 1) - c * ex);
+  }
+  for (int g = 0; g < iso.ngauss; ++g){
+    d = iso.dgauss[g];
+    cij0 = iso.cgauss[g] * delp[2];
+    eij0 = iso.egauss[g] * del;
+    ndt = iso.agauss[g] * delp[d] * exp(cij0 + eij0);
+    ex = d + 2 * cij0 + eij0;
+    ex2 = (ex * ex - d + 2 * cij0);
+    ar01 += ndt * ex;
+    ar02 += ndt * ex2;
+  }
+
+  Z = 1 + ar01;
+  P = D * RGERG * iso.T * Z;
+  dPdD = RGERG * iso.T * (1 + 2 * ar01 + ar02);
+}
+
+/**
+ * @brief Fold a fixed composition into the coefficients of the GERG-2008 equation
+ *
+ * The pure fluid terms are weighted by x_i, the departure terms by the sum of x_i*x_j*fij over the
+ * binaries sharing the same departure function, and the terms with the same exponents are merged.
+ * The ideal gas part is reduced to Sum(x*n0i) constants and one hyperbolic term per component and
+ * Planck-Einstein term. Only needed once per composition, e.g. by the aga8-fixedgas generator.
+ *
+ * @param x Composition (mole fraction)
+ * @param[out] fg Folded terms
+ * @see FixedGasGERG.h for the kernels evaluating them
+ */
+void PrepareFixedGasGERG(const std::vector<double> &x, FixedGasTermsGERG &fg)
+{
+  double Tr, Dr, xijm[MaxMdl+1];
+  int mn, n;
+
+  InvalidateCacheGERG();   // Recalculate the composition terms for this exact x
+  ReducingParametersGERG(x, Tr, Dr);
+  PseudoCriticalPointGERGImpl(x, fg.Tcx, fg.Dcx);
+  MolarMassGERGImpl(x, fg.Mm);
+  fg.R = RGERG;
+  fg.Tr = Tr;
+  fg.Dr = Dr;
+
+  // Ideal gas part
+  fg.Sumx = 0;
+  fg.SumxLnx = SumxLnx;
+  fg.n01 = 0;
+  fg.n02 = 0;
+  fg.n03 = 0;
+  fg.nhyp = 0;
+  for (int i = 1; i <= NcGERG; ++i){
+    if (x[i] > epsilon){
+      fg.Sumx += x[i];
+      fg.n01 += x[i] * n0i[i][1];
+      fg.n02 += x[i] * n0i[i][2];
+      fg.n03 += x[i] * n0i[i][3];
+      for (int j = 4; j <= 7; ++j){
+        if (th0i[i][j] > epsilon){
+          fg.sinhhyp[fg.nhyp] = (j == 4 || j == 6) ? 1 : 0;
+          fg.ahyp[fg.nhyp] = x[i] * n0i[i][j];
+          fg.thhyp[fg.nhyp] = th0i[i][j];
+          ++fg.nhyp;
+        }
+      }
+    }
+  }
+
+  // Residual terms, merged when their exponents are the same
+  auto addpol = [&fg](const int d, const double t, const double a){
+    for (int k = 0; k < fg.npol; ++k){
+      if (fg.dpol[k] == d && fg.tpol[k] == t){ fg.apol[k] += a; return; }
+    }
+    fg.dpol[fg.npol] = d; fg.tpol[fg.npol] = t; fg.apol[fg.npol] = a;
+    ++fg.npol;
+  };
+  auto addexp = [&fg](const int d, const int c, const double t, const double a){
+    for (int k = 0; k < fg.nexp; ++k){
+      if (fg.dexp[k] == d && fg.cexp[k] == c && fg.texp[k] == t){ fg.aexp[k] += a; return; }
+    }
+    fg.dexp[fg.nexp] = d; fg.cexp[fg.nexp] = c; fg.texp[fg.nexp] = t; fg.aexp[fg.nexp] = a;
+    ++fg.nexp;
+  };
+  fg.npol = 0;
+  fg.nexp = 0;
+  fg.ngauss = 0;
+  for (int i = 1; i <= NcGERG; ++i){
+    if (x[i] > epsilon){
+      for (int k = 1; k <= kpol[i]; ++k){ addpol(doik[i][k], toik[i][k], x[i] * noik[i][k]); }
+      for (int k = 1 + kpol[i]; k <= kpol[i] + kexp[i]; ++k){ addexp(doik[i][k], coik[i][k], toik[i][k], x[i] * noik[i][k]); }
+    }
+  }
+  for (mn = 0; mn <= MaxMdl; ++mn){ xijm[mn] = 0; }
+  for (int i = 1; i <= NcGERG - 1; ++i){
+    if (x[i] > epsilon){
+      for (int j = i + 1; j <= NcGERG; ++j){
+        if (x[j] > epsilon && mNumb[i][j] >= 0){ xijm[mNumb[i][j]] += x[i] * x[j] * fij[i][j]; }
+      }
+    }
+  }
+  for (mn = 0; mn <= MaxMdl; ++mn){
+    if (xijm[mn] == 0){ continue; }
+    for (int k = 1; k <= kpolij[mn]; ++k){ addpol(dijk[mn][k], tijk[mn][k], xijm[mn] * nijk[mn][k]); }
+    for (int k = 1 + kpolij[mn]; k <= kpolij[mn] + kexpij[mn]; ++k){
+      n = fg.ngauss++;
+      fg.dgauss[n] = dijk[mn][k];
+      fg.tgauss[n] = tijk[mn][k];
+      fg.cgauss[n] = cijk[mn][k];
+      fg.egauss[n] = eijk[mn][k];
+      fg.ggauss[n] = gijk[mn][k];
+      fg.agauss[n] = xijm[mn] * nijk[mn][k];
+    }
+  }
+}
+
+/**
+ * @brief Add one residual term to the derivatives A[m][n] = tau^m*delta^n*d^(m+n)(alphar)/d(tau)^m/d(delta)^n
+ *
+ * @param f Value of the term, coef*tau^t*delta^d*E(delta)
+ * @param t Exponent of tau
+ * @param d1, d2, d3 delta*d(f)/d(delta), delta^2*d^2(f)/d(delta)^2 and delta^3*d^3(f)/d(delta)^3, divided by f
+ * @param[in,out] A Derivatives with m + n <= 3
+ */
+static void AddTermGERG(const double f, const double t, const double d1, const double d2, const double d3, double A[4][4])
+{
+  const double ft[4] = {f, f * t, f * t * (t - 1), f * t * (t - 1) * (t - 2)}, fd[4] = {1, d1, d2, d3};
+  for (int m = 0; m <= 3; ++m){
+    for (int n = 0; m + n <= 3; ++n){ A[m][n] += ft[m] * fd[n]; }
+  }
+}
+
+// Derivatives A[m][n] (see AddTermGERG) of the pure fluid equation of component i, not weighted by x[i]
+static void PureDerivativesGERG(const int i, const double lntau, const double delp[], double A[4][4])
+{
+  double d, c, ex, ex2, ex3;
+
+  for (int m = 0; m <= 3; ++m){ for (int n = 0; n <= 3; ++n){ A[m][n] = 0; } }
+  for (int k = 1; k <= kpol[i]; ++k){
+    d = doik[i][k];
+    AddTermGERG(noik[i][k] * exp(toik[i][k] * lntau) * delp[doik[i][k]], toik[i][k], d, d * (d - 1), d * (d - 1) * (d - 2), A);
+  }
+  for (int k = 1 + kpol[i]; k <= kpol[i] + kexp[i]; ++k){
+    c = coik[i][k];
+    ex = c * delp[coik[i][k]];
+    ex2 = doik[i][k] - ex;
+    ex3 = ex2 * (ex2 - 1);
+    AddTermGERG(noik[i][k] * exp(toik[i][k] * lntau) * delp[doik[i][k]] * exp(-delp[coik[i][k]]), toik[i][k],
+                ex2, ex3 - c * ex, ex3 * (ex2 - 2) - ex * (3 * ex2 - 3 + c) * c, A);
+  }
+}
+
+// Derivatives A[m][n] (see AddTermGERG) of departure function mn, not weighted by x[i]*x[j]*fij
+static void DepartureDerivativesGERG(const int mn, const double lntau, const double del, const double delp[], double A[4][4])
+{
+  double d, cij0, eij0, ex, ex2;
+
+  for (int m = 0; m <= 3; ++m){ for (int n = 0; n <= 3; ++n){ A[m][n] = 0; } }
+  for (int k = 1; k <= kpolij[mn]; ++k){
+    d = dijk[mn][k];
+    AddTermGERG(nijk[mn][k] * exp(tijk[mn][k] * lntau) * delp[dijk[mn][k]], tijk[mn][k], d, d * (d - 1), d * (d - 1) * (d - 2), A);
+  }
+  for (int k = 1 + kpolij[mn]; k <= kpolij[mn] + kexpij[mn]; ++k){
+    d = dijk[mn][k];
+    cij0 = cijk[mn][k] * delp[2];
+    eij0 = eijk[mn][k] * del;
+    ex = d + 2 * cij0 + eij0;
+    ex2 = ex * ex - d + 2 * cij0;
+    AddTermGERG(nijk[mn][k] * delp[dijk[mn][k]] * exp(cij0 + eij0 + gijk[mn][k] + tijk[mn][k] * lntau), tijk[mn][k],
+                ex, ex2, ex * (ex2 - 2 * (d - 2 * cij0)) + 2 * d, A);
+  }
+}
+
+// Add the binary term 2*g*xi*xj*(xi + xj)/(b*xi + xj) of a reducing function and its derivatives with respect to xi and xj
+static void ReducingPairGERG(const double xi, const double xj, const double b, const double g, double &Y, double &dYi, double &dYj)
+{
+  const double w = b * xi + xj, u = xi * xj * (xi + xj);
+  Y += 2 * g * u / w;
+  dYi += 2 * g * ((2 * xi * xj + xj * xj) * w - u * b) / (w * w);
+  dYj += 2 * g * ((xi * xi + 2 * xi * xj) * w - u) / (w * w);
+}
+
+/**
+ * @brief Derivatives of Z, D and W with respect to the mole fractions at constant temperature and pressure
+ *
+ * The derivatives are analytic. The composition enters the equation through the reducing functions
+ * Tr(x) and Dr(x) (the btij, gtij, bvij and gvij mixing rules), the x_i weights of the pure fluid
+ * equations and the x_i*x_j*fij weights of the departure functions, and x_i*c2_i(T) in the ideal gas
+ * heat capacity. Their derivatives at constant T and D are combined with the density derivatives of
+ * the same properties, dD/dx_i being -(dP/dx_i)/(dP/dD).
+ *
+ * Each mole fraction is varied alone, the other ones being held constant (x is not normalized), so
+ * that the derivative for replacing component j by component i is dZdx[i] - dZdx[j]. Components
+ * absent from x have derivatives too, those of adding a trace of them.
+ *
+ * @param T Temperature (K)
+ * @param D Density (mol/l), from DensityGERG at the pressure of interest
+ * @param x Composition (mole fraction)
+ * @param[out] P Pressure (kPa)
+ * @param[out] Z Compressibility factor
+ * @param[out] W Speed of sound (m/s)
+ * @param[out] dZdx dZ/dx_i (NcGERG + 1 elements, index 0 unused)
+ * @param[out] dDdx dD/dx_i [mol/l]
+ * @param[out] dWdx dW/dx_i (m/s)
+ * @see PropertiesGERG for P, Z and W; CompositionDerivativesGERG_wrapper for the Emscripten wrapped version
+ */
+void CompositionDerivativesGERG(const double T, const double D, const std::vector<double> &x, double &P, double &Z, double &W, std::vector<double> &dZdx, std::vector<double> &dDdx, std::vector<double> &dWdx)
+{
+  dZdx.assign(NcGERG + 1, 0);
+  dDdx.assign(NcGERG + 1, 0);
+  dWdx.assign(NcGERG + 1, 0);
+  CompositionDerivativesGERGImpl(T, D, x, P, Z, W, dZdx, dDdx, dWdx);
+}
+
+/**
+ * @brief CompositionDerivativesGERG for a fixed-size Composition, with fixed-size derivatives
+ * @see CompositionDerivativesGERG
+ */
+void CompositionDerivativesGERG(const double T, const double D, const Composition &x, double &P, double &Z, double &W, Composition &dZdx, Composition &dDdx, Composition &dWdx)
+{
+  CompositionDerivativesGERGImpl(T, D, x, P, Z, W, dZdx, dDdx, dWdx);
+}
+
+/**
+ * @brief CompositionDerivativesGERG for a CompositionView, e.g. a row of a composition matrix
+ * @see CompositionDerivativesGERG
+ */
+void CompositionDerivativesGERG(const double T, const double D, const CompositionView &x, double &P, double &Z, double &W, Composition &dZdx, Composition &dDdx, Composition &dWdx)
+{
+  CompositionDerivativesGERGImpl(T, D, x, P, Z, W, dZdx, dDdx, dWdx);
+}
+
+// CompositionDerivativesGERG for any composition type X, writing dZdx[i], dDdx[i] and dWdx[i], i = 1 to NcGERG, of any type Y
+template <typename X, typename Y>
+static void CompositionDerivativesGERGImpl(const double T, const double D, const X &x, double &P, double &Z, double &W, Y &dZdx, Y &dDdx, Y &dWdx)
+{
+  AGA8_TRACE_SCOPE("CompositionDerivativesGERG");
+  double xe[MaxFlds+1], dTr[MaxFlds+1], dVr[MaxFlds+1], c2[MaxFlds+1], c0, c1;
+  double Ao[MaxFlds+1][4][4], Ad[MaxMdl+1][4][4], A[4][4], B[4][4];
+  double delp[7+1], Tr, Vr, del, lntau, a02, Mm, xijf;
+  int mn;
+
+  // Reducing functions and their derivatives, with the fractions below epsilon skipped as in ReducingParametersGERG
+  Tr = 0;
+  Vr = 0;
+  for (int i = 1; i <= NcGERG; ++i){
+    xe[i] = x[i] > epsilon ? x[i] : 0;
+    dTr[i] = 0;
+    dVr[i] = 0;
+  }
+  for (int i = 1; i <= NcGERG; ++i){
+    Tr += xe[i] * xe[i] * gtij[i][i];
+    Vr += xe[i] * xe[i] * gvij[i][i];
+    dTr[i] += 2 * xe[i] * gtij[i][i];
+    dVr[i] += 2 * xe[i] * gvij[i][i];
+    for (int j = i + 1; j <= NcGERG; ++j){
+      if (xe[i] == 0 && xe[j] == 0){ continue; }
+      ReducingPairGERG(xe[i], xe[j], btij[i][j], gtij[i][j], Tr, dTr[i], dTr[j]);
+      ReducingPairGERG(xe[i], xe[j], bvij[i][j], gvij[i][j], Vr, dVr[i], dVr[j]);
+    }
+  }
+
+  // Residual derivatives of every pure fluid and departure function at the (delta, tau) of the mixture
+  del = D * Vr;
+  lntau = log(Tr / T);
+  delp[0] = 1;
+  for (int i = 1; i <= 7; ++i){ delp[i] = delp[i - 1] * del; }
+  for (int i = 1; i <= NcGERG; ++i){ PureDerivativesGERG(i, lntau, delp, Ao[i]); }
+  for (mn = 0; mn <= MaxMdl; ++mn){ DepartureDerivativesGERG(mn, lntau, del, delp, Ad[mn]); }
+
+  for (int m = 0; m <= 3; ++m){ for (int n = 0; n <= 3; ++n){ A[m][n] = 0; } }
+  a02 = 0;
+  Mm = 0;
+  for (int i = 1; i <= NcGERG; ++i){
+    IdealTermsGERG(T, i, c0, c1, c2[i]);
+    a02 += -xe[i] * c2[i];
+    Mm += x[i] * MMiGERG[i];
+    if (xe[i] == 0){ continue; }
+    for (int m = 0; m <= 3; ++m){ for (int n = 0; m + n <= 3; ++n){ A[m][n] += xe[i] * Ao[i][m][n]; } }
+    for (int j = i + 1; j <= NcGERG; ++j){
+      mn = mNumb[i][j];
+      if (xe[j] == 0 || mn < 0){ continue; }
+      xijf = xe[i] * xe[j] * fij[i][j];
+      for (int m = 0; m <= 3; ++m){ for (int n = 0; m + n <= 3; ++n){ A[m][n] += xijf * Ad[mn][m][n]; } }
+    }
+  }
+
+  // Properties (as in PropertiesGERG), and the relative derivative of W^2 along any direction from those of A[m][n], a0[2] and Mm
+  const double R = RGERG, RT = R * T;
+  Z = 1 + A[0][1];
+  P = D * RT * Z;
+  const double dPdD = RT * (1 + 2 * A[0][1] + A[0][2]);
+  const double y = R * (1 + A[0][1] - A[1][1]);  // dP/dT divided by D
+  const double Cv = -R * (a02 + A[2][0]);
+  const double Cp = Cv + T * y * y / dPdD;
+  const double W2 = 1000 * Cp / Cv * dPdD / Mm;
+  W = W2 > 0 ? sqrt(W2) : 0;
+  auto dlnW2 = [&](const double dA01, const double dA02, const double dA11, const double dA20, const double da02, const double dMm){
+    const double ddPdD = RT * (2 * dA01 + dA02), dy = R * (dA01 - dA11), dCv = -R * (da02 + dA20);
+    const double dCp = dCv + T * y * (2 * dy - y * ddPdD / dPdD) / dPdD;
+    return dCp / Cp - dCv / Cv + ddPdD / dPdD - dMm / Mm;
+  };
+
+  // Derivatives with respect to ln(D) at constant T and x
+  const double dZdlnD = A[0][1] + A[0][2];
+  const double dW2dlnD = dlnW2(A[0][1] + A[0][2], 2 * A[0][2] + A[0][3], A[1][1] + A[1][2], A[2][1], 0, 0);
+
+  // Derivatives with respect to x[k] at constant T and D, delta and tau changing with Dr and Tr, then at constant T and P
+  for (int k = 1; k <= NcGERG; ++k){
+    for (int m = 0; m <= 2; ++m){
+      for (int n = 0; m + n <= 2; ++n){ B[m][n] = Ao[k][m][n]; }
+    }
+    for (int j = 1; j <= NcGERG; ++j){
+      mn = j < k ? mNumb[j][k] : mNumb[k][j];
+      if (j == k || xe[j] == 0 || mn < 0){ continue; }
+      xijf = xe[j] * fij[k][j];
+      for (int m = 0; m <= 2; ++m){
+        for (int n = 0; m + n <= 2; ++n){ B[m][n] += xijf * Ad[mn][m][n]; }
+      }
+    }
+    const double dlndel = dVr[k] / Vr, dlntau = dTr[k] / Tr;
+    for (int m = 0; m <= 2; ++m){
+      for (int n = 0; m + n <= 2; ++n){
+        B[m][n] += (n * A[m][n] + A[m][n + 1]) * dlndel + (m * A[m][n] + A[m + 1][n]) * dlntau;
+      }
+    }
+    const double dlnD = -RT * B[0][1] / dPdD;
+    dDdx[k] = D * dlnD;
+    dZdx[k] = B[0][1] + dlnD * dZdlnD;
+    dWdx[k] = W > 0 ? W / 2 * (dlnW2(B[0][1], B[0][2], B[1][1], B[2][0], -c2[k], MMiGERG[k]) + dlnD * dW2dlnD) : 0;
+  }
+}
+
+/**
+ * @brief Density, Z and W with their derivatives with respect to the mole fractions at many (T, P) states
+ *
+ * DensityGERG (iFlag 0) then CompositionDerivativesGERG at each state. The derivatives of state k with
+ * respect to x_i are at index k * NcGERG + i - 1 (methane first); those of a state whose density
+ * solve fails are 0, as are its D, Z and W.
+ *
+ * @param T Temperatures (K)
+ * @param P Pressures (kPa), as many as T (the extra values of the longer vector are ignored)
+ * @param x Composition (mole fraction)
+ * @param[out] D Densities (mol/l)
+ * @param[out] Z Compressibility factors
+ * @param[out] W Speeds of sound (m/s)
+ * @param[out] dZdx dZ/dx_i of each state (n * NcGERG elements)
+ * @param[out] dDdx dD/dx_i [mol/l]
+ * @param[out] dWdx dW/dx_i (m/s)
+ * @param[out] ierr Error numbers of DensityGERG (0 indicates no error)
+ * @see CompositionDerivativesBatchGERG_wrapper for the Emscripten wrapped version
+ */
+void CompositionDerivativesBatchGERG(const std::vector<double> &T, const std::vector<double> &P, const std::vector<double> &x, std::vector<double> &D, std::vector<double> &Z, std::vector<double> &W, std::vector<double> &dZdx, std::vector<double> &dDdx, std::vector<double> &dWdx, std::vector<int> &ierr)
+{
+  CompositionDerivativesBatchGERGImpl(T, P, x, D, Z, W, dZdx, dDdx, dWdx, ierr);
+}
+
+/**
+ * @brief CompositionDerivativesBatchGERG for a fixed-size Composition
+ * @see CompositionDerivativesBatchGERG
+ */
+void CompositionDerivativesBatchGERG(const std::vector<double> &T, const std::vector<double> &P, const Composition &x, std::vector<double> &D, std::vector<double> &Z, std::vector<double> &W, std::vector<double> &dZdx, std::vector<double> &dDdx, std::vector<double> &dWdx, std::vector<int> &ierr)
+{
+  CompositionDerivativesBatchGERGImpl(T, P, x, D, Z, W, dZdx, dDdx, dWdx, ierr);
+}
+
+/**
+ * @brief CompositionDerivativesBatchGERG for a CompositionView, e.g. a row of a composition matrix
+ * @see CompositionDerivativesBatchGERG
  */
-void PropertiesGERG(const double T, const double D, const std::vector<double> &x, double &P, double &Z, double &dPdD, double &d2PdD2, double &d2PdTD, double &dPdT, double &U, double &H, double &S, double &Cv, double &Cp, double &W, double &G, double &JT, double &Kappa, double &A, double &Cf)
+void CompositionDerivativesBatchGERG(const std::vector<double> &T, const std::vector<double> &P, const CompositionView &x, std::vector<double> &D, std::vector<double> &Z, std::vector<double> &W, std::vector<double> &dZdx, std::vector<double> &dDdx, std::vector<double> &dWdx, std::vector<int> &ierr)
 {
-    double a0[2+1], ar[3+1][3+1], Mm, R, RT;
-
-    // Calculate molar mass
-    MolarMassGERG(x, Mm);
+  CompositionDerivativesBatchGERGImpl(T, P, x, D, Z, W, dZdx, dDdx, dWdx, ierr);
+}
 
-    // Calculate the ideal gas Helmholtz energy, and its first and second derivatives with respect to temperature.
-    Alpha0GERG(T, D, x, a0);
+// CompositionDerivativesBatchGERG for any composition type X, the derivatives of each state in a Composition
+template <typename X>
+static void CompositionDerivativesBatchGERGImpl(const std::vector<double> &T, const std::vector<double> &P, const X &x, std::vector<double> &D, std::vector<double> &Z, std::vector<double> &W, std::vector<double> &dZdx, std::vector<double> &dDdx, std::vector<double> &dWdx, std::vector<int> &ierr)
+{
+  const std::size_t n = std::min(T.size(), P.size());
+  Composition dZ, dD, dW;
+  double P2;
+  const char *herr;
+
+  D.assign(n, 0);
+  Z.assign(n, 0);
+  W.assign(n, 0);
+  ierr.assign(n, 0);
+  dZdx.assign(n * NcGERG, 0);
+  dDdx.assign(n * NcGERG, 0);
+  dWdx.assign(n * NcGERG, 0);
+  for (std::size_t k = 0; k < n; ++k){
+    DensityGERGImpl(0, T[k], P[k], x, D[k], ierr[k], herr);
+    if (ierr[k] != 0){ D[k] = 0; continue; }
+    CompositionDerivativesGERGImpl(T[k], D[k], x, P2, Z[k], W[k], dZ, dD, dW);
+    for (int i = 1; i <= NcGERG; ++i){
+      dZdx[k * NcGERG + i - 1] = dZ[i];
+      dDdx[k * NcGERG + i - 1] = dD[i];
+      dWdx[k * NcGERG + i - 1] = dW[i];
+    }
+  }
+}
 
-    // Calculate the real gas Helmholtz energy, and its derivatives with respect to temperature and/or density.
-    AlpharGERG(1, 0, T, D, x, ar);
+// The following routines are low-level routines that should not be called outside of this code.
+/**
+ * @brief Reducing temperature and density of the GERG-2008 mixing rules, for any scalar type
+ *
+ * @param x Composition (mole fraction)
+ * @param[out] Tr Reducing temperature (K)
+ * @param[out] Dr Reducing density (mol/l)
+ */
+template <typename V, typename X>
+static void ReducingValuesGERG(const X &x, V &Tr, V &Dr)
+{
+  V Vr, xij;
+  double F;
 
-    R = RGERG;
-    RT = R * T;
-    Z = 1 + ar[0][1];
-    P = D * RT * Z;
-    dPdD = RT * (1 + 2 * ar[0][1] + ar[0][2]);
-    dPdT = D * R * (1 + ar[0][1] - ar[1][1]);
-    d2PdTD = R * (1 + 2 * ar[0][1] + ar[0][2] - 2 * ar[1][1] - ar[1][2]);
-    A = RT * (a0[0] + ar[0][0]);
-    G = RT * (1 + ar[0][1] + a0[0] + ar[0][0]);
-    U = RT * (a0[1] + ar[1][0]);
-    H = RT * (1 + ar[0][1] + a0[1] + ar[1][0]);
-    S = R * (a0[1] + ar[1][0] - a0[0] - ar[0][0]);
-    Cv = -R * (a0[2] + ar[2][0]);
-    if (D > epsilon){
-        Cp = Cv + T * (dPdT / D) * (dPdT / D) / dPdD;
-        d2PdD2 = RT * (2 * ar[0][1] + 4 * ar[0][2] + ar[0][3]) / D;
-        JT = (T / D * dPdT / dPdD - 1) / Cp / D; //  '=(dB/dT*T-B)/Cp for an ideal gas, but dB/dT is not known
-    }
-    else{
-        Cp = Cv + R;
-        d2PdD2 = 0;
-        JT = 1E+20;
+  Dr = 0;
+  Vr = 0;
+  Tr = 0;
+  for (int i = 1; i <= NcGERG; ++i){
+    if (x[i] > epsilon){
+      F = 1;
+      for (int j = i; j <= NcGERG; ++j){
+        if (x[j] > epsilon){
+          xij = F * (x[i] * x[j]) * (x[i] + x[j]);
+          Vr = Vr + xij * gvij[i][j] / (bvij[i][j] * x[i] + x[j]);
+          Tr = Tr + xij * gtij[i][j] / (btij[i][j] * x[i] + x[j]);
+          F = 2;
+        }
+      }
     }
-    W = 1000 * Cp / Cv * dPdD / Mm;
-    if (W < 0) { W = 0; }
-    W = sqrt(W);
-    Kappa = pow(W, 2) * Mm / (RT * 1000 * Z);
-    Cf = sqrt(Kappa * pow( (2 / (Kappa + 1)), ((Kappa + 1) / (Kappa - 1))));
+  }
+  if (Vr > epsilon){ Dr = 1 / Vr; }
 }
 
-
-// The following routines are low-level routines that should not be called outside of this code.
 /**
  * @brief Calculates reducing variables for temperature and density in GERG-2008 EOS
  * 
@@ -428,22 +1256,31 @@ void PropertiesGERG(const double T, const double D, const std::vector<double> &x
  * If not, it returns the previously calculated values. If the composition has changed,
  * it calculates new reducing parameters using the GERG-2008 mixing rules.
  * 
+ * It also refreshes SumxLnx, the Sum(x*ln(x)) term used by Alpha0GERG, and the short form
+ * pseudo-component coefficients noagg used by tTermsGERG, and sets iPureGERG on every call.
+ *
  * @note The function uses global variables xold, Drold, Trold, Told, Trold2, epsilon,
  * NcGERG, gvij, bvij, gtij, and btij.
  * 
  * @warning Input vector x must be sized appropriately (at least NcGERG+1 elements)
  */
-static void ReducingParametersGERG(const std::vector<double> &x, double &Tr, double &Dr)
+template <typename X>
+static void ReducingParametersGERG(const X &x, double &Tr, double &Dr)
 {
-  double Vr, xij, F;
-  int icheck;
+  AGA8_TRACE_SCOPE("ReducingParametersGERG");
+  int icheck, nx, ix;
 
   // Check to see if a component fraction has changed.  If x is the same as the previous call, then exit.
+  // The number of non-zero fractions is counted on the way to detect a pure fluid.
   icheck = 0;
+  nx = 0;
+  ix = 0;
   for (int i = 1; i <= NcGERG; ++i){
     if (std::abs(x[i] - xold[i]) > 0.0000001){ icheck = 1; }
     xold[i] = x[i];
+    if (x[i] != 0){ ++nx; ix = i; }
   }
+  iPureGERG = (nx == 1 && x[ix] > epsilon) ? ix : 0;
   if (icheck == 0){
     Dr = Drold;
     Tr = Trold;
@@ -452,26 +1289,87 @@ static void ReducingParametersGERG(const std::vector<double> &x, double &Tr, dou
   Told = 0;
   Trold2 = 0;
 
-  // Calculate reducing variables for T and D
-  Dr = 0;
-  Vr = 0;
-  Tr = 0;
+  ReducingValuesGERG(x, Tr, Dr);
+  Drold = Dr;
+  Trold = Tr;
+
+  SumxLnx = 0;
   for (int i = 1; i <= NcGERG; ++i){
-    if (x[i] > epsilon){
-      F = 1;
-      for (int j = i; j <= NcGERG; ++j){
-        if (x[j] > epsilon){
-          xij = F * (x[i] * x[j]) * (x[i] + x[j]);
-          Vr = Vr + xij * gvij[i][j] / (bvij[i][j] * x[i] + x[j]);
-          Tr = Tr + xij * gtij[i][j] / (btij[i][j] * x[i] + x[j]);
-          F = 2;
+    if (x[i] > epsilon){ SumxLnx += x[i] * log(x[i]); }
+  }
+
+  nShortGERG = 0;
+  for (int k = 1; k <= kpol[5] + kexp[5]; ++k){ noagg[k] = 0; }
+  for (int i = 1; i <= NcGERG; ++i){
+    if (x[i] > epsilon && IsShortFormGERG(i)){
+      ++nShortGERG;
+      for (int k = 1; k <= kpol[i] + kexp[i]; ++k){ noagg[k] += x[i] * noik[i][k]; }
+    }
+  }
+}
+
+/**
+ * @brief Temperature dependent part of the ideal gas Helmholtz energy of one pure component
+ *
+ * @param T Temperature (K)
+ * @param i Component number (1 to 21)
+ * @param[out] c0 n0i1 + n0i2/T - n0i3*ln(T) + Sum(hyperbolic terms), the part of alpha0 not depending on x and D
+ * @param[out] c1 tau*d(c0)/d(tau)
+ * @param[out] c2 -tau^2*d^2(c0)/d(tau)^2
+ */
+template <typename V>
+static void IdealTermsGERG(const V &T, const int i, V &c0, V &c1, V &c2)
+{
+  using std::abs;
+  V LogHyp, th0T, em, ep, hcn, hsn;
+  V SumHyp0 = 0, SumHyp1 = 0, SumHyp2 = 0;
+
+  for (int j = 4; j <= 7; ++j){
+    if (th0i[i][j] > epsilon){
+      th0T = th0i[i][j] / T;
+      ep = exp(th0T);
+      em = 1 / ep;
+      hsn = (ep - em) / 2;
+      hcn = (ep + em) / 2;
+      if (j == 4 || j == 6){
+        LogHyp = log(abs(hsn));
+        SumHyp0 = SumHyp0 + n0i[i][j] * LogHyp;
+        SumHyp1 = SumHyp1 + n0i[i][j] * th0T * hcn / hsn;
+        SumHyp2 = SumHyp2 + n0i[i][j] * (th0T / hsn)* (th0T / hsn);
         }
+      else{
+        LogHyp = log(abs(hcn));
+        SumHyp0 = SumHyp0 - n0i[i][j] * LogHyp;
+        SumHyp1 = SumHyp1 - n0i[i][j] * th0T * hsn / hcn;
+        SumHyp2 = SumHyp2 + n0i[i][j] * (th0T / hcn) * (th0T / hcn);
       }
     }
   }
-  if (Vr > epsilon){ Dr = 1 / Vr; }
-  Drold = Dr;
-  Trold = Tr;
+  c0 = n0i[i][1] + n0i[i][2] / T - n0i[i][3] * log(T) + SumHyp0;
+  c1 = n0i[i][3] + n0i[i][2] / T + SumHyp1;
+  c2 = n0i[i][3] + SumHyp2;
+}
+
+/**
+ * @brief Find (or claim) the ideal gas cache slot of temperature T
+ *
+ * The slots are shared by every composition evaluated at the same temperature, and the terms of a
+ * component are only filled the first time that component is needed at that temperature.
+ * Temperatures are matched exactly so that cached values are bit-identical to a fresh evaluation.
+ *
+ * @param T Temperature (K)
+ * @return Slot index in a0T and a0Tset
+ */
+static int IdealSlotGERG(const double T)
+{
+  for (int s = 0; s < NTSlots; ++s){
+    if (a0Told[s] == T){ return s; }
+  }
+  int s = a0Tnext;
+  a0Tnext = (a0Tnext + 1) % NTSlots;
+  a0Told[s] = T;
+  for (int i = 1; i <= NcGERG; ++i){ a0Tset[s][i] = false; }
+  return s;
 }
 
 /**
@@ -485,49 +1383,132 @@ static void ReducingParametersGERG(const std::vector<double> &x, double &Tr, dou
  *               - a0[1]: tau*d(alpha0)/d(tau) 
  *               - a0[2]: tau^2*d^2(alpha0)/d(tau)^2
  */
-static void Alpha0GERG(const double T, const double D, const std::vector<double> &x, double a0[3])
+template <typename X>
+static void Alpha0GERG(const double T, const double D, const X &x, double a0[3])
 {
-  double LogT, LogD, LogHyp, th0T, LogxD;
-  double SumHyp0, SumHyp1, SumHyp2;
-  double em, ep, hcn, hsn;
+  AGA8_TRACE_SCOPE("Alpha0GERG");
+  double LogD, Tr, Dr;
+  int s;
 
-  a0[0] = 0; a0[1] = 0; a0[2] = 0;
+  // Refresh SumxLnx if the composition has changed
+  ReducingParametersGERG(x, Tr, Dr);
+  s = IdealSlotGERG(T);
+
+  a0[0] = SumxLnx; a0[1] = 0; a0[2] = 0;
   if (D > epsilon) {LogD = log(D);} else {LogD = log(epsilon);}
-  LogT = log(T);
-  for (int i = 1; i <= NcGERG; ++i){
+  const int i0 = iPureGERG > 0 ? iPureGERG : 1, i1 = iPureGERG > 0 ? iPureGERG : NcGERG;
+  for (int i = i0; i <= i1; ++i){
     if (x[i] > epsilon){
-      LogxD = LogD + log(x[i]);
-      SumHyp0 = 0;
-      SumHyp1 = 0;
-      SumHyp2 = 0;
-      for (int j = 4; j <= 7; ++j){
-        if (th0i[i][j] > epsilon){
-          th0T = th0i[i][j] / T;
-          ep = exp(th0T);
-          em = 1 / ep;
-          hsn = (ep - em) / 2;
-          hcn = (ep + em) / 2;
-          if (j == 4 || j == 6){
-            LogHyp = log(std::abs(hsn));
-            SumHyp0 = SumHyp0 + n0i[i][j] * LogHyp;
-            SumHyp1 = SumHyp1 + n0i[i][j] * th0T * hcn / hsn;
-            SumHyp2 = SumHyp2 + n0i[i][j] * (th0T / hsn)* (th0T / hsn);
-            }
-          else{
-            LogHyp = log(std::abs(hcn));
-            SumHyp0 = SumHyp0 - n0i[i][j] * LogHyp;
-            SumHyp1 = SumHyp1 - n0i[i][j] * th0T * hsn / hcn;
-            SumHyp2 = SumHyp2 + n0i[i][j] * (th0T / hcn) * (th0T / hcn);
-          }
-        }
-      }
-      a0[0] += +x[i] * (LogxD + n0i[i][1] + n0i[i][2] / T - n0i[i][3] * LogT + SumHyp0);
-      a0[1] += +x[i] * (n0i[i][3] + n0i[i][2] / T + SumHyp1);
-      a0[2] += -x[i] * (n0i[i][3] + SumHyp2);
+      if (!a0Tset[s][i]){ IdealTermsGERG(T, i, a0T[s][0][i], a0T[s][1][i], a0T[s][2][i]); a0Tset[s][i] = true; }
+      a0[0] += +x[i] * (LogD + a0T[s][0][i]);
+      a0[1] += +x[i] * a0T[s][1][i];
+      a0[2] += -x[i] * a0T[s][2][i];
     }
   }
 }
 
+/**
+ * @brief Add the pure fluid terms of one component to the residual Helmholtz derivatives
+ *
+ * @param itau Calculate tau derivatives if > 0
+ * @param i Component whose exponents (doik, coik, toik) are used
+ * @param xi Weight of the component (mole fraction, or 1 when tp already includes it)
+ * @param tp Temperature terms noik*tau^toik (see tTermsGERG)
+ * @param delp Powers of del
+ * @param Expd exp(-del^c) for the exponents c
+ * @param[in,out] ar Residual Helmholtz derivatives (see AlpharGERG)
+ */
+template <typename V>
+static void PureTermsGERG(const int itau, const int i, const V &xi, const V tp[], const V delp[], const V Expd[], V ar[4][4])
+{
+    V ex, ex2, ex3, ndt, ndtd, ndtt;
+
+    for (int k = 1; k <= kpol[i]; ++k){
+        ndt = xi * delp[doik[i][k]] * tp[k];
+        ndtd = ndt * doik[i][k];
+        ar[0][1] += ndtd;
+        ar[0][2] += ndtd * (doik[i][k] - 1);
+        if (itau > 0){
+            ndtt = ndt * toik[i][k];
+            ar[0][0] += ndt;
+            ar[1][0] += ndtt;
+            ar[2][0] += ndtt * (toik[i][k] - 1);
+            ar[1][1] += ndtt * doik[i][k];
+            ar[1][2] += ndtt * doik[i][k] * (doik[i][k] - 1);
+            ar[0][3] += ndtd * (doik[i][k] - 1) * (doik[i][k] - 2);
+        }
+    }
+    for (int k = 1 + kpol[i]; k <= kpol[i] + kexp[i]; ++k){
+        ndt = xi * delp[doik[i][k]] * tp[k]*Expd[coik[i][k]];
+        ex = coik[i][k] * delp[coik[i][k]];
+        ex2 = doik[i][k] - ex;
+        ex3 = ex2 * (ex2 - 1);
+        ar[0][1] += ndt * ex2;
+        ar[0][2] += ndt * (ex3 - coik[i][k] * ex);
+        if (itau > 0){
+            ndtt = ndt * toik[i][k];
+            ar[0][0] += ndt;
+            ar[1][0] += ndtt;
+            ar[2][0] += ndtt * (toik[i][k] - 1);
+            ar[1][1] += ndtt * ex2;
+            ar[1][2] += ndtt * (ex3 - coik[i][k] * ex);
+            ar[0][3] += ndt * (ex3 * (ex2 - 2) - ex * (3 * ex2 - 3 + coik[i][k]) * coik[i][k]);
+        }
+    }
+}
+
+/**
+ * @brief Add the binary departure terms of one pair to the residual Helmholtz derivatives
+ *
+ * @param itau Calculate tau derivatives if > 0
+ * @param mn Departure function number of the pair (mNumb)
+ * @param xijf x[i]*x[j]*fij of the pair
+ * @param del Reduced density
+ * @param lntau Natural logarithm of the inverse reduced temperature
+ * @param delp Powers of del
+ * @param tp Temperature terms nijk*tau^tijk of the polynomial terms (see tTermsGERG)
+ * @param[in,out] ar Residual Helmholtz derivatives (see AlpharGERG)
+ */
+template <typename V>
+static void DepartureTermsGERG(const int itau, const int mn, const V &xijf, const V &del, const V &lntau, const V delp[], const V tp[], V ar[4][4])
+{
+    V cij0, eij0, ex, ex2, ndt, ndtd, ndtt;
+
+    for (int k = 1; k <= kpolij[mn]; ++k){
+        ndt = xijf * delp[dijk[mn][k]] * tp[k];
+        ndtd = ndt * dijk[mn][k];
+        ar[0][1] += ndtd;
+        ar[0][2] += ndtd * (dijk[mn][k] - 1);
+        if (itau > 0){
+            ndtt = ndt * tijk[mn][k];
+            ar[0][0] += ndt;
+            ar[1][0] += ndtt;
+            ar[2][0] += ndtt * (tijk[mn][k] - 1);
+            ar[1][1] += ndtt * dijk[mn][k];
+            ar[1][2] += ndtt * dijk[mn][k] * (dijk[mn][k] - 1);
+            ar[0][3] += ndtd * (dijk[mn][k] - 1) * (dijk[mn][k] - 2);
+        }
+    }
+    for (int k = 1 + kpolij[mn]; k <= kpolij[mn] + kexpij[mn]; ++k){
+        cij0 = cijk[mn][k] * delp[2];
+        eij0 = eijk[mn][k] * del;
+        ndt = xijf * nijk[mn][k] * delp[dijk[mn][k]] * exp(cij0 + eij0 + gijk[mn][k] + tijk[mn][k] * lntau);
+        ex = dijk[mn][k] + 2 * cij0 + eij0;
+        ex2 = (ex * ex - dijk[mn][k] + 2 * cij0);
+        ar[0][1] += ndt * ex;
+        ar[0][2] += ndt * ex2;
+        if(itau > 0){
+            ndtt = ndt * tijk[mn][k];
+            ar[0][0] += ndt;
+            ar[1][0] += ndtt;
+            ar[2][0] += ndtt * (tijk[mn][k] - 1);
+            ar[1][1] += ndtt * ex;
+            ar[1][2] += ndtt * ex2;
+            ar[0][3] += ndt * (ex * (ex2 - 2 * (dijk[mn][k] - 2 * cij0)) + 2 * dijk[mn][k]);
+        }
+    }
+}
+
 /**
  * @brief Calculate alphar - Residual Helmholtz energy and derivatives
  * 
@@ -545,12 +1526,14 @@ static void Alpha0GERG(const double T, const double D, const std::vector<double>
  *               - ar[1][1]: tau*delta*d^2(ar)/d(tau)/d(delta)
  *               - ar[2][0]: tau^2*d^2(ar)/d(tau)^2
  */
-static void AlpharGERG(const int itau, const int idelta, const double T, const double D, const std::vector<double> &x, double ar[4][4])
+template <typename X>
+static void AlpharGERG(const int itau, const int idelta, const double T, const double D, const X &x, double ar[4][4])
 {
+    AGA8_TRACE_SCOPE("AlpharGERG");
     int mn;
     double Tr, Dr, del, tau;
-    double lntau, ex, ex2, ex3, cij0, eij0;
-    double delp[7+1], Expd[7+1], ndt, ndtd, ndtt, xijf;
+    double lntau;
+    double delp[7+1], Expd[7+1], xijf;
 
     for (int i = 0; i <= 3; ++i){ for (int j = 0; j <= 3; ++j){ ar[i][j] = 0; } }
 
@@ -573,45 +1556,102 @@ static void AlpharGERG(const int itau, const int idelta, const double T, const d
     Told = T;
     Trold2 = Tr;
 
-    // Calculate pure fluid contributions
+    // Pure fluid: only the terms of that component (or of the pseudo-component if it uses the short form)
+    if (iPureGERG > 0){
+        if (IsShortFormGERG(iPureGERG)){ PureTermsGERG(itau, 5, 1.0, taupagg, delp, Expd, ar); }
+        else{ PureTermsGERG(itau, iPureGERG, x[iPureGERG], taup[iPureGERG], delp, Expd, ar); }
+        return;
+    }
+
+    // Calculate pure fluid contributions, the short form components being evaluated together as one pseudo-component
     for (int i = 1; i <= NcGERG; ++i){
+        if (x[i] > epsilon && !IsShortFormGERG(i)){
+            PureTermsGERG(itau, i, x[i], taup[i], delp, Expd, ar);
+        }
+    }
+    if (nShortGERG > 0){
+        PureTermsGERG(itau, 5, 1.0, taupagg, delp, Expd, ar);
+    }
+
+    // Calculate mixture contributions
+    for (int i = 1; i <= NcGERG - 1; ++i){
         if (x[i] > epsilon){
-            for (int k = 1; k <= kpol[i]; ++k){
-                ndt = x[i] * delp[doik[i][k]] * taup[i][k];
-                ndtd = ndt * doik[i][k];
-                ar[0][1] += ndtd;
-                ar[0][2] += ndtd * (doik[i][k] - 1);
-                if (itau > 0){
-                    ndtt = ndt * toik[i][k];
-                    ar[0][0] += ndt;
-                    ar[1][0] += ndtt;
-                    ar[2][0] += ndtt * (toik[i][k] - 1);
-                    ar[1][1] += ndtt * doik[i][k];
-                    ar[1][2] += ndtt * doik[i][k] * (doik[i][k] - 1);
-                    ar[0][3] += ndtd * (doik[i][k] - 1) * (doik[i][k] - 2);
-                }
-            }
-            for (int k = 1 + kpol[i]; k <= kpol[i] + kexp[i]; ++k){
-                ndt = x[i] * delp[doik[i][k]] * taup[i][k]*Expd[coik[i][k]];
-                ex = coik[i][k] * delp[coik[i][k]];
-                ex2 = doik[i][k] - ex;
-                ex3 = ex2 * (ex2 - 1);
-                ar[0][1] += ndt * ex2;
-                ar[0][2] += ndt * (ex3 - coik[i][k] * ex);
-                if (itau > 0){
-                    ndtt = ndt * toik[i][k];
-                    ar[0][0] += ndt;
-                    ar[1][0] += ndtt;
-                    ar[2][0] += ndtt * (toik[i][k] - 1);
-                    ar[1][1] += ndtt * ex2;
-                    ar[1][2] += ndtt * (ex3 - coik[i][k] * ex);
-                    ar[0][3] += ndt * (ex3 * (ex2 - 2) - ex * (3 * ex2 - 3 + coik[i][k]) * coik[i][k]);
+            for (int j = i + 1; j <= NcGERG; ++j){
+                if (x[j] > epsilon){
+                    mn = mNumb[i][j];
+                    if (mn >= 0){
+                        xijf = x[i] * x[j] * fij[i][j];
+                        DepartureTermsGERG(itau, mn, xijf, del, lntau, delp, taupijk[mn], ar);
+                    }
                 }
             }
         }
     }
+}
+
+/**
+ * @brief Alpha0GERG for any scalar type, without the temperature and composition caches
+ *
+ * @param T Temperature (K)
+ * @param D Density (mol/l)
+ * @param x Composition (mole fraction)
+ * @param[out] a0 Ideal gas Helmholtz energy and derivatives (see Alpha0GERG)
+ */
+template <typename V>
+static void Alpha0ScalarGERG(const V &T, const V &D, const std::vector<V> &x, V a0[3])
+{
+  V LogD, c0, c1, c2;
+
+  a0[0] = 0; a0[1] = 0; a0[2] = 0;
+  if (D > epsilon) {LogD = log(D);} else {LogD = log(epsilon);}
+  for (int i = 1; i <= NcGERG; ++i){
+    if (x[i] > epsilon){
+      IdealTermsGERG(T, i, c0, c1, c2);
+      a0[0] += +x[i] * (LogD + c0 + log(x[i]));
+      a0[1] += +x[i] * c1;
+      a0[2] += -x[i] * c2;
+    }
+  }
+}
+
+/**
+ * @brief AlpharGERG for any scalar type, without the temperature and composition caches
+ *
+ * The temperature terms are calculated on the way for each component and pair, and the short form
+ * components are summed one by one instead of as one pseudo-component.
+ *
+ * @param itau Calculate tau derivatives if > 0
+ * @param T Temperature (K)
+ * @param D Density (mol/l)
+ * @param x Composition (mole fraction)
+ * @param[out] ar Residual Helmholtz derivatives (see AlpharGERG)
+ */
+template <typename V>
+static void AlpharScalarGERG(const int itau, const V &T, const V &D, const std::vector<V> &x, V ar[4][4])
+{
+    int mn;
+    V Tr, Dr, del, lntau, xijf;
+    V delp[7+1], Expd[7+1], tp[MaxTrmP+1];
+
+    for (int i = 0; i <= 3; ++i){ for (int j = 0; j <= 3; ++j){ ar[i][j] = 0; } }
+
+    ReducingValuesGERG(x, Tr, Dr);
+    del = D / Dr;
+    lntau = log(Tr / T);
+    delp[1] = del;
+    Expd[1] = exp(-delp[1]);
+    for (int i = 2; i <= 7; ++i){
+        delp[i] = delp[i - 1] * del;
+        Expd[i] = exp(-delp[i]);
+    }
+
+    for (int i = 1; i <= NcGERG; ++i){
+        if (x[i] > epsilon){
+            for (int k = 1; k <= kpol[i] + kexp[i]; ++k){ tp[k] = noik[i][k] * exp(toik[i][k] * lntau); }
+            PureTermsGERG(itau, i, x[i], tp, delp, Expd, ar);
+        }
+    }
 
-    // Calculate mixture contributions
     for (int i = 1; i <= NcGERG - 1; ++i){
         if (x[i] > epsilon){
             for (int j = i + 1; j <= NcGERG; ++j){
@@ -619,39 +1659,8 @@ static void AlpharGERG(const int itau, const int idelta, const double T, const d
                     mn = mNumb[i][j];
                     if (mn >= 0){
                         xijf = x[i] * x[j] * fij[i][j];
-                        for (int k = 1; k <= kpolij[mn]; ++k){
-                            ndt = xijf * delp[dijk[mn][k]] * taupijk[mn][k];
-                            ndtd = ndt * dijk[mn][k];
-                            ar[0][1] += ndtd;
-                            ar[0][2] += ndtd * (dijk[mn][k] - 1);
-                            if (itau > 0){
-                                ndtt = ndt * tijk[mn][k];
-                                ar[0][0] += ndt;
-                                ar[1][0] += ndtt;
-                                ar[2][0] += ndtt * (tijk[mn][k] - 1);
-                                ar[1][1] += ndtt * dijk[mn][k];
-                                ar[1][2] += ndtt * dijk[mn][k] * (dijk[mn][k] - 1);
-                                ar[0][3] += ndtd * (dijk[mn][k] - 1) * (dijk[mn][k] - 2);
-                            }
-                        }
-                        for (int k = 1 + kpolij[mn]; k <= kpolij[mn] + kexpij[mn]; ++k){
-                            cij0 = cijk[mn][k] * delp[2];
-                            eij0 = eijk[mn][k] * del;
-                            ndt = xijf * nijk[mn][k] * delp[dijk[mn][k]] * exp(cij0 + eij0 + gijk[mn][k] + tijk[mn][k] * lntau);
-                            ex = dijk[mn][k] + 2 * cij0 + eij0;
-                            ex2 = (ex * ex - dijk[mn][k] + 2 * cij0);
-                            ar[0][1] += ndt * ex;
-                            ar[0][2] += ndt * ex2;
-                            if(itau > 0){
-                                ndtt = ndt * tijk[mn][k];
-                                ar[0][0] += ndt;
-                                ar[1][0] += ndtt;
-                                ar[2][0] += ndtt * (tijk[mn][k] - 1);
-                                ar[1][1] += ndtt * ex;
-                                ar[1][2] += ndtt * ex2;
-                                ar[0][3] += ndt * (ex * (ex2 - 2 * (dijk[mn][k] - 2 * cij0)) + 2 * dijk[mn][k]);
-                            }
-                        }
+                        for (int k = 1; k <= kpolij[mn]; ++k){ tp[k] = nijk[mn][k] * exp(tijk[mn][k] * lntau); }
+                        DepartureTermsGERG(itau, mn, xijf, del, lntau, delp, tp, ar);
                     }
                 }
             }
@@ -671,40 +1680,49 @@ static void AlpharGERG(const int itau, const int idelta, const double T, const d
  *
  * @details
  * The function calculates:
- * - Temperature-dependent terms for pure fluids using propane as reference
+ * - Temperature-dependent terms of the short form pseudo-component (noagg) using propane as reference
  * - Special handling for components 1-4, 15, 18, and 20
  * - Binary interaction parameters for mixture calculations
  * 
  * The results are stored in global arrays:
- * - taup[][] for pure fluid terms
+ * - taup[][] for pure fluid terms of components 1-4, 15, 18, and 20
+ * - taupagg[] for the short form pseudo-component
  * - taupijk[][] for mixture interaction terms
  * 
  * @note This is an internal helper function used in the GERG-2008 EOS calculations
  * @note Components with mole fractions below epsilon are skipped for optimization
  */
-static void tTermsGERG(const double lntau, const std::vector<double> &x)
+template <typename X>
+static void tTermsGERG(const double lntau, const X &x)
 {
+    AGA8_TRACE_SCOPE("tTermsGERG");
     int i, mn;
     double taup0[12+1];
 
+    // Pure fluid: no pseudo-component unless the fluid uses the short form, and no binary terms
+    if (iPureGERG > 0 && !IsShortFormGERG(iPureGERG)){
+        i = iPureGERG;
+        for (int k = 1; k <= kpol[i] + kexp[i]; ++k){
+            taup[i][k] = noik[i][k] * exp(toik[i][k] * lntau);
+        }
+        return;
+    }
+
     i = 5;  // Use propane to get exponents for short form of EOS
     for (int k = 1; k <= kpol[i] + kexp[i]; ++k){
         taup0[k] = exp(toik[i][k] * lntau);
     }
+    for (int k = 1; k <= kpol[i] + kexp[i]; ++k){
+        taupagg[k] = noagg[k] * taup0[k];
+    }
     for (int i = 1; i <= NcGERG; ++i){
-        if (x[i] > epsilon){
-            if (i > 4 && i != 15 && i != 18 && i != 20 ) {
-                for (int k = 1; k <= kpol[i] + kexp[i]; ++k){
-                    taup[i][k] = noik[i][k] * taup0[k];
-                }
-            }
-            else{
-                for (int k = 1; k <= kpol[i] + kexp[i]; ++k){
-                    taup[i][k] = noik[i][k] * exp(toik[i][k] * lntau);
-                }
+        if (x[i] > epsilon && !IsShortFormGERG(i)){
+            for (int k = 1; k <= kpol[i] + kexp[i]; ++k){
+                taup[i][k] = noik[i][k] * exp(toik[i][k] * lntau);
             }
         }
     }
+    if (iPureGERG > 0){ return; }
 
     for (int i = 1; i <= NcGERG - 1; ++i) {
         if (x[i] > epsilon){
@@ -725,13 +1743,15 @@ static void tTermsGERG(const double lntau, const std::vector<double> &x)
 /**
  * @brief Calculate pseudo-critical point
  *
- * Calculates mole fraction average of critical temperatures and volumes
+ * Calculates mole fraction average of critical temperatures and volumes.
+ * ReducingParametersGERG must have been called with the same x (see iPureGERG).
  *
  * @param x Composition array (mole fraction)
  * @param[out] Tcx Pseudo-critical temperature (K)
  * @param[out] Dcx Pseudo-critical density (mol/l)
  */
-static void PseudoCriticalPointGERG(const std::vector<double> &x, double &Tcx, double &Dcx)
+template <typename X>
+static void PseudoCriticalPointGERGImpl(const X &x, double &Tcx, double &Dcx)
 {
     // PseudoCriticalPointGERG(x, Tcx, Dcx)
 
@@ -741,6 +1761,13 @@ static void PseudoCriticalPointGERG(const std::vector<double> &x, double &Tcx, d
     Tcx = 0;
     Vcx = 0;
     Dcx = 0;
+    if (iPureGERG > 0){
+        // Pure fluid (iPureGERG was set by the preceding ReducingParametersGERG call)
+        Tcx = x[iPureGERG] * Tc[iPureGERG];
+        Vcx = x[iPureGERG] / Dc[iPureGERG];
+        if (Vcx > epsilon){ Dcx = 1 / Vcx; }
+        return;
+    }
     for (int i = 1; i <= NcGERG; ++i){
         Tcx = Tcx + x[i] * Tc[i];
         Vcx = Vcx + x[i] / Dc[i];
@@ -748,6 +1775,45 @@ static void PseudoCriticalPointGERG(const std::vector<double> &x, double &Tcx, d
     if (Vcx > epsilon){ Dcx = 1 / Vcx; }
 }
 
+/**
+ * @brief Pseudo-critical point of a composition, the mole fraction average of the critical temperatures and volumes
+ *
+ * 3 times the pseudo-critical density is the initial estimate of DensityGERG with iFlag = 2.
+ * SetupGERG must have been called.
+ *
+ * @param x Composition (mole fraction)
+ * @param[out] Tcx Pseudo-critical temperature (K)
+ * @param[out] Dcx Pseudo-critical density (mol/l)
+ */
+void PseudoCriticalPointGERG(const std::vector<double> &x, double &Tcx, double &Dcx)
+{
+  double Tr, Dr;
+  ReducingParametersGERG(x, Tr, Dr);
+  PseudoCriticalPointGERGImpl(x, Tcx, Dcx);
+}
+
+/**
+ * @brief PseudoCriticalPointGERG for a fixed-size Composition
+ * @see PseudoCriticalPointGERG
+ */
+void PseudoCriticalPointGERG(const Composition &x, double &Tcx, double &Dcx)
+{
+  double Tr, Dr;
+  ReducingParametersGERG(x, Tr, Dr);
+  PseudoCriticalPointGERGImpl(x, Tcx, Dcx);
+}
+
+/**
+ * @brief PseudoCriticalPointGERG for a CompositionView, e.g. a row of a composition matrix
+ * @see PseudoCriticalPointGERG
+ */
+void PseudoCriticalPointGERG(const CompositionView &x, double &Tcx, double &Dcx)
+{
+  double Tr, Dr;
+  ReducingParametersGERG(x, Tr, Dr);
+  PseudoCriticalPointGERGImpl(x, Tcx, Dcx);
+}
+
 /**
  * @brief Initializes all the constants and parameters in the GERG-2008 model.
  * 
@@ -785,10 +1851,9 @@ void SetupGERG()
   Rsr = Rs / RGERG;
   o13 = 1.0 / 3.0;
 
-  for (int i = 1; i <= MaxFlds; ++i){
-    xold[i] = 0;
-  }
-  Told = 0;
+  InvalidateCacheGERG();
+  for (int s = 0; s < NTSlots; ++s){ a0Told[s] = 0; }
+  a0Tnext = 0;
 
   // Molar masses [g/mol]
   MMiGERG[1] = 16.04246;    // Methane
@@ -1685,6 +2750,17 @@ void SetupGERG()
   // }
 }
 
+// Scalar types of PressureGERG<V> and PropertiesGERG<V>
+#define AGA8_GERG_SCALAR(V) \
+  template void PressureGERG<V>(const V &T, const V &D, const std::vector<V> &x, V &P, V &Z); \
+  template void PropertiesGERG<V>(const V &T, const V &D, const std::vector<V> &x, V &P, V &Z, V &dPdD, V &d2PdD2, V &d2PdTD, V &dPdT, V &U, V &H, V &S, V &Cv, V &Cp, V &W, V &G, V &JT, V &Kappa, V &A, V &Cf);
+AGA8_GERG_SCALAR(float)
+AGA8_GERG_SCALAR(double)
+AGA8_GERG_SCALAR(Dual<1>)
+AGA8_GERG_SCALAR(Dual<2>)
+AGA8_GERG_SCALAR(Dual<23>)
+#undef AGA8_GERG_SCALAR
+
 #ifdef TEST_GERG
 int main()
 {
@@ -22,11 +22,90 @@ OR USE OF, THE SOFTWARE OR SERVICES PROVIDED HEREUNDER.
 
 #include <vector>
 #include <string>
+#include "Composition.h"
 
 void MolarMassGERG(const std::vector<double> &x, double &Mm);
+void MolarMassGERG(const Composition &x, double &Mm);
+void MolarMassGERG(const CompositionView &x, double &Mm);
 void PressureGERG(const double T, const double D, const std::vector<double> &x, double &P, double &Z);
+void PressureGERG(const double T, const double D, const Composition &x, double &P, double &Z);
+void PressureGERG(const double T, const double D, const CompositionView &x, double &P, double &Z);
 void DensityGERG(const int iflag, const double T, const double P, const std::vector<double> &x, double &D, int &ierr, std::string &herr);
+void DensityGERG(const int iflag, const double T, const double P, const std::vector<double> &x, double &D, int &ierr, const char *&herr);
+void DensityGERG(const int iflag, const double T, const double P, const Composition &x, double &D, int &ierr, const char *&herr);
+void DensityGERG(const int iflag, const double T, const double P, const CompositionView &x, double &D, int &ierr, const char *&herr);
+int DensityIterationsGERG();
+void PseudoCriticalPointGERG(const std::vector<double> &x, double &Tcx, double &Dcx);
+void PseudoCriticalPointGERG(const Composition &x, double &Tcx, double &Dcx);
+void PseudoCriticalPointGERG(const CompositionView &x, double &Tcx, double &Dcx);
 void PropertiesGERG(const double T, const double D, const std::vector<double> &x, double &P, double &Z, double &dPdD, double &d2PdD2, double &d2PdTD, double &dPdT, double &U, double &H, double &S, double &Cv, double &Cp, double &W, double &G, double &JT, double &Kappa, double &A, double &Cf);
+void PropertiesGERG(const double T, const double D, const Composition &x, double &P, double &Z, double &dPdD, double &d2PdD2, double &d2PdTD, double &dPdT, double &U, double &H, double &S, double &Cv, double &Cp, double &W, double &G, double &JT, double &Kappa, double &A, double &Cf);
+void PropertiesGERG(const double T, const double D, const CompositionView &x, double &P, double &Z, double &dPdD, double &d2PdD2, double &d2PdTD, double &dPdT, double &U, double &H, double &S, double &Cv, double &Cp, double &W, double &G, double &JT, double &Kappa, double &A, double &Cf);
+void CompositionDerivativesGERG(const double T, const double D, const std::vector<double> &x, double &P, double &Z, double &W, std::vector<double> &dZdx, std::vector<double> &dDdx, std::vector<double> &dWdx);
+void CompositionDerivativesGERG(const double T, const double D, const Composition &x, double &P, double &Z, double &W, Composition &dZdx, Composition &dDdx, Composition &dWdx);
+void CompositionDerivativesGERG(const double T, const double D, const CompositionView &x, double &P, double &Z, double &W, Composition &dZdx, Composition &dDdx, Composition &dWdx);
+void CompositionDerivativesBatchGERG(const std::vector<double> &T, const std::vector<double> &P, const std::vector<double> &x, std::vector<double> &D, std::vector<double> &Z, std::vector<double> &W, std::vector<double> &dZdx, std::vector<double> &dDdx, std::vector<double> &dWdx, std::vector<int> &ierr);
+void CompositionDerivativesBatchGERG(const std::vector<double> &T, const std::vector<double> &P, const Composition &x, std::vector<double> &D, std::vector<double> &Z, std::vector<double> &W, std::vector<double> &dZdx, std::vector<double> &dDdx, std::vector<double> &dWdx, std::vector<int> &ierr);
+void CompositionDerivativesBatchGERG(const std::vector<double> &T, const std::vector<double> &P, const CompositionView &x, std::vector<double> &D, std::vector<double> &Z, std::vector<double> &W, std::vector<double> &dZdx, std::vector<double> &dDdx, std::vector<double> &dWdx, std::vector<int> &ierr);
+// Scalar templates without caches, instantiated for float, double, Dual<1>, Dual<2> and Dual<23> (see Scalar.h)
+template <typename V> void PressureGERG(const V &T, const V &D, const std::vector<V> &x, V &P, V &Z);
+template <typename V> void PropertiesGERG(const V &T, const V &D, const std::vector<V> &x, V &P, V &Z, V &dPdD, V &d2PdD2, V &d2PdTD, V &dPdT, V &U, V &H, V &S, V &Cv, V &Cp, V &W, V &G, V &JT, V &Kappa, V &A, V &Cf);
 void SetupGERG();
 
+/**
+ * @brief GERG-2008 residual terms at a fixed temperature and composition, grouped by their density exponents
+ *
+ * All the composition and temperature dependent factors (x_i*taup, x_i*x_j*fij*taupijk, ...) are
+ * pre-multiplied, so that the pressure at a new density only needs one sum per (d, c) exponent pair
+ * and one per Gaussian-type departure term.
+ * @see PrepareIsothermGERG, PressureIsothermGERG
+ */
+struct PreparedIsothermGERG
+{
+    static const int MaxD = 7, MaxGroups = 7 * 7, MaxGauss = 10 * 12;
+    double T, Tr, Dr;          // Temperature and reducing parameters (K, K, mol/l)
+    double apol[MaxD + 1];     // Coefficients of the del^d terms, indexed by d
+    int nexp;                  // Number of del^d*exp(-del^c) groups
+    int dexp[MaxGroups], cexp[MaxGroups];
+    double aexp[MaxGroups];
+    int ngauss;                // Number of del^d*exp(c*del^2 + e*del) departure terms
+    int dgauss[MaxGauss];
+    double cgauss[MaxGauss], egauss[MaxGauss], agauss[MaxGauss];
+};
+
+void PrepareIsothermGERG(const double T, const std::vector<double> &x, PreparedIsothermGERG &iso);
+void PrepareIsothermGERG(const double T, const Composition &x, PreparedIsothermGERG &iso);
+void PrepareIsothermGERG(const double T, const CompositionView &x, PreparedIsothermGERG &iso);
+void PressureIsothermGERG(const PreparedIsothermGERG &iso, const double D, double &P, double &Z, double &dPdD);
+
+/**
+ * @brief GERG-2008 equation of a fixed composition, with all the composition dependent factors folded into the coefficients
+ *
+ * Terms with the same exponents are merged, so that a residual term is one of coef*del^d*tau^t,
+ * coef*del^d*tau^t*exp(-del^c) or coef*del^d*tau^t*exp(c*del^2 + e*del + g). The terms are written out
+ * as constants by the aga8-fixedgas generator (src/tools/fixedgas.cpp) and evaluated by FixedGasGERG.h.
+ * @see PrepareFixedGasGERG
+ */
+struct FixedGasTermsGERG
+{
+    static const int MaxHyp = 21 * 4, MaxTerms = 21 * 24, MaxGauss = 10 * 12;
+    double R, Mm, Tr, Dr, Tcx, Dcx;   // Gas constant, molar mass, reducing and pseudo-critical parameters
+    double Sumx, SumxLnx;             // Sum(x) and Sum(x*ln(x)) of the components used
+    double n01, n02, n03;             // Sum(x*n0i[1..3]) of the ideal gas part
+    int nhyp;                         // Number of x*n0*ln|sinh(th0/T)| or -x*n0*ln|cosh(th0/T)| ideal gas terms
+    int sinhhyp[MaxHyp];
+    double ahyp[MaxHyp], thhyp[MaxHyp];
+    int npol;                         // Number of coef*del^d*tau^t terms
+    int dpol[MaxTerms];
+    double tpol[MaxTerms], apol[MaxTerms];
+    int nexp;                         // Number of coef*del^d*tau^t*exp(-del^c) terms
+    int dexp[MaxTerms], cexp[MaxTerms];
+    double texp[MaxTerms], aexp[MaxTerms];
+    int ngauss;                       // Number of departure terms coef*del^d*tau^t*exp(c*del^2 + e*del + g)
+    int dgauss[MaxGauss];
+    double tgauss[MaxGauss], cgauss[MaxGauss], egauss[MaxGauss], ggauss[MaxGauss], agauss[MaxGauss];
+};
+
+void PrepareFixedGasGERG(const std::vector<double> &x, FixedGasTermsGERG &fg);
+
 #endif
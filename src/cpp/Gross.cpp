@@ -52,11 +52,14 @@ OR USE OF, THE SOFTWARE OR SERVICES PROVIDED HEREUNDER.
 //  **********  June 7, 2016  **********
 
 #include "Gross.h"
+#include "Trace.h"
 // We add both math headers to placate some non-standards-compliant compilers
 #include <math.h>
 #include <cmath>
 #include <iostream>
 #include <cstdlib>
+#include <algorithm>
+#include <limits>
 
 // Version 2.0 of routines for the calculation of thermodynamic
 // properties from the AGA 8 Part 1 GROSS equation of state.
@@ -87,12 +90,24 @@ OR USE OF, THE SOFTWARE OR SERVICES PROVIDED HEREUNDER.
 // ***** Subroutine SetupGross must be called once before calling other routines. ******
 // Function prototypes
 void Bmix(const double T, const std::vector<double> &xGrs, const double HCH, double &B, double &C, int &ierr, std::string &herr);
+void Bmix(const double T, const std::vector<double> &xGrs, const double HCH, double &B, double &C, int &ierr, const char *&herr);
 void MolarMassGross(const std::vector<double> &x, double &Mm);
 void PressureGross(const double T, const double D, const std::vector<double> &xGrs, const double HCH, double &P, double &Z, int &ierr, std::string &herr);
+void PressureGross(const double T, const double D, const std::vector<double> &xGrs, const double HCH, double &P, double &Z, int &ierr, const char *&herr);
 void DensityGross(const double T, const double P, const std::vector<double> &xGrs, const double HCH, double &D, int &ierr, std::string &herr);
+void DensityGross(const double T, const double P, const std::vector<double> &xGrs, const double HCH, double &D, int &ierr, const char *&herr);
+void DensityGrossIterative(const double T, const double P, const std::vector<double> &xGrs, const double HCH, double &D, int &ierr, std::string &herr);
+void DensityGrossIterative(const double T, const double P, const std::vector<double> &xGrs, const double HCH, double &D, int &ierr, const char *&herr);
+void DensityGrossBatch(const std::vector<double> &T, const std::vector<double> &P, const std::vector<double> &xCH, const std::vector<double> &xN2, const std::vector<double> &xCO2, const std::vector<double> &HCH, std::vector<double> &D, std::vector<double> &Z, std::vector<int> &ierr);
 void GrossHv(const std::vector<double> &x, std::vector<double> &xGrs, double &HN, double &HCH);
 void GrossInputs(const double T, const double P, const std::vector<double> &x, std::vector<double> &xGrs, double &Gr, double &HN, double &HCH, int &ierr, std::string &herr);
+void GrossInputs(const double T, const double P, const std::vector<double> &x, std::vector<double> &xGrs, double &Gr, double &HN, double &HCH, int &ierr, const char *&herr);
+void GrossMethod1Batch(const double Th, const double Td, const double Pd, const std::vector<double> &Gr, const std::vector<double> &Hv, const std::vector<double> &xCO2, std::vector<double> &xCH, std::vector<double> &xN2, std::vector<double> &Mm, std::vector<double> &HCH, std::vector<double> &HN, std::vector<int> &ierr);
+void GrossMethod2Batch(const double Th, const double Td, const double Pd, const std::vector<double> &Gr, const std::vector<double> &xN2, const std::vector<double> &xCO2, std::vector<double> &xCH, std::vector<double> &Hv, std::vector<double> &Mm, std::vector<double> &HCH, std::vector<double> &HN, std::vector<int> &ierr);
 void SetupGross();
+template <typename X> static void MolarMassGrossImpl(const X &x, double &Mm);
+template <typename X> static void GrossHvImpl(const X &x, std::vector<double> &xGrs, double &HN, double &HCH);
+template <typename X> static void GrossInputsImpl(const double T, const double P, const X &x, std::vector<double> &xGrs, double &Gr, double &HN, double &HCH, int &ierr, const char *&herr);
 
 // 'The compositions in the x() array use the following order and must be sent as mole fractions:
 // '    0 - PLACEHOLDER
@@ -125,22 +140,38 @@ void SetupGross();
 static double RGross;
 static const int NcGross = 21, MaxFlds = 21;
 static const double epsilon = 1e-15;
-static double mN2, mCO2, dPdDsave;
+static double mN2, mCO2;
 static double  xHN[MaxFlds+1] , MMiGross[MaxFlds+1]; // +1 since C/C++ is 0-based indexing
 static double b0[4][4], b1[4][4], b2[4][4], bCHx[3][3], cCHx[3][3];
 static double c0[4][4][4], c1[4][4][4], c2[4][4][4];
 
-/**
- * @brief Calculate molar mass of the mixture with the compositions contained in the x() input array
- * 
- * @param x Composition array (mole fraction)
- *          Do not send mole percents or mass fractions in the x() array, otherwise the output will be incorrect.
- *          The sum of the compositions in the x() array must be equal to one.
- *          The order of the fluids in this array is given at the top of this code.
- * @param Mm [out] Molar mass (g/mol)
- * @see MolarMassGross_wrapper for the Emscripten wrapper
- */
-void MolarMassGross(const std::vector<double> &x, double &Mm)
+// Temperature dependent terms of Bmix, kept for the last NTSlots temperatures (see BmixTermsGross)
+struct BmixTGross
+{
+    // Empty slots have T = NaN, which never matches a temperature, on every thread and before SetupGross. All members
+    // have initializers, so that the thread_local slots are constant-initialized.
+    double T = std::numeric_limits<double>::quiet_NaN();
+    double bCH[3] = {}, cCH[3] = {};                  // Coefficients of the HCH polynomials of B(CH-CH) and C(CH-CH-CH)
+    double B22 = 0, B23 = 0, B33 = 0;                 // Bij of nitrogen and CO2
+    double C222 = 0, C223 = 0, C233 = 0, C333 = 0;    // Cijk of nitrogen and CO2
+    double f12 = 0, f112 = 0;                         // Temperature factors of B(CH-N2) and of C(CH-CH-N2), C(CH-N2-N2)
+    double r222 = 0, r333 = 0;                        // Cube roots of C(N2-N2-N2) and C(CO2-CO2-CO2)
+};
+// The caches and results of the last calls are kept per thread: once SetupGross has filled the constants above, the
+// functions of this module may be called from several threads at once
+static const int NTSlots = 4;
+static thread_local BmixTGross BmixT[NTSlots];
+static thread_local int BmixTnext;
+static thread_local double dPdDsave;
+
+static const BmixTGross &BmixTermsGross(const double T);
+static int BmixRowGross(const BmixTGross &t, const double xCH, const double xN2, const double xCO2, const double HCH, double &B, double &C);
+static bool CubicDensityGross(const double pr, const double B, const double C, double &D);
+static double ZrefGross(const double Td, const double Pd);
+
+// MolarMassGross for any composition type with x[i], i = 1 to NcGross (std::vector, Composition, CompositionView)
+template <typename X>
+static void MolarMassGrossImpl(const X &x, double &Mm)
 {
 // Sub MolarMassGross(x, Mm)
 
@@ -161,10 +192,43 @@ void MolarMassGross(const std::vector<double> &x, double &Mm)
   }
 }
 
+/**
+ * @brief Calculate molar mass of the mixture with the compositions contained in the x() input array
+ * 
+ * @param x Composition array (mole fraction)
+ *          Do not send mole percents or mass fractions in the x() array, otherwise the output will be incorrect.
+ *          The sum of the compositions in the x() array must be equal to one.
+ *          The order of the fluids in this array is given at the top of this code.
+ * @param Mm [out] Molar mass (g/mol)
+ * @see MolarMassGross_wrapper for the Emscripten wrapper
+ */
+void MolarMassGross(const std::vector<double> &x, double &Mm)
+{
+    MolarMassGrossImpl(x, Mm);
+}
+
+/**
+ * @brief MolarMassGross for a fixed-size Composition
+ * @see MolarMassGross
+ */
+void MolarMassGross(const Composition &x, double &Mm)
+{
+    MolarMassGrossImpl(x, Mm);
+}
+
+/**
+ * @brief MolarMassGross for a CompositionView, e.g. a row of a composition matrix
+ * @see MolarMassGross
+ */
+void MolarMassGross(const CompositionView &x, double &Mm)
+{
+    MolarMassGrossImpl(x, Mm);
+}
+
 /**
  * @brief Calculate pressure as a function of temperature and density
  * 
- * The derivative d(P)/d(D) is also calculated for use in the iterative DensityGross 
+ * The derivative d(P)/d(D) is also calculated for use in the iterative DensityGrossIterative 
  * subroutine (and is only returned as a common variable).
  * 
  * @param T Temperature (K)
@@ -180,12 +244,12 @@ void MolarMassGross(const std::vector<double> &x, double &Mm)
  *       This variable is cached in the common variables for use in the iterative density solver
  * @see PressureGross_wrapper for the Emscripten wrapper
  */
-void PressureGross(const double T, const double D, const std::vector<double> &xGrs, const double HCH, double &P, double &Z, int &ierr, std::string &herr)
+void PressureGross(const double T, const double D, const std::vector<double> &xGrs, const double HCH, double &P, double &Z, int &ierr, const char *&herr)
 {
     // Sub PressureGross(T, D, xGrs, HCH, P, Z, ierr, herr)
     //
     // Calculate pressure as a function of temperature and density.  The derivative d(P)/d(D) is also calculated
-    // for use in the iterative DensityGross subroutine (and is only returned as a common variable).
+    // for use in the iterative DensityGrossIterative subroutine (and is only returned as a common variable).
     // 
     // Inputs:
     //      T - Temperature (K)
@@ -216,12 +280,178 @@ void PressureGross(const double T, const double D, const std::vector<double> &xG
     }
 }
 
+/**
+ * @brief PressureGross with the error message returned as a std::string
+ * @see PressureGross
+ */
+void PressureGross(const double T, const double D, const std::vector<double> &xGrs, const double HCH, double &P, double &Z, int &ierr, std::string &herr)
+{
+    const char *msg = "";
+    PressureGross(T, D, xGrs, HCH, P, Z, ierr, msg);
+    herr = msg;
+}
+
 /**
  * @brief Calculate density as a function of temperature and pressure
  * 
+ * The GROSS equation is the truncated virial form Z = 1 + B*D + C*D^2, so the density is a root of
+ * the cubic C*D^3 + B*D^2 + D - P/(R*T) = 0. Bmix is called once, the real roots are obtained in
+ * closed form, and the gas root (the smallest positive root, reached from the ideal gas limit) is
+ * polished with a few Newton steps on the cubic. If there is no root on the gas branch, the result
+ * (and error code) of DensityGrossIterative is returned.
+ * 
+ * @param T Temperature (K)
+ * @param P Pressure (kPa)
+ * @param xGrs Compositions of the equivalent hydrocarbon, nitrogen, and CO2 (mole fractions)
+ * @param HCH Molar ideal gross heating value of the hydrocarbon components (kJ/mol) at 298.15 K.
+ *            Call subroutine GrossHv or GrossInputs first to obtain HCH.
+ * @param[out] D Density (mol/l)
+ * @param[out] ierr Error number (0 indicates no error)
+ * @param[out] herr Error message if ierr is not equal to zero
+ * @see DensityGrossIterative for the original iterative solver
+ * @see DensityGross_wrapper for the Emscripten wrapper
+ */
+void DensityGross(const double T, const double P, const std::vector<double> &xGrs, const double HCH, double &D, int &ierr, const char *&herr)
+{
+    // Sub DensityGross(T, P, xGrs, HCH, D, ierr, herr)
+    //
+    // Calculate density as a function of temperature and pressure from the closed-form roots of
+    // C*D^3 + B*D^2 + D - P/(R*T) = 0.
+    //
+    // Inputs:
+    //      T - Temperature (K)
+    //      P - Pressure (kPa)
+    //   xGrs - Compositions of the equivalent hydrocarbon, nitrogen, and CO2 (mole fractions)
+    //    HCH - Molar ideal gross heating value of the hydrocarbon components (kJ/mol) at 298.15 K
+    //          *** Call subroutine GrossHv or GrossInputs first to obtain HCH. ***
+    //
+    // Outputs:
+    //      D - Density (mol/l)
+    //   ierr - Error number (0 indicates no error)
+    //   herr - Error message if ierr is not equal to zero
+
+    AGA8_TRACE_SCOPE("DensityGross");
+    double B, C;
+
+    ierr = 0;
+    herr = "";
+    if (P < epsilon){
+        D = 0; return;
+    }
+    D = P / RGross / T;       //Ideal gas density, returned on failure
+    Bmix(T, xGrs, HCH, B, C, ierr, herr);
+    if (ierr > 0){ return; }
+    if (!CubicDensityGross(P / RGross / T, B, C, D)){
+        // No root on the gas branch: the state is far outside the range of the GROSS method, where
+        // the iterative solver either fails or lands on the dense branch. Keep its exact behavior.
+        DensityGrossIterative(T, P, xGrs, HCH, D, ierr, herr);
+    }
+}
+
+/**
+ * @brief DensityGross with the error message returned as a std::string
+ * @see DensityGross
+ */
+void DensityGross(const double T, const double P, const std::vector<double> &xGrs, const double HCH, double &D, int &ierr, std::string &herr)
+{
+    const char *msg = "";
+    DensityGross(T, P, xGrs, HCH, D, ierr, msg);
+    herr = msg;
+}
+
+/**
+ * @brief Gas root of C*D^3 + B*D^2 + D - pr = 0
+ *
+ * The real roots are obtained in closed form and the smallest positive one is polished with a few
+ * Newton steps on the cubic.
+ *
+ * @param pr P/(R*T) (mol/l)
+ * @param B Second virial coefficient (dm^3/mol)
+ * @param C Third virial coefficient (dm^6/mol^2)
+ * @param[out] D Density (mol/l), only set when a root is found
+ * @return false if there is no root below the first density where d(P)/d(D) = 0
+ */
+static bool CubicDensityGross(const double pr, const double B, const double C, double &D)
+{
+    const double pi = 3.14159265358979323846;
+    double roots[3], f, df, dD;
+    int nroots;
+
+    // Real roots of C*D^3 + B*D^2 + D - pr = 0
+    nroots = 0;
+    if (C == 0){
+        if (B == 0){
+            roots[nroots++] = pr;
+        }
+        else if (1 + 4 * B * pr >= 0){
+            roots[nroots++] = 2 * pr / (1 + sqrt(1 + 4 * B * pr)); // Root connected to the ideal gas limit
+        }
+    }
+    else{
+        // Depressed cubic t^3 + p3*t + q3 = 0 with D = t - a/3
+        const double a = B / C, b = 1 / C, c = -pr / C;
+        const double p3 = b - a * a / 3;
+        const double q3 = 2 * a * a * a / 27 - a * b / 3 + c;
+        const double disc = q3 * q3 / 4 + p3 * p3 * p3 / 27;
+        if (disc > 0){
+            const double sq = sqrt(disc);
+            roots[nroots++] = std::cbrt(-q3 / 2 + sq) + std::cbrt(-q3 / 2 - sq) - a / 3;
+        }
+        else if (p3 < 0){
+            const double m = 2 * sqrt(-p3 / 3);
+            double arg = 3 * q3 / (p3 * m);
+            if (arg > 1){ arg = 1; }
+            if (arg < -1){ arg = -1; }
+            const double phi = acos(arg) / 3;
+            for (int k = 0; k <= 2; ++k){
+                roots[nroots++] = m * cos(phi - 2 * pi * k / 3) - a / 3;
+            }
+        }
+        else{
+            roots[nroots++] = -a / 3; // Triple root
+        }
+    }
+
+    // Gas root: smallest positive root
+    double Dgas = -1;
+    for (int k = 0; k < nroots; ++k){
+        if (roots[k] > 0 && (Dgas < 0 || roots[k] < Dgas)){ Dgas = roots[k]; }
+    }
+    if (Dgas > 0){
+        // Polish the closed-form root, which loses digits when C is small
+        for (int it = 1; it <= 5; ++it){
+            f = ((C * Dgas + B) * Dgas + 1) * Dgas - pr;
+            df = (3 * C * Dgas + 2 * B) * Dgas + 1;
+            if (df <= 0){ break; }
+            dD = f / df;
+            Dgas -= dD;
+            if (std::abs(dD) <= 1e-15 * Dgas){ break; }
+        }
+    }
+    // The gas root must lie on the branch connected to the ideal gas limit, i.e. below the first
+    // density where d(P)/d(D) = 0 (smallest positive root of 3*C*D^2 + 2*B*D + 1)
+    double Dspin = -1;
+    if (C == 0){
+        if (B < 0){ Dspin = -1 / (2 * B); }
+    }
+    else if (B * B - 3 * C >= 0){
+        const double sq = sqrt(B * B - 3 * C);
+        const double r1 = (-B - sq) / (3 * C), r2 = (-B + sq) / (3 * C);
+        if (r1 > 0){ Dspin = r1; }
+        if (r2 > 0 && (Dspin < 0 || r2 < Dspin)){ Dspin = r2; }
+    }
+    if (!(Dgas > 0) || !(Dgas < exp(7.0)) || (Dspin > 0 && Dgas > Dspin)){ return false; }
+    D = Dgas;
+    return true;
+}
+
+/**
+ * @brief Calculate density as a function of temperature and pressure (original iterative solver)
+ * 
  * This is an iterative routine that calls PressureGross to find the correct state point.
  * Generally only 6 iterations at most are required. If the iteration fails to converge, 
  * the ideal gas density and an error message are returned.
+ * It is kept to verify the closed-form solution of DensityGross.
  * 
  * @param T Temperature (K)
  * @param P Pressure (kPa)
@@ -231,11 +461,11 @@ void PressureGross(const double T, const double D, const std::vector<double> &xG
  * @param[out] D Density (mol/l)
  * @param[out] ierr Error number (0 indicates no error)
  * @param[out] herr Error message if ierr is not equal to zero
- * @see DensityGross_wrapper for the Emscripten wrapper
+ * @see DensityGross, DensityGrossIterative_wrapper for the Emscripten wrapper
  */
-void DensityGross(const double T, const double P, const std::vector<double> &xGrs, const double HCH, double &D, int &ierr, std::string &herr)
+void DensityGrossIterative(const double T, const double P, const std::vector<double> &xGrs, const double HCH, double &D, int &ierr, const char *&herr)
 {
-    // Sub DensityGross(T, P, xGrs, HCH, D, ierr, herr)
+    // Sub DensityGrossIterative(T, P, xGrs, HCH, D, ierr, herr)
     //
     // Calculate density as a function of temperature and pressure.  This is an iterative routine that calls PressureGross
     // to find the correct state point.  Generally only 6 iterations at most are required.
@@ -265,6 +495,7 @@ void DensityGross(const double T, const double P, const std::vector<double> &xGr
     plog = log(P);
     vlog = -log(D);
     for(int it = 1; it <= 20; ++it){
+        AGA8_TRACE_SCOPE_ARG("DensityGrossIterative iteration", it);
         if(vlog < -7 || vlog > 100){
             ierr = 1;
             herr = "Calculation failed to converge in GROSS method, ideal gas density returned.";
@@ -303,18 +534,98 @@ void DensityGross(const double T, const double P, const std::vector<double> &xGr
 }
 
 /**
- * @brief Calculate ideal heating values based on composition
- * 
- * The mole fractions in the mixture are required in this routine, not just xCH, xN2, and xCO2.
- * 
- * @param x Molar compositions of all components in the mixture. 
- *          The order in this array is given at the top of this code.
- * @param[out] xGrs Compositions of the equivalent hydrocarbon, nitrogen, and CO2 (mole fractions)
- * @param[out] HN Molar ideal gross heating value of the mixture (kJ/mol) at 298.15 K
- * @param[out] HCH Molar ideal gross heating value of the equivalent hydrocarbon (kJ/mol) at 298.15 K
- * @see GrossHv_wrapper for the Emscripten wrapper
+ * @brief DensityGrossIterative with the error message returned as a std::string
+ * @see DensityGrossIterative
  */
-void GrossHv(const std::vector<double> &x, std::vector<double> &xGrs, double &HN, double &HCH)
+void DensityGrossIterative(const double T, const double P, const std::vector<double> &xGrs, const double HCH, double &D, int &ierr, std::string &herr)
+{
+    const char *msg = "";
+    DensityGrossIterative(T, P, xGrs, HCH, D, ierr, msg);
+    herr = msg;
+}
+
+/**
+ * @brief Calculate density and compressibility factor for many (T, P, xGrs, HCH) rows
+ *
+ * The rows are processed grouped by temperature, so that the temperature dependent terms of Bmix
+ * are evaluated once per distinct temperature. For each group, B and C of every row are computed
+ * first, then the density is obtained from the closed-form roots of the cubic as in DensityGross.
+ * Rows without a root on the gas branch fall back to DensityGrossIterative. The results are the
+ * same as calling DensityGross and PressureGross row by row.
+ *
+ * @param T Temperatures (K)
+ * @param P Pressures (kPa)
+ * @param xCH Mole fractions of the equivalent hydrocarbon
+ * @param xN2 Mole fractions of nitrogen
+ * @param xCO2 Mole fractions of CO2
+ * @param HCH Molar ideal gross heating values of the equivalent hydrocarbon (kJ/mol) at 298.15 K
+ * @param[out] D Densities (mol/l), the ideal gas density for rows in error
+ * @param[out] Z Compressibility factors, 1 for rows in error
+ * @param[out] ierr Error numbers of each row (0 indicates no error), see DensityGross and Bmix
+ * @note All the input vectors must have the same length, extra elements are ignored.
+ * @see DensityGrossBatch_wrapper for the Emscripten wrapper
+ */
+void DensityGrossBatch(const std::vector<double> &T, const std::vector<double> &P, const std::vector<double> &xCH, const std::vector<double> &xN2, const std::vector<double> &xCO2, const std::vector<double> &HCH, std::vector<double> &D, std::vector<double> &Z, std::vector<int> &ierr)
+{
+    AGA8_TRACE_SCOPE("DensityGrossBatch");
+    static thread_local std::vector<int> order;
+    static thread_local std::vector<double> Bs, Cs, xGrs(4);
+    const char *herr = "";
+    std::size_t n = T.size();
+    n = std::min(n, std::min(P.size(), HCH.size()));
+    n = std::min(n, std::min(xCH.size(), std::min(xN2.size(), xCO2.size())));
+
+    D.resize(n);
+    Z.resize(n);
+    ierr.resize(n);
+    order.resize(n);
+    Bs.resize(n);
+    Cs.resize(n);
+
+    // Row order sorted by temperature (NaN last), ties kept in input order
+    for (std::size_t i = 0; i < n; ++i){ order[i] = (int)i; }
+    std::sort(order.begin(), order.end(), [&T](int a, int b){
+        const double Ta = std::isnan(T[a]) ? HUGE_VAL : T[a], Tb = std::isnan(T[b]) ? HUGE_VAL : T[b];
+        return Ta < Tb || (Ta == Tb && a < b);
+    });
+
+    std::size_t g0 = 0;
+    while (g0 < n){
+        const double Tg = T[order[g0]];
+        std::size_t g1 = g0 + 1;
+        while (g1 < n && T[order[g1]] == Tg){ ++g1; }
+
+        // Mixture virial coefficients of the group
+        const BmixTGross &t = BmixTermsGross(Tg);
+        for (std::size_t k = g0; k < g1; ++k){
+            const int i = order[k];
+            ierr[i] = BmixRowGross(t, xCH[i], xN2[i], xCO2[i], HCH[i], Bs[k], Cs[k]);
+        }
+
+        // Densities of the group
+        for (std::size_t k = g0; k < g1; ++k){
+            const int i = order[k];
+            const double B = Bs[k], C = Cs[k];
+            Z[i] = 1;
+            if (P[i] < epsilon){
+                D[i] = 0; ierr[i] = 0; continue;
+            }
+            D[i] = P[i] / RGross / Tg;
+            if (ierr[i] > 0){ continue; }
+            if (!CubicDensityGross(P[i] / RGross / Tg, B, C, D[i])){
+                xGrs[1] = xCH[i]; xGrs[2] = xN2[i]; xGrs[3] = xCO2[i];
+                DensityGrossIterative(Tg, P[i], xGrs, HCH[i], D[i], ierr[i], herr);
+                if (ierr[i] > 0){ continue; }
+            }
+            Z[i] = 1 + B * D[i] + C * D[i] * D[i];
+        }
+        g0 = g1;
+    }
+}
+
+// GrossHv for any composition type with x[i], i = 1 to NcGross (std::vector, Composition, CompositionView)
+template <typename X>
+static void GrossHvImpl(const X &x, std::vector<double> &xGrs, double &HN, double &HCH)
 {
     // Sub GrossHv(x, xGrs, HN, HCH)
     //
@@ -328,7 +639,7 @@ void GrossHv(const std::vector<double> &x, std::vector<double> &xGrs, double &HN
     //  xGrs - Compositions of the equivalent hydrocarbon, nitrogen, and CO2 (mole fractions)
     //    HN - Molar ideal gross heating value of the mixture (kJ/mol) at 298.15 K
     //   HCH - Molar ideal gross heating value of the equivalent hydrocarbon (kJ/mol) at 298.15 K
-    xGrs.resize(4);
+    if (xGrs.size() < 4){ xGrs.resize(4); }
     xGrs[1] = 1 - x[2] - x[3];
     xGrs[2] = x[2];
     xGrs[3] = x[3];
@@ -343,25 +654,43 @@ void GrossHv(const std::vector<double> &x, std::vector<double> &xGrs, double &HN
 }
 
 /**
- * @brief Calculate relative density and heating values based on composition
+ * @brief Calculate ideal heating values based on composition
  * 
- * This routine should only be used to get these two values for use as inputs to Method 1 or 
- * Method 2, and not for the relative density for any T and P. All of the mole fractions in 
- * the mixture are required in this routine, not just xCH, xN2, and xCO2.
+ * The mole fractions in the mixture are required in this routine, not just xCH, xN2, and xCO2.
  * 
- * @param T Temperature (K), generally a reference temperature for relative density
- * @param P Pressure (kPa), generally a reference pressure for relative density
  * @param x Molar compositions of all components in the mixture. 
  *          The order in this array is given at the top of this code.
  * @param[out] xGrs Compositions of the equivalent hydrocarbon, nitrogen, and CO2 (mole fractions)
- * @param[out] Gr Relative density at T and P
  * @param[out] HN Molar ideal gross heating value of the mixture (kJ/mol) at 298.15 K
  * @param[out] HCH Molar ideal gross heating value of the equivalent hydrocarbon (kJ/mol) at 298.15 K
- * @param[out] ierr Error number (0 indicates no error)
- * @param[out] herr Error message if ierr is not equal to zero
- * @see GrossInputs_wrapper for the Emscripten wrapper
+ * @see GrossHv_wrapper for the Emscripten wrapper
  */
-void GrossInputs(const double T, const double P, const std::vector<double> &x, std::vector<double> &xGrs, double &Gr, double &HN, double &HCH, int &ierr, std::string &herr)
+void GrossHv(const std::vector<double> &x, std::vector<double> &xGrs, double &HN, double &HCH)
+{
+    GrossHvImpl(x, xGrs, HN, HCH);
+}
+
+/**
+ * @brief GrossHv for a fixed-size Composition
+ * @see GrossHv
+ */
+void GrossHv(const Composition &x, std::vector<double> &xGrs, double &HN, double &HCH)
+{
+    GrossHvImpl(x, xGrs, HN, HCH);
+}
+
+/**
+ * @brief GrossHv for a CompositionView, e.g. a row of a composition matrix
+ * @see GrossHv
+ */
+void GrossHv(const CompositionView &x, std::vector<double> &xGrs, double &HN, double &HCH)
+{
+    GrossHvImpl(x, xGrs, HN, HCH);
+}
+
+// GrossInputs for any composition type with x[i], i = 1 to NcGross (std::vector, Composition, CompositionView)
+template <typename X>
+static void GrossInputsImpl(const double T, const double P, const X &x, std::vector<double> &xGrs, double &Gr, double &HN, double &HCH, int &ierr, const char *&herr)
 {
     // Sub GrossInputs(T, P, x, xGrs, Gr, HN, HCH, ierr, herr)
 
@@ -383,20 +712,73 @@ void GrossInputs(const double T, const double P, const std::vector<double> &x, s
     //   herr - Error message if ierr is not equal to zero
 
     double Bref, Zref, Mref, Z, D, Mm;
-    xGrs.resize(4);
+    if (xGrs.size() < 4){ xGrs.resize(4); }
     ierr = 0;
     herr = "";
-    GrossHv(x, xGrs, HN, HCH);
+    GrossHvImpl(x, xGrs, HN, HCH);
     Bref = -0.12527 + 0.000591*T - 0.000000662*pow(T, 2);   // 2nd virial coefficient of the reference fluid at T
     Zref = 1 + Bref*P/RGross/T;                             // Z of the reference fluid at T and P
     Mref = 28.9625;
-    MolarMassGross(x, Mm);
+    MolarMassGrossImpl(x, Mm);
 
     DensityGross(T, P, xGrs, HCH, D, ierr, herr);           // Density of the input fluid at T and D
     Z = P / T / D / RGross;                                 // Z of the input fluid at T and D
     Gr = Mm * Zref / Mref / Z;
 }
 
+/**
+ * @brief Calculate relative density and heating values based on composition
+ * 
+ * This routine should only be used to get these two values for use as inputs to Method 1 or 
+ * Method 2, and not for the relative density for any T and P. All of the mole fractions in 
+ * the mixture are required in this routine, not just xCH, xN2, and xCO2.
+ * 
+ * @param T Temperature (K), generally a reference temperature for relative density
+ * @param P Pressure (kPa), generally a reference pressure for relative density
+ * @param x Molar compositions of all components in the mixture. 
+ *          The order in this array is given at the top of this code.
+ * @param[out] xGrs Compositions of the equivalent hydrocarbon, nitrogen, and CO2 (mole fractions)
+ * @param[out] Gr Relative density at T and P
+ * @param[out] HN Molar ideal gross heating value of the mixture (kJ/mol) at 298.15 K
+ * @param[out] HCH Molar ideal gross heating value of the equivalent hydrocarbon (kJ/mol) at 298.15 K
+ * @param[out] ierr Error number (0 indicates no error)
+ * @param[out] herr Error message if ierr is not equal to zero
+ * @see GrossInputs_wrapper for the Emscripten wrapper
+ */
+void GrossInputs(const double T, const double P, const std::vector<double> &x, std::vector<double> &xGrs, double &Gr, double &HN, double &HCH, int &ierr, const char *&herr)
+{
+    GrossInputsImpl(T, P, x, xGrs, Gr, HN, HCH, ierr, herr);
+}
+
+/**
+ * @brief GrossInputs for a fixed-size Composition
+ * @see GrossInputs
+ */
+void GrossInputs(const double T, const double P, const Composition &x, std::vector<double> &xGrs, double &Gr, double &HN, double &HCH, int &ierr, const char *&herr)
+{
+    GrossInputsImpl(T, P, x, xGrs, Gr, HN, HCH, ierr, herr);
+}
+
+/**
+ * @brief GrossInputs for a CompositionView, e.g. a row of a composition matrix
+ * @see GrossInputs
+ */
+void GrossInputs(const double T, const double P, const CompositionView &x, std::vector<double> &xGrs, double &Gr, double &HN, double &HCH, int &ierr, const char *&herr)
+{
+    GrossInputsImpl(T, P, x, xGrs, Gr, HN, HCH, ierr, herr);
+}
+
+/**
+ * @brief GrossInputs with the error message returned as a std::string
+ * @see GrossInputs
+ */
+void GrossInputs(const double T, const double P, const std::vector<double> &x, std::vector<double> &xGrs, double &Gr, double &HN, double &HCH, int &ierr, std::string &herr)
+{
+    const char *msg = "";
+    GrossInputs(T, P, x, xGrs, Gr, HN, HCH, ierr, msg);
+    herr = msg;
+}
+
 /**
  * @brief Calculate 2nd and 3rd virial coefficients for the mixture at T
  * 
@@ -409,7 +791,7 @@ void GrossInputs(const double T, const double P, const std::vector<double> &x, s
  * @param[out] herr Error message if ierr is not equal to zero
  * @see Bmix_wrapper for the Emscripten wrapper
  */
-void Bmix(const double T, const std::vector<double> &xGrs, const double HCH, double &B, double &C, int &ierr, std::string &herr)
+void Bmix(const double T, const std::vector<double> &xGrs, const double HCH, double &B, double &C, int &ierr, const char *&herr)
 {
     // Sub Bmix(T, xGrs, HCH, B, C, ierr, herr)
 
@@ -426,73 +808,107 @@ void Bmix(const double T, const std::vector<double> &xGrs, const double HCH, dou
     //   ierr - Error number (0 indicates no error)
     //   herr - Error message if ierr is not equal to zero
 
-    double bCH[3], cCH[3], BB[4][4], CC[4][4][4];
-    const double onethrd = 1.0 / 3.0;
+    AGA8_TRACE_SCOPE("Bmix");
 
     ierr = 0;
     herr = "";
-    B = 0;
-    C = 0;
+    ierr = BmixRowGross(BmixTermsGross(T), xGrs[1], xGrs[2], xGrs[3], HCH, B, C);
+    if (ierr > 0){ herr = "Invalid input in Bmix routine"; }
+}
+
+/**
+ * @brief Bmix with the error message returned as a std::string
+ * @see Bmix
+ */
+void Bmix(const double T, const std::vector<double> &xGrs, const double HCH, double &B, double &C, int &ierr, std::string &herr)
+{
+    const char *msg = "";
+    Bmix(T, xGrs, HCH, B, C, ierr, msg);
+    herr = msg;
+}
+
+/**
+ * @brief Temperature dependent terms of Bmix
+ *
+ * The terms are computed once per temperature and kept for the last NTSlots temperatures, which
+ * covers the iterations of the density solvers and the reference conditions of GrossMethod1/2.
+ *
+ * @param T Temperature (K)
+ * @return Cached terms at T
+ */
+static const BmixTGross &BmixTermsGross(const double T)
+{
+    const double onethrd = 1.0 / 3.0;
+    for (int s = 0; s < NTSlots; ++s){
+        if (BmixT[s].T == T){ return BmixT[s]; }
+    }
+    BmixTGross &t = BmixT[BmixTnext];
+    BmixTnext = (BmixTnext + 1) % NTSlots;
+    t.T = T;
 
     // Temperature dependent Bi and Ci values for obtaining B(CH-CH) and C(CH-CH-CH)
     for (int i = 0; i <= 2; ++i){
-        bCH[i] = bCHx[0][i] + bCHx[1][i]*T + bCHx[2][i]*pow(T, 2);
-        cCH[i] = cCHx[0][i] + cCHx[1][i]*T + cCHx[2][i]*pow(T, 2);
+        t.bCH[i] = bCHx[0][i] + bCHx[1][i]*T + bCHx[2][i]*T*T;
+        t.cCH[i] = cCHx[0][i] + cCHx[1][i]*T + cCHx[2][i]*T*T;
     }
 
     // Bij and Cijk values for nitrogen and CO2
-    for(int i = 2; i <= 3; ++i){
-        for(int j = i; j <= 3; ++j){
-            BB[i][j] = b0[i][j] + b1[i][j] * T + b2[i][j]*pow(T, 2);
-            for(int k = j; k <= 3; ++k){
-                CC[i][j][k] = c0[i][j][k] + c1[i][j][k] * T + c2[i][j][k]*pow(T, 2);
-            }
-        }
-    }
+    t.B22 = b0[2][2] + b1[2][2]*T + b2[2][2]*T*T;
+    t.B23 = b0[2][3] + b1[2][3]*T + b2[2][3]*T*T;
+    t.B33 = b0[3][3] + b1[3][3]*T + b2[3][3]*T*T;
+    t.C222 = c0[2][2][2] + c1[2][2][2]*T + c2[2][2][2]*T*T;
+    t.C223 = c0[2][2][3] + c1[2][2][3]*T + c2[2][2][3]*T*T;
+    t.C233 = c0[2][3][3] + c1[2][3][3]*T + c2[2][3][3]*T*T;
+    t.C333 = c0[3][3][3] + c1[3][3][3]*T + c2[3][3][3]*T*T;
+
+    // Cross terms with the equivalent hydrocarbon, see BmixRowGross
+    t.f12 = (0.72 + 0.00001875 * pow(320 - T, 2)) / 2.0;
+    t.f112 = 0.92 + 0.0013 * (T - 270);
+    t.r222 = pow(t.C222, onethrd);
+    t.r333 = pow(t.C333, onethrd);
+    return t;
+}
+
+/**
+ * @brief 2nd and 3rd virial coefficients of one mixture from the temperature dependent terms
+ *
+ * @param t Temperature dependent terms (see BmixTermsGross)
+ * @param xCH Mole fraction of the equivalent hydrocarbon
+ * @param xN2 Mole fraction of nitrogen
+ * @param xCO2 Mole fraction of CO2
+ * @param HCH Molar ideal gross heating value of the equivalent hydrocarbon (kJ/mol) at 298.15 K
+ * @param[out] B Second virial coefficient (dm^3/mol), 0 on error
+ * @param[out] C Third virial coefficient (dm^6/mol^2), 0 on error
+ * @return Error number of Bmix (0 indicates no error)
+ */
+static inline int BmixRowGross(const BmixTGross &t, const double xCH, const double xN2, const double xCO2, const double HCH, double &B, double &C)
+{
+    B = 0;
+    C = 0;
 
     // Bij values for use in calculating Bmix
-    BB[1][1] = bCH[0] + bCH[1]*HCH + bCH[2]*pow(HCH, 2); // B(CH-CH) for the equivalent hydrocarbon
-    BB[1][2] = (0.72 + 0.00001875 * pow(320 - T, 2))*(BB[1][1] + BB[2][2])/2.0; // B(CH-N2)
-    if (BB[1][1]*BB[3][3] < 0){
-        ierr = 4; herr = "Invalid input in Bmix routine";
-        return;
-    }
-    BB[1][3] = -0.865 * sqrt(BB[1][1] * BB[3][3]); // B(CH-CO2)
+    const double B11 = t.bCH[0] + t.bCH[1]*HCH + t.bCH[2]*HCH*HCH;  // B(CH-CH) for the equivalent hydrocarbon
+    const double B12 = t.f12 * (B11 + t.B22);                        // B(CH-N2)
+    if (B11 * t.B33 < 0){ return 4; }
+    const double B13 = -0.865 * sqrt(B11 * t.B33);                   // B(CH-CO2)
 
-    // Cijk values for use in calculating Cmix
-    CC[1][1][1] = cCH[0] + cCH[1] * HCH + cCH[2] * pow(HCH, 2); // C(CH-CH-CH) for the equivalent hydrocarbon
-    if (CC[1][1][1] < 0 || CC[3][3][3] < 0){
-        ierr = 5; herr = "Invalid input in Bmix routine";
-        return;
-    }
-    CC[1][1][2] = (0.92 + 0.0013 * (T - 270)) * pow(pow(CC[1][1][1], 2) * CC[2][2][2], onethrd); // C(CH-CH-N2)
-    CC[1][2][2] = (0.92 + 0.0013 * (T - 270)) * pow(pow(CC[2][2][2], 2) * CC[1][1][1], onethrd); // C(CH-N2-N2)
-    CC[1][1][3] = 0.92 * pow(pow(CC[1][1][1], 2) * CC[3][3][3], onethrd); // C(CH-CH-CO2)
-    CC[1][3][3] = 0.92 * pow(pow(CC[3][3][3], 2) * CC[1][1][1], onethrd); // C(CH-CO2-CO2)
-    CC[1][2][3] = 1.1 * pow(CC[1][1][1] * CC[2][2][2] * CC[3][3][3], onethrd); // C(CH-N2-CO2)
+    // Cijk values for use in calculating Cmix, with (Ciii^2*Cjjj)^(1/3) = ri^2*rj and ri = Ciii^(1/3)
+    const double C111 = t.cCH[0] + t.cCH[1]*HCH + t.cCH[2]*HCH*HCH;  // C(CH-CH-CH) for the equivalent hydrocarbon
+    if (C111 < 0 || t.C333 < 0){ return 5; }
+    const double r111 = std::cbrt(C111);
+    const double C112 = t.f112 * r111 * r111 * t.r222;               // C(CH-CH-N2)
+    const double C122 = t.f112 * t.r222 * t.r222 * r111;             // C(CH-N2-N2)
+    const double C113 = 0.92 * r111 * r111 * t.r333;                 // C(CH-CH-CO2)
+    const double C133 = 0.92 * t.r333 * t.r333 * r111;               // C(CH-CO2-CO2)
+    const double C123 = 1.1 * r111 * t.r222 * t.r333;                // C(CH-N2-CO2)
 
     // Calculate Bmix and Cmix
-    for (std::size_t i = 1; i <= 3; ++i){
-        for(std::size_t j = i; j <= 3; ++j){
-            if (i == j){
-                B += BB[i][i]*pow(xGrs[i], 2);
-            }
-            else{
-                B += 2*BB[i][j]*xGrs[i]*xGrs[j];
-            }
-            for(std::size_t k = j; k <= 3; ++k){
-                if (i == j && j == k) {
-                    C += CC[i][i][i]*pow(xGrs[i], 3);
-                }
-                else if (i != j && j != k && i != k){
-                    C += 6*CC[i][j][k]*xGrs[i]*xGrs[j]*xGrs[k];
-                }
-                else{
-                    C += 3*CC[i][j][k]*xGrs[i]*xGrs[j]*xGrs[k];
-                }
-            }
-        }
-    }
+    const double x1 = xCH, x2 = xN2, x3 = xCO2;
+    B = B11*x1*x1 + t.B22*x2*x2 + t.B33*x3*x3 + 2*(B12*x1*x2 + B13*x1*x3 + t.B23*x2*x3);
+    C = C111*x1*x1*x1 + t.C222*x2*x2*x2 + t.C333*x3*x3*x3
+      + 3*(C112*x1*x1*x2 + C113*x1*x1*x3 + C122*x1*x2*x2 + C133*x1*x3*x3 + t.C223*x2*x2*x3 + t.C233*x2*x3*x3)
+      + 6*C123*x1*x2*x3;
+    return 0;
 }
 
 /**
@@ -514,7 +930,7 @@ void Bmix(const double T, const std::vector<double> &xGrs, const double HCH, dou
  * @param[out] herr Error message if ierr is not equal to zero
  * @see GrossMethod1_wrapper for the Emscripten wrapper
  */
-void GrossMethod1(const double Th, const double Td, const double Pd, std::vector<double> &xGrs, const double Gr, const double Hv, double & Mm, double &HCH, double &HN, int &ierr, std::string &herr)
+void GrossMethod1(const double Th, const double Td, const double Pd, std::vector<double> &xGrs, const double Gr, const double Hv, double & Mm, double &HCH, double &HN, int &ierr, const char *&herr)
 {
     // Sub GrossMethod1(Th, Td, Pd, xGrs, Gr, Hv, Mm, HCH, HN, ierr, herr)
 
@@ -537,7 +953,7 @@ void GrossMethod1(const double Th, const double Td, const double Pd, std::vector
     //   ierr - Error number (0 indicates no error)
     //   herr - Error message if ierr is not equal to zero
 
-    double xCH, xN2, xCO2, Zd, Zold, G1, G2, Bref, Zref, B, C;
+    double xCH, xN2, xCO2, Zd, Zold, G1, G2, Zref, B, C;
 
     ierr = 0;
     herr = "";
@@ -548,8 +964,7 @@ void GrossMethod1(const double Th, const double Td, const double Pd, std::vector
     Zd = 1;
     G1 = -2.709328;
     G2 = 0.021062199;
-    Bref = -0.12527 + 0.000591*Td - 0.000000662*pow(Td, 2);              // [dm^3/mol]
-    Zref = (1 + Pd / RGross / Td * Bref);
+    Zref = ZrefGross(Td, Pd);
     for (int i = 0; i < 20; ++i){
         Zold = Zd;
         HN = Zd*RGross*Td/Pd*Hv*(1 + 0.0001027*(Th - 298.15));          // [kJ/mol] at 25 C
@@ -572,6 +987,17 @@ void GrossMethod1(const double Th, const double Td, const double Pd, std::vector
     }
 }
 
+/**
+ * @brief GrossMethod1 with the error message returned as a std::string
+ * @see GrossMethod1
+ */
+void GrossMethod1(const double Th, const double Td, const double Pd, std::vector<double> &xGrs, const double Gr, const double Hv, double & Mm, double &HCH, double &HN, int &ierr, std::string &herr)
+{
+    const char *msg = "";
+    GrossMethod1(Th, Td, Pd, xGrs, Gr, Hv, Mm, HCH, HN, ierr, msg);
+    herr = msg;
+}
+
 /**
  * @brief Initialize variables required in the GROSS equation with Method 2 of the AGA 8 Part 1 publication
  * 
@@ -591,7 +1017,7 @@ void GrossMethod1(const double Th, const double Td, const double Pd, std::vector
  * @param[out] herr Error message if ierr is not equal to zero
  * @see GrossMethod2_wrapper for the Emscripten wrapper
  */
-void GrossMethod2(const double Th, const double Td, const double Pd, std::vector<double> &xGrs, const double Gr, double &Hv, double &Mm, double &HCH, double &HN, int &ierr, std::string &herr)
+void GrossMethod2(const double Th, const double Td, const double Pd, std::vector<double> &xGrs, const double Gr, double &Hv, double &Mm, double &HCH, double &HN, int &ierr, const char *&herr)
 {
     // Sub GrossMethod2(Th, Td, Pd, xGrs, Gr, Hv, Mm, HCH, HN, ierr, herr)
 
@@ -614,7 +1040,7 @@ void GrossMethod2(const double Th, const double Td, const double Pd, std::vector
     //   ierr - Error number (0 indicates no error)
     //   herr - Error message if ierr is not equal to zero
 
-    double xCH, Z, Zold, Bref, Zref, MrCH, G1, G2, B, C, xN2, xCO2;
+    double xCH, Z, Zold, Zref, MrCH, G1, G2, B, C, xN2, xCO2;
     ierr = 0;
     herr = "";
     if (Gr < epsilon){ ierr = 1; herr = "Invalid input for relative density"; return; }
@@ -626,8 +1052,7 @@ void GrossMethod2(const double Th, const double Td, const double Pd, std::vector
     Z = 1;
     G1 = -2.709328;
     G2 = 0.021062199;
-    Bref = -0.12527 + 0.000591*Td - 0.000000662*pow(Td, 2);
-    Zref = (1 + Pd / RGross / Td * Bref);
+    Zref = ZrefGross(Td, Pd);
     for (int i = 0; i < 20; ++i){
         Zold = Z;
         Mm = Gr*Z*28.9625/Zref;
@@ -642,6 +1067,164 @@ void GrossMethod2(const double Th, const double Td, const double Pd, std::vector
     Hv = HN / Z / RGross / Td * Pd / (1 + 0.0001027 * (Th - 298.15));
 }
 
+/**
+ * @brief GrossMethod2 with the error message returned as a std::string
+ * @see GrossMethod2
+ */
+void GrossMethod2(const double Th, const double Td, const double Pd, std::vector<double> &xGrs, const double Gr, double &Hv, double &Mm, double &HCH, double &HN, int &ierr, std::string &herr)
+{
+    const char *msg = "";
+    GrossMethod2(Th, Td, Pd, xGrs, Gr, Hv, Mm, HCH, HN, ierr, msg);
+    herr = msg;
+}
+
+/**
+ * @brief Compressibility factor of the reference fluid (air) at Td and Pd, used to convert relative densities
+ *
+ * @param Td Reference temperature for density (K)
+ * @param Pd Reference pressure for density (kPa)
+ * @return Zref
+ */
+static double ZrefGross(const double Td, const double Pd)
+{
+    const double Bref = -0.12527 + 0.000591*Td - 0.000000662*pow(Td, 2);  // [dm^3/mol]
+    return (1 + Pd / RGross / Td * Bref);
+}
+
+/**
+ * @brief GROSS Method 1 setup for many (Gr, Hv, xCO2) rows at common reference conditions
+ *
+ * The reference fluid and the temperature dependent terms of Bmix are evaluated once, then the
+ * fixed-point iteration on Zd of GrossMethod1 is run for all rows together. A row leaves the
+ * iteration when it converges or fails, the others keep iterating. The results are the same as
+ * calling GrossMethod1 row by row.
+ *
+ * @param Th Reference temperature for heating value (K)
+ * @param Td Reference temperature for density (K)
+ * @param Pd Reference pressure for density (kPa)
+ * @param Gr Relative densities at Td and Pd
+ * @param Hv Volumetric ideal gross heating values (MJ/m^3) at Th
+ * @param xCO2 Mole fractions of CO2
+ * @param[out] xCH Mole fractions of the equivalent hydrocarbon
+ * @param[out] xN2 Mole fractions of nitrogen
+ * @param[out] Mm Molar masses (g/mol)
+ * @param[out] HCH Molar ideal gross heating values of the equivalent hydrocarbon (kJ/mol) at 298.15 K
+ * @param[out] HN Molar ideal gross heating values of the mixtures (kJ/mol) at 298.15 K
+ * @param[out] ierr Error numbers of each row (0 indicates no error), see GrossMethod1
+ * @note All the input vectors must have the same length, extra elements are ignored.
+ * @see GrossMethod1Batch_wrapper for the Emscripten wrapper
+ */
+void GrossMethod1Batch(const double Th, const double Td, const double Pd, const std::vector<double> &Gr, const std::vector<double> &Hv, const std::vector<double> &xCO2, std::vector<double> &xCH, std::vector<double> &xN2, std::vector<double> &Mm, std::vector<double> &HCH, std::vector<double> &HN, std::vector<int> &ierr)
+{
+    AGA8_TRACE_SCOPE("GrossMethod1Batch");
+    static thread_local std::vector<double> Zd;
+    static thread_local std::vector<char> active;
+    const std::size_t n = std::min(Gr.size(), std::min(Hv.size(), xCO2.size()));
+    const double G1 = -2.709328, G2 = 0.021062199;
+    const double Zref = ZrefGross(Td, Pd);
+    const BmixTGross &t = BmixTermsGross(Td);
+    double B, C;
+    std::size_t nactive = 0;
+
+    xCH.assign(n, 0); xN2.assign(n, 0); Mm.assign(n, 0); HCH.assign(n, 0); HN.assign(n, 0);
+    ierr.assign(n, 0);
+    Zd.assign(n, 1);
+    active.assign(n, 0);
+    for (std::size_t i = 0; i < n; ++i){
+        if (Gr[i] < epsilon){ ierr[i] = 1; }
+        else if (Hv[i] < epsilon){ ierr[i] = 2; }
+        else{ active[i] = 1; ++nactive; }
+    }
+
+    for (int it = 0; it < 20 && nactive > 0; ++it){
+        for (std::size_t i = 0; i < n; ++i){
+            if (!active[i]){ continue; }
+            const double Zold = Zd[i];
+            HN[i] = Zd[i]*RGross*Td/Pd*Hv[i]*(1 + 0.0001027*(Th - 298.15));        // [kJ/mol] at 25 C
+            Mm[i] = Gr[i]*Zd[i]*28.9625 / Zref;                                     // [g/mol]
+            const double x1 = (Mm[i] + (xCO2[i] - 1) * mN2 - xCO2[i] * mCO2 - G2 * HN[i]) / (G1 - mN2);
+            const double x2 = 1 - x1 - xCO2[i];
+            if (x2 < 0){
+                ierr[i] = 3; active[i] = 0; --nactive; continue;
+            }
+            HCH[i] = HN[i] / x1;
+            xCH[i] = x1;
+            xN2[i] = x2;
+            ierr[i] = BmixRowGross(t, x1, x2, xCO2[i], HCH[i], B, C);
+            if (ierr[i] > 0){
+                active[i] = 0; --nactive; continue;
+            }
+            Zd[i] = 1 + B*Pd/RGross/Td;
+            if (std::abs(Zold - Zd[i]) < 0.0000001){ active[i] = 0; --nactive; }
+        }
+    }
+}
+
+/**
+ * @brief GROSS Method 2 setup for many (Gr, xN2, xCO2) rows at common reference conditions
+ *
+ * Batch form of GrossMethod2, organized as GrossMethod1Batch. The results are the same as calling
+ * GrossMethod2 row by row.
+ *
+ * @param Th Reference temperature for heating value (K)
+ * @param Td Reference temperature for density (K)
+ * @param Pd Reference pressure for density (kPa)
+ * @param Gr Relative densities at Td and Pd
+ * @param xN2 Mole fractions of nitrogen
+ * @param xCO2 Mole fractions of CO2
+ * @param[out] xCH Mole fractions of the equivalent hydrocarbon
+ * @param[out] Hv Volumetric ideal gross heating values (MJ/m^3) at Th
+ * @param[out] Mm Molar masses (g/mol)
+ * @param[out] HCH Molar ideal gross heating values of the equivalent hydrocarbon (kJ/mol) at 298.15 K
+ * @param[out] HN Molar ideal gross heating values of the mixtures (kJ/mol) at 298.15 K
+ * @param[out] ierr Error numbers of each row (0 indicates no error), see GrossMethod2
+ * @note All the input vectors must have the same length, extra elements are ignored.
+ * @see GrossMethod2Batch_wrapper for the Emscripten wrapper
+ */
+void GrossMethod2Batch(const double Th, const double Td, const double Pd, const std::vector<double> &Gr, const std::vector<double> &xN2, const std::vector<double> &xCO2, std::vector<double> &xCH, std::vector<double> &Hv, std::vector<double> &Mm, std::vector<double> &HCH, std::vector<double> &HN, std::vector<int> &ierr)
+{
+    AGA8_TRACE_SCOPE("GrossMethod2Batch");
+    static thread_local std::vector<double> Z;
+    static thread_local std::vector<char> active;
+    const std::size_t n = std::min(Gr.size(), std::min(xN2.size(), xCO2.size()));
+    const double G1 = -2.709328, G2 = 0.021062199;
+    const double Zref = ZrefGross(Td, Pd);
+    const BmixTGross &t = BmixTermsGross(Td);
+    double B, C;
+    std::size_t nactive = 0;
+
+    xCH.assign(n, 0); Hv.assign(n, 0); Mm.assign(n, 0); HCH.assign(n, 0); HN.assign(n, 0);
+    ierr.assign(n, 0);
+    Z.assign(n, 1);
+    active.assign(n, 0);
+    for (std::size_t i = 0; i < n; ++i){
+        if (Gr[i] < epsilon){ ierr[i] = 1; }
+        else{ xCH[i] = 1 - xN2[i] - xCO2[i]; active[i] = 1; ++nactive; }
+    }
+
+    for (int it = 0; it < 20 && nactive > 0; ++it){
+        for (std::size_t i = 0; i < n; ++i){
+            if (!active[i]){ continue; }
+            const double Zold = Z[i];
+            Mm[i] = Gr[i]*Z[i]*28.9625/Zref;
+            const double MrCH = (Mm[i] - xN2[i] * mN2 - xCO2[i] * mCO2)/xCH[i];
+            HCH[i] = (MrCH - G1) / G2;
+            ierr[i] = BmixRowGross(t, xCH[i], xN2[i], xCO2[i], HCH[i], B, C);
+            if (ierr[i] > 0){
+                active[i] = 0; --nactive; continue;
+            }
+            Z[i] = 1 + B * Pd / RGross / Td;
+            if (std::abs(Zold - Z[i]) < 0.0000001){ active[i] = 0; --nactive; }
+        }
+    }
+
+    for (std::size_t i = 0; i < n; ++i){
+        if (ierr[i] > 0){ continue; }
+        HN[i] = HCH[i] * xCH[i];
+        Hv[i] = HN[i] / Z[i] / RGross / Td * Pd / (1 + 0.0001027 * (Th - 298.15));
+    }
+}
+
 /**
  * @brief Initialize all the constants and parameters in the GROSS model
  * 
@@ -691,6 +1274,10 @@ void SetupGross()
   cCHx[0][1] = 0.000646422;     cCHx[1][1] = -0.00000422876;   cCHx[2][1] = 0.00000000688157;
   cCHx[0][2] = -0.000000332805; cCHx[1][2] = 0.0000000022316;  cCHx[2][2] = -3.67713E-12;
 
+  // Clear the temperature dependent terms of Bmix (NaN never matches a temperature)
+  for (int s = 0; s < NTSlots; ++s){ BmixT[s] = BmixTGross(); }
+  BmixTnext = 0;
+
   // //Heating values from ISO 6976 at 25 C (kJ/mol)
   // 'xHN(1) = 890.58    'Methane
   // 'xHN(2) = 0         'Nitrogen
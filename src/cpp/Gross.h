@@ -22,15 +22,33 @@ OR USE OF, THE SOFTWARE OR SERVICES PROVIDED HEREUNDER.
 
 #include <vector>
 #include <string>
+#include "Composition.h"
 
 void MolarMassGross(const std::vector<double> &x, double &Mm);
+void MolarMassGross(const Composition &x, double &Mm);
+void MolarMassGross(const CompositionView &x, double &Mm);
 void PressureGross(const double T, const double D, const std::vector<double> &xGrs, const double HCH, double &P, double &Z, int &ierr, std::string &herr);
+void PressureGross(const double T, const double D, const std::vector<double> &xGrs, const double HCH, double &P, double &Z, int &ierr, const char *&herr);
 void DensityGross(const double T, const double P, const std::vector<double> &xGrs, const double HCH, double &D, int &ierr, std::string &herr);
+void DensityGross(const double T, const double P, const std::vector<double> &xGrs, const double HCH, double &D, int &ierr, const char *&herr);
+void DensityGrossIterative(const double T, const double P, const std::vector<double> &xGrs, const double HCH, double &D, int &ierr, std::string &herr);
+void DensityGrossIterative(const double T, const double P, const std::vector<double> &xGrs, const double HCH, double &D, int &ierr, const char *&herr);
+void DensityGrossBatch(const std::vector<double> &T, const std::vector<double> &P, const std::vector<double> &xCH, const std::vector<double> &xN2, const std::vector<double> &xCO2, const std::vector<double> &HCH, std::vector<double> &D, std::vector<double> &Z, std::vector<int> &ierr);
 void GrossHv(const std::vector<double> &x, std::vector<double> &xGrs, double &HN, double &HCH);
+void GrossHv(const Composition &x, std::vector<double> &xGrs, double &HN, double &HCH);
+void GrossHv(const CompositionView &x, std::vector<double> &xGrs, double &HN, double &HCH);
 void GrossInputs(const double T, const double P, const std::vector<double> &x, std::vector<double> &xGrs, double &Gr, double &HN, double &HCH, int &ierr, std::string &herr);
+void GrossInputs(const double T, const double P, const std::vector<double> &x, std::vector<double> &xGrs, double &Gr, double &HN, double &HCH, int &ierr, const char *&herr);
+void GrossInputs(const double T, const double P, const Composition &x, std::vector<double> &xGrs, double &Gr, double &HN, double &HCH, int &ierr, const char *&herr);
+void GrossInputs(const double T, const double P, const CompositionView &x, std::vector<double> &xGrs, double &Gr, double &HN, double &HCH, int &ierr, const char *&herr);
 void Bmix(const double T, const std::vector<double> &xGrs, const double HCH, double &B, double &C, int &ierr, std::string &herr);
+void Bmix(const double T, const std::vector<double> &xGrs, const double HCH, double &B, double &C, int &ierr, const char *&herr);
 void GrossMethod1(const double Th, const double Td, const double Pd, std::vector<double> &xGrs, const double Gr, const double Hv, double & Mm, double &HCH, double &HN, int &ierr, std::string &herr);
+void GrossMethod1(const double Th, const double Td, const double Pd, std::vector<double> &xGrs, const double Gr, const double Hv, double & Mm, double &HCH, double &HN, int &ierr, const char *&herr);
 void GrossMethod2(const double Th, const double Td, const double Pd, std::vector<double> &xGrs, const double Gr, double &Hv, double &Mm, double &HCH, double &HN, int &ierr, std::string &herr);
+void GrossMethod2(const double Th, const double Td, const double Pd, std::vector<double> &xGrs, const double Gr, double &Hv, double &Mm, double &HCH, double &HN, int &ierr, const char *&herr);
+void GrossMethod1Batch(const double Th, const double Td, const double Pd, const std::vector<double> &Gr, const std::vector<double> &Hv, const std::vector<double> &xCO2, std::vector<double> &xCH, std::vector<double> &xN2, std::vector<double> &Mm, std::vector<double> &HCH, std::vector<double> &HN, std::vector<int> &ierr);
+void GrossMethod2Batch(const double Th, const double Td, const double Pd, const std::vector<double> &Gr, const std::vector<double> &xN2, const std::vector<double> &xCO2, std::vector<double> &xCH, std::vector<double> &Hv, std::vector<double> &Mm, std::vector<double> &HCH, std::vector<double> &HN, std::vector<int> &ierr);
 void SetupGross();
 
 #endif
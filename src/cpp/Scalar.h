@@ -0,0 +1,121 @@
+/**
+ * @file Scalar.h
+ * @brief Scalar types of the templates of PressureGERG, PropertiesGERG, PressureDetail and PropertiesDetail
+ *
+ * Besides double, the templates are instantiated for float and for forward-mode dual numbers. A Dual<N> carries a value and its derivatives with respect to N seeded variables. Evaluating a
+ * property with Dual<N> inputs returns the property and its N derivatives in one pass, e.g. with
+ * T = Dual<2>::Variable(T, 0) and D = Dual<2>::Variable(D, 1), P.d[0] is dP/dT and P.d[1] is dP/dD.
+ * Comparisons only use the value, so that the branches of the kernels follow the double path.
+ *
+ * Some factors of the DETAIL terms (E^un of the mixing rules, T^-un) exceed the range of float while
+ * their products do not; they are held in WideScalar<V>, double for float and V otherwise.
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef AGA8SCALAR_H_
+#define AGA8SCALAR_H_
+
+#include <cmath>
+
+// Type of the factors of a V evaluation that exceed the range of V
+template <typename V>
+struct WideScalar
+{
+    typedef V type;
+};
+
+template <>
+struct WideScalar<float>
+{
+    typedef double type;
+};
+
+template <int N>
+struct Dual
+{
+    double v;                    // Value
+    double d[N];                 // Derivatives with respect to the seeded variables
+
+    Dual() : v(0), d() {}
+    Dual(const double a) : v(a), d() {}
+
+    // Variable number k (0 to N-1) with value a
+    static Dual Variable(const double a, const int k)
+    {
+        Dual r(a);
+        r.d[k] = 1;
+        return r;
+    }
+
+    Dual &operator+=(const Dual &b) { v += b.v; for (int k = 0; k < N; ++k) { d[k] += b.d[k]; } return *this; }
+    Dual &operator-=(const Dual &b) { v -= b.v; for (int k = 0; k < N; ++k) { d[k] -= b.d[k]; } return *this; }
+    Dual &operator*=(const Dual &b) { for (int k = 0; k < N; ++k) { d[k] = d[k] * b.v + v * b.d[k]; } v *= b.v; return *this; }
+    Dual &operator/=(const Dual &b) { const double r = 1 / b.v; v *= r; for (int k = 0; k < N; ++k) { d[k] = (d[k] - v * b.d[k]) * r; } return *this; }
+    Dual &operator+=(const double b) { v += b; return *this; }
+    Dual &operator-=(const double b) { v -= b; return *this; }
+    Dual &operator*=(const double b) { v *= b; for (int k = 0; k < N; ++k) { d[k] *= b; } return *this; }
+    Dual &operator/=(const double b) { return *this *= 1 / b; }
+};
+
+// Value and derivatives of f(a), with f(a.v) = fa and f'(a.v) = dfa
+template <int N>
+inline Dual<N> ChainDual(const Dual<N> &a, const double fa, const double dfa)
+{
+    Dual<N> r(fa);
+    for (int k = 0; k < N; ++k) { r.d[k] = dfa * a.d[k]; }
+    return r;
+}
+
+template <int N> inline Dual<N> operator+(const Dual<N> &a) { return a; }
+template <int N> inline Dual<N> operator-(const Dual<N> &a) { return ChainDual(a, -a.v, -1); }
+template <int N> inline Dual<N> operator+(Dual<N> a, const Dual<N> &b) { return a += b; }
+template <int N> inline Dual<N> operator-(Dual<N> a, const Dual<N> &b) { return a -= b; }
+template <int N> inline Dual<N> operator*(Dual<N> a, const Dual<N> &b) { return a *= b; }
+template <int N> inline Dual<N> operator/(Dual<N> a, const Dual<N> &b) { return a /= b; }
+template <int N> inline Dual<N> operator+(Dual<N> a, const double b) { return a += b; }
+template <int N> inline Dual<N> operator-(Dual<N> a, const double b) { return a -= b; }
+template <int N> inline Dual<N> operator*(Dual<N> a, const double b) { return a *= b; }
+template <int N> inline Dual<N> operator/(Dual<N> a, const double b) { return a /= b; }
+template <int N> inline Dual<N> operator+(const double a, Dual<N> b) { return b += a; }
+template <int N> inline Dual<N> operator-(const double a, const Dual<N> &b) { return ChainDual(b, a - b.v, -1); }
+template <int N> inline Dual<N> operator*(const double a, Dual<N> b) { return b *= a; }
+template <int N> inline Dual<N> operator/(const double a, const Dual<N> &b) { const double r = a / b.v; return ChainDual(b, r, -r / b.v); }
+
+template <int N> inline bool operator<(const Dual<N> &a, const Dual<N> &b) { return a.v < b.v; }
+template <int N> inline bool operator>(const Dual<N> &a, const Dual<N> &b) { return a.v > b.v; }
+template <int N> inline bool operator<=(const Dual<N> &a, const Dual<N> &b) { return a.v <= b.v; }
+template <int N> inline bool operator>=(const Dual<N> &a, const Dual<N> &b) { return a.v >= b.v; }
+template <int N> inline bool operator==(const Dual<N> &a, const Dual<N> &b) { return a.v == b.v; }
+template <int N> inline bool operator!=(const Dual<N> &a, const Dual<N> &b) { return a.v != b.v; }
+template <int N> inline bool operator<(const Dual<N> &a, const double b) { return a.v < b; }
+template <int N> inline bool operator>(const Dual<N> &a, const double b) { return a.v > b; }
+template <int N> inline bool operator<=(const Dual<N> &a, const double b) { return a.v <= b; }
+template <int N> inline bool operator>=(const Dual<N> &a, const double b) { return a.v >= b; }
+template <int N> inline bool operator==(const Dual<N> &a, const double b) { return a.v == b; }
+template <int N> inline bool operator!=(const Dual<N> &a, const double b) { return a.v != b; }
+
+template <int N> inline Dual<N> exp(const Dual<N> &a) { const double e = std::exp(a.v); return ChainDual(a, e, e); }
+template <int N> inline Dual<N> log(const Dual<N> &a) { return ChainDual(a, std::log(a.v), 1 / a.v); }
+template <int N> inline Dual<N> sqrt(const Dual<N> &a) { const double s = std::sqrt(a.v); return ChainDual(a, s, s > 0 ? 0.5 / s : 0); }
+template <int N> inline Dual<N> abs(const Dual<N> &a) { return a.v < 0 ? -a : a; }
+template <int N> inline Dual<N> pow(const Dual<N> &a, const double b) { const double p = std::pow(a.v, b); return ChainDual(a, p, b == 0 ? 0 : b * std::pow(a.v, b - 1)); }
+template <int N> inline Dual<N> pow(const Dual<N> &a, const Dual<N> &b) { return exp(b * log(a)); }
+
+#endif
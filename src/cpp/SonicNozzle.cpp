@@ -0,0 +1,238 @@
+/**
+ * @file SonicNozzle.cpp
+ * @brief Sizing of toroidal-throat sonic nozzles (ISO 9300) for a target mass flow rate
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "SonicNozzle.h"
+#include "CriticalFlow.h"
+#include "Detail.h"
+#include "GERG2008.h"
+
+#include <cmath>
+
+static const int MaxIterNozzle = 50;
+static const double tolNozzle = 1e-12;       // Relative tolerance on the diameter
+static const double tolPressureNozzle = 1e-10; // Relative tolerance on the inlet pressure, above the noise of C*
+static const double MaxPressureNozzle = 1e5; // Highest inlet pressure searched (kPa)
+static const double CstarIdealNozzle = 0.67; // C* of the first inlet pressure estimate
+static const double piNozzle = 3.14159265358979323846;
+
+template <typename X> static void SonicNozzleDiameterImpl(const int method, const X &x, const double qm, const double T0, const double P0, const double Pout, const double mu, SonicNozzle &nozzle, int &ierr, const char *&herr);
+template <typename X> static void SonicNozzlePressureImpl(const int method, const X &x, const double qm, const double T0, const double d, const double Pout, const double mu, SonicNozzle &nozzle, int &ierr, const char *&herr);
+
+/**
+ * @brief Discharge coefficient of a toroidal-throat sonic nozzle (ISO 9300)
+ *
+ * Same as getThoroidalNozzleDischargeCoefficient of sonic.ts.
+ *
+ * @param Re Throat Reynolds number
+ * @return Cd = 0.9959 - 2.72*Re^-0.5
+ */
+double ToroidalNozzleDischargeCoefficient(const double Re)
+{
+    return 0.9959 - 2.72 / std::sqrt(Re);
+}
+
+// C* and throat pressure at (T0, P0), from the throat estimate (Tt, Pt, -Dt) if Dt < 0
+template <typename X>
+static void CriticalFlowNozzle(const int method, const X &x, const double T0, const double P0, double &Cstar, double &Tt, double &Pt, double &Dt, int &ierr, const char *&herr)
+{
+    if (method == SonicNozzleDetail) { CriticalFlowFunctionDetail(T0, P0, x, Cstar, Tt, Pt, Dt, ierr, herr); }
+    else { CriticalFlowFunctionGERG(T0, P0, x, Cstar, Tt, Pt, Dt, ierr, herr); }
+}
+
+// sqrt(R*T0/M) (m/s)
+template <typename X>
+static double SoundScaleNozzle(const int method, const X &x, const double T0)
+{
+    double Mm;
+    if (method == SonicNozzleDetail)
+    {
+        MolarMassDetail(x, Mm);
+        return std::sqrt(8.31451 * T0 / (Mm / 1000));
+    }
+    MolarMassGERG(x, Mm);
+    return std::sqrt(8.314472 * T0 / (Mm / 1000));
+}
+
+/**
+ * @brief Throat diameter of a toroidal-throat sonic nozzle passing a mass flow rate
+ *
+ * C* is solved once at the inlet state; the diameter then follows from the fixed point
+ * d = sqrt(4*qm*sqrt(R*T0/M)/(pi*Cd(Re(d))*C*P0)), which converges in a few iterations since Cd
+ * varies slowly with Re. The flow must be choked: Pout <= Pt, the throat pressure.
+ * SetupGERG (or SetupDetail) must have been called.
+ *
+ * @param method SonicNozzleGERG or SonicNozzleDetail
+ * @param x Composition (mole fraction)
+ * @param qm Mass flow rate (kg/s)
+ * @param T0 Inlet (stagnation) temperature (K)
+ * @param P0 Inlet (stagnation) pressure (kPa)
+ * @param Pout Outlet pressure (kPa)
+ * @param mu Dynamic viscosity of the gas at the inlet (Pa-s)
+ * @param[out] nozzle Throat diameter, discharge coefficient, Reynolds number, C* and throat pressure
+ * @param[out] ierr Error number (0 indicates no error)
+ * @param[out] herr Error message if ierr is not equal to zero
+ */
+void SonicNozzleDiameter(const int method, const std::vector<double> &x, const double qm, const double T0, const double P0, const double Pout, const double mu, SonicNozzle &nozzle, int &ierr, const char *&herr)
+{
+    SonicNozzleDiameterImpl(method, x, qm, T0, P0, Pout, mu, nozzle, ierr, herr);
+}
+
+/**
+ * @brief SonicNozzleDiameter for a fixed-size Composition
+ * @see SonicNozzleDiameter
+ */
+void SonicNozzleDiameter(const int method, const Composition &x, const double qm, const double T0, const double P0, const double Pout, const double mu, SonicNozzle &nozzle, int &ierr, const char *&herr)
+{
+    SonicNozzleDiameterImpl(method, x, qm, T0, P0, Pout, mu, nozzle, ierr, herr);
+}
+
+/**
+ * @brief SonicNozzleDiameter for a CompositionView, e.g. a row of a composition matrix
+ * @see SonicNozzleDiameter
+ */
+void SonicNozzleDiameter(const int method, const CompositionView &x, const double qm, const double T0, const double P0, const double Pout, const double mu, SonicNozzle &nozzle, int &ierr, const char *&herr)
+{
+    SonicNozzleDiameterImpl(method, x, qm, T0, P0, Pout, mu, nozzle, ierr, herr);
+}
+
+// SonicNozzleDiameter for any composition type X (std::vector, Composition, CompositionView)
+template <typename X>
+static void SonicNozzleDiameterImpl(const int method, const X &x, const double qm, const double T0, const double P0, const double Pout, const double mu, SonicNozzle &nozzle, int &ierr, const char *&herr)
+{
+    ierr = 0;
+    herr = "";
+    nozzle = SonicNozzle();
+    if (!(qm > 0 && T0 > 0 && P0 > 0 && Pout >= 0 && mu > 0)) { ierr = 1; herr = "Invalid nozzle input"; return; }
+
+    double Tt = 0, Dt = 0;
+    CriticalFlowNozzle(method, x, T0, P0, nozzle.Cstar, Tt, nozzle.Pt, Dt, ierr, herr);
+    if (ierr != 0) { return; }
+    nozzle.P0 = P0;
+    nozzle.Poutmax = nozzle.Pt;
+    if (Pout > nozzle.Poutmax) { ierr = 2; herr = "The flow is not choked at the outlet pressure"; return; }
+
+    // Mass flux per unit Cd (kg/(s-m^2))
+    const double flux = nozzle.Cstar * P0 * 1000 / SoundScaleNozzle(method, x, T0);
+    double Cd = ToroidalNozzleDischargeCoefficient(HUGE_VAL), d = std::sqrt(4 * qm / (piNozzle * flux * Cd)), Re = 0;
+    for (int it = 0; it < MaxIterNozzle; ++it)
+    {
+        Re = 4 * qm / (piNozzle * d * mu);
+        Cd = ToroidalNozzleDischargeCoefficient(Re);
+        if (!(Cd > 0)) { ierr = 3; herr = "Reynolds number too low for the discharge coefficient"; return; }
+        const double dnew = std::sqrt(4 * qm / (piNozzle * flux * Cd));
+        const bool converged = std::abs(dnew - d) <= tolNozzle * d;
+        d = dnew;
+        if (converged) { break; }
+    }
+    nozzle.d = d * 1000;
+    nozzle.Cd = Cd;
+    nozzle.Re = 4 * qm / (piNozzle * d * mu);
+}
+
+/**
+ * @brief Inlet pressure of a toroidal-throat sonic nozzle passing a mass flow rate
+ *
+ * With the throat diameter and mass flow rate known, Re and Cd are fixed, and P0 solves
+ * C*(P0)*P0 = qm*sqrt(R*T0/M)/(A*Cd) by secants, each throat solve starting from the previous one.
+ * The flow must be choked: Pout <= Pt, the throat pressure. SetupGERG (or SetupDetail) must have been called.
+ *
+ * @param method SonicNozzleGERG or SonicNozzleDetail
+ * @param x Composition (mole fraction)
+ * @param qm Mass flow rate (kg/s)
+ * @param T0 Inlet (stagnation) temperature (K)
+ * @param d Throat diameter (mm)
+ * @param Pout Outlet pressure (kPa)
+ * @param mu Dynamic viscosity of the gas at the inlet (Pa-s)
+ * @param[out] nozzle Inlet pressure, discharge coefficient, Reynolds number, C* and throat pressure
+ * @param[out] ierr Error number (0 indicates no error)
+ * @param[out] herr Error message if ierr is not equal to zero
+ */
+void SonicNozzlePressure(const int method, const std::vector<double> &x, const double qm, const double T0, const double d, const double Pout, const double mu, SonicNozzle &nozzle, int &ierr, const char *&herr)
+{
+    SonicNozzlePressureImpl(method, x, qm, T0, d, Pout, mu, nozzle, ierr, herr);
+}
+
+/**
+ * @brief SonicNozzlePressure for a fixed-size Composition
+ * @see SonicNozzlePressure
+ */
+void SonicNozzlePressure(const int method, const Composition &x, const double qm, const double T0, const double d, const double Pout, const double mu, SonicNozzle &nozzle, int &ierr, const char *&herr)
+{
+    SonicNozzlePressureImpl(method, x, qm, T0, d, Pout, mu, nozzle, ierr, herr);
+}
+
+/**
+ * @brief SonicNozzlePressure for a CompositionView, e.g. a row of a composition matrix
+ * @see SonicNozzlePressure
+ */
+void SonicNozzlePressure(const int method, const CompositionView &x, const double qm, const double T0, const double d, const double Pout, const double mu, SonicNozzle &nozzle, int &ierr, const char *&herr)
+{
+    SonicNozzlePressureImpl(method, x, qm, T0, d, Pout, mu, nozzle, ierr, herr);
+}
+
+// SonicNozzlePressure for any composition type X (std::vector, Composition, CompositionView)
+template <typename X>
+static void SonicNozzlePressureImpl(const int method, const X &x, const double qm, const double T0, const double d, const double Pout, const double mu, SonicNozzle &nozzle, int &ierr, const char *&herr)
+{
+    ierr = 0;
+    herr = "";
+    nozzle = SonicNozzle();
+    if (!(qm > 0 && T0 > 0 && d > 0 && Pout >= 0 && mu > 0)) { ierr = 1; herr = "Invalid nozzle input"; return; }
+
+    const double dm = d / 1000;
+    nozzle.d = d;
+    nozzle.Re = 4 * qm / (piNozzle * dm * mu);
+    nozzle.Cd = ToroidalNozzleDischargeCoefficient(nozzle.Re);
+    if (!(nozzle.Cd > 0)) { ierr = 3; herr = "Reynolds number too low for the discharge coefficient"; return; }
+    const double target = qm * SoundScaleNozzle(method, x, T0) / (piNozzle * dm * dm / 4 * nozzle.Cd * 1000); // C*P0 (kPa)
+
+    // Secants on f(P0) = C*(P0)*P0 - target, from the estimates with the ideal gas C* and the first calculated C*
+    double P0 = target / CstarIdealNozzle, Cstar = 0, Tt = 0, Pt = 0, Dt = 0;
+    double P0old = 0, fold = 0;
+    bool converged = false;
+    for (int it = 0; it < MaxIterNozzle && !converged; ++it)
+    {
+        if (!(P0 > 0 && P0 <= MaxPressureNozzle)) { ierr = 4; herr = "No inlet pressure gives the mass flow rate"; return; }
+        if (it > 0)
+        {
+            // Throat estimate scaled from the previous inlet pressure
+            Pt *= P0 / P0old;
+            Dt = -Dt * P0 / P0old;
+        }
+        CriticalFlowNozzle(method, x, T0, P0, Cstar, Tt, Pt, Dt, ierr, herr);
+        if (ierr != 0) { return; }
+        const double f = Cstar * P0 - target;
+        const double P0new = it == 0 || f == fold ? target / Cstar : P0 - f * (P0 - P0old) / (f - fold);
+        converged = std::abs(P0new - P0) <= tolPressureNozzle * P0;
+        P0old = P0;
+        fold = f;
+        P0 = converged ? P0 : P0new;
+    }
+    if (!converged) { ierr = 5; herr = "Inlet pressure did not converge"; return; }
+
+    nozzle.P0 = P0;
+    nozzle.Cstar = Cstar;
+    nozzle.Pt = Pt;
+    nozzle.Poutmax = Pt;
+    if (Pout > nozzle.Poutmax) { ierr = 2; herr = "The flow is not choked at the outlet pressure"; return; }
+}
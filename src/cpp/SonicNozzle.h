@@ -0,0 +1,61 @@
+/**
+ * @file SonicNozzle.h
+ * @brief Sizing of toroidal-throat sonic nozzles (ISO 9300) for a target mass flow rate
+ *
+ * The mass flow rate of a choked nozzle is qm = A*Cd*C*P0/sqrt(R*T0/M), with the real-gas critical
+ * flow function C* of CriticalFlowFunctionGERG (or DETAIL) and the discharge coefficient of a
+ * toroidal-throat nozzle Cd = 0.9959 - 2.72*Re^-0.5, Re = 4*qm/(pi*d*mu0) being the throat Reynolds
+ * number. For a throat diameter, Cd only depends on the mass flow rate, and C* only on the inlet
+ * state, so both unknowns are found by short fixed-point iterations.
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef AGA8SONICNOZZLE_H_
+#define AGA8SONICNOZZLE_H_
+
+#include <vector>
+#include "Composition.h"
+
+// Equation of state of a nozzle
+const int SonicNozzleGERG = 0, SonicNozzleDetail = 1;
+
+/**
+ * @brief Nozzle found by SonicNozzleDiameter or SonicNozzlePressure
+ */
+struct SonicNozzle
+{
+    double d;                    // Throat diameter (mm)
+    double P0;                   // Inlet (stagnation) pressure (kPa)
+    double Cd;                   // Discharge coefficient
+    double Re;                   // Throat Reynolds number
+    double Cstar;                // Real-gas critical flow function
+    double Pt;                   // Throat pressure (kPa)
+    double Poutmax;              // Largest outlet pressure of a choked flow, the throat pressure Pt (kPa)
+};
+
+double ToroidalNozzleDischargeCoefficient(const double Re);
+void SonicNozzleDiameter(const int method, const std::vector<double> &x, const double qm, const double T0, const double P0, const double Pout, const double mu, SonicNozzle &nozzle, int &ierr, const char *&herr);
+void SonicNozzleDiameter(const int method, const Composition &x, const double qm, const double T0, const double P0, const double Pout, const double mu, SonicNozzle &nozzle, int &ierr, const char *&herr);
+void SonicNozzleDiameter(const int method, const CompositionView &x, const double qm, const double T0, const double P0, const double Pout, const double mu, SonicNozzle &nozzle, int &ierr, const char *&herr);
+void SonicNozzlePressure(const int method, const std::vector<double> &x, const double qm, const double T0, const double d, const double Pout, const double mu, SonicNozzle &nozzle, int &ierr, const char *&herr);
+void SonicNozzlePressure(const int method, const Composition &x, const double qm, const double T0, const double d, const double Pout, const double mu, SonicNozzle &nozzle, int &ierr, const char *&herr);
+void SonicNozzlePressure(const int method, const CompositionView &x, const double qm, const double T0, const double d, const double Pout, const double mu, SonicNozzle &nozzle, int &ierr, const char *&herr);
+
+#endif
@@ -0,0 +1,407 @@
+/**
+ * @file Surrogate.cpp
+ * @brief Error-bounded (T,P) tables of Z, H, S, W and Cf for one composition
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "Surrogate.h"
+#include "Detail.h"
+#include "GERG2008.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+static const double RSurrogate = 8.314472; // Only scales the H and S errors, see SurrogateError
+static const int MinDepthSurrogate = 2;    // The domain is split in at least 4 x 4 cells
+static const int MaxDepthSurrogate = 8;    // and at most 256 x 256 cells
+static const int NCheckSurrogate = 5;      // Check points per direction of a cell
+static const char MagicSurrogate[8] = {'A', 'G', 'A', '8', 'S', 'R', 'G', '2'};
+
+// Z, H, S, W and Cf from the equation of state, with the density, dP/dD and Gibbs energy of the state
+static void ExactSurrogate(const SurrogateTable &tab, const double T, const double P, double v[NPropSurrogate], double &D, double &dPdD, double &G, int &ierr, const char *&herr)
+{
+    double Pc, Z, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, JT, Kappa, A, Cf;
+    D = 0;
+    if (tab.method == SurrogateDetail)
+    {
+        DensityDetail(T, P, tab.x, D, ierr, herr);
+        PropertiesDetail(T, D, tab.x, Pc, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, Cf);
+    }
+    else
+    {
+        DensityGERG(0, T, P, tab.x, D, ierr, herr);
+        PropertiesGERG(T, D, tab.x, Pc, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf);
+    }
+    v[0] = Z;
+    v[1] = H;
+    v[2] = S;
+    v[3] = W;
+    v[4] = Cf;
+}
+
+/**
+ * @brief Check whether the root of DensityGERG (iFlag = 0) or DensityDetail is unstable or metastable
+ *
+ * A root with dP/dD <= 0 lies inside the spinodal. Otherwise the density is solved again from a
+ * liquid-like initial guess; if it converges to another root with a lower Gibbs energy, the state
+ * is 2-phase (or liquid) and the gas root is not the stable one.
+ */
+static bool TwoPhaseSurrogate(const SurrogateTable &tab, const double T, const double P, const double D, const double dPdD0, const double G)
+{
+    if (!(dPdD0 > 0)) { return true; }
+
+    double Dl, Pc, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, Gl, JT, Kappa, A, Cf;
+    int ierr;
+    const char *herr;
+    if (tab.method == SurrogateDetail)
+    {
+        PreparedIsothermDetail iso;
+        PrepareIsothermDetail(T, tab.x, iso);
+        Dl = -1 / iso.K3; // Reduced density of 1
+        DensityDetail(T, P, tab.x, Dl, ierr, herr);
+        if (ierr != 0) { return false; }
+        PropertiesDetail(T, Dl, tab.x, Pc, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, Gl, JT, Kappa, Cf);
+    }
+    else
+    {
+        DensityGERG(2, T, P, tab.x, Dl, ierr, herr);
+        if (ierr != 0) { return false; }
+        PropertiesGERG(T, Dl, tab.x, Pc, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, Gl, JT, Kappa, A, Cf);
+    }
+    return std::abs(Dl - D) > 1e-6 * D && Gl < G;
+}
+
+// Sample of a cell: false if the density solve failed or the state is 2-phase
+static bool SampleSurrogate(const SurrogateTable &tab, const double T, const double P, double v[NPropSurrogate])
+{
+    double D, dPdD, G;
+    int ierr;
+    const char *herr;
+    ExactSurrogate(tab, T, P, v, D, dPdD, G, ierr, herr);
+    return ierr == 0 && !TwoPhaseSurrogate(tab, T, P, D, dPdD, G);
+}
+
+// Chebyshev polynomials T0(u) to T3(u)
+static inline void ChebyshevSurrogate(const double u, double t[NNodeSurrogate])
+{
+    t[0] = 1;
+    t[1] = u;
+    for (int k = 2; k < NNodeSurrogate; ++k) { t[k] = 2 * u * t[k - 1] - t[k - 2]; }
+}
+
+// Properties of a cell at the local coordinates -1 <= u, v <= 1
+static inline void InterpolateSurrogate(const double *c, const double u, const double v, double out[NPropSurrogate])
+{
+    double tu[NNodeSurrogate], tv[NNodeSurrogate];
+    ChebyshevSurrogate(u, tu);
+    ChebyshevSurrogate(v, tv);
+    for (int p = 0; p < NPropSurrogate; ++p)
+    {
+        double sum = 0;
+        for (int i = 0; i < NNodeSurrogate; ++i)
+        {
+            double si = 0;
+            for (int j = 0; j < NNodeSurrogate; ++j) { si += c[j] * tv[j]; }
+            sum += si * tu[i];
+            c += NNodeSurrogate;
+        }
+        out[p] = sum;
+    }
+}
+
+// Relative error of property p; H and S have an arbitrary origin and are compared to RT and R near zero
+static double SurrogateError(const int p, const double T, const double a, const double e)
+{
+    double scale = std::abs(e);
+    if (p == 1) { scale = std::max(scale, RSurrogate * T); }
+    if (p == 2) { scale = std::max(scale, RSurrogate); }
+    return std::abs(a - e) / scale;
+}
+
+/**
+ * @brief Fit one cell and check it against the equation of state
+ *
+ * @return 0 if the cell is within tol, 1 if its error is too large, 2 if some of its states
+ *         failed (density solver error or 2-phase), 3 if all the fitted states failed
+ */
+static int FitCellSurrogate(const SurrogateTable &tab, const double T0, const double T1, const double L0, const double L1, double *c)
+{
+    const double pi = 3.141592653589793;
+    const int N = NNodeSurrogate;
+    double f[N][N][NPropSurrogate], node[N];
+    int failed = 0;
+
+    for (int k = 0; k < N; ++k) { node[k] = std::cos(pi * (k + 0.5) / N); }
+    for (int a = 0; a < N; ++a)
+    {
+        const double T = T0 + (T1 - T0) * (node[a] + 1) / 2;
+        for (int b = 0; b < N; ++b)
+        {
+            const double P = std::exp(L0 + (L1 - L0) * (node[b] + 1) / 2);
+            if (!SampleSurrogate(tab, T, P, f[a][b])) { ++failed; }
+        }
+    }
+    if (failed == N * N) { return 3; }
+    if (failed > 0) { return 2; }
+
+    // Discrete Chebyshev transform, coefficient (p, i, j) at c[(p*N + i)*N + j]
+    for (int p = 0; p < NPropSurrogate; ++p)
+    {
+        for (int i = 0; i < N; ++i)
+        {
+            for (int j = 0; j < N; ++j)
+            {
+                double sum = 0;
+                for (int a = 0; a < N; ++a)
+                {
+                    for (int b = 0; b < N; ++b) { sum += f[a][b][p] * std::cos(pi * i * (a + 0.5) / N) * std::cos(pi * j * (b + 0.5) / N); }
+                }
+                sum *= 4.0 / (N * N);
+                if (i == 0) { sum /= 2; }
+                if (j == 0) { sum /= 2; }
+                c[(p * N + i) * N + j] = sum;
+            }
+        }
+    }
+
+    double e[NPropSurrogate], s[NPropSurrogate];
+    for (int a = 0; a < NCheckSurrogate; ++a)
+    {
+        const double u = -1 + 2.0 * a / (NCheckSurrogate - 1);
+        const double T = T0 + (T1 - T0) * (u + 1) / 2;
+        for (int b = 0; b < NCheckSurrogate; ++b)
+        {
+            const double v = -1 + 2.0 * b / (NCheckSurrogate - 1);
+            const double P = std::exp(L0 + (L1 - L0) * (v + 1) / 2);
+            if (!SampleSurrogate(tab, T, P, e)) { return 2; }
+            InterpolateSurrogate(c, u, v, s);
+            for (int p = 0; p < NPropSurrogate; ++p)
+            {
+                if (!(SurrogateError(p, T, s[p], e[p]) <= tab.tol)) { return 1; }
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Build the property table of a composition
+ *
+ * The domain is split in 4 x 4 cells, and each cell that is not within tol of the equation of
+ * state is split in four, down to cells of 1/256 of the domain in each direction. Cells where some
+ * states have a density solver error or are 2-phase are split in the same way, so that only the
+ * neighbourhood of the phase boundary is evaluated exactly. SetupGERG (or SetupDetail) must have
+ * been called.
+ *
+ * @param method SurrogateGERG or SurrogateDetail
+ * @param x Composition (mole fraction)
+ * @param Tmin, Tmax Temperature range (K)
+ * @param Pmin, Pmax Pressure range (kPa), Pmin > 0
+ * @param tol Maximum relative error of Z, H, S, W and Cf (H and S relative to at least RT and R)
+ * @param[out] tab Table
+ * @param[out] ierr Error number (0 indicates no error)
+ * @param[out] herr Error message if ierr is not equal to zero
+ */
+void BuildSurrogate(const int method, const std::vector<double> &x, const double Tmin, const double Tmax, const double Pmin, const double Pmax, const double tol, SurrogateTable &tab, int &ierr, const char *&herr)
+{
+    struct Cell
+    {
+        double T0, T1, L0, L1;
+        int depth;
+    };
+
+    ierr = 0;
+    herr = "";
+    if (method != SurrogateGERG && method != SurrogateDetail) { ierr = 1; herr = "Unknown surrogate method"; return; }
+    if (!(Tmin > 0 && Tmax > Tmin && Pmin > 0 && Pmax > Pmin)) { ierr = 2; herr = "Invalid surrogate domain"; return; }
+    if (!(tol > 0)) { ierr = 3; herr = "Surrogate tolerance must be positive"; return; }
+
+    tab.method = method;
+    tab.x = x;
+    tab.Tmin = Tmin;
+    tab.Tmax = Tmax;
+    tab.lnPmin = std::log(Pmin);
+    tab.lnPmax = std::log(Pmax);
+    tab.tol = tol;
+    tab.node.assign(1, 0);
+    tab.coef.clear();
+
+    // Breadth-first: the cells are numbered like their nodes
+    std::vector<Cell> cells(1, Cell{Tmin, Tmax, tab.lnPmin, tab.lnPmax, 0});
+    double c[NCoefSurrogate];
+    for (std::size_t k = 0; k < cells.size(); ++k)
+    {
+        const Cell cell = cells[k];
+        const int fit = cell.depth < MinDepthSurrogate ? 1 : FitCellSurrogate(tab, cell.T0, cell.T1, cell.L0, cell.L1, c);
+        if (fit == 0)
+        {
+            tab.node[k] = -1 - (int)(tab.coef.size() / NCoefSurrogate);
+            tab.coef.insert(tab.coef.end(), c, c + NCoefSurrogate);
+        }
+        else if (fit == 3 || cell.depth == MaxDepthSurrogate)
+        {
+            tab.node[k] = 0;
+        }
+        else
+        {
+            const double Tm = (cell.T0 + cell.T1) / 2, Lm = (cell.L0 + cell.L1) / 2;
+            tab.node[k] = (int)cells.size();
+            cells.push_back(Cell{cell.T0, Tm, cell.L0, Lm, cell.depth + 1});
+            cells.push_back(Cell{cell.T0, Tm, Lm, cell.L1, cell.depth + 1});
+            cells.push_back(Cell{Tm, cell.T1, cell.L0, Lm, cell.depth + 1});
+            cells.push_back(Cell{Tm, cell.T1, Lm, cell.L1, cell.depth + 1});
+            tab.node.resize(cells.size(), 0);
+        }
+    }
+}
+
+/**
+ * @brief Z, H, S, W and Cf at (T, P) from the table, or from the equation of state outside the validated cells
+ *
+ * The exact evaluation goes through DensityGERG (iFlag = 0) or DensityDetail, and needs the same setup.
+ *
+ * @param tab Table from BuildSurrogate or LoadSurrogate
+ * @param T Temperature (K)
+ * @param P Pressure (kPa)
+ * @param[out] Z Compressibility factor
+ * @param[out] H Enthalpy (J/mol)
+ * @param[out] S Entropy (J/mol-K)
+ * @param[out] W Speed of sound (m/s)
+ * @param[out] Cf Critical flow factor
+ * @param[out] ierr Error number of the density solve (0 indicates no error)
+ * @param[out] herr Error message if ierr is not equal to zero
+ * @return 0 if the table was used, 1 if the state was evaluated exactly
+ */
+int EvaluateSurrogate(const SurrogateTable &tab, const double T, const double P, double &Z, double &H, double &S, double &W, double &Cf, int &ierr, const char *&herr)
+{
+    double v[NPropSurrogate];
+    ierr = 0;
+    herr = "";
+    if (T >= tab.Tmin && T <= tab.Tmax && P > 0)
+    {
+        const double L = std::log(P);
+        if (L >= tab.lnPmin && L <= tab.lnPmax)
+        {
+            // Position in the current cell, from 0 to 2 (2 only on the upper edges of the domain)
+            double u = (T - tab.Tmin) / (tab.Tmax - tab.Tmin), w = (L - tab.lnPmin) / (tab.lnPmax - tab.lnPmin);
+            int k = 0;
+            while (tab.node[k] > 0)
+            {
+                u *= 2;
+                w *= 2;
+                const int hiT = u >= 1, hiP = w >= 1;
+                u -= hiT;
+                w -= hiP;
+                k = tab.node[k] + 2 * hiT + hiP;
+            }
+            if (tab.node[k] < 0)
+            {
+                InterpolateSurrogate(&tab.coef[(std::size_t)(-1 - tab.node[k]) * NCoefSurrogate], 2 * u - 1, 2 * w - 1, v);
+                Z = v[0];
+                H = v[1];
+                S = v[2];
+                W = v[3];
+                Cf = v[4];
+                return 0;
+            }
+        }
+    }
+    double D, dPdD, G;
+    ExactSurrogate(tab, T, P, v, D, dPdD, G, ierr, herr);
+    Z = v[0];
+    H = v[1];
+    S = v[2];
+    W = v[3];
+    Cf = v[4];
+    return 1;
+}
+
+/**
+ * @brief Write a table as bytes: magic, method, node and cell counts, x[1..21], domain, tol, nodes and coefficients
+ *
+ * Numbers are stored in the byte order of the machine (little-endian for WebAssembly).
+ */
+void SaveSurrogate(const SurrogateTable &tab, std::vector<unsigned char> &bytes)
+{
+    bytes.clear();
+    auto put = [&bytes](const void *p, std::size_t n) {
+        const unsigned char *b = static_cast<const unsigned char *>(p);
+        bytes.insert(bytes.end(), b, b + n);
+    };
+    const int header[3] = {tab.method, (int)tab.node.size(), (int)(tab.coef.size() / NCoefSurrogate)};
+    const double domain[5] = {tab.Tmin, tab.Tmax, tab.lnPmin, tab.lnPmax, tab.tol};
+    put(MagicSurrogate, sizeof(MagicSurrogate));
+    put(header, sizeof(header));
+    put(&tab.x[1], NcComposition * sizeof(double));
+    put(domain, sizeof(domain));
+    put(tab.node.data(), tab.node.size() * sizeof(int));
+    put(tab.coef.data(), tab.coef.size() * sizeof(double));
+}
+
+/**
+ * @brief Read a table written by SaveSurrogate
+ *
+ * @param bytes, n Serialized table
+ * @param[out] tab Table
+ * @param[out] ierr Error number (0 indicates no error)
+ * @param[out] herr Error message if ierr is not equal to zero
+ */
+void LoadSurrogate(const unsigned char *bytes, const std::size_t n, SurrogateTable &tab, int &ierr, const char *&herr)
+{
+    ierr = 0;
+    herr = "";
+    std::size_t pos = 0;
+    auto get = [&](void *p, std::size_t size) {
+        if (n - pos < size) { return false; }
+        std::memcpy(p, bytes + pos, size);
+        pos += size;
+        return true;
+    };
+    char magic[sizeof(MagicSurrogate)];
+    int header[3];
+    double domain[5];
+    if (!get(magic, sizeof(magic)) || std::memcmp(magic, MagicSurrogate, sizeof(magic)) != 0) { ierr = 1; herr = "Not a surrogate table"; return; }
+    tab.x.assign(NcComposition + 1, 0);
+    if (!get(header, sizeof(header)) || !get(&tab.x[1], NcComposition * sizeof(double)) || !get(domain, sizeof(domain))) { ierr = 2; herr = "Truncated surrogate table"; return; }
+    const std::size_t nnode = (std::size_t)header[1], ncell = (std::size_t)header[2];
+    if ((header[0] != SurrogateGERG && header[0] != SurrogateDetail) || header[1] < 1 || header[2] < 0 || nnode > n || ncell > n) { ierr = 1; herr = "Not a surrogate table"; return; }
+    tab.method = header[0];
+    tab.Tmin = domain[0];
+    tab.Tmax = domain[1];
+    tab.lnPmin = domain[2];
+    tab.lnPmax = domain[3];
+    tab.tol = domain[4];
+    tab.node.resize(nnode);
+    tab.coef.resize(ncell * NCoefSurrogate);
+    if (!get(tab.node.data(), nnode * sizeof(int)) || !get(tab.coef.data(), ncell * NCoefSurrogate * sizeof(double))) { ierr = 2; herr = "Truncated surrogate table"; return; }
+
+    // Children after their parent and inside the tree, cells inside the coefficients
+    for (std::size_t k = 0; k < nnode; ++k)
+    {
+        const int v = tab.node[k];
+        if ((v > 0 && ((std::size_t)v <= k || (std::size_t)v + 4 > nnode)) || (v < 0 && (std::size_t)(-1 - (long long)v) >= ncell))
+        {
+            ierr = 1;
+            herr = "Not a surrogate table";
+            return;
+        }
+    }
+}
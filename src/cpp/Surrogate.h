@@ -0,0 +1,72 @@
+/**
+ * @file Surrogate.h
+ * @brief Error-bounded (T,P) tables of Z, H, S, W and Cf for one composition
+ *
+ * The (T, ln P) domain is split by a quadtree into cells, each holding a bicubic Chebyshev fit of
+ * the five properties sampled from DensityGERG/PropertiesGERG (or the DETAIL equivalents). A cell
+ * is only used if its fit agrees with the equation of state within the requested relative error at
+ * a check grid, and is subdivided otherwise. Cells at the finest level that still fail, cells with
+ * density solver errors or 2-phase states, and the states outside the domain are evaluated exactly.
+ * The table can be saved to bytes and loaded again, on a machine with the same byte order.
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef AGA8SURROGATE_H_
+#define AGA8SURROGATE_H_
+
+#include <cstddef>
+#include <vector>
+
+// Equation of state sampled by a table
+const int SurrogateGERG = 0, SurrogateDetail = 1;
+
+// Properties of a table, in the order of their coefficients in a cell
+const int NPropSurrogate = 5; // Z, H, S, W, Cf
+
+// Chebyshev nodes per direction of a cell (degree 3 in T and ln P)
+const int NNodeSurrogate = 4;
+const int NCoefSurrogate = NPropSurrogate * NNodeSurrogate * NNodeSurrogate;
+
+/**
+ * @brief Property table of one composition over Tmin <= T <= Tmax, Pmin <= P <= Pmax
+ *
+ * The quadtree is flattened in breadth-first order, node 0 being the whole domain:
+ *   node[k] > 0   the four halves of cell k are nodes node[k] to node[k] + 3, in the order
+ *                 (low T, low P), (low T, high P), (high T, low P), (high T, high P)
+ *   node[k] < 0   cell k uses the coefficients -1 - node[k]
+ *   node[k] == 0  cell k is evaluated with the equation of state
+ */
+struct SurrogateTable
+{
+    int method;                  // SurrogateGERG or SurrogateDetail
+    std::vector<double> x;       // Composition (22 elements, index 0 unused)
+    double Tmin, Tmax;           // Temperature range (K)
+    double lnPmin, lnPmax;       // Natural logarithm of the pressure range (kPa)
+    double tol;                  // Maximum relative error of a table cell
+    std::vector<int> node;       // Flattened quadtree
+    std::vector<double> coef;    // NCoefSurrogate Chebyshev coefficients per table cell
+};
+
+void BuildSurrogate(const int method, const std::vector<double> &x, const double Tmin, const double Tmax, const double Pmin, const double Pmax, const double tol, SurrogateTable &tab, int &ierr, const char *&herr);
+int EvaluateSurrogate(const SurrogateTable &tab, const double T, const double P, double &Z, double &H, double &S, double &W, double &Cf, int &ierr, const char *&herr);
+void SaveSurrogate(const SurrogateTable &tab, std::vector<unsigned char> &bytes);
+void LoadSurrogate(const unsigned char *bytes, const std::size_t n, SurrogateTable &tab, int &ierr, const char *&herr);
+
+#endif
@@ -0,0 +1,159 @@
+/**
+ * @file Trace.cpp
+ * @brief Lock-free ring buffer of trace spans and its Chrome trace JSON export
+ *
+ * Each writer claims a slot with a single fetch_add on the head counter, fills it and
+ * publishes it by storing the slot sequence number with release semantics. The buffer
+ * wraps around, so only the most recent AGA8_TRACE_CAPACITY spans are kept. A reader
+ * (TraceDump) skips slots that are being rewritten while it copies them: the fields of a
+ * slot are relaxed atomics, so a copy racing with a writer is discarded, not undefined.
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "Trace.h"
+
+#ifdef AGA8_TRACE
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+static_assert((AGA8_TRACE_CAPACITY & (AGA8_TRACE_CAPACITY - 1)) == 0, "AGA8_TRACE_CAPACITY must be a power of two");
+
+struct TraceEvent
+{
+    std::atomic<uint64_t> seq; // index + 1 of the span stored in this slot, 0 while empty or being written
+    std::atomic<const char *> name;
+    std::atomic<long long> start; // ns since the trace epoch
+    std::atomic<long long> dur;   // ns
+    std::atomic<int> tid;
+    std::atomic<int> arg;
+};
+
+static TraceEvent traceEvents[AGA8_TRACE_CAPACITY];
+static std::atomic<uint64_t> traceHead(0);
+static std::atomic<int> traceThreads(0);
+static const std::chrono::steady_clock::time_point traceEpoch = std::chrono::steady_clock::now();
+
+static long long TraceNow()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - traceEpoch).count();
+}
+
+static int TraceThreadId()
+{
+    static thread_local int tid = ++traceThreads;
+    return tid;
+}
+
+TraceSpan::TraceSpan(const char *name, int arg) : name(name), arg(arg), start(TraceNow())
+{
+}
+
+TraceSpan::~TraceSpan()
+{
+    long long end = TraceNow();
+    uint64_t idx = traceHead.fetch_add(1, std::memory_order_relaxed);
+    TraceEvent &ev = traceEvents[idx & (AGA8_TRACE_CAPACITY - 1)];
+    ev.seq.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    ev.name.store(name, std::memory_order_relaxed);
+    ev.start.store(start, std::memory_order_relaxed);
+    ev.dur.store(end - start, std::memory_order_relaxed);
+    ev.tid.store(TraceThreadId(), std::memory_order_relaxed);
+    ev.arg.store(arg, std::memory_order_relaxed);
+    ev.seq.store(idx + 1, std::memory_order_release);
+}
+#endif
+
+/**
+ * @brief Discard all recorded spans
+ */
+void TraceReset()
+{
+#ifdef AGA8_TRACE
+    for (int i = 0; i < AGA8_TRACE_CAPACITY; ++i)
+    {
+        traceEvents[i].seq.store(0, std::memory_order_relaxed);
+    }
+    traceHead.store(0, std::memory_order_release);
+#endif
+}
+
+/**
+ * @brief Number of published spans currently held in the ring buffer, the spans TraceDump would write
+ *
+ * Slots claimed by a span that is still being written are not counted.
+ * @return 0 when the library is built without AGA8_TRACE
+ */
+int TraceEventCount()
+{
+#ifdef AGA8_TRACE
+    uint64_t head = traceHead.load(std::memory_order_acquire);
+    uint64_t first = head > AGA8_TRACE_CAPACITY ? head - AGA8_TRACE_CAPACITY : 0;
+    int count = 0;
+    for (uint64_t idx = first; idx < head; ++idx)
+    {
+        if (traceEvents[idx & (AGA8_TRACE_CAPACITY - 1)].seq.load(std::memory_order_acquire) == idx + 1) { ++count; }
+    }
+    return count;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Serialize the recorded spans as Chrome trace JSON ("X" complete events, timestamps in microseconds)
+ *
+ * @param[out] json Trace document, {"traceEvents":[]} when the library is built without AGA8_TRACE
+ * @see TraceDump_wrapper for the Emscripten wrapped version of this function
+ */
+void TraceDump(std::string &json)
+{
+    json = "{\"traceEvents\":[";
+#ifdef AGA8_TRACE
+    uint64_t head = traceHead.load(std::memory_order_acquire);
+    uint64_t first = head > AGA8_TRACE_CAPACITY ? head - AGA8_TRACE_CAPACITY : 0;
+    char buf[256];
+    bool comma = false;
+    for (uint64_t idx = first; idx < head; ++idx)
+    {
+        const TraceEvent &ev = traceEvents[idx & (AGA8_TRACE_CAPACITY - 1)];
+        if (ev.seq.load(std::memory_order_acquire) != idx + 1) { continue; }
+        const char *name = ev.name.load(std::memory_order_relaxed);
+        long long start = ev.start.load(std::memory_order_relaxed), dur = ev.dur.load(std::memory_order_relaxed);
+        int tid = ev.tid.load(std::memory_order_relaxed), arg = ev.arg.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (ev.seq.load(std::memory_order_relaxed) != idx + 1) { continue; } // overwritten while copying
+        int n;
+        if (arg >= 0){
+            n = snprintf(buf, sizeof(buf), "%s{\"name\":\"%s\",\"cat\":\"aga8\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d,\"args\":{\"it\":%d}}",
+                         comma ? "," : "", name, start / 1000.0, dur / 1000.0, tid, arg);
+        }
+        else{
+            n = snprintf(buf, sizeof(buf), "%s{\"name\":\"%s\",\"cat\":\"aga8\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}",
+                         comma ? "," : "", name, start / 1000.0, dur / 1000.0, tid);
+        }
+        if (n > 0) { json.append(buf, n < (int)sizeof(buf) ? n : (int)sizeof(buf) - 1); }
+        comma = true;
+    }
+#endif
+    json += "],\"displayTimeUnit\":\"ns\"}";
+}
@@ -0,0 +1,72 @@
+/**
+ * @file Trace.h
+ * @brief Optional Chrome trace / Perfetto span recording for the solver and kernel phases
+ *
+ * When the library is compiled with AGA8_TRACE defined (CMake option AGA8_TRACE=ON),
+ * AGA8_TRACE_SCOPE() records a span (name, start, duration, thread) in a fixed-size
+ * lock-free ring buffer. TraceDump() serializes the buffer as Chrome trace JSON that can
+ * be loaded in chrome://tracing or https://ui.perfetto.dev.
+ *
+ * Without AGA8_TRACE the macros expand to nothing, and TraceDump() returns an empty trace.
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef AGA8TRACE_H_
+#define AGA8TRACE_H_
+
+#include <string>
+
+// Number of spans kept in the ring buffer (must be a power of two)
+#ifndef AGA8_TRACE_CAPACITY
+#define AGA8_TRACE_CAPACITY 65536
+#endif
+
+void TraceReset();
+void TraceDump(std::string &json);
+int TraceEventCount();
+
+#ifdef AGA8_TRACE
+/**
+ * @brief RAII span: records [construction, destruction) into the trace ring buffer
+ */
+class TraceSpan
+{
+public:
+    TraceSpan(const char *name, int arg = -1);
+    ~TraceSpan();
+    TraceSpan(const TraceSpan &) = delete;
+    TraceSpan &operator=(const TraceSpan &) = delete;
+
+private:
+    const char *name;
+    int arg;
+    long long start;
+};
+
+#define AGA8_TRACE_CONCAT_(a, b) a##b
+#define AGA8_TRACE_CONCAT(a, b) AGA8_TRACE_CONCAT_(a, b)
+#define AGA8_TRACE_SCOPE(name) TraceSpan AGA8_TRACE_CONCAT(traceSpan_, __LINE__)(name)
+#define AGA8_TRACE_SCOPE_ARG(name, arg) TraceSpan AGA8_TRACE_CONCAT(traceSpan_, __LINE__)(name, arg)
+#else
+#define AGA8_TRACE_SCOPE(name) ((void)0)
+#define AGA8_TRACE_SCOPE_ARG(name, arg) ((void)0)
+#endif
+
+#endif
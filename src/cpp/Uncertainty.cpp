@@ -0,0 +1,330 @@
+/**
+ * @file Uncertainty.cpp
+ * @brief Monte Carlo propagation of the temperature, pressure and composition uncertainties
+ *
+ * The samples are evaluated with the scalar templates of PressureGERG/PropertiesGERG (DETAIL), which
+ * give dP/dD through Dual<1> for the Newton iterations of the sample density, and keep no cache: every
+ * sample has its own composition, which would only churn the per-thread caches of the double functions.
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "Uncertainty.h"
+#include "Detail.h"
+#include "GERG2008.h"
+#include "Scalar.h"
+#include "Trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+static const int MaxIterUncertainty = 20;
+static const double tolUncertainty = 1e-7;   // Tolerance on the Newton steps of ln(1/D), as in DensityGERG: the error left is of the order of its square
+static const long long ChunkUncertainty = 64; // Samples taken at once by a thread
+static const double piUncertainty = 3.14159265358979323846;
+
+// Philox4x32-10 counter-based generator (Salmon et al., SC'11): 4 random words from a counter and a key
+static void Philox4x32(uint32_t ctr[4], const uint64_t seed)
+{
+    uint32_t k0 = (uint32_t)seed, k1 = (uint32_t)(seed >> 32);
+    for (int round = 0; round < 10; ++round)
+    {
+        const uint64_t p0 = (uint64_t)0xD2511F53u * ctr[0], p1 = (uint64_t)0xCD9E8D57u * ctr[2];
+        const uint32_t c0 = (uint32_t)(p1 >> 32) ^ ctr[1] ^ k0, c2 = (uint32_t)(p0 >> 32) ^ ctr[3] ^ k1;
+        ctr[1] = (uint32_t)p1;
+        ctr[3] = (uint32_t)p0;
+        ctr[0] = c0;
+        ctr[2] = c2;
+        k0 += 0x9E3779B9u;
+        k1 += 0xBB67AE85u;
+    }
+}
+
+// Two uniform numbers in (0, 1) for input j of sample k
+static void UniformPair(const uint64_t seed, const long long k, const int j, double &r1, double &r2)
+{
+    uint32_t ctr[4] = {(uint32_t)k, (uint32_t)((uint64_t)k >> 32), (uint32_t)j, 0};
+    Philox4x32(ctr, seed);
+    r1 = ((((uint64_t)ctr[0] << 21) ^ (ctr[1] >> 11)) + 0.5) * 0x1.0p-53;
+    r2 = ((((uint64_t)ctr[2] << 21) ^ (ctr[3] >> 11)) + 0.5) * 0x1.0p-53;
+}
+
+// Deviate of input j of sample k with zero mean and unit variance
+static double Deviate(const uint64_t seed, const long long k, const int j, const int distribution)
+{
+    double r1, r2;
+    UniformPair(seed, k, j, r1, r2);
+    if (distribution == DistributionUniform) { return (2 * r1 - 1) * std::sqrt(3.0); }
+    if (distribution == DistributionTriangular) { return (r1 + r2 - 1) * std::sqrt(6.0); }
+    return std::sqrt(-2 * std::log(r1)) * std::cos(2 * piUncertainty * r2);
+}
+
+// Lower triangular L with L*L^T = C, allowing zero rows and columns (inputs without uncertainty)
+static bool CholeskyUncertainty(const std::vector<double> &C, std::vector<double> &L)
+{
+    const int n = NInputsUncertainty;
+    L.assign(n * n, 0);
+    for (int j = 0; j < n; ++j)
+    {
+        double s = C[j * n + j];
+        for (int m = 0; m < j; ++m) { s -= L[j * n + m] * L[j * n + m]; }
+        const double tol = 1e-12 * std::abs(C[j * n + j]);
+        if (s < -tol) { return false; }
+        if (s <= tol) { continue; }
+        L[j * n + j] = std::sqrt(s);
+        for (int i = j + 1; i < n; ++i)
+        {
+            double t = C[i * n + j];
+            for (int m = 0; m < j; ++m) { t -= L[i * n + m] * L[j * n + m]; }
+            L[i * n + j] = t / L[j * n + j];
+        }
+    }
+    return true;
+}
+
+// Density at (T, P) by Newton iterations on ln(1/D) from D, with dP/dD from a Dual<1> evaluation
+static bool DensityUncertainty(const int method, const double T, const double P, const std::vector<Dual<1>> &x, double &D)
+{
+    double vlog = -std::log(D);
+    for (int it = 0; it < MaxIterUncertainty; ++it)
+    {
+        Dual<1> P2, Z;
+        if (method == UncertaintyDetail) { PressureDetail(Dual<1>(T), Dual<1>::Variable(D, 0), x, P2, Z); }
+        else { PressureGERG(Dual<1>(T), Dual<1>::Variable(D, 0), x, P2, Z); }
+        if (!(P2.v > 0 && P2.d[0] > 0)) { return false; }
+        const double vdiff = (std::log(P2.v) - std::log(P)) * P2.v / (-D * P2.d[0]);
+        vlog -= vdiff;
+        D = std::exp(-vlog);
+        if (std::abs(vdiff) < tolUncertainty) { return true; }
+    }
+    return false;
+}
+
+// Outputs of a (T, D) state, for any scalar type of the templates
+template <typename V>
+static void OutputsUncertainty(const int method, const V &T, const V &D, const std::vector<V> &x, const V &Mm, V &P, V y[NOutputsUncertainty])
+{
+    V Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf;
+    if (method == UncertaintyDetail) { PropertiesDetail<V>(T, D, x, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, Cf); }
+    else { PropertiesGERG<V>(T, D, x, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf); }
+    y[UncertaintyD] = D;
+    y[UncertaintyZ] = Z;
+    y[UncertaintyRho] = D * Mm;
+    y[UncertaintyW] = W;
+    y[UncertaintyCf] = Cf;
+    y[UncertaintyH] = H;
+    y[UncertaintyS] = S;
+    y[UncertaintyCp] = Cp;
+    y[UncertaintyJT] = JT;
+}
+
+// Sensitivity coefficients at the nominal state: derivatives with respect to T, D and x from Dual<23>, brought to
+// constant P, then to a change of x[i] followed by the renormalization of the composition
+static void SensitivitiesUncertainty(const int method, const double T, const double D, const std::vector<double> &x, const double MMi[], UncertaintyResult &result)
+{
+    std::vector<Dual<23>> x23(x.size());
+    Dual<23> Mm = 0, P, y[NOutputsUncertainty];
+    for (int i = 1; i <= 21; ++i)
+    {
+        x23[i] = Dual<23>::Variable(x[i], i + 1);
+        Mm += x23[i] * MMi[i];
+    }
+    OutputsUncertainty(method, Dual<23>::Variable(T, 0), Dual<23>::Variable(D, 1), x23, Mm, P, y);
+    for (int o = 0; o < NOutputsUncertainty; ++o)
+    {
+        double *c = result.outputs[o].c, g[21 + 1], xg = 0;
+        const double dydD = y[o].d[1] / P.d[1];
+        c[0] = y[o].d[0] - dydD * P.d[0];
+        c[1] = dydD;
+        for (int i = 1; i <= 21; ++i)
+        {
+            g[i] = y[o].d[i + 1] - dydD * P.d[i + 1];
+            xg += x[i] * g[i];
+        }
+        for (int i = 1; i <= 21; ++i) { c[i + 1] = g[i] - xg; }
+    }
+}
+
+// Percentile at probability q of sorted values, interpolated between the order statistics
+static double PercentileUncertainty(const std::vector<double> &v, const double q)
+{
+    if (v.empty()) { return 0; }
+    const double r = std::min(std::max(q, 0.0), 1.0) * (v.size() - 1);
+    const std::size_t i = std::min((std::size_t)r, v.size() - 1), i2 = std::min(i + 1, v.size() - 1);
+    return v[i] + (r - i) * (v[i2] - v[i]);
+}
+
+/**
+ * @brief Monte Carlo propagation of the uncertainties of T, P and the composition to the properties
+ *
+ * Each sample draws the NInputsUncertainty inputs around their nominal values, from u and
+ * distribution or from the covariance; the deviate of input j of sample k comes from a Philox
+ * counter-based generator keyed by the seed, with the counter (k, j). The sampled composition is
+ * renormalized, its density solved at the sampled (T, P) by Newton iterations, and the outputs
+ * evaluated. The samples are shared by the threads in chunks and stored by
+ * sample number, then the statistics are calculated in sample order: the results only depend on the
+ * seed and the number of samples, not on the number of threads. The Newton iterations of the sample
+ * density start from the linear prediction of the nominal density and its sensitivity coefficients.
+ *
+ * The sensitivity coefficients are the analytic derivatives of each output at the nominal inputs
+ * (Dual<23> evaluation), at constant P for T and x[i], and including the renormalization for x[i]
+ * (a component absent from the nominal composition has zero coefficients). The memory is
+ * NOutputsUncertainty doubles per sample. SetupGERG (or SetupDetail) must have been called.
+ *
+ * @param study Nominal inputs, uncertainties and settings
+ * @param[out] result Nominal value, mean, standard deviation, percentiles and sensitivity coefficients of each output
+ * @param[out] ierr Error number (0 indicates no error). -1 is a warning: the density of result.failed
+ *                  samples did not converge, and the statistics, still filled, are those of the other samples
+ * @param[out] herr Error message if ierr is not equal to zero
+ */
+void MonteCarloUncertainty(const UncertaintyStudy &study, UncertaintyResult &result, int &ierr, const char *&herr)
+{
+    AGA8_TRACE_SCOPE("MonteCarloUncertainty");
+    const int method = study.method, n = NInputsUncertainty;
+    const bool correlated = !study.covariance.empty();
+
+    ierr = 0;
+    herr = "";
+    result.samples = 0;
+    result.failed = 0;
+    if (!(study.T > 0 && study.P > 0 && study.x.size() >= 21 + 1 && study.samples > 1)
+        || (correlated ? study.covariance.size() != (std::size_t)(n * n) : study.u.size() != (std::size_t)n)
+        || !(study.distribution.empty() || study.distribution.size() == (std::size_t)n))
+    {
+        ierr = 1; herr = "Invalid uncertainty study"; return;
+    }
+    std::vector<double> L;
+    if (correlated && !CholeskyUncertainty(study.covariance, L)) { ierr = 2; herr = "Covariance is not positive semidefinite"; return; }
+
+    // Nominal state
+    double x0[21 + 1], MMi[21 + 1], sum = 0;
+    for (int i = 1; i <= 21; ++i) { x0[i] = study.x[i]; sum += x0[i]; }
+    if (!(sum > 0)) { ierr = 1; herr = "Invalid uncertainty study"; return; }
+    std::vector<double> x(21 + 1, 0), e(21 + 1, 0);
+    for (int i = 1; i <= 21; ++i) { x[i] = x0[i] / sum; }
+    for (int i = 1; i <= 21; ++i)
+    {
+        e[i] = 1;
+        if (method == UncertaintyDetail) { MolarMassDetail(e, MMi[i]); }
+        else { MolarMassGERG(e, MMi[i]); }
+        e[i] = 0;
+    }
+    double D0 = 0;
+    if (method == UncertaintyDetail) { DensityDetail(study.T, study.P, x, D0, ierr, herr); }
+    else { DensityGERG(0, study.T, study.P, x, D0, ierr, herr); }
+    if (ierr != 0) { ierr = 3; herr = "Nominal density did not converge"; return; }
+    {
+        double P, y[NOutputsUncertainty], Mm = 0;
+        for (int i = 1; i <= 21; ++i) { Mm += x[i] * MMi[i]; }
+        OutputsUncertainty<double>(method, study.T, D0, x, Mm, P, y);
+        for (int o = 0; o < NOutputsUncertainty; ++o) { result.outputs[o].nominal = y[o]; }
+    }
+    SensitivitiesUncertainty(method, study.T, D0, x, MMi, result);
+
+    // Samples, stored as one column per output
+    const long long N = study.samples;
+    std::vector<double> values(NOutputsUncertainty * N);
+    std::vector<char> converged(N);
+    std::atomic<long long> next(0);
+    auto worker = [&]()
+    {
+        double in0[NInputsUncertainty], in[NInputsUncertainty], z[NInputsUncertainty], y[NOutputsUncertainty];
+        std::vector<double> xs(21 + 1, 0);
+        std::vector<Dual<1>> x1(21 + 1);
+        in0[0] = study.T;
+        in0[1] = study.P;
+        for (int i = 1; i <= 21; ++i) { in0[i + 1] = x[i]; }
+        for (long long k0; (k0 = next.fetch_add(ChunkUncertainty)) < N;)
+        {
+            for (long long k = k0; k < std::min(k0 + ChunkUncertainty, N); ++k)
+            {
+                for (int j = 0; j < n; ++j)
+                {
+                    z[j] = Deviate(study.seed, k, j, correlated || study.distribution.empty() ? DistributionNormal : study.distribution[j]);
+                }
+                for (int j = 0; j < n; ++j)
+                {
+                    in[j] = in0[j];
+                    if (correlated) { for (int m = 0; m <= j; ++m) { in[j] += L[j * n + m] * z[m]; } }
+                    else { in[j] += study.u[j] * z[j]; }
+                }
+                // Density of the sample from the nominal density and its sensitivity coefficients
+                double s = 0, Mm = 0, P, D = D0;
+                for (int j = 0; j < n; ++j) { D += result.outputs[UncertaintyD].c[j] * (in[j] - in0[j]); }
+                if (!(D > 0)) { D = D0; }
+                for (int i = 1; i <= 21; ++i)
+                {
+                    xs[i] = std::max(in[i + 1], 0.0);
+                    s += xs[i];
+                }
+                bool ok = s > 0 && in[0] > 0 && in[1] > 0;
+                if (ok)
+                {
+                    for (int i = 1; i <= 21; ++i)
+                    {
+                        xs[i] /= s;
+                        x1[i] = xs[i];
+                        Mm += xs[i] * MMi[i];
+                    }
+                    ok = DensityUncertainty(method, in[0], in[1], x1, D);
+                }
+                if (ok)
+                {
+                    OutputsUncertainty<double>(method, in[0], D, xs, Mm, P, y);
+                    for (int o = 0; o < NOutputsUncertainty; ++o) { values[o * N + k] = y[o]; }
+                }
+                converged[k] = ok;
+            }
+        }
+    };
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    worker();
+#else
+    const int threads = study.threads > 0 ? study.threads : std::max(1, (int)std::thread::hardware_concurrency());
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t) { pool.emplace_back(worker); }
+    worker();
+    for (std::thread &th : pool) { th.join(); }
+#endif
+
+    // Statistics in sample order
+    std::vector<double> v;
+    v.reserve(N);
+    for (int o = 0; o < NOutputsUncertainty; ++o)
+    {
+        UncertaintyOutput &out = result.outputs[o];
+        v.clear();
+        for (long long k = 0; k < N; ++k) { if (converged[k]) { v.push_back(values[o * N + k]); } }
+        double mean = 0, var = 0;
+        for (const double a : v) { mean += a; }
+        mean /= std::max<std::size_t>(v.size(), 1);
+        for (const double a : v) { var += (a - mean) * (a - mean); }
+        out.mean = mean;
+        out.u = v.size() > 1 ? std::sqrt(var / (v.size() - 1)) : 0;
+        std::sort(v.begin(), v.end());
+        out.percentiles.resize(study.levels.size());
+        for (std::size_t q = 0; q < study.levels.size(); ++q) { out.percentiles[q] = PercentileUncertainty(v, study.levels[q]); }
+    }
+    result.samples = (long long)v.size();
+    result.failed = N - result.samples;
+    if (result.samples < 2) { ierr = 4; herr = "No sample density converged"; }
+    else if (result.failed > 0) { ierr = -1; herr = "Some sample densities did not converge and were left out of the statistics"; }
+}
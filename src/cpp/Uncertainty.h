@@ -0,0 +1,100 @@
+/**
+ * @file Uncertainty.h
+ * @brief Monte Carlo propagation of the temperature, pressure and composition uncertainties (GUM Supplement 1)
+ *
+ * The inputs T, P and x[1..21] are sampled around their nominal values, either independently from
+ * their standard uncertainties and distributions or jointly from a covariance matrix. The sampled
+ * compositions are renormalized, the density of each sample is solved from the nominal density,
+ * and the properties are evaluated; the samples are spread over threads. The sample k only depends
+ * on the seed and on k (counter-based generator), and the statistics are summed in sample order, so
+ * the results are identical for any number of threads.
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef AGA8UNCERTAINTY_H_
+#define AGA8UNCERTAINTY_H_
+
+#include <cstdint>
+#include <vector>
+
+// Equation of state of a study
+const int UncertaintyGERG = 0, UncertaintyDetail = 1;
+
+// Inputs of a study, in the order of UncertaintyStudy::u and UncertaintyStudy::covariance: T (K), P (kPa), then x[1..21]
+const int NInputsUncertainty = 23;
+
+// Distribution of an input, scaled to its standard uncertainty u: normal, uniform of half-width u*sqrt(3),
+// triangular of half-width u*sqrt(6)
+const int DistributionNormal = 0, DistributionUniform = 1, DistributionTriangular = 2;
+
+// Outputs of a study: molar density (mol/l), compressibility factor, mass density (kg/m³), speed of sound (m/s),
+// critical flow factor Cf of PropertiesGERG/PropertiesDetail (the ideal gas formula, not the real-gas C* of
+// CriticalFlow.h), enthalpy (J/mol), entropy [J/(mol-K)], isobaric heat capacity [J/(mol-K)] and Joule-Thomson
+// coefficient (K/kPa)
+const int UncertaintyD = 0, UncertaintyZ = 1, UncertaintyRho = 2, UncertaintyW = 3, UncertaintyCf = 4, UncertaintyH = 5,
+          UncertaintyS = 6, UncertaintyCp = 7, UncertaintyJT = 8;
+const int NOutputsUncertainty = 9;
+
+/**
+ * @brief Nominal inputs, their uncertainties and the settings of a Monte Carlo study
+ *
+ * Give either u (and optionally distribution) or covariance. With a covariance, the inputs are
+ * sampled from the multivariate normal distribution; a component that must stay absent has a zero
+ * row. Sampled mole fractions below zero are set to zero before the composition is renormalized.
+ */
+struct UncertaintyStudy
+{
+    int method = UncertaintyGERG;        // UncertaintyGERG or UncertaintyDetail
+    double T = 0, P = 0;                 // Nominal temperature (K) and pressure (kPa)
+    std::vector<double> x;               // Nominal composition (mole fraction), x[1..21]
+    std::vector<double> u;               // Standard uncertainties of the NInputsUncertainty inputs
+    std::vector<int> distribution;       // Distribution of each input, all DistributionNormal if empty
+    std::vector<double> covariance;      // NInputsUncertainty x NInputsUncertainty covariance (row-major), replaces u if not empty
+    std::vector<double> levels = {0.025, 0.5, 0.975}; // Probabilities of the percentiles
+    long long samples = 100000;
+    uint64_t seed = 1;
+    int threads = 0;                     // Number of threads, 0 for one per core
+};
+
+/**
+ * @brief Distribution of one output of a Monte Carlo study
+ */
+struct UncertaintyOutput
+{
+    double nominal;                      // Value at the nominal inputs
+    double mean;                         // Mean of the samples
+    double u;                            // Standard deviation of the samples
+    std::vector<double> percentiles;     // Percentiles at UncertaintyStudy::levels
+    double c[NInputsUncertainty];        // Sensitivity coefficients at the nominal inputs, d(output)/d(input)
+};
+
+/**
+ * @brief Results of a Monte Carlo study
+ */
+struct UncertaintyResult
+{
+    UncertaintyOutput outputs[NOutputsUncertainty]; // Indexed by UncertaintyD ... UncertaintyJT
+    long long samples;                   // Samples in the statistics
+    long long failed;                    // Samples without a converged density, left out of the statistics (ierr -1)
+};
+
+void MonteCarloUncertainty(const UncertaintyStudy &study, UncertaintyResult &result, int &ierr, const char *&herr);
+
+#endif
@@ -49,9 +49,18 @@
  */
 #include <emscripten/bind.h>
 #include <emscripten/val.h>
+#include "Columnar.h"
+#include "CriticalFlow.h"
+#include "DensityGuess.h"
 #include "Detail.h"
+#include "Flash.h"
+#include "Float32.h"
 #include "GERG2008.h"
 #include "Gross.h"
+#include "SonicNozzle.h"
+#include "Surrogate.h"
+#include "Trace.h"
+#include "Uncertainty.h"
 
 using namespace emscripten;
 
@@ -303,15 +312,112 @@ struct GrossMethod2Result
     std::string herr; /**< Error message if ierr is not equal to zero */
 };
 
+/**
+ * @struct HandleResult
+ * @brief Structure to hold the handle of a table built by the module (surrogate table, density estimate grid)
+ *
+ * @var handle Table handle passed to the functions using the table (-1 on error)
+ * @var ierr Error flag (0 = success, non-zero = error)
+ * @var herr Error message string describing the error if ierr is non-zero
+ */
+struct HandleResult
+{
+    int handle;       /**< Table handle (-1 on error) */
+    int ierr;         /**< Error flag (0 = success, non-zero = error) */
+    std::string herr; /**< Error message string describing the error if ierr is non-zero */
+};
+
+/**
+ * @struct DensityGuessStatsResult
+ * @brief Structure to hold the counters of DensityGuessBatch
+ *
+ * @var calls Number of densities calculated
+ * @var hits Densities started from the grid estimate
+ * @var iterations Iterations of the density solver
+ * @var iterationsSaved Estimated iterations saved by the grid estimates
+ */
+struct DensityGuessStatsResult
+{
+    double calls;           /**< Number of densities calculated */
+    double hits;            /**< Densities started from the grid estimate */
+    double iterations;      /**< Iterations of the density solver */
+    double iterationsSaved; /**< Estimated iterations saved by the grid estimates */
+};
+
+/**
+ * @struct FlashResult
+ * @brief Structure to hold the results of a flash calculation
+ *
+ * @var T Temperature in K
+ * @var D Density in mol/L
+ * @var ierr Error flag (0 = success, non-zero = error)
+ * @var herr Error message string describing the error if ierr is non-zero
+ */
+struct FlashResult
+{
+    double T;         /**< T Temperature in K */
+    double D;         /**< D Density in mol/L */
+    int ierr;         /**< ierr Error flag (0 = success, non-zero = error) */
+    std::string herr; /**< herr Error message string describing the error if ierr is non-zero */
+};
+
+/**
+ * @struct CriticalFlowResult
+ * @brief Structure to hold the real-gas critical flow function and the throat state of a sonic nozzle
+ *
+ * @var Cstar Critical flow function C* (dimensionless)
+ * @var T Throat temperature in K
+ * @var P Throat pressure in kPa
+ * @var D Throat density in mol/L
+ * @var ierr Error flag (0 = success, non-zero = error)
+ * @var herr Error message string describing the error if ierr is non-zero
+ */
+struct CriticalFlowResult
+{
+    double Cstar;     /**< Cstar Critical flow function */
+    double T;         /**< T Throat temperature in K */
+    double P;         /**< P Throat pressure in kPa */
+    double D;         /**< D Throat density in mol/L */
+    int ierr;         /**< ierr Error flag (0 = success, non-zero = error) */
+    std::string herr; /**< herr Error message string describing the error if ierr is non-zero */
+};
+
+/**
+ * @struct SonicNozzleResult
+ * @brief Structure to hold a sonic nozzle sized for a mass flow rate
+ *
+ * @var d Throat diameter in mm
+ * @var P0 Inlet pressure in kPa
+ * @var Cd Discharge coefficient
+ * @var Re Throat Reynolds number
+ * @var Cstar Real-gas critical flow function
+ * @var Pt Throat pressure in kPa
+ * @var Poutmax Largest outlet pressure of a choked flow (the throat pressure Pt) in kPa
+ * @var ierr Error flag (0 = success, non-zero = error)
+ * @var herr Error message string describing the error if ierr is non-zero
+ */
+struct SonicNozzleResult
+{
+    double d;         /**< d Throat diameter in mm */
+    double P0;        /**< P0 Inlet pressure in kPa */
+    double Cd;        /**< Cd Discharge coefficient */
+    double Re;        /**< Re Throat Reynolds number */
+    double Cstar;     /**< Cstar Real-gas critical flow function */
+    double Pt;        /**< Pt Throat pressure in kPa */
+    double Poutmax;   /**< Poutmax Largest outlet pressure of a choked flow (the throat pressure Pt) in kPa */
+    int ierr;         /**< ierr Error flag (0 = success, non-zero = error) */
+    std::string herr; /**< herr Error message string describing the error if ierr is non-zero */
+};
+
 // Helper function to convert a JavaScript object to a C++ struct
 /**
  * @brief Converts a JavaScript gasMixture Object to a C++ struct
  * @param js_object JavaScript gasMixture object
+ * @return Fixed-size composition (no heap allocation)
  */
-std::vector<double> gasMixture_to_vector(gasMixture js_object)
+Composition gasMixture_to_composition(const gasMixture &js_object)
 {
-    std::vector<double> result(22);
-    result[0] = 0;
+    Composition result;
     result[1] = js_object.methane;
     result[2] = js_object.nitrogen;
     result[3] = js_object.carbon_dioxide;
@@ -336,14 +442,31 @@ std::vector<double> gasMixture_to_vector(gasMixture js_object)
     return result;
 }
 
+/**
+ * @brief Converts a JavaScript gasMixture Object to a composition vector (index 0 unused)
+ *
+ * For the functions that take the composition as a std::vector. The vector is a static buffer reused by every
+ * call, so that no heap allocation is made after the first one; it is overwritten by the next call.
+ * @param js_object JavaScript gasMixture object
+ * @return Composition vector of NcComposition + 1 elements
+ */
+const std::vector<double> &gasMixture_to_vector(const gasMixture &js_object)
+{
+    static std::vector<double> x(NcComposition + 1, 0);
+    const Composition c = gasMixture_to_composition(js_object);
+    for (int i = 1; i <= NcComposition; ++i) { x[i] = c[i]; }
+    return x;
+}
+
 // Helper function to convert a JavaScript xGr object to a C++ struct
 /**
  * @brief Converts a JavaScript xGrs Object to a C++ struct
  * @param js_object JavaScript xGrs object
+ * @return Compositions in positions 1 to 3 of a static buffer, valid until the next call
  */
-std::vector<double> xGrs_to_vector(xGrs js_object)
+std::vector<double> &xGrs_to_vector(const xGrs &js_object)
 {
-    std::vector<double> result(3);
+    static std::vector<double> result(4);
     result[0] = 0;
     result[1] = js_object.hydrocarbon;
     result[2] = js_object.nitrogen;
@@ -370,21 +493,21 @@ xGrs vector_to_xGrs(const std::vector<double> &vec)
  * @brief Converts a JavaScript array to a C++ vector of doubles
  *
  * @param js_array JavaScript array object passed as an emscripten::val
- * @return std::vector<double> C++ vector containing the converted values
+ * @param[out] result C++ vector receiving the converted values, resized to the array length
  *
  * @details This function takes a JavaScript array passed through emscripten's val
  * interface and converts it to a C++ std::vector<double>. Each element in the
- * JavaScript array is converted to a double value.
+ * JavaScript array is converted to a double value. The vector is reused, so a
+ * static vector does not allocate once it has grown to the largest array.
  */
-std::vector<double> array_to_vector(const val &js_array)
+void array_to_vector(const val &js_array, std::vector<double> &result)
 {
     auto length = js_array["length"].as<unsigned>();
-    std::vector<double> result(length);
+    result.resize(length);
     for (unsigned i = 0; i < length; ++i)
     {
         result[i] = js_array[i].as<double>();
     }
-    return result;
 }
 
 // Helper function to convert a C++ vector to a JavaScript array
@@ -408,6 +531,39 @@ val vector_to_array(const std::vector<double> &vec)
     return result;
 }
 
+// Helper function to convert a JavaScript array or typed array to a C++ vector
+/**
+ * @brief Copies a JavaScript array or typed array (Float64Array, ...) into a C++ vector
+ *
+ * @param js_array JavaScript array or typed array passed as an emscripten::val
+ * @param[out] result C++ vector receiving the values, resized to the array length
+ *
+ * The values are copied in one block by TypedArray.set on a view of the vector memory, converted
+ * to the element type of the vector (double or float). The vector is reused, so a static vector
+ * does not allocate once it has grown to the largest array.
+ */
+template <typename T>
+void typed_array_to_vector(const val &js_array, std::vector<T> &result)
+{
+    auto length = js_array["length"].as<unsigned>();
+    result.resize(length);
+    val(typed_memory_view(length, result.data())).call<void>("set", js_array);
+}
+
+// Helper function to convert a C++ vector to a JavaScript typed array
+/**
+ * @brief Copies a C++ vector into a new JavaScript typed array
+ *
+ * @param type Name of the typed array constructor ("Float64Array", "Int32Array", ...)
+ * @param vec The input vector, its element type must match the typed array
+ * @return val A new typed array owning a copy of the values
+ */
+template <typename T>
+val vector_to_typed_array(const char *type, const std::vector<T> &vec)
+{
+    return val::global(type).new_(typed_memory_view(vec.size(), vec.data()));
+}
+
 // Detail wrappers
 /**
  * @brief Calculates the molar mass of a gas mixture given mole percentages
@@ -422,7 +578,7 @@ val vector_to_array(const std::vector<double> &vec)
  */
 double MolarMassDetail_wrapper(gasMixture x_array)
 {
-    std::vector<double> x = gasMixture_to_vector(x_array);
+    const Composition x = gasMixture_to_composition(x_array);
     double Mm = 0;
     MolarMassDetail(x, Mm);
     return Mm;
@@ -444,7 +600,7 @@ double MolarMassDetail_wrapper(gasMixture x_array)
  */
 PressureResult PressureDetail_wrapper(double T, double D, gasMixture x_array)
 {
-    std::vector<double> x = gasMixture_to_vector(x_array);
+    const Composition x = gasMixture_to_composition(x_array);
     double P = 0, Z = 0;
     PressureDetail(T, D, x, P, Z);
     PressureResult result = {P, Z};
@@ -467,10 +623,10 @@ PressureResult PressureDetail_wrapper(double T, double D, gasMixture x_array)
  */
 DensityResult DensityDetail_wrapper(double T, double P, gasMixture x_array)
 {
-    std::vector<double> x = gasMixture_to_vector(x_array);
+    const Composition x = gasMixture_to_composition(x_array);
     double D = 0;
     int ierr = 0;
-    std::string herr;
+    const char *herr = "";
 
     DensityDetail(T, P, x, D, ierr, herr);
 
@@ -506,7 +662,7 @@ DensityResult DensityDetail_wrapper(double T, double P, gasMixture x_array)
  */
 PropertiesDetailResult PropertiesDetail_wrapper(double T, double D, gasMixture x_array)
 {
-    std::vector<double> x = gasMixture_to_vector(x_array);
+    const Composition x = gasMixture_to_composition(x_array);
     double P = 0, Z = 0, dPdD = 0, d2PdD2 = 0, d2PdTD = 0, dPdT = 0;
     double U = 0, H = 0, S = 0, Cv = 0, Cp = 0, W = 0, G = 0, JT = 0, Kappa = 0, Cf = 0;
 
@@ -518,6 +674,36 @@ PropertiesDetailResult PropertiesDetail_wrapper(double T, double D, gasMixture x
     return result;
 }
 
+/**
+ * @brief Calculates the pressure along an isotherm for a list of densities
+ *
+ * The residual terms are prepared once for the temperature and composition, then each density
+ * only costs one short fused sum.
+ *
+ * @param T Temperature in Kelvin
+ * @param x_array Gas mixture composition in mole fraction
+ * @param D_array JavaScript array of densities in mol/l
+ * @return val JavaScript array of pressures in kPa
+ *
+ * @see PrepareIsothermDetail, PressureIsothermDetail For the underlying calculation implementation
+ */
+val IsothermDetail_wrapper(double T, gasMixture x_array, val D_array)
+{
+    const Composition x = gasMixture_to_composition(x_array);
+    static std::vector<double> D, P;
+    array_to_vector(D_array, D);
+    P.resize(D.size());
+    double Z = 0, dPdD = 0;
+    static PreparedIsothermDetail iso;
+
+    PrepareIsothermDetail(T, x, iso);
+    for (size_t i = 0; i < D.size(); ++i)
+    {
+        PressureIsothermDetail(iso, D[i], P[i], Z, dPdD);
+    }
+    return vector_to_array(P);
+}
+
 // GERG wrappers
 /**
  * @brief Calculates the molar mass of a gas mixture using GERG-2008 equation of state
@@ -532,7 +718,7 @@ PropertiesDetailResult PropertiesDetail_wrapper(double T, double D, gasMixture x
  */
 double MolarMassGERG_wrapper(gasMixture x_array)
 {
-    std::vector<double> x = gasMixture_to_vector(x_array);
+    const Composition x = gasMixture_to_composition(x_array);
     double Mm = 0;
     MolarMassGERG(x, Mm);
     return Mm;
@@ -555,7 +741,7 @@ double MolarMassGERG_wrapper(gasMixture x_array)
  */
 PressureResult PressureGERG_wrapper(double T, double D, gasMixture x_array)
 {
-    std::vector<double> x = gasMixture_to_vector(x_array);
+    const Composition x = gasMixture_to_composition(x_array);
     double P = 0, Z = 0;
     PressureGERG(T, D, x, P, Z);
 
@@ -579,10 +765,10 @@ PressureResult PressureGERG_wrapper(double T, double D, gasMixture x_array)
  */
 DensityResult DensityGERG_wrapper(int iflag, double T, double P, gasMixture x_array)
 {
-    std::vector<double> x = gasMixture_to_vector(x_array);
+    const Composition x = gasMixture_to_composition(x_array);
     double D = 0;
     int ierr = 0;
-    std::string herr;
+    const char *herr = "";
 
     DensityGERG(iflag, T, P, x, D, ierr, herr);
 
@@ -620,7 +806,7 @@ DensityResult DensityGERG_wrapper(int iflag, double T, double P, gasMixture x_ar
  */
 PropertiesGERGResult PropertiesGERG_wrapper(double T, double D, gasMixture x_array)
 {
-    std::vector<double> x = gasMixture_to_vector(x_array);
+    const Composition x = gasMixture_to_composition(x_array);
     double P = 0, Z = 0, dPdD = 0, d2PdD2 = 0, d2PdTD = 0, dPdT = 0;
     double U = 0, H = 0, S = 0, Cv = 0, Cp = 0, W = 0, G = 0, JT = 0, Kappa = 0, A = 0, Cf = 0;
 
@@ -631,6 +817,36 @@ PropertiesGERGResult PropertiesGERG_wrapper(double T, double D, gasMixture x_arr
     return result;
 }
 
+/**
+ * @brief Calculates the pressure along an isotherm for a list of densities
+ *
+ * The residual terms are prepared once for the temperature and composition, then each density
+ * only costs one short fused sum.
+ *
+ * @param T Temperature in Kelvin
+ * @param x_array Gas mixture composition in mole fraction
+ * @param D_array JavaScript array of densities in mol/l
+ * @return val JavaScript array of pressures in kPa
+ *
+ * @see PrepareIsothermGERG, PressureIsothermGERG For the underlying calculation implementation
+ */
+val IsothermGERG_wrapper(double T, gasMixture x_array, val D_array)
+{
+    const Composition x = gasMixture_to_composition(x_array);
+    static std::vector<double> D, P;
+    array_to_vector(D_array, D);
+    P.resize(D.size());
+    double Z = 0, dPdD = 0;
+    static PreparedIsothermGERG iso;
+
+    PrepareIsothermGERG(T, x, iso);
+    for (size_t i = 0; i < D.size(); ++i)
+    {
+        PressureIsothermGERG(iso, D[i], P[i], Z, dPdD);
+    }
+    return vector_to_array(P);
+}
+
 // Gross wrappers
 /**
  * @brief Calculates the gross molar mass of a gas mixture
@@ -645,7 +861,7 @@ PropertiesGERGResult PropertiesGERG_wrapper(double T, double D, gasMixture x_arr
  */
 double MolarMassGross_wrapper(gasMixture x_array)
 {
-    std::vector<double> x = gasMixture_to_vector(x_array);
+    const Composition x = gasMixture_to_composition(x_array);
     double Mm = 0;
     MolarMassGross(x, Mm);
     return Mm;
@@ -672,10 +888,10 @@ double MolarMassGross_wrapper(gasMixture x_array)
  */
 PressureGrossResult PressureGross_wrapper(double T, double D, xGrs xGrs_object, double HCH)
 {
-    std::vector<double> xGrs = xGrs_to_vector(xGrs_object);
+    std::vector<double> &xGrs = xGrs_to_vector(xGrs_object);
     double P = 0, Z = 0;
     int ierr = 0;
-    std::string herr;
+    const char *herr = "";
 
     PressureGross(T, D, xGrs, HCH, P, Z, ierr, herr);
 
@@ -702,10 +918,10 @@ PressureGrossResult PressureGross_wrapper(double T, double D, xGrs xGrs_object,
  */
 DensityResult DensityGross_wrapper(double T, double P, xGrs xGrs_object, double HCH)
 {
-    std::vector<double> xGrs = xGrs_to_vector(xGrs_object);
+    std::vector<double> &xGrs = xGrs_to_vector(xGrs_object);
     double D = 0;
     int ierr = 0;
-    std::string herr;
+    const char *herr = "";
 
     DensityGross(T, P, xGrs, HCH, D, ierr, herr);
 
@@ -713,6 +929,75 @@ DensityResult DensityGross_wrapper(double T, double P, xGrs xGrs_object, double
     return result;
 }
 
+/**
+ * @brief Wrapper function for DensityGrossIterative calculation
+ *
+ * Same inputs and outputs as DensityGross_wrapper, but the density is obtained with the original
+ * iterative Newton solver instead of the closed-form cubic roots.
+ *
+ * @param T Temperature [K]
+ * @param P Pressure [kPa]
+ * @param xGrs_object Array containing mole fractions of the mixture components
+ * @param HCH Heating value [MJ/m³]
+ * @return DensityResult struct containing:
+ *         - D: Density [kg/m³]
+ *         - ierr: Error code (0 = successful)
+ *         - herr: Error message string
+ *
+ * @see DensityGrossIterative For the underlying calculation implementation
+ */
+DensityResult DensityGrossIterative_wrapper(double T, double P, xGrs xGrs_object, double HCH)
+{
+    std::vector<double> &xGrs = xGrs_to_vector(xGrs_object);
+    double D = 0;
+    int ierr = 0;
+    const char *herr = "";
+
+    DensityGrossIterative(T, P, xGrs, HCH, D, ierr, herr);
+
+    DensityResult result = {D, ierr, herr};
+    return result;
+}
+
+/**
+ * @brief Wrapper function for DensityGrossBatch calculation
+ *
+ * Calculates the density and compressibility factor of many GROSS states at once, for instance
+ * all the meters of a network. The rows are grouped by temperature internally.
+ *
+ * @param T_array Temperatures [K] (Array or Float64Array)
+ * @param P_array Pressures [kPa]
+ * @param xCH_array Mole fractions of the equivalent hydrocarbon
+ * @param xN2_array Mole fractions of nitrogen
+ * @param xCO2_array Mole fractions of CO2
+ * @param HCH_array Molar ideal gross heating values of the equivalent hydrocarbon [kJ/mol]
+ * @return val JavaScript object containing:
+ *         - D: Float64Array of densities [mol/l]
+ *         - Z: Float64Array of compressibility factors
+ *         - ierr: Int32Array of error codes (0 = successful)
+ *
+ * @see DensityGrossBatch For the underlying calculation implementation
+ */
+val DensityGrossBatch_wrapper(val T_array, val P_array, val xCH_array, val xN2_array, val xCO2_array, val HCH_array)
+{
+    static std::vector<double> T, P, xCH, xN2, xCO2, HCH, D, Z;
+    static std::vector<int> ierr;
+
+    typed_array_to_vector(T_array, T);
+    typed_array_to_vector(P_array, P);
+    typed_array_to_vector(xCH_array, xCH);
+    typed_array_to_vector(xN2_array, xN2);
+    typed_array_to_vector(xCO2_array, xCO2);
+    typed_array_to_vector(HCH_array, HCH);
+    DensityGrossBatch(T, P, xCH, xN2, xCO2, HCH, D, Z, ierr);
+
+    val result = val::object();
+    result.set("D", vector_to_typed_array("Float64Array", D));
+    result.set("Z", vector_to_typed_array("Float64Array", Z));
+    result.set("ierr", vector_to_typed_array("Int32Array", ierr));
+    return result;
+}
+
 /**
  * @brief Wrapper function to calculate gross heating values for a gas mixture
  *
@@ -730,8 +1015,8 @@ DensityResult DensityGross_wrapper(double T, double P, xGrs xGrs_object, double
  */
 GrossHvResult GrossHv_wrapper(gasMixture x_array)
 {
-    std::vector<double> x = gasMixture_to_vector(x_array);
-    std::vector<double> xGrs(x.size());
+    const Composition x = gasMixture_to_composition(x_array);
+    static std::vector<double> xGrs(4);
     double HN = 0, HCH = 0;
 
     GrossHv(x, xGrs, HN, HCH);
@@ -758,11 +1043,11 @@ GrossHvResult GrossHv_wrapper(gasMixture x_array)
  */
 GrossInputsResult GrossInputs_wrapper(double T, double P, gasMixture x_array)
 {
-    std::vector<double> x = gasMixture_to_vector(x_array);
-    std::vector<double> xGrs(x.size());
+    const Composition x = gasMixture_to_composition(x_array);
+    static std::vector<double> xGrs(4);
     double Gr = 0, HN = 0, HCH = 0;
     int ierr = 0;
-    std::string herr;
+    const char *herr = "";
 
     GrossInputs(T, P, x, xGrs, Gr, HN, HCH, ierr, herr);
 
@@ -789,10 +1074,10 @@ GrossInputsResult GrossInputs_wrapper(double T, double P, gasMixture x_array)
  */
 BmixResult Bmix_wrapper(double T, xGrs xGrs_object, double HCH)
 {
-    std::vector<double> xGrs = xGrs_to_vector(xGrs_object);
+    std::vector<double> &xGrs = xGrs_to_vector(xGrs_object);
     double B = 0, C = 0;
     int ierr = 0;
-    std::string herr;
+    const char *herr = "";
 
     Bmix(T, xGrs, HCH, B, C, ierr, herr);
 
@@ -822,10 +1107,10 @@ BmixResult Bmix_wrapper(double T, xGrs xGrs_object, double HCH)
  */
 GrossMethod1Result GrossMethod1_wrapper(double Th, double Td, double Pd, xGrs xGrs_object, double Gr, double Hv)
 {
-    std::vector<double> xGrs = xGrs_to_vector(xGrs_object);
+    std::vector<double> &xGrs = xGrs_to_vector(xGrs_object);
     double Mm = 0, HCH = 0, HN = 0;
     int ierr = 0;
-    std::string herr;
+    const char *herr = "";
 
     GrossMethod1(Th, Td, Pd, xGrs, Gr, Hv, Mm, HCH, HN, ierr, herr);
 
@@ -855,10 +1140,10 @@ GrossMethod1Result GrossMethod1_wrapper(double Th, double Td, double Pd, xGrs xG
  */
 GrossMethod2Result GrossMethod2_wrapper(double Th, double Td, double Pd, xGrs xGrs_object, double Gr)
 {
-    std::vector<double> xGrs = xGrs_to_vector(xGrs_object);
+    std::vector<double> &xGrs = xGrs_to_vector(xGrs_object);
     double Hv = 0, Mm = 0, HCH = 0, HN = 0;
     int ierr = 0;
-    std::string herr;
+    const char *herr = "";
 
     GrossMethod2(Th, Td, Pd, xGrs, Gr, Hv, Mm, HCH, HN, ierr, herr);
 
@@ -867,97 +1152,1309 @@ GrossMethod2Result GrossMethod2_wrapper(double Th, double Td, double Pd, xGrs xG
 }
 
 /**
- * @brief Emscripten bindings for the AGA8 gas calculation module
+ * @brief Wrapper function for GrossMethod1Batch calculation
  *
- * These bindings expose the AGA8 gas calculation functionality to JavaScript/WebAssembly.
- * It includes:
+ * Runs the GROSS Method 1 setup for many meters at the same reference conditions.
  *
- * Enums:
- * - GasComponent: Enumeration of different gas components (methane, nitrogen, etc.)
+ * @param Th Reference temperature for heating value [K]
+ * @param Td Reference temperature for density [K]
+ * @param Pd Reference pressure for density [kPa]
+ * @param Gr_array Relative densities (Array or Float64Array)
+ * @param Hv_array Volumetric ideal gross heating values [MJ/m³]
+ * @param xCO2_array Mole fractions of CO2
+ * @return val JavaScript object of Float64Arrays xCH, xN2, Mm, HCH, HN and an Int32Array ierr
  *
- * Types:
- * - gasMixtureInMolePercent: Gas mixture composition in mole percent
- * - xGrsArray: Array for gross method calculations
- * - VectorDouble: Vector of double precision numbers
+ * @see GrossMethod1Batch For the underlying calculation implementation
+ */
+val GrossMethod1Batch_wrapper(double Th, double Td, double Pd, val Gr_array, val Hv_array, val xCO2_array)
+{
+    static std::vector<double> Gr, Hv, xCO2, xCH, xN2, Mm, HCH, HN;
+    static std::vector<int> ierr;
+
+    typed_array_to_vector(Gr_array, Gr);
+    typed_array_to_vector(Hv_array, Hv);
+    typed_array_to_vector(xCO2_array, xCO2);
+    GrossMethod1Batch(Th, Td, Pd, Gr, Hv, xCO2, xCH, xN2, Mm, HCH, HN, ierr);
+
+    val result = val::object();
+    result.set("xCH", vector_to_typed_array("Float64Array", xCH));
+    result.set("xN2", vector_to_typed_array("Float64Array", xN2));
+    result.set("Mm", vector_to_typed_array("Float64Array", Mm));
+    result.set("HCH", vector_to_typed_array("Float64Array", HCH));
+    result.set("HN", vector_to_typed_array("Float64Array", HN));
+    result.set("ierr", vector_to_typed_array("Int32Array", ierr));
+    return result;
+}
+
+/**
+ * @brief Wrapper function for GrossMethod2Batch calculation
  *
- * Value Objects:
- * - PressureResult: Pressure calculation results (P, Z)
- * - DensityResult: Density calculation results (D, error info)
- * - PropertiesDetailResult: Detailed gas properties results
- * - PropertiesGERGResult: GERG-2008 properties calculation results
- * - PressureGrossResult: Gross method pressure calculation results
- * - GrossHvResult: Heating value calculation results
- * - GrossInputsResult: Gross method input processing results
- * - BmixResult: Binary mixture calculation results
- * - GrossMethod1Result: Results for gross characterization method 1
- * - GrossMethod2Result: Results for gross characterization method 2
+ * Runs the GROSS Method 2 setup for many meters at the same reference conditions.
  *
- * Functions:
- * Detail Methods:
- * - SetupDetail: Initialize detail calculation method
- * - MolarMassDetail: Calculate molar mass using detail method
- * - PressureDetail: Calculate pressure using detail method
- * - DensityDetail: Calculate density using detail method
- * - PropertiesDetail: Calculate detailed properties
+ * @param Th Reference temperature for heating value [K]
+ * @param Td Reference temperature for density [K]
+ * @param Pd Reference pressure for density [kPa]
+ * @param Gr_array Relative densities (Array or Float64Array)
+ * @param xN2_array Mole fractions of nitrogen
+ * @param xCO2_array Mole fractions of CO2
+ * @return val JavaScript object of Float64Arrays xCH, Hv, Mm, HCH, HN and an Int32Array ierr
  *
- * GERG Methods:
- * - SetupGERG: Initialize GERG-2008 calculation method
- * - MolarMassGERG: Calculate molar mass using GERG-2008
- * - PressureGERG: Calculate pressure using GERG-2008
- * - DensityGERG: Calculate density using GERG-2008
- * - PropertiesGERG: Calculate properties using GERG-2008
+ * @see GrossMethod2Batch For the underlying calculation implementation
+ */
+val GrossMethod2Batch_wrapper(double Th, double Td, double Pd, val Gr_array, val xN2_array, val xCO2_array)
+{
+    static std::vector<double> Gr, xN2, xCO2, xCH, Hv, Mm, HCH, HN;
+    static std::vector<int> ierr;
+
+    typed_array_to_vector(Gr_array, Gr);
+    typed_array_to_vector(xN2_array, xN2);
+    typed_array_to_vector(xCO2_array, xCO2);
+    GrossMethod2Batch(Th, Td, Pd, Gr, xN2, xCO2, xCH, Hv, Mm, HCH, HN, ierr);
+
+    val result = val::object();
+    result.set("xCH", vector_to_typed_array("Float64Array", xCH));
+    result.set("Hv", vector_to_typed_array("Float64Array", Hv));
+    result.set("Mm", vector_to_typed_array("Float64Array", Mm));
+    result.set("HCH", vector_to_typed_array("Float64Array", HCH));
+    result.set("HN", vector_to_typed_array("Float64Array", HN));
+    result.set("ierr", vector_to_typed_array("Int32Array", ierr));
+    return result;
+}
+
+/**
+ * @brief Tables built or loaded by this module, referenced from JavaScript by an integer handle
  *
- * Gross Methods:
- * - SetupGross: Initialize gross calculation method
- * - MolarMassGross: Calculate molar mass using gross method
- * - PressureGross: Calculate pressure using gross method
- * - DensityGross: Calculate density using gross method
- * - GrossHv: Calculate heating value
- * - GrossInputs: Process inputs for gross calculations
- * - Bmix: Calculate binary mixture properties
- * - GrossMethod1: Perform gross characterization method 1
- * - GrossMethod2: Perform gross characterization method 2
+ * A freed slot is reused by the next table.
  */
-EMSCRIPTEN_BINDINGS(AGA8_module)
+template <typename T>
+struct HandleRegistry
 {
-    register_vector<double>("VectorDouble");
+    std::vector<T> items;
+    std::vector<bool> used;
 
-    value_object<gasMixture>("GasMixture")
-        .field("methane", &gasMixture::methane)
-        .field("nitrogen", &gasMixture::nitrogen)
-        .field("carbon_dioxide", &gasMixture::carbon_dioxide)
-        .field("ethane", &gasMixture::ethane)
-        .field("propane", &gasMixture::propane)
-        .field("isobutane", &gasMixture::isobutane)
-        .field("n_butane", &gasMixture::n_butane)
-        .field("isopentane", &gasMixture::isopentane)
-        .field("n_pentane", &gasMixture::n_pentane)
-        .field("n_hexane", &gasMixture::n_hexane)
-        .field("n_heptane", &gasMixture::n_heptane)
-        .field("n_octane", &gasMixture::n_octane)
-        .field("n_nonane", &gasMixture::n_nonane)
-        .field("n_decane", &gasMixture::n_decane)
-        .field("hydrogen", &gasMixture::hydrogen)
-        .field("oxygen", &gasMixture::oxygen)
-        .field("carbon_monoxide", &gasMixture::carbon_monoxide)
-        .field("water", &gasMixture::water)
-        .field("hydrogen_sulfide", &gasMixture::hydrogen_sulfide)
-        .field("helium", &gasMixture::helium)
-        .field("argon", &gasMixture::argon);
+    HandleResult Store(T &item)
+    {
+        std::size_t handle = 0;
+        while (handle < used.size() && used[handle]) { ++handle; }
+        if (handle == used.size())
+        {
+            items.emplace_back();
+            used.push_back(false);
+        }
+        items[handle] = std::move(item);
+        used[handle] = true;
+        return {(int)handle, 0, ""};
+    }
 
-    value_object<xGrs>("xGrs")
-        .field("hydrocarbon", &xGrs::hydrocarbon)
-        .field("nitrogen", &xGrs::nitrogen)
-        .field("carbon_dioxide", &xGrs::carbon_dioxide);
+    bool Valid(int handle) const
+    {
+        return handle >= 0 && handle < (int)used.size() && used[handle];
+    }
 
-    value_object<PressureResult>("PressureResult")
-        .field("P", &PressureResult::P)
-        .field("Z", &PressureResult::Z);
+    void Free(int handle)
+    {
+        if (!Valid(handle)) { return; }
+        items[handle] = T();
+        used[handle] = false;
+    }
+};
 
-    value_object<DensityResult>("DensityResult")
-        .field("D", &DensityResult::D)
-        .field("ierr", &DensityResult::ierr)
-        .field("herr", &DensityResult::herr);
+// Surrogate wrappers
+static HandleRegistry<SurrogateTable> surrogateTables;
+
+/**
+ * @brief Wrapper function for BuildSurrogate
+ *
+ * Samples the GERG-2008 or DETAIL equation of state over the domain and builds a table of Z, H, S,
+ * W and Cf whose relative error does not exceed tol. SetupGERG (or SetupDetail) must have been called.
+ *
+ * @param method 0 for GERG-2008, 1 for DETAIL
+ * @param x_array Gas mixture composition in mole fraction
+ * @param Tmin Lowest temperature [K]
+ * @param Tmax Highest temperature [K]
+ * @param Pmin Lowest pressure [kPa]
+ * @param Pmax Highest pressure [kPa]
+ * @param tol Maximum relative error
+ * @return HandleResult Table handle, error flag and message
+ *
+ * @see BuildSurrogate For the underlying implementation
+ */
+HandleResult BuildSurrogate_wrapper(int method, gasMixture x_array, double Tmin, double Tmax, double Pmin, double Pmax, double tol)
+{
+    const std::vector<double> &x = gasMixture_to_vector(x_array);
+    SurrogateTable tab;
+    int ierr = 0;
+    const char *herr = "";
+
+    BuildSurrogate(method, x, Tmin, Tmax, Pmin, Pmax, tol, tab, ierr, herr);
+    if (ierr != 0) { return {-1, ierr, herr}; }
+    return surrogateTables.Store(tab);
+}
+
+/**
+ * @brief Wrapper function for LoadSurrogate
+ *
+ * @param bytes Uint8Array written by SaveSurrogate
+ * @return HandleResult Table handle, error flag and message
+ *
+ * @see LoadSurrogate For the underlying implementation
+ */
+HandleResult LoadSurrogate_wrapper(val bytes)
+{
+    std::vector<unsigned char> data(bytes["length"].as<unsigned>());
+    val(typed_memory_view(data.size(), data.data())).call<void>("set", bytes);
+    SurrogateTable tab;
+    int ierr = 0;
+    const char *herr = "";
+
+    LoadSurrogate(data.data(), data.size(), tab, ierr, herr);
+    if (ierr != 0) { return {-1, ierr, herr}; }
+    return surrogateTables.Store(tab);
+}
+
+/**
+ * @brief Wrapper function for SaveSurrogate
+ *
+ * @param handle Table handle
+ * @return val Uint8Array holding the table, empty for an invalid handle
+ *
+ * @see SaveSurrogate For the underlying implementation
+ */
+val SaveSurrogate_wrapper(int handle)
+{
+    std::vector<unsigned char> bytes;
+    if (surrogateTables.Valid(handle)) { SaveSurrogate(surrogateTables.items[handle], bytes); }
+    return vector_to_typed_array("Uint8Array", bytes);
+}
+
+/**
+ * @brief Releases a table built or loaded by this module
+ *
+ * @param handle Table handle, reused by the next table
+ */
+void FreeSurrogate_wrapper(int handle)
+{
+    surrogateTables.Free(handle);
+}
+
+/**
+ * @brief Wrapper function for EvaluateSurrogate
+ *
+ * Evaluates many (T, P) states at once. States outside the validated cells of the table are
+ * evaluated with the equation of state.
+ *
+ * @param handle Table handle
+ * @param T_array Temperatures [K] (Array or Float64Array)
+ * @param P_array Pressures [kPa]
+ * @return val JavaScript object containing:
+ *         - Z, H, S, W, Cf: Float64Array of compressibility factors, enthalpies [J/mol],
+ *           entropies [J/(mol·K)], speeds of sound [m/s] and critical flow factors
+ *         - exact: Int32Array, 1 where the equation of state was used
+ *         - ierr: Int32Array of error codes of the exact evaluations (0 = successful)
+ *         The arrays are empty for an invalid handle.
+ *
+ * @see EvaluateSurrogate For the underlying calculation implementation
+ */
+val EvaluateSurrogate_wrapper(int handle, val T_array, val P_array)
+{
+    static std::vector<double> T, P, Z, H, S, W, Cf;
+    static std::vector<int> exact, ierr;
+
+    typed_array_to_vector(T_array, T);
+    typed_array_to_vector(P_array, P);
+    const std::size_t n = surrogateTables.Valid(handle) ? std::min(T.size(), P.size()) : 0;
+    Z.resize(n);
+    H.resize(n);
+    S.resize(n);
+    W.resize(n);
+    Cf.resize(n);
+    exact.resize(n);
+    ierr.resize(n);
+    const char *herr;
+    for (std::size_t k = 0; k < n; ++k)
+    {
+        exact[k] = EvaluateSurrogate(surrogateTables.items[handle], T[k], P[k], Z[k], H[k], S[k], W[k], Cf[k], ierr[k], herr);
+    }
+
+    val result = val::object();
+    result.set("Z", vector_to_typed_array("Float64Array", Z));
+    result.set("H", vector_to_typed_array("Float64Array", H));
+    result.set("S", vector_to_typed_array("Float64Array", S));
+    result.set("W", vector_to_typed_array("Float64Array", W));
+    result.set("Cf", vector_to_typed_array("Float64Array", Cf));
+    result.set("exact", vector_to_typed_array("Int32Array", exact));
+    result.set("ierr", vector_to_typed_array("Int32Array", ierr));
+    return result;
+}
+
+// Density estimate wrappers
+static HandleRegistry<DensityGuessGrid> densityGuessGrids;
+
+/**
+ * @brief Wrapper function for BuildDensityGuess
+ *
+ * Solves the density at the nodes of a (T, ln P) grid, used as initial estimates by DensityGuessBatch.
+ * SetupGERG (or SetupDetail) must have been called.
+ *
+ * @param method 0 for GERG-2008, 1 for DETAIL
+ * @param iFlag iFlag of DensityGERG (ignored for DETAIL)
+ * @param x_array Gas mixture composition in mole fraction
+ * @param Tmin Lowest temperature [K]
+ * @param Tmax Highest temperature [K]
+ * @param Pmin Lowest pressure [kPa]
+ * @param Pmax Highest pressure [kPa]
+ * @param nT Number of cells in temperature
+ * @param nP Number of cells in ln(P)
+ * @return HandleResult Grid handle, error flag and message
+ *
+ * @see BuildDensityGuess For the underlying implementation
+ */
+HandleResult BuildDensityGuess_wrapper(int method, int iFlag, gasMixture x_array, double Tmin, double Tmax, double Pmin, double Pmax, int nT, int nP)
+{
+    const Composition x = gasMixture_to_composition(x_array);
+    DensityGuessGrid grid;
+    int ierr = 0;
+    const char *herr = "";
+
+    BuildDensityGuess(method, iFlag, x, Tmin, Tmax, Pmin, Pmax, nT, nP, grid, ierr, herr);
+    if (ierr != 0) { return {-1, ierr, herr}; }
+    return densityGuessGrids.Store(grid);
+}
+
+/**
+ * @brief Releases a density estimate grid
+ *
+ * @param handle Grid handle, reused by the next grid
+ */
+void FreeDensityGuess_wrapper(int handle)
+{
+    densityGuessGrids.Free(handle);
+}
+
+/**
+ * @brief Wrapper function for DensityGuess
+ *
+ * Calculates many densities of the grid composition, each solve starting from the grid estimate
+ * when possible. The densities are those of DensityGERG (or DensityDetail) within the solver tolerance.
+ *
+ * @param handle Grid handle
+ * @param T_array Temperatures [K] (Array or Float64Array)
+ * @param P_array Pressures [kPa]
+ * @return val JavaScript object containing:
+ *         - D: Float64Array of densities [mol/l]
+ *         - ierr: Int32Array of error codes (0 = successful)
+ *         The arrays are empty for an invalid handle.
+ *
+ * @see DensityGuess For the underlying calculation implementation
+ */
+val DensityGuessBatch_wrapper(int handle, val T_array, val P_array)
+{
+    static std::vector<double> T, P, D;
+    static std::vector<int> ierr;
+
+    typed_array_to_vector(T_array, T);
+    typed_array_to_vector(P_array, P);
+    const std::size_t n = densityGuessGrids.Valid(handle) ? std::min(T.size(), P.size()) : 0;
+    D.resize(n);
+    ierr.resize(n);
+    const char *herr;
+    for (std::size_t k = 0; k < n; ++k) { DensityGuess(densityGuessGrids.items[handle], T[k], P[k], D[k], ierr[k], herr); }
+
+    val result = val::object();
+    result.set("D", vector_to_typed_array("Float64Array", D));
+    result.set("ierr", vector_to_typed_array("Int32Array", ierr));
+    return result;
+}
+
+/**
+ * @brief Wrapper function for GetDensityGuessStats
+ *
+ * @return DensityGuessStatsResult Counters since the last ResetDensityGuessStats
+ * @see GetDensityGuessStats For the underlying implementation
+ */
+DensityGuessStatsResult GetDensityGuessStats_wrapper()
+{
+    DensityGuessStats stats;
+    GetDensityGuessStats(stats);
+    return {(double)stats.calls, (double)stats.hits, (double)stats.iterations, stats.iterationsSaved};
+}
+
+// Flash wrappers
+/**
+ * @brief Common part of FlashGERG_wrapper and FlashDetail_wrapper
+ */
+static FlashResult Flash_wrapper(bool detail, int pair, double v1, double v2, gasMixture x_array, double T0, double D0)
+{
+    const Composition x = gasMixture_to_composition(x_array);
+    double T = T0, D = T0 > 0 && D0 > 0 ? -D0 : 0;
+    int ierr = 0;
+    const char *herr = "";
+
+    if (detail) { FlashDetail(pair, v1, v2, x, T, D, ierr, herr); }
+    else { FlashGERG(pair, v1, v2, x, T, D, ierr, herr); }
+    return {T, D, ierr, herr};
+}
+
+/**
+ * @brief Wrapper function for FlashGERG
+ *
+ * Solves the temperature and density of a state given by two properties with the GERG-2008 equation.
+ * SetupGERG must have been called.
+ *
+ * @param pair Known properties: 0 PH, 1 PS, 2 PU, 3 TH, 4 TS, 5 DH, 6 DS, 7 UV (P [kPa], T [K],
+ *             D [mol/l], H [J/mol], S [J/(mol·K)], U [J/mol], V [l/mol])
+ * @param v1 First known property
+ * @param v2 Second known property
+ * @param x_array Gas mixture composition in mole fraction
+ * @param T0 Initial estimate of the temperature [K], 0 for none
+ * @param D0 Initial estimate of the density [mol/l], 0 for none
+ * @return FlashResult Temperature, density, error flag and message
+ *
+ * @see FlashGERG For the underlying calculation implementation
+ */
+FlashResult FlashGERG_wrapper(int pair, double v1, double v2, gasMixture x_array, double T0, double D0)
+{
+    return Flash_wrapper(false, pair, v1, v2, x_array, T0, D0);
+}
+
+/**
+ * @brief Wrapper function for FlashDetail
+ *
+ * Same as FlashGERG_wrapper with the DETAIL equation. SetupDetail must have been called.
+ *
+ * @see FlashGERG_wrapper For the parameters
+ * @see FlashDetail For the underlying calculation implementation
+ */
+FlashResult FlashDetail_wrapper(int pair, double v1, double v2, gasMixture x_array, double T0, double D0)
+{
+    return Flash_wrapper(true, pair, v1, v2, x_array, T0, D0);
+}
+
+/**
+ * @brief Common part of FlashBatchGERG_wrapper and FlashBatchDetail_wrapper
+ */
+static val FlashBatch_wrapper(bool detail, int pair, val v1_array, val v2_array, gasMixture x_array)
+{
+    static std::vector<double> v1, v2, T, D;
+    static std::vector<int> ierr;
+
+    const Composition x = gasMixture_to_composition(x_array);
+    typed_array_to_vector(v1_array, v1);
+    typed_array_to_vector(v2_array, v2);
+    if (detail) { FlashBatchDetail(pair, v1, v2, x, T, D, ierr); }
+    else { FlashBatchGERG(pair, v1, v2, x, T, D, ierr); }
+
+    val result = val::object();
+    result.set("T", vector_to_typed_array("Float64Array", T));
+    result.set("D", vector_to_typed_array("Float64Array", D));
+    result.set("ierr", vector_to_typed_array("Int32Array", ierr));
+    return result;
+}
+
+/**
+ * @brief Wrapper function for FlashBatchGERG
+ *
+ * Solves many states given by the same pair of properties, each one starting from the solution
+ * of the previous one, e.g. along an isentropic compression or a valve characteristic.
+ *
+ * @param pair Known properties, see FlashGERG_wrapper
+ * @param v1_array First known property of each state (Array or Float64Array)
+ * @param v2_array Second known property of each state
+ * @param x_array Gas mixture composition in mole fraction
+ * @return val JavaScript object containing:
+ *         - T: Float64Array of temperatures [K]
+ *         - D: Float64Array of densities [mol/l]
+ *         - ierr: Int32Array of error codes (0 = successful)
+ *
+ * @see FlashBatchGERG For the underlying calculation implementation
+ */
+val FlashBatchGERG_wrapper(int pair, val v1_array, val v2_array, gasMixture x_array)
+{
+    return FlashBatch_wrapper(false, pair, v1_array, v2_array, x_array);
+}
+
+/**
+ * @brief Wrapper function for FlashBatchDetail
+ *
+ * @see FlashBatchGERG_wrapper For the parameters and results
+ * @see FlashBatchDetail For the underlying calculation implementation
+ */
+val FlashBatchDetail_wrapper(int pair, val v1_array, val v2_array, gasMixture x_array)
+{
+    return FlashBatch_wrapper(true, pair, v1_array, v2_array, x_array);
+}
+
+// Critical flow wrappers
+/**
+ * @brief Common part of CriticalFlowFunctionGERG_wrapper and CriticalFlowFunctionDetail_wrapper
+ */
+static CriticalFlowResult CriticalFlowFunction_wrapper(bool detail, double T0, double P0, gasMixture x_array)
+{
+    const Composition x = gasMixture_to_composition(x_array);
+    double Cstar = 0, Tt = 0, Pt = 0, Dt = 0;
+    int ierr = 0;
+    const char *herr = "";
+
+    if (detail) { CriticalFlowFunctionDetail(T0, P0, x, Cstar, Tt, Pt, Dt, ierr, herr); }
+    else { CriticalFlowFunctionGERG(T0, P0, x, Cstar, Tt, Pt, Dt, ierr, herr); }
+    return {Cstar, Tt, Pt, Dt, ierr, herr};
+}
+
+/**
+ * @brief Wrapper function for CriticalFlowFunctionGERG
+ *
+ * Real-gas critical flow function of a sonic nozzle (ISO 9300), from the throat state on the
+ * isentrope of the stagnation state where the velocity equals the speed of sound.
+ * SetupGERG must have been called.
+ *
+ * @param T0 Stagnation temperature [K]
+ * @param P0 Stagnation pressure [kPa]
+ * @param x_array Gas mixture composition in mole fraction
+ * @return CriticalFlowResult C*, throat temperature, pressure and density, error flag and message
+ *
+ * @see CriticalFlowFunctionGERG For the underlying calculation implementation
+ */
+CriticalFlowResult CriticalFlowFunctionGERG_wrapper(double T0, double P0, gasMixture x_array)
+{
+    return CriticalFlowFunction_wrapper(false, T0, P0, x_array);
+}
+
+/**
+ * @brief Wrapper function for CriticalFlowFunctionDetail
+ *
+ * Same as CriticalFlowFunctionGERG_wrapper with the DETAIL equation. SetupDetail must have been called.
+ *
+ * @see CriticalFlowFunctionGERG_wrapper For the parameters
+ * @see CriticalFlowFunctionDetail For the underlying calculation implementation
+ */
+CriticalFlowResult CriticalFlowFunctionDetail_wrapper(double T0, double P0, gasMixture x_array)
+{
+    return CriticalFlowFunction_wrapper(true, T0, P0, x_array);
+}
+
+/**
+ * @brief Common part of CriticalFlowBatchGERG_wrapper and CriticalFlowBatchDetail_wrapper
+ */
+static val CriticalFlowBatch_wrapper(bool detail, val T0_array, val P0_array, gasMixture x_array)
+{
+    static std::vector<double> T0, P0, Cstar, Tt, Pt, Dt;
+    static std::vector<int> ierr;
+
+    const Composition x = gasMixture_to_composition(x_array);
+    typed_array_to_vector(T0_array, T0);
+    typed_array_to_vector(P0_array, P0);
+    if (detail) { CriticalFlowBatchDetail(T0, P0, x, Cstar, Tt, Pt, Dt, ierr); }
+    else { CriticalFlowBatchGERG(T0, P0, x, Cstar, Tt, Pt, Dt, ierr); }
+
+    val result = val::object();
+    result.set("Cstar", vector_to_typed_array("Float64Array", Cstar));
+    result.set("T", vector_to_typed_array("Float64Array", Tt));
+    result.set("P", vector_to_typed_array("Float64Array", Pt));
+    result.set("D", vector_to_typed_array("Float64Array", Dt));
+    result.set("ierr", vector_to_typed_array("Int32Array", ierr));
+    return result;
+}
+
+/**
+ * @brief Wrapper function for CriticalFlowBatchGERG
+ *
+ * Critical flow functions of many stagnation states, e.g. the inlet pressures of a nozzle curve.
+ * Each throat solve starts from the previous one.
+ *
+ * @param T0_array Stagnation temperatures [K] (Array or Float64Array)
+ * @param P0_array Stagnation pressures [kPa]
+ * @param x_array Gas mixture composition in mole fraction
+ * @return val JavaScript object containing:
+ *         - Cstar: Float64Array of critical flow functions
+ *         - T, P, D: Float64Array of throat temperatures [K], pressures [kPa] and densities [mol/l]
+ *         - ierr: Int32Array of error codes (0 = successful)
+ *
+ * @see CriticalFlowBatchGERG For the underlying calculation implementation
+ */
+val CriticalFlowBatchGERG_wrapper(val T0_array, val P0_array, gasMixture x_array)
+{
+    return CriticalFlowBatch_wrapper(false, T0_array, P0_array, x_array);
+}
+
+/**
+ * @brief Wrapper function for CriticalFlowBatchDetail
+ *
+ * @see CriticalFlowBatchGERG_wrapper For the parameters and results
+ * @see CriticalFlowBatchDetail For the underlying calculation implementation
+ */
+val CriticalFlowBatchDetail_wrapper(val T0_array, val P0_array, gasMixture x_array)
+{
+    return CriticalFlowBatch_wrapper(true, T0_array, P0_array, x_array);
+}
+
+// Sonic nozzle wrappers
+/**
+ * @brief Wrapper function for SonicNozzleDiameter
+ *
+ * Throat diameter of a toroidal-throat sonic nozzle (ISO 9300) passing a mass flow rate, with the
+ * Reynolds-dependent discharge coefficient and the real-gas critical flow function.
+ * SetupGERG (or SetupDetail) must have been called.
+ *
+ * @param method 0 for GERG-2008, 1 for DETAIL
+ * @param x_array Gas mixture composition in mole fraction
+ * @param qm Mass flow rate [kg/s]
+ * @param T0 Inlet temperature [K]
+ * @param P0 Inlet pressure [kPa]
+ * @param Pout Outlet pressure [kPa]
+ * @param mu Dynamic viscosity of the gas at the inlet [Pa·s]
+ * @return SonicNozzleResult Diameter, discharge coefficient, Reynolds number, C*, throat pressure, error flag and message
+ *
+ * @see SonicNozzleDiameter For the underlying calculation implementation
+ */
+SonicNozzleResult SonicNozzleDiameter_wrapper(int method, gasMixture x_array, double qm, double T0, double P0, double Pout, double mu)
+{
+    const Composition x = gasMixture_to_composition(x_array);
+    SonicNozzle nozzle;
+    int ierr = 0;
+    const char *herr = "";
+
+    SonicNozzleDiameter(method, x, qm, T0, P0, Pout, mu, nozzle, ierr, herr);
+    return {nozzle.d, nozzle.P0, nozzle.Cd, nozzle.Re, nozzle.Cstar, nozzle.Pt, nozzle.Poutmax, ierr, herr};
+}
+
+/**
+ * @brief Wrapper function for SonicNozzlePressure
+ *
+ * Inlet pressure of a toroidal-throat sonic nozzle of known diameter passing a mass flow rate.
+ * SetupGERG (or SetupDetail) must have been called.
+ *
+ * @param method 0 for GERG-2008, 1 for DETAIL
+ * @param x_array Gas mixture composition in mole fraction
+ * @param qm Mass flow rate [kg/s]
+ * @param T0 Inlet temperature [K]
+ * @param d Throat diameter [mm]
+ * @param Pout Outlet pressure [kPa]
+ * @param mu Dynamic viscosity of the gas at the inlet [Pa·s]
+ * @return SonicNozzleResult Inlet pressure, discharge coefficient, Reynolds number, C*, throat pressure, error flag and message
+ *
+ * @see SonicNozzlePressure For the underlying calculation implementation
+ */
+SonicNozzleResult SonicNozzlePressure_wrapper(int method, gasMixture x_array, double qm, double T0, double d, double Pout, double mu)
+{
+    const Composition x = gasMixture_to_composition(x_array);
+    SonicNozzle nozzle;
+    int ierr = 0;
+    const char *herr = "";
+
+    SonicNozzlePressure(method, x, qm, T0, d, Pout, mu, nozzle, ierr, herr);
+    return {nozzle.d, nozzle.P0, nozzle.Cd, nozzle.Re, nozzle.Cstar, nozzle.Pt, nozzle.Poutmax, ierr, herr};
+}
+
+// Composition derivative wrappers
+/**
+ * @brief Copies the derivatives of the 21 components into a new Float64Array
+ */
+static val components_to_typed_array(const Composition &c)
+{
+    return val::global("Float64Array").new_(typed_memory_view(NcComposition, c.values.data()));
+}
+
+/**
+ * @brief Common part of CompositionDerivativesGERG_wrapper and CompositionDerivativesDetail_wrapper
+ */
+static val CompositionDerivatives_wrapper(bool detail, double T, double P, gasMixture x_array)
+{
+    Composition dZdx, dDdx, dWdx;
+
+    const Composition x = gasMixture_to_composition(x_array);
+    double D = 0, P2 = 0, Z = 0, W = 0;
+    int ierr = 0;
+    const char *herr = "";
+
+    if (detail) { DensityDetail(T, P, x, D, ierr, herr); }
+    else { DensityGERG(0, T, P, x, D, ierr, herr); }
+    if (ierr == 0 && detail) { CompositionDerivativesDetail(T, D, x, P2, Z, W, dZdx, dDdx, dWdx); }
+    else if (ierr == 0) { CompositionDerivativesGERG(T, D, x, P2, Z, W, dZdx, dDdx, dWdx); }
+
+    val result = val::object();
+    result.set("D", D);
+    result.set("Z", Z);
+    result.set("W", W);
+    result.set("dZdx", components_to_typed_array(dZdx));
+    result.set("dDdx", components_to_typed_array(dDdx));
+    result.set("dWdx", components_to_typed_array(dWdx));
+    result.set("ierr", ierr);
+    result.set("herr", std::string(herr));
+    return result;
+}
+
+/**
+ * @brief Wrapper function for CompositionDerivativesGERG
+ *
+ * Density, compressibility factor and speed of sound at (T, P) with their analytic derivatives with
+ * respect to each mole fraction at constant T and P, e.g. for the composition part of an uncertainty
+ * budget. Each fraction is varied alone (no normalization); absent components have derivatives too.
+ * SetupGERG must have been called.
+ *
+ * @param T Temperature [K]
+ * @param P Pressure [kPa]
+ * @param x_array Gas mixture composition in mole fraction
+ * @return val JavaScript object containing:
+ *         - D, Z, W: density [mol/l], compressibility factor and speed of sound [m/s]
+ *         - dZdx, dDdx, dWdx: Float64Array of the 21 derivatives, in the order of GasMixture (methane first)
+ *         - ierr, herr: error flag (0 = successful) and message of the density solve
+ *
+ * @see CompositionDerivativesGERG For the underlying calculation implementation
+ */
+val CompositionDerivativesGERG_wrapper(double T, double P, gasMixture x_array)
+{
+    return CompositionDerivatives_wrapper(false, T, P, x_array);
+}
+
+/**
+ * @brief Wrapper function for CompositionDerivativesDetail
+ *
+ * Same as CompositionDerivativesGERG_wrapper with the DETAIL equation. SetupDetail must have been called.
+ *
+ * @see CompositionDerivativesGERG_wrapper For the parameters and results
+ * @see CompositionDerivativesDetail For the underlying calculation implementation
+ */
+val CompositionDerivativesDetail_wrapper(double T, double P, gasMixture x_array)
+{
+    return CompositionDerivatives_wrapper(true, T, P, x_array);
+}
+
+/**
+ * @brief Common part of CompositionDerivativesBatchGERG_wrapper and CompositionDerivativesBatchDetail_wrapper
+ */
+static val CompositionDerivativesBatch_wrapper(bool detail, val T_array, val P_array, gasMixture x_array)
+{
+    static std::vector<double> T, P, D, Z, W, dZdx, dDdx, dWdx;
+    static std::vector<int> ierr;
+
+    const Composition x = gasMixture_to_composition(x_array);
+    typed_array_to_vector(T_array, T);
+    typed_array_to_vector(P_array, P);
+    if (detail) { CompositionDerivativesBatchDetail(T, P, x, D, Z, W, dZdx, dDdx, dWdx, ierr); }
+    else { CompositionDerivativesBatchGERG(T, P, x, D, Z, W, dZdx, dDdx, dWdx, ierr); }
+
+    val result = val::object();
+    result.set("D", vector_to_typed_array("Float64Array", D));
+    result.set("Z", vector_to_typed_array("Float64Array", Z));
+    result.set("W", vector_to_typed_array("Float64Array", W));
+    result.set("dZdx", vector_to_typed_array("Float64Array", dZdx));
+    result.set("dDdx", vector_to_typed_array("Float64Array", dDdx));
+    result.set("dWdx", vector_to_typed_array("Float64Array", dWdx));
+    result.set("ierr", vector_to_typed_array("Int32Array", ierr));
+    return result;
+}
+
+/**
+ * @brief Wrapper function for CompositionDerivativesGERG over many states
+ *
+ * @param T_array Temperatures [K] (Array or Float64Array)
+ * @param P_array Pressures [kPa]
+ * @param x_array Gas mixture composition in mole fraction
+ * @return val JavaScript object containing:
+ *         - D, Z, W: Float64Array of densities [mol/l], compressibility factors and speeds of sound [m/s]
+ *         - dZdx, dDdx, dWdx: Float64Array of 21 derivatives per state, state k at 21*k to 21*k + 20
+ *         - ierr: Int32Array of error codes of the density solves (0 = successful)
+ *
+ * @see CompositionDerivativesGERG_wrapper For the derivatives
+ */
+val CompositionDerivativesBatchGERG_wrapper(val T_array, val P_array, gasMixture x_array)
+{
+    return CompositionDerivativesBatch_wrapper(false, T_array, P_array, x_array);
+}
+
+/**
+ * @brief Wrapper function for CompositionDerivativesDetail over many states
+ *
+ * @see CompositionDerivativesBatchGERG_wrapper For the parameters and results
+ * @see CompositionDerivativesDetail For the underlying calculation implementation
+ */
+val CompositionDerivativesBatchDetail_wrapper(val T_array, val P_array, gasMixture x_array)
+{
+    return CompositionDerivativesBatch_wrapper(true, T_array, P_array, x_array);
+}
+
+// Single-precision batch wrappers
+/**
+ * @brief Common part of PressureBatchFloatGERG_wrapper and PressureBatchFloatDetail_wrapper
+ */
+static val PressureBatchFloat_wrapper(bool detail, val T_array, val D_array, gasMixture x_array)
+{
+    static std::vector<float> T, D, P, Z;
+
+    const std::vector<double> &x = gasMixture_to_vector(x_array);
+    typed_array_to_vector(T_array, T);
+    typed_array_to_vector(D_array, D);
+    if (detail) { PressureBatchFloatDetail(T, D, x, P, Z); }
+    else { PressureBatchFloatGERG(T, D, x, P, Z); }
+
+    val result = val::object();
+    result.set("P", vector_to_typed_array("Float32Array", P));
+    result.set("Z", vector_to_typed_array("Float32Array", Z));
+    return result;
+}
+
+/**
+ * @brief Wrapper function for PressureBatchFloatGERG
+ *
+ * Single-precision pressures of many states of one composition, see Float32.h. The error against
+ * PressureGERG is given by the float32-report target (README.md, "Single-precision batch mode").
+ *
+ * @param T_array Temperatures [K] (Array, Float32Array or Float64Array)
+ * @param D_array Molar densities [mol/l]
+ * @param x_array Gas mixture composition in mole fraction
+ * @return val JavaScript object containing:
+ *         - P: Float32Array of pressures [kPa]
+ *         - Z: Float32Array of compressibility factors
+ *
+ * @see PressureBatchFloatGERG For the underlying calculation implementation
+ */
+val PressureBatchFloatGERG_wrapper(val T_array, val D_array, gasMixture x_array)
+{
+    return PressureBatchFloat_wrapper(false, T_array, D_array, x_array);
+}
+
+/**
+ * @brief Wrapper function for PressureBatchFloatDetail
+ *
+ * @see PressureBatchFloatGERG_wrapper For the parameters and results
+ * @see PressureBatchFloatDetail For the underlying calculation implementation
+ */
+val PressureBatchFloatDetail_wrapper(val T_array, val D_array, gasMixture x_array)
+{
+    return PressureBatchFloat_wrapper(true, T_array, D_array, x_array);
+}
+
+/**
+ * @brief Common part of PropertiesBatchFloatGERG_wrapper and PropertiesBatchFloatDetail_wrapper
+ */
+static val PropertiesBatchFloat_wrapper(bool detail, val T_array, val D_array, gasMixture x_array)
+{
+    static std::vector<float> T, D;
+    static PropertiesFloat props;
+
+    const std::vector<double> &x = gasMixture_to_vector(x_array);
+    typed_array_to_vector(T_array, T);
+    typed_array_to_vector(D_array, D);
+    if (detail) { PropertiesBatchFloatDetail(T, D, x, props); }
+    else { PropertiesBatchFloatGERG(T, D, x, props); }
+
+    val result = val::object();
+    result.set("P", vector_to_typed_array("Float32Array", props.P));
+    result.set("Z", vector_to_typed_array("Float32Array", props.Z));
+    result.set("dPdD", vector_to_typed_array("Float32Array", props.dPdD));
+    result.set("d2PdD2", vector_to_typed_array("Float32Array", props.d2PdD2));
+    result.set("d2PdTD", vector_to_typed_array("Float32Array", props.d2PdTD));
+    result.set("dPdT", vector_to_typed_array("Float32Array", props.dPdT));
+    result.set("U", vector_to_typed_array("Float32Array", props.U));
+    result.set("H", vector_to_typed_array("Float32Array", props.H));
+    result.set("S", vector_to_typed_array("Float32Array", props.S));
+    result.set("Cv", vector_to_typed_array("Float32Array", props.Cv));
+    result.set("Cp", vector_to_typed_array("Float32Array", props.Cp));
+    result.set("W", vector_to_typed_array("Float32Array", props.W));
+    result.set("G", vector_to_typed_array("Float32Array", props.G));
+    result.set("JT", vector_to_typed_array("Float32Array", props.JT));
+    result.set("Kappa", vector_to_typed_array("Float32Array", props.Kappa));
+    result.set("A", vector_to_typed_array("Float32Array", props.A));
+    result.set("Cf", vector_to_typed_array("Float32Array", props.Cf));
+    return result;
+}
+
+/**
+ * @brief Wrapper function for PropertiesBatchFloatGERG
+ *
+ * Single-precision properties of many states of one composition, see Float32.h.
+ *
+ * @param T_array Temperatures [K] (Array, Float32Array or Float64Array)
+ * @param D_array Molar densities [mol/l]
+ * @param x_array Gas mixture composition in mole fraction
+ * @return val JavaScript object with one Float32Array per property of PropertiesGERG (P, Z, dPdD,
+ *         d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf), in the same units
+ *
+ * @see PropertiesBatchFloatGERG For the underlying calculation implementation
+ */
+val PropertiesBatchFloatGERG_wrapper(val T_array, val D_array, gasMixture x_array)
+{
+    return PropertiesBatchFloat_wrapper(false, T_array, D_array, x_array);
+}
+
+/**
+ * @brief Wrapper function for PropertiesBatchFloatDetail
+ *
+ * Same columns as PropertiesBatchFloatGERG_wrapper; d2PdTD is 0, as in PropertiesDetail.
+ *
+ * @see PropertiesBatchFloatGERG_wrapper For the parameters and results
+ * @see PropertiesBatchFloatDetail For the underlying calculation implementation
+ */
+val PropertiesBatchFloatDetail_wrapper(val T_array, val D_array, gasMixture x_array)
+{
+    return PropertiesBatchFloat_wrapper(true, T_array, D_array, x_array);
+}
+
+// Uncertainty wrappers
+/**
+ * @brief Common part of the Uncertainty wrappers: runs the study and converts its result
+ */
+static val Uncertainty_wrapper(UncertaintyStudy &study, double T, double P, gasMixture x_array, double samples, double seed)
+{
+    static const char *names[NOutputsUncertainty] = {"D", "Z", "Rho", "W", "Cf", "H", "S", "Cp", "JT"};
+    static UncertaintyResult r;
+
+    study.x = gasMixture_to_vector(x_array);
+    study.T = T;
+    study.P = P;
+    study.samples = (long long)samples;
+    study.seed = (uint64_t)seed;
+    int ierr;
+    const char *herr;
+    MonteCarloUncertainty(study, r, ierr, herr);
+
+    val outputs = val::object();
+    for (int o = 0; o < NOutputsUncertainty; ++o)
+    {
+        const UncertaintyOutput &out = r.outputs[o];
+        val output = val::object();
+        output.set("nominal", out.nominal);
+        output.set("mean", out.mean);
+        output.set("u", out.u);
+        output.set("percentiles", vector_to_typed_array("Float64Array", out.percentiles));
+        output.set("c", vector_to_typed_array("Float64Array", std::vector<double>(out.c, out.c + NInputsUncertainty)));
+        outputs.set(names[o], output);
+    }
+    val result = val::object();
+    result.set("outputs", outputs);
+    result.set("samples", (double)r.samples);
+    result.set("failed", (double)r.failed);
+    result.set("ierr", ierr);
+    result.set("herr", std::string(herr));
+    return result;
+}
+
+/**
+ * @brief Wrapper function for MonteCarloUncertainty with independent inputs and GERG-2008
+ *
+ * The inputs are T, P and the 21 mole fractions of the mixture, in this order. The samples are
+ * evaluated on one thread unless the module is built with pthreads; the results only depend on the seed.
+ *
+ * @param T Nominal temperature [K]
+ * @param P Nominal pressure [kPa]
+ * @param x_array Nominal gas mixture composition in mole fraction, renormalized in each sample
+ * @param u_array Standard uncertainties of the 23 inputs (Array or Float64Array)
+ * @param distribution_array Distribution of each input (0 normal, 1 uniform, 2 triangular), all normal if empty
+ * @param samples Number of samples
+ * @param seed Seed of the counter-based generator (integer below 2^53)
+ * @return val JavaScript object containing:
+ *         - outputs: D, Z, Rho, W, Cf, H, S, Cp and JT, each with nominal, mean, u (standard deviation),
+ *           percentiles (Float64Array at 2.5 %, 50 % and 97.5 %) and c (Float64Array of the 23 sensitivity coefficients)
+ *         - samples, failed: samples in the statistics and samples without a converged density
+ *         - ierr, herr: error flag (0 = successful, -1 = warning, some samples failed) and message
+ *
+ * @see MonteCarloUncertainty For the underlying calculation implementation
+ */
+val UncertaintyGERG_wrapper(double T, double P, gasMixture x_array, val u_array, val distribution_array, double samples, double seed)
+{
+    UncertaintyStudy study;
+    study.method = UncertaintyGERG;
+    typed_array_to_vector(u_array, study.u);
+    typed_array_to_vector(distribution_array, study.distribution);
+    return Uncertainty_wrapper(study, T, P, x_array, samples, seed);
+}
+
+/**
+ * @brief Wrapper function for MonteCarloUncertainty with independent inputs and the detail method
+ *
+ * @see UncertaintyGERG_wrapper For the parameters and results
+ */
+val UncertaintyDetail_wrapper(double T, double P, gasMixture x_array, val u_array, val distribution_array, double samples, double seed)
+{
+    UncertaintyStudy study;
+    study.method = UncertaintyDetail;
+    typed_array_to_vector(u_array, study.u);
+    typed_array_to_vector(distribution_array, study.distribution);
+    return Uncertainty_wrapper(study, T, P, x_array, samples, seed);
+}
+
+/**
+ * @brief Wrapper function for MonteCarloUncertainty with correlated normal inputs and GERG-2008
+ *
+ * @param covariance_array 23 x 23 covariance matrix of T, P and the 21 mole fractions, row-major
+ * @see UncertaintyGERG_wrapper For the other parameters and the results
+ */
+val UncertaintyCovarianceGERG_wrapper(double T, double P, gasMixture x_array, val covariance_array, double samples, double seed)
+{
+    UncertaintyStudy study;
+    study.method = UncertaintyGERG;
+    typed_array_to_vector(covariance_array, study.covariance);
+    return Uncertainty_wrapper(study, T, P, x_array, samples, seed);
+}
+
+/**
+ * @brief Wrapper function for MonteCarloUncertainty with correlated normal inputs and the detail method
+ *
+ * @see UncertaintyCovarianceGERG_wrapper For the parameters and results
+ */
+val UncertaintyCovarianceDetail_wrapper(double T, double P, gasMixture x_array, val covariance_array, double samples, double seed)
+{
+    UncertaintyStudy study;
+    study.method = UncertaintyDetail;
+    typed_array_to_vector(covariance_array, study.covariance);
+    return Uncertainty_wrapper(study, T, P, x_array, samples, seed);
+}
+
+// Columnar wrappers
+/**
+ * @brief Wrapper function for ViewColumnar: columns of a columnar dataset
+ *
+ * @param bytes Uint8Array holding the dataset (file written by aga8-calc or WriteColumnar)
+ * @return val JavaScript object containing:
+ *         - rows: number of rows
+ *         - names: column names, starting with methane ... argon, T and P
+ *         - columns: object of a Float64Array per column name
+ *         - ierr, herr: error flag (0 = successful) and message
+ *
+ * @see ViewColumnar For the layout and error flags
+ */
+val ReadColumnar_wrapper(val bytes)
+{
+    static std::vector<unsigned char> data;
+    typed_array_to_vector(bytes, data);
+    ColumnarTable table;
+    int ierr;
+    const char *herr;
+    ViewColumnar(data.data(), data.size(), table, ierr, herr);
+
+    val names = val::array();
+    val columns = val::object();
+    for (std::size_t c = 0; c < table.names.size(); ++c)
+    {
+        names.call<void>("push", table.names[c]);
+        columns.set(table.names[c], val::global("Float64Array").new_(typed_memory_view(table.rows, table.columns[c])));
+    }
+    val result = val::object();
+    result.set("rows", (double)table.rows);
+    result.set("names", names);
+    result.set("columns", columns);
+    result.set("ierr", ierr);
+    result.set("herr", std::string(herr));
+    return result;
+}
+
+/**
+ * @brief Wrapper function for SerializeColumnar: columnar dataset of columns of the same length
+ *
+ * @param names_array Column names, the first 23 being methane ... argon, T and P for a dataset readable by ReadColumnar
+ * @param columns_array Columns (Array of Float64Array or Array), in the order of the names
+ * @return val JavaScript object containing:
+ *         - bytes: Uint8Array holding the dataset, empty on error
+ *         - ierr, herr: error flag (0 = successful, 1 = names and columns do not match) and message
+ *
+ * @see SerializeColumnar For the underlying implementation
+ */
+val WriteColumnar_wrapper(val names_array, val columns_array)
+{
+    static std::vector<std::vector<double>> values;
+    std::vector<std::string> names;
+    std::vector<const double *> columns;
+    const unsigned n = names_array["length"].as<unsigned>();
+    bool ok = columns_array["length"].as<unsigned>() == n;
+    values.resize(ok ? n : 0);
+    for (unsigned c = 0; c < values.size(); ++c)
+    {
+        names.push_back(names_array[c].as<std::string>());
+        typed_array_to_vector(columns_array[c], values[c]);
+        columns.push_back(values[c].data());
+        ok = ok && values[c].size() == values[0].size();
+    }
+    std::vector<unsigned char> bytes;
+    if (ok) { SerializeColumnar(names, columns, values.empty() ? 0 : values[0].size(), bytes); }
+    val result = val::object();
+    result.set("bytes", vector_to_typed_array("Uint8Array", bytes));
+    result.set("ierr", ok ? 0 : 1);
+    result.set("herr", std::string(ok ? "" : "Names and columns of different lengths"));
+    return result;
+}
+
+/**
+ * @brief Common part of the BatchColumnar wrappers: evaluates a dataset and serializes the result
+ */
+static val BatchColumnar_wrapper(int method, val bytes, val properties_array)
+{
+    static std::vector<unsigned char> data, out;
+    static std::vector<std::vector<double>> outputs;
+    static std::vector<double> errors;
+    typed_array_to_vector(bytes, data);
+    ColumnarTable table;
+    int ierr;
+    const char *herr;
+    ViewColumnar(data.data(), data.size(), table, ierr, herr);
+    std::vector<int> properties;
+    const unsigned n = properties_array["length"].as<unsigned>();
+    for (unsigned p = 0; p < n && ierr == 0; ++p)
+    {
+        properties.push_back(FindPropertyColumnar(method, properties_array[p].as<std::string>()));
+        if (properties.back() < 0) { ierr = 7; herr = "Unknown property, or not calculated by this method"; }
+    }
+
+    out.clear();
+    double failed = 0;
+    if (ierr == 0)
+    {
+        BatchColumnar(method, table, properties, 1, outputs, errors);
+        std::vector<std::string> names;
+        std::vector<const double *> columns;
+        ResultColumnar(table, properties, outputs, errors, names, columns);
+        SerializeColumnar(names, columns, table.rows, out);
+        for (const double e : errors) { failed += e != 0; }
+    }
+    val result = val::object();
+    result.set("bytes", vector_to_typed_array("Uint8Array", out));
+    result.set("rows", (double)table.rows);
+    result.set("failed", failed);
+    result.set("ierr", ierr);
+    result.set("herr", std::string(herr));
+    return result;
+}
+
+/**
+ * @brief Wrapper function for BatchColumnar with GERG-2008
+ *
+ * SetupGERG must have been called. The mole fractions of the dataset are used as given.
+ *
+ * @param bytes Uint8Array holding the input dataset
+ * @param properties_array Names of the properties to calculate (D, Z, Mm, Rho, dPdD, ..., Cf, see ColumnarProperties)
+ * @return val JavaScript object containing:
+ *         - bytes: Uint8Array holding the dataset of the inputs, the other columns of the input, the properties and
+ *           ierr (error flag of each row, the properties are NaN where it is not 0)
+ *         - rows, failed: number of rows and of rows with an error
+ *         - ierr, herr: error flag (0 = successful, 7 = unknown property, else that of ReadColumnar) and message
+ *
+ * @see BatchColumnar For the underlying calculation implementation
+ */
+val BatchColumnarGERG_wrapper(val bytes, val properties_array)
+{
+    return BatchColumnar_wrapper(ColumnarGERG, bytes, properties_array);
+}
+
+/**
+ * @brief Wrapper function for BatchColumnar with the detail method
+ *
+ * @see BatchColumnarGERG_wrapper For the parameters and results; SetupDetail must have been called
+ */
+val BatchColumnarDetail_wrapper(val bytes, val properties_array)
+{
+    return BatchColumnar_wrapper(ColumnarDetail, bytes, properties_array);
+}
+
+/**
+ * @brief Wrapper function for BatchColumnar with the gross method (D, Z, Mm, Rho, Gr and HN)
+ *
+ * @see BatchColumnarGERG_wrapper For the parameters and results; SetupGross must have been called
+ */
+val BatchColumnarGross_wrapper(val bytes, val properties_array)
+{
+    return BatchColumnar_wrapper(ColumnarGross, bytes, properties_array);
+}
+
+// Trace wrappers
+/**
+ * @brief Returns the recorded solver and kernel spans as Chrome trace JSON
+ *
+ * The document can be loaded in chrome://tracing or https://ui.perfetto.dev.
+ * Spans are only recorded when the module is built with the CMake option AGA8_TRACE=ON,
+ * otherwise an empty trace is returned.
+ *
+ * @return std::string Chrome trace JSON document
+ * @see TraceDump For the underlying implementation
+ */
+std::string TraceDump_wrapper()
+{
+    std::string json;
+    TraceDump(json);
+    return json;
+}
+
+/**
+ * @brief Emscripten bindings for the AGA8 gas calculation module
+ *
+ * These bindings expose the AGA8 gas calculation functionality to JavaScript/WebAssembly.
+ * It includes:
+ *
+ * Enums:
+ * - GasComponent: Enumeration of different gas components (methane, nitrogen, etc.)
+ *
+ * Types:
+ * - gasMixtureInMolePercent: Gas mixture composition in mole percent
+ * - xGrsArray: Array for gross method calculations
+ * - VectorDouble: Vector of double precision numbers
+ *
+ * Value Objects:
+ * - PressureResult: Pressure calculation results (P, Z)
+ * - DensityResult: Density calculation results (D, error info)
+ * - FlashResult: Flash calculation results (T, D, error info)
+ * - CriticalFlowResult: Critical flow function and throat state (C*, T, P, D, error info)
+ * - SonicNozzleResult: Sonic nozzle sized for a mass flow rate (d, P0, Cd, Re, C*, error info)
+ * - PropertiesDetailResult: Detailed gas properties results
+ * - PropertiesGERGResult: GERG-2008 properties calculation results
+ * - PressureGrossResult: Gross method pressure calculation results
+ * - GrossHvResult: Heating value calculation results
+ * - GrossInputsResult: Gross method input processing results
+ * - BmixResult: Binary mixture calculation results
+ * - GrossMethod1Result: Results for gross characterization method 1
+ * - GrossMethod2Result: Results for gross characterization method 2
+ *
+ * Functions:
+ * Detail Methods:
+ * - SetupDetail: Initialize detail calculation method
+ * - MolarMassDetail: Calculate molar mass using detail method
+ * - PressureDetail: Calculate pressure using detail method
+ * - DensityDetail: Calculate density using detail method
+ * - PropertiesDetail: Calculate detailed properties
+ * - IsothermDetail: Calculate pressures along an isotherm using detail method
+ *
+ * GERG Methods:
+ * - SetupGERG: Initialize GERG-2008 calculation method
+ * - MolarMassGERG: Calculate molar mass using GERG-2008
+ * - PressureGERG: Calculate pressure using GERG-2008
+ * - DensityGERG: Calculate density using GERG-2008
+ * - PropertiesGERG: Calculate properties using GERG-2008
+ * - IsothermGERG: Calculate pressures along an isotherm using GERG-2008
+ *
+ * Gross Methods:
+ * - SetupGross: Initialize gross calculation method
+ * - MolarMassGross: Calculate molar mass using gross method
+ * - PressureGross: Calculate pressure using gross method
+ * - DensityGross: Calculate density using gross method
+ * - DensityGrossIterative: Calculate density using the iterative gross solver
+ * - DensityGrossBatch: Calculate densities of many states using gross method
+ * - GrossHv: Calculate heating value
+ * - GrossInputs: Process inputs for gross calculations
+ * - Bmix: Calculate binary mixture properties
+ * - GrossMethod1: Perform gross characterization method 1
+ * - GrossMethod2: Perform gross characterization method 2
+ * - GrossMethod1Batch: Perform gross characterization method 1 for many meters
+ * - GrossMethod2Batch: Perform gross characterization method 2 for many meters
+ *
+ * Flash Methods:
+ * - FlashGERG: Temperature and density from two known properties using GERG-2008
+ * - FlashDetail: Temperature and density from two known properties using detail method
+ * - FlashBatchGERG: Flashes of many states using GERG-2008, each started from the previous one
+ * - FlashBatchDetail: Flashes of many states using detail method, each started from the previous one
+ *
+ * Critical Flow Methods:
+ * - CriticalFlowFunctionGERG: Real-gas critical flow function of a sonic nozzle using GERG-2008
+ * - CriticalFlowFunctionDetail: Real-gas critical flow function of a sonic nozzle using detail method
+ * - CriticalFlowBatchGERG: Critical flow functions of many stagnation states using GERG-2008
+ * - CriticalFlowBatchDetail: Critical flow functions of many stagnation states using detail method
+ *
+ * Sonic Nozzle Methods:
+ * - SonicNozzleDiameter: Throat diameter of a sonic nozzle passing a mass flow rate
+ * - SonicNozzlePressure: Inlet pressure of a sonic nozzle passing a mass flow rate
+ *
+ * Composition Derivative Methods:
+ * - CompositionDerivativesGERG: D, Z and W with their derivatives with respect to the mole fractions using GERG-2008
+ * - CompositionDerivativesDetail: D, Z and W with their derivatives with respect to the mole fractions using detail method
+ * - CompositionDerivativesBatchGERG: Composition derivatives of many states using GERG-2008
+ * - CompositionDerivativesBatchDetail: Composition derivatives of many states using detail method
+ *
+ * Single-Precision Batch Methods:
+ * - PressureBatchFloatGERG: Pressures of many states of one composition in float using GERG-2008
+ * - PressureBatchFloatDetail: Pressures of many states of one composition in float using detail method
+ * - PropertiesBatchFloatGERG: Properties of many states of one composition in float using GERG-2008
+ * - PropertiesBatchFloatDetail: Properties of many states of one composition in float using detail method
+ *
+ * Uncertainty Methods:
+ * - UncertaintyGERG: Monte Carlo propagation of independent T, P and composition uncertainties using GERG-2008
+ * - UncertaintyDetail: Monte Carlo propagation of independent T, P and composition uncertainties using detail method
+ * - UncertaintyCovarianceGERG: Monte Carlo propagation of a T, P and composition covariance using GERG-2008
+ * - UncertaintyCovarianceDetail: Monte Carlo propagation of a T, P and composition covariance using detail method
+ *
+ * Columnar Methods:
+ * - ReadColumnar: Columns of a columnar binary dataset
+ * - WriteColumnar: Columnar binary dataset of named columns
+ * - BatchColumnarGERG: Properties of every row of a columnar dataset using GERG-2008
+ * - BatchColumnarDetail: Properties of every row of a columnar dataset using detail method
+ * - BatchColumnarGross: Properties of every row of a columnar dataset using gross method
+ *
+ * Trace Methods:
+ * - TraceDump: Chrome trace JSON of the recorded spans (AGA8_TRACE builds only)
+ * - TraceReset: Discard the recorded spans
+ * - TraceEventCount: Number of recorded spans
+ */
+EMSCRIPTEN_BINDINGS(AGA8_module)
+{
+    register_vector<double>("VectorDouble");
+
+    value_object<gasMixture>("GasMixture")
+        .field("methane", &gasMixture::methane)
+        .field("nitrogen", &gasMixture::nitrogen)
+        .field("carbon_dioxide", &gasMixture::carbon_dioxide)
+        .field("ethane", &gasMixture::ethane)
+        .field("propane", &gasMixture::propane)
+        .field("isobutane", &gasMixture::isobutane)
+        .field("n_butane", &gasMixture::n_butane)
+        .field("isopentane", &gasMixture::isopentane)
+        .field("n_pentane", &gasMixture::n_pentane)
+        .field("n_hexane", &gasMixture::n_hexane)
+        .field("n_heptane", &gasMixture::n_heptane)
+        .field("n_octane", &gasMixture::n_octane)
+        .field("n_nonane", &gasMixture::n_nonane)
+        .field("n_decane", &gasMixture::n_decane)
+        .field("hydrogen", &gasMixture::hydrogen)
+        .field("oxygen", &gasMixture::oxygen)
+        .field("carbon_monoxide", &gasMixture::carbon_monoxide)
+        .field("water", &gasMixture::water)
+        .field("hydrogen_sulfide", &gasMixture::hydrogen_sulfide)
+        .field("helium", &gasMixture::helium)
+        .field("argon", &gasMixture::argon);
+
+    value_object<xGrs>("xGrs")
+        .field("hydrocarbon", &xGrs::hydrocarbon)
+        .field("nitrogen", &xGrs::nitrogen)
+        .field("carbon_dioxide", &xGrs::carbon_dioxide);
+
+    value_object<PressureResult>("PressureResult")
+        .field("P", &PressureResult::P)
+        .field("Z", &PressureResult::Z);
+
+    value_object<DensityResult>("DensityResult")
+        .field("D", &DensityResult::D)
+        .field("ierr", &DensityResult::ierr)
+        .field("herr", &DensityResult::herr);
+
+    value_object<FlashResult>("FlashResult")
+        .field("T", &FlashResult::T)
+        .field("D", &FlashResult::D)
+        .field("ierr", &FlashResult::ierr)
+        .field("herr", &FlashResult::herr);
+
+    value_object<CriticalFlowResult>("CriticalFlowResult")
+        .field("Cstar", &CriticalFlowResult::Cstar)
+        .field("T", &CriticalFlowResult::T)
+        .field("P", &CriticalFlowResult::P)
+        .field("D", &CriticalFlowResult::D)
+        .field("ierr", &CriticalFlowResult::ierr)
+        .field("herr", &CriticalFlowResult::herr);
+
+    value_object<SonicNozzleResult>("SonicNozzleResult")
+        .field("d", &SonicNozzleResult::d)
+        .field("P0", &SonicNozzleResult::P0)
+        .field("Cd", &SonicNozzleResult::Cd)
+        .field("Re", &SonicNozzleResult::Re)
+        .field("Cstar", &SonicNozzleResult::Cstar)
+        .field("Pt", &SonicNozzleResult::Pt)
+        .field("Poutmax", &SonicNozzleResult::Poutmax)
+        .field("ierr", &SonicNozzleResult::ierr)
+        .field("herr", &SonicNozzleResult::herr);
+
+    value_object<HandleResult>("HandleResult")
+        .field("handle", &HandleResult::handle)
+        .field("ierr", &HandleResult::ierr)
+        .field("herr", &HandleResult::herr);
+
+    value_object<DensityGuessStatsResult>("DensityGuessStatsResult")
+        .field("calls", &DensityGuessStatsResult::calls)
+        .field("hits", &DensityGuessStatsResult::hits)
+        .field("iterations", &DensityGuessStatsResult::iterations)
+        .field("iterationsSaved", &DensityGuessStatsResult::iterationsSaved);
 
     value_object<PropertiesDetailResult>("PropertiesDetailResult")
         .field("P", &PropertiesDetailResult::P)
@@ -1044,6 +2541,7 @@ EMSCRIPTEN_BINDINGS(AGA8_module)
     function("PressureDetail", &PressureDetail_wrapper);
     function("DensityDetail", &DensityDetail_wrapper);
     function("PropertiesDetail", &PropertiesDetail_wrapper);
+    function("IsothermDetail", &IsothermDetail_wrapper);
 
     // GERG bindings
     function("SetupGERG", &SetupGERG);
@@ -1051,15 +2549,80 @@ EMSCRIPTEN_BINDINGS(AGA8_module)
     function("PressureGERG", &PressureGERG_wrapper);
     function("DensityGERG", &DensityGERG_wrapper);
     function("PropertiesGERG", &PropertiesGERG_wrapper);
+    function("IsothermGERG", &IsothermGERG_wrapper);
 
     // Gross bindings
     function("SetupGross", &SetupGross);
     function("MolarMassGross", &MolarMassGross_wrapper);
     function("PressureGross", &PressureGross_wrapper);
     function("DensityGross", &DensityGross_wrapper);
+    function("DensityGrossIterative", &DensityGrossIterative_wrapper);
+    function("DensityGrossBatch", &DensityGrossBatch_wrapper);
     function("GrossHv", &GrossHv_wrapper);
     function("GrossInputs", &GrossInputs_wrapper);
     function("Bmix", &Bmix_wrapper);
     function("GrossMethod1", &GrossMethod1_wrapper);
     function("GrossMethod2", &GrossMethod2_wrapper);
+    function("GrossMethod1Batch", &GrossMethod1Batch_wrapper);
+    function("GrossMethod2Batch", &GrossMethod2Batch_wrapper);
+
+    // Surrogate bindings
+    function("BuildSurrogate", &BuildSurrogate_wrapper);
+    function("LoadSurrogate", &LoadSurrogate_wrapper);
+    function("SaveSurrogate", &SaveSurrogate_wrapper);
+    function("FreeSurrogate", &FreeSurrogate_wrapper);
+    function("EvaluateSurrogate", &EvaluateSurrogate_wrapper);
+
+    // Density estimate bindings
+    function("BuildDensityGuess", &BuildDensityGuess_wrapper);
+    function("FreeDensityGuess", &FreeDensityGuess_wrapper);
+    function("DensityGuessBatch", &DensityGuessBatch_wrapper);
+    function("GetDensityGuessStats", &GetDensityGuessStats_wrapper);
+    function("ResetDensityGuessStats", &ResetDensityGuessStats);
+
+    // Flash bindings
+    function("FlashGERG", &FlashGERG_wrapper);
+    function("FlashDetail", &FlashDetail_wrapper);
+    function("FlashBatchGERG", &FlashBatchGERG_wrapper);
+    function("FlashBatchDetail", &FlashBatchDetail_wrapper);
+
+    // Critical flow bindings
+    function("CriticalFlowFunctionGERG", &CriticalFlowFunctionGERG_wrapper);
+    function("CriticalFlowFunctionDetail", &CriticalFlowFunctionDetail_wrapper);
+    function("CriticalFlowBatchGERG", &CriticalFlowBatchGERG_wrapper);
+    function("CriticalFlowBatchDetail", &CriticalFlowBatchDetail_wrapper);
+
+    // Sonic nozzle bindings
+    function("SonicNozzleDiameter", &SonicNozzleDiameter_wrapper);
+    function("SonicNozzlePressure", &SonicNozzlePressure_wrapper);
+
+    // Composition derivative bindings
+    function("CompositionDerivativesGERG", &CompositionDerivativesGERG_wrapper);
+    function("CompositionDerivativesDetail", &CompositionDerivativesDetail_wrapper);
+    function("CompositionDerivativesBatchGERG", &CompositionDerivativesBatchGERG_wrapper);
+    function("CompositionDerivativesBatchDetail", &CompositionDerivativesBatchDetail_wrapper);
+
+    // Single-precision batch functions
+    function("PressureBatchFloatGERG", &PressureBatchFloatGERG_wrapper);
+    function("PressureBatchFloatDetail", &PressureBatchFloatDetail_wrapper);
+    function("PropertiesBatchFloatGERG", &PropertiesBatchFloatGERG_wrapper);
+    function("PropertiesBatchFloatDetail", &PropertiesBatchFloatDetail_wrapper);
+
+    // Uncertainty functions
+    function("UncertaintyGERG", &UncertaintyGERG_wrapper);
+    function("UncertaintyDetail", &UncertaintyDetail_wrapper);
+    function("UncertaintyCovarianceGERG", &UncertaintyCovarianceGERG_wrapper);
+    function("UncertaintyCovarianceDetail", &UncertaintyCovarianceDetail_wrapper);
+
+    // Columnar functions
+    function("ReadColumnar", &ReadColumnar_wrapper);
+    function("WriteColumnar", &WriteColumnar_wrapper);
+    function("BatchColumnarGERG", &BatchColumnarGERG_wrapper);
+    function("BatchColumnarDetail", &BatchColumnarDetail_wrapper);
+    function("BatchColumnarGross", &BatchColumnarGross_wrapper);
+
+    // Trace bindings
+    function("TraceDump", &TraceDump_wrapper);
+    function("TraceReset", &TraceReset);
+    function("TraceEventCount", &TraceEventCount);
 }
\ No newline at end of file
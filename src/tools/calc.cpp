@@ -0,0 +1,530 @@
+/**
+ * @file calc.cpp
+ * @brief aga8-calc: properties of the gases of a CSV file, streamed through a pool of threads
+ *
+ * Usage: aga8-calc [options] [input.csv|-] [output.csv|-]
+ *
+ * The input is in the format of src/examples/NG_Compositions.csv: a header line naming the columns,
+ * then one gas per line. The columns named after the 21 components (methane ... argon, see
+ * InputNamesColumnar) hold mole percents, or any amounts normalized to mole fractions; missing components
+ * are absent from every gas. The temperature (K) and pressure (kPa) are read from the columns T and
+ * P, or given on the command line for every line. Each output line is the input line followed by the
+ * requested properties and the error number of the calculation (0 if successful).
+ *
+ * The file is streamed in blocks of whole lines: a reader thread reads chunks of --chunk-size bytes,
+ * the worker threads parse them with std::from_chars and evaluate their lines, and the calling
+ * thread writes the blocks back in input order. At most a few blocks per thread are in flight, so
+ * the memory does not depend on the size of the file.
+ *
+ * A columnar dataset (Columnar.h) given as the input file is recognized by its magic number, mapped
+ * in memory and evaluated in place by BatchColumnar. With --format columnar, the output is a columnar
+ * dataset of the inputs, the properties and ierr, written column by column; from a CSV input, its
+ * columns are gathered in memory until the end of the file.
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "Columnar.h"
+#include "Detail.h"
+#include "GERG2008.h"
+#include "Gross.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+const int FormatCSV = 0, FormatColumnar = 1;
+
+struct CalcOptions
+{
+    int method = ColumnarGERG;
+    int format = -1;                     // Output format, that of the input if -1
+    std::vector<int> props;
+    int threads = 0;
+    std::size_t chunk = 4 << 20;
+    std::string Tcolumn = "T", Pcolumn = "P";
+    double T = NAN, P = NAN;
+    const char *input = "-", *output = "-";
+};
+
+// Columns of the input: index of each component, of T and of P (-1 if absent), and number of columns
+struct CalcColumns
+{
+    int x[21 + 1];
+    int T, P, n;
+};
+
+// Block of whole input lines, and its output: text, or the values of the columns of each line for a columnar output
+struct CalcBlock
+{
+    long long seq;
+    std::string in, out;
+    std::vector<double> values;
+};
+
+static std::atomic<long long> rowCount(0), errorCount(0);
+
+static void Usage(const char *name)
+{
+    fprintf(stderr, "Usage: %s [options] [input.csv|input.a8c|-] [output|-]\n\n", name);
+    fprintf(stderr, "  -h, --help                      This help\n");
+    fprintf(stderr, "  -m, --method gerg|detail|gross  Equation of state (default gerg)\n");
+    fprintf(stderr, "  -p, --properties LIST           Comma separated properties (default D,Z), none to convert only\n");
+    fprintf(stderr, "  -j, --threads N                 Worker threads (default: one per core)\n");
+    fprintf(stderr, "  -f, --format csv|columnar       Output format (default: that of the input)\n");
+    fprintf(stderr, "  -T, --temperature K             Temperature of the lines without a T column\n");
+    fprintf(stderr, "  -P, --pressure KPA              Pressure of the lines without a P column\n");
+    fprintf(stderr, "      --T-column NAME             Name of the temperature column (default T)\n");
+    fprintf(stderr, "      --P-column NAME             Name of the pressure column (default P)\n");
+    fprintf(stderr, "      --chunk-size BYTES          Size of the blocks read at once (default 4194304)\n\n");
+    fprintf(stderr, "Properties:\n");
+    for (const ColumnarProperty &p : ColumnarProperties)
+    {
+        fprintf(stderr, "  %-7s %s (%s%s%s)\n", p.name, p.description, p.gerg ? "G" : "", p.detail ? "D" : "", p.gross ? "g" : "");
+    }
+    fprintf(stderr, "(G: GERG-2008, D: DETAIL, g: GROSS)\n");
+}
+
+static bool ParseDouble(const char *s, double &v)
+{
+    const char *end = s + std::strlen(s);
+    const std::from_chars_result r = std::from_chars(s, end, v);
+    return r.ec == std::errc() && r.ptr == end;
+}
+
+static bool ParseOptions(int argc, char **argv, CalcOptions &opt)
+{
+    std::vector<const char *> files;
+    std::string props = "D,Z";
+    for (int a = 1; a < argc; ++a)
+    {
+        const std::string arg = argv[a];
+        const bool hasValue = a + 1 < argc;
+        if (arg == "-h" || arg == "--help") { return false; }
+        else if ((arg == "-m" || arg == "--method") && hasValue)
+        {
+            const std::string m = argv[++a];
+            if (m == "gerg") { opt.method = ColumnarGERG; }
+            else if (m == "detail") { opt.method = ColumnarDetail; }
+            else if (m == "gross") { opt.method = ColumnarGross; }
+            else { fprintf(stderr, "Unknown method %s\n", m.c_str()); return false; }
+        }
+        else if ((arg == "-p" || arg == "--properties") && hasValue) { props = argv[++a]; }
+        else if ((arg == "-j" || arg == "--threads") && hasValue) { opt.threads = std::atoi(argv[++a]); }
+        else if ((arg == "-f" || arg == "--format") && hasValue)
+        {
+            const std::string f = argv[++a];
+            if (f == "csv") { opt.format = FormatCSV; }
+            else if (f == "columnar") { opt.format = FormatColumnar; }
+            else { fprintf(stderr, "Unknown format %s\n", f.c_str()); return false; }
+        }
+        else if ((arg == "-T" || arg == "--temperature") && hasValue)
+        {
+            if (!ParseDouble(argv[++a], opt.T)) { fprintf(stderr, "Invalid temperature %s\n", argv[a]); return false; }
+        }
+        else if ((arg == "-P" || arg == "--pressure") && hasValue)
+        {
+            if (!ParseDouble(argv[++a], opt.P)) { fprintf(stderr, "Invalid pressure %s\n", argv[a]); return false; }
+        }
+        else if (arg == "--T-column" && hasValue) { opt.Tcolumn = argv[++a]; }
+        else if (arg == "--P-column" && hasValue) { opt.Pcolumn = argv[++a]; }
+        else if (arg == "--chunk-size" && hasValue) { opt.chunk = std::max(1L, std::atol(argv[++a])); }
+        else if (arg.size() > 1 && arg[0] == '-') { fprintf(stderr, "Unknown option %s\n", arg.c_str()); return false; }
+        else { files.push_back(argv[a]); }
+    }
+    if (files.size() > 2) { return false; }
+    if (files.size() > 0) { opt.input = files[0]; }
+    if (files.size() > 1) { opt.output = files[1]; }
+
+    for (std::size_t start = 0; !props.empty() && start <= props.size();)
+    {
+        std::size_t end = props.find(',', start);
+        if (end == std::string::npos) { end = props.size(); }
+        const std::string name = props.substr(start, end - start);
+        const int p = FindPropertyColumnar(opt.method, name);
+        if (p < 0) { fprintf(stderr, "Unknown property %s, or not calculated by this method\n", name.c_str()); return false; }
+        opt.props.push_back(p);
+        start = end + 1;
+    }
+    return true;
+}
+
+// Splits a line at the commas, without the end of line characters
+static void SplitFields(std::string_view line, std::vector<std::string_view> &fields)
+{
+    fields.clear();
+    while (!line.empty() && (line.back() == '\r' || line.back() == '\n')) { line.remove_suffix(1); }
+    std::size_t start = 0;
+    for (std::size_t k = 0; k <= line.size(); ++k)
+    {
+        if (k == line.size() || line[k] == ',')
+        {
+            fields.push_back(line.substr(start, k - start));
+            start = k + 1;
+        }
+    }
+}
+
+static std::string_view Trim(std::string_view s)
+{
+    while (!s.empty() && (s.front() == ' ' || s.front() == '"')) { s.remove_prefix(1); }
+    while (!s.empty() && (s.back() == ' ' || s.back() == '"')) { s.remove_suffix(1); }
+    return s;
+}
+
+static bool FindColumns(const std::string &header, const CalcOptions &opt, CalcColumns &cols)
+{
+    std::vector<std::string_view> fields;
+    std::string_view h = header;
+    if (h.size() >= 3 && h.substr(0, 3) == "\xEF\xBB\xBF") { h.remove_prefix(3); } // UTF-8 byte order mark
+    SplitFields(h, fields);
+    cols.n = (int)fields.size();
+    cols.T = cols.P = -1;
+    int found = 0;
+    for (int i = 1; i <= 21; ++i) { cols.x[i] = -1; }
+    for (int c = 0; c < cols.n; ++c)
+    {
+        const std::string_view f = Trim(fields[c]);
+        if (f == opt.Tcolumn) { cols.T = c; }
+        else if (f == opt.Pcolumn) { cols.P = c; }
+        for (int i = 1; i <= 21; ++i)
+        {
+            if (f == InputNamesColumnar[i - 1]) { cols.x[i] = c; ++found; }
+        }
+    }
+    if (found == 0) { fprintf(stderr, "No component column in the header\n"); return false; }
+    if (cols.T < 0 && std::isnan(opt.T)) { fprintf(stderr, "No %s column, give the temperature with -T\n", opt.Tcolumn.c_str()); return false; }
+    if (cols.P < 0 && std::isnan(opt.P)) { fprintf(stderr, "No %s column, give the pressure with -P\n", opt.Pcolumn.c_str()); return false; }
+    return true;
+}
+
+static bool FieldValue(const std::string_view f, double &v)
+{
+    const std::string_view t = Trim(f);
+    if (t.empty()) { v = 0; return true; }
+    const std::from_chars_result r = std::from_chars(t.data(), t.data() + t.size(), v);
+    return r.ec == std::errc() && r.ptr == t.data() + t.size();
+}
+
+// Evaluates the lines of a block into its output
+static void EvaluateBlock(const CalcOptions &opt, const CalcColumns &cols, CalcBlock &b)
+{
+    std::vector<std::string_view> fields;
+    std::vector<double> x(21 + 1, 0);
+    double v[NPropertiesColumnar];
+    char num[32];
+    bool full = false;
+    for (const int p : opt.props) { full = full || p >= NDensityPropertiesColumnar; }
+
+    b.out.clear();
+    b.values.clear();
+    if (opt.format == FormatCSV) { b.out.reserve(b.in.size() + b.in.size() / 2); }
+    long long rows = 0, errors = 0;
+    std::size_t start = 0;
+    while (start < b.in.size())
+    {
+        std::size_t end = b.in.find('\n', start);
+        if (end == std::string::npos) { end = b.in.size(); }
+        const std::string_view line(b.in.data() + start, end - start);
+        start = end + 1;
+        SplitFields(line, fields);
+        if (fields.size() == 1 && fields[0].empty()) { continue; }
+
+        // Composition normalized to mole fractions, temperature and pressure
+        int ierr = 0;
+        double sum = 0, T = opt.T, P = opt.P;
+        for (int i = 1; i <= 21; ++i)
+        {
+            x[i] = 0;
+            if (cols.x[i] >= 0 && (cols.x[i] >= (int)fields.size() || !FieldValue(fields[cols.x[i]], x[i]) || x[i] < 0)) { ierr = -1; }
+            sum += x[i];
+        }
+        if (cols.T >= 0 && (cols.T >= (int)fields.size() || !FieldValue(fields[cols.T], T))) { ierr = -1; }
+        if (cols.P >= 0 && (cols.P >= (int)fields.size() || !FieldValue(fields[cols.P], P))) { ierr = -1; }
+        if (ierr == 0 && !(sum > 0)) { ierr = -1; }
+        if (ierr == 0)
+        {
+            for (int i = 1; i <= 21; ++i) { x[i] /= sum; }
+            if (!opt.props.empty()) { EvaluateColumnar(opt.method, full, T, P, CompositionView(&x[1]), v, ierr); }
+        }
+        ++rows;
+        if (ierr != 0) { ++errors; }
+
+        if (opt.format == FormatColumnar)
+        {
+            // Inputs, properties, error number; NaN where the line could not be read or evaluated
+            for (int i = 1; i <= 21; ++i) { b.values.push_back(ierr == -1 ? NAN : x[i]); }
+            b.values.push_back(ierr == -1 ? NAN : T);
+            b.values.push_back(ierr == -1 ? NAN : P);
+            for (const int p : opt.props) { b.values.push_back(ierr == 0 ? v[p] : NAN); }
+            b.values.push_back(ierr);
+            continue;
+        }
+
+        // Input line, properties, error number
+        std::string_view text = line;
+        while (!text.empty() && text.back() == '\r') { text.remove_suffix(1); }
+        b.out.append(text.data(), text.size());
+        for (const int p : opt.props)
+        {
+            b.out.push_back(',');
+            if (ierr == 0)
+            {
+                const std::to_chars_result r = std::to_chars(num, num + sizeof(num), v[p]);
+                b.out.append(num, r.ptr - num);
+            }
+        }
+        b.out.push_back(',');
+        b.out.append(std::to_string(ierr));
+        b.out.push_back('\n');
+    }
+    rowCount += rows;
+    errorCount += errors;
+    std::string().swap(b.in);
+}
+
+// Columnar input: evaluated in place, written as a columnar dataset or as CSV
+static int RunColumnar(const CalcOptions &opt, const int threads, FILE *out)
+{
+    ColumnarFile file;
+    int ierr;
+    const char *herr;
+    OpenColumnar(opt.input, file, ierr, herr);
+    if (ierr != 0) { fprintf(stderr, "%s: %s\n", opt.input, herr); return 2; }
+    const ColumnarTable &in = file.table;
+    std::vector<std::vector<double>> outputs;
+    std::vector<double> errors;
+    std::vector<std::string> names = in.names;
+    std::vector<const double *> columns = in.columns;
+    rowCount = (long long)in.rows;
+    if (!opt.props.empty())
+    {
+        BatchColumnar(opt.method, in, opt.props, threads, outputs, errors);
+        errorCount = (long long)std::count_if(errors.begin(), errors.end(), [](const double e) { return e != 0; });
+        ResultColumnar(in, opt.props, outputs, errors, names, columns);
+    }
+    if (opt.format == FormatColumnar)
+    {
+        WriteColumnar(out, names, columns, in.rows, ierr, herr);
+        return ierr == 0 ? 0 : 1;
+    }
+
+    std::string text;
+    char num[32];
+    for (std::size_t c = 0; c < names.size(); ++c) { text += (c > 0 ? "," : "") + names[c]; }
+    text.push_back('\n');
+    for (uint64_t k = 0; k < in.rows; ++k)
+    {
+        for (std::size_t c = 0; c < columns.size(); ++c)
+        {
+            if (c > 0) { text.push_back(','); }
+            if (!std::isnan(columns[c][k]))
+            {
+                const std::to_chars_result r = std::to_chars(num, num + sizeof(num), columns[c][k]);
+                text.append(num, r.ptr - num);
+            }
+        }
+        text.push_back('\n');
+        if (text.size() >= opt.chunk || k + 1 == in.rows)
+        {
+            std::fwrite(text.data(), 1, text.size(), out);
+            text.clear();
+        }
+    }
+    if (in.rows == 0) { std::fwrite(text.data(), 1, text.size(), out); }
+    return 0;
+}
+
+static void Setup(const int method)
+{
+    if (method == ColumnarGERG) { SetupGERG(); }
+    else if (method == ColumnarDetail) { SetupDetail(); }
+    else { SetupGross(); }
+}
+
+int main(int argc, char **argv)
+{
+    CalcOptions opt;
+    if (!ParseOptions(argc, argv, opt))
+    {
+        Usage(argv[0]);
+        return 2;
+    }
+    FILE *in = std::strcmp(opt.input, "-") == 0 ? stdin : std::fopen(opt.input, "rb");
+    if (!in) { fprintf(stderr, "Cannot read %s\n", opt.input); return 2; }
+    FILE *out = std::strcmp(opt.output, "-") == 0 ? stdout : std::fopen(opt.output, "wb");
+    if (!out) { fprintf(stderr, "Cannot write %s\n", opt.output); return 2; }
+    const int threads = opt.threads > 0 ? opt.threads : std::max(1, (int)std::thread::hardware_concurrency());
+
+    // Columnar input, recognized by its magic number
+    if (in != stdin)
+    {
+        char magic[sizeof(ColumnarMagic)];
+        const std::size_t n = std::fread(magic, 1, sizeof(magic), in);
+        std::rewind(in);
+        if (IsColumnar(magic, n))
+        {
+            std::fclose(in);
+            if (opt.format < 0) { opt.format = FormatColumnar; }
+            Setup(opt.method);
+            int status = RunColumnar(opt, threads, out);
+            if (std::ferror(out) && status == 0) { status = 1; }
+            if (out != stdout && std::fclose(out) != 0 && status == 0) { status = 1; }
+            if (status == 1) { fprintf(stderr, "Write error\n"); }
+            if (status == 0) { fprintf(stderr, "%lld lines, %lld with an error\n", (long long)rowCount, (long long)errorCount); }
+            return status;
+        }
+    }
+    if (opt.format < 0) { opt.format = FormatCSV; }
+
+    // Header
+    std::string header;
+    for (int c; (c = std::fgetc(in)) != EOF && c != '\n';) { header.push_back((char)c); }
+    CalcColumns cols;
+    if (!FindColumns(header, opt, cols)) { return 2; }
+    while (!header.empty() && header.back() == '\r') { header.pop_back(); }
+    for (const int p : opt.props) { header += std::string(",") + ColumnarProperties[p].name; }
+    header += ",ierr\n";
+    if (opt.format == FormatCSV) { std::fwrite(header.data(), 1, header.size(), out); }
+
+    Setup(opt.method);
+
+    const long long maxInFlight = 2 * threads + 2;
+    std::mutex m;
+    std::condition_variable cv;
+    std::deque<CalcBlock> todo;
+    std::map<long long, CalcBlock> done;
+    long long inFlight = 0, nBlocks = 0;
+    bool eof = false;
+
+    // Reader: blocks of whole lines, at most maxInFlight of them read and not yet written
+    std::thread reader([&]()
+    {
+        std::string carry;
+        for (long long seq = 0;; ++seq)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m);
+                cv.wait(lock, [&] { return inFlight < maxInFlight; });
+            }
+            CalcBlock b;
+            b.seq = seq;
+            b.in.swap(carry);
+            const std::size_t kept = b.in.size();
+            b.in.resize(kept + opt.chunk);
+            const std::size_t n = std::fread(&b.in[kept], 1, opt.chunk, in);
+            b.in.resize(kept + n);
+            if (n > 0)
+            {
+                const std::size_t last = b.in.rfind('\n');
+                if (last == std::string::npos || last < kept) { carry.swap(b.in); --seq; continue; }
+                carry.assign(b.in, last + 1, std::string::npos);
+                b.in.resize(last + 1);
+            }
+            std::lock_guard<std::mutex> lock(m);
+            if (n == 0)
+            {
+                if (!b.in.empty()) { todo.push_back(std::move(b)); ++inFlight; ++seq; }
+                nBlocks = seq;
+                eof = true;
+                cv.notify_all();
+                return;
+            }
+            todo.push_back(std::move(b));
+            ++inFlight;
+            cv.notify_all();
+        }
+    });
+
+    // Workers
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t)
+    {
+        pool.emplace_back([&]()
+        {
+            for (;;)
+            {
+                CalcBlock b;
+                {
+                    std::unique_lock<std::mutex> lock(m);
+                    cv.wait(lock, [&] { return !todo.empty() || eof; });
+                    if (todo.empty()) { return; }
+                    b = std::move(todo.front());
+                    todo.pop_front();
+                }
+                EvaluateBlock(opt, cols, b);
+                std::lock_guard<std::mutex> lock(m);
+                const long long seq = b.seq;
+                done.emplace(seq, std::move(b));
+                cv.notify_all();
+            }
+        });
+    }
+
+    // Writer: the blocks in input order, as text or appended to the columns of a columnar output
+    std::vector<std::string> names(InputNamesColumnar, InputNamesColumnar + NInputsColumnar);
+    for (const int p : opt.props) { names.push_back(ColumnarProperties[p].name); }
+    names.push_back("ierr");
+    std::vector<std::vector<double>> columns(opt.format == FormatColumnar ? names.size() : 0);
+    for (long long next = 0;; ++next)
+    {
+        CalcBlock b;
+        {
+            std::unique_lock<std::mutex> lock(m);
+            cv.wait(lock, [&] { return done.count(next) > 0 || (eof && next >= nBlocks); });
+            if (eof && next >= nBlocks) { break; }
+            b = std::move(done[next]);
+            done.erase(next);
+        }
+        if (opt.format == FormatCSV) { std::fwrite(b.out.data(), 1, b.out.size(), out); }
+        for (std::size_t k = 0; k < b.values.size(); ++k) { columns[k % columns.size()].push_back(b.values[k]); }
+        std::lock_guard<std::mutex> lock(m);
+        --inFlight;
+        cv.notify_all();
+    }
+    reader.join();
+    for (std::thread &th : pool) { th.join(); }
+    if (opt.format == FormatColumnar)
+    {
+        int ierr;
+        const char *herr;
+        std::vector<const double *> pointers;
+        for (const std::vector<double> &c : columns) { pointers.push_back(c.data()); }
+        WriteColumnar(out, names, pointers, columns[0].size(), ierr, herr);
+    }
+
+    const bool failed = std::ferror(in) || std::ferror(out);
+    if (in != stdin) { std::fclose(in); }
+    if (out != stdout && std::fclose(out) != 0) { fprintf(stderr, "Write error\n"); return 1; }
+    if (failed) { fprintf(stderr, "Read or write error\n"); return 1; }
+    fprintf(stderr, "%lld lines, %lld with an error\n", (long long)rowCount, (long long)errorCount);
+    return 0;
+}
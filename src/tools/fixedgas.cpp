@@ -0,0 +1,183 @@
+/**
+ * @file fixedgas.cpp
+ * @brief aga8-fixedgas: generate the GERG-2008 constants of one fixed composition as a C++ header
+ *
+ * Usage: aga8-fixedgas <namespace> <output.h> <x1> ... <x21>
+ *
+ * x1 to x21 are the mole fractions in the order of GERG2008.cpp (methane, nitrogen, carbon dioxide,
+ * ..., helium, argon). The header defines, in the given namespace, a struct Gas holding the folded
+ * terms from PrepareFixedGasGERG and the functions
+ *   DensityFixedGas(T, P, D, ierr, herr)
+ *   PressureFixedGas(T, D, P, Z)
+ *   PropertiesFixedGas(T, D, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf)
+ * which only need FixedGasGERG.h. See aga8_fixedgas_header() in CMakeLists.txt.
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "GERG2008.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+static const char *ComponentNames[21 + 1] = {"", "methane", "nitrogen", "carbon_dioxide", "ethane", "propane",
+                                             "isobutane", "n_butane", "isopentane", "n_pentane", "n_hexane",
+                                             "n_heptane", "n_octane", "n_nonane", "n_decane", "hydrogen", "oxygen",
+                                             "carbon_monoxide", "water", "hydrogen_sulfide", "helium", "argon"};
+
+// Writes "static constexpr <type> <name>[] = {...};", with one element when n = 0 (arrays cannot be empty)
+template <typename T>
+static void WriteArray(FILE *f, const char *type, const char *name, const T *v, int n, const char *fmt)
+{
+    fprintf(f, "    static constexpr %s %s[] = {", type, name);
+    for (int k = 0; k < n; ++k)
+    {
+        fprintf(f, k % 4 == 0 ? "\n        " : " ");
+        fprintf(f, fmt, v[k]);
+        fprintf(f, ",");
+    }
+    fprintf(f, n == 0 ? "0};\n" : "\n    };\n");
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 3 + 21)
+    {
+        fprintf(stderr, "Usage: %s <namespace> <output.h> <x1> ... <x21>\n", argv[0]);
+        return 2;
+    }
+    const std::string name = argv[1];
+    std::vector<double> x(21 + 1, 0);
+    double sum = 0;
+    for (int i = 1; i <= 21; ++i)
+    {
+        char *end;
+        x[i] = std::strtod(argv[2 + i], &end);
+        if (*end != 0 || x[i] < 0)
+        {
+            fprintf(stderr, "Invalid mole fraction for %s: %s\n", ComponentNames[i], argv[2 + i]);
+            return 2;
+        }
+        sum += x[i];
+    }
+    if (std::abs(sum - 1) > 1e-6)
+    {
+        fprintf(stderr, "The mole fractions sum to %.10g instead of 1\n", sum);
+        return 2;
+    }
+
+    SetupGERG();
+    static FixedGasTermsGERG fg;
+    PrepareFixedGasGERG(x, fg);
+
+    // Distinct tau exponents, so that each tau^t is only calculated once per temperature
+    std::vector<double> tTau;
+    auto tindex = [&tTau](const double t) {
+        for (std::size_t j = 0; j < tTau.size(); ++j)
+        {
+            if (tTau[j] == t) { return (int)j; }
+        }
+        tTau.push_back(t);
+        return (int)tTau.size() - 1;
+    };
+    std::vector<int> iPol(fg.npol), iExp(fg.nexp), iGauss(fg.ngauss);
+    for (int k = 0; k < fg.npol; ++k) { iPol[k] = tindex(fg.tpol[k]); }
+    for (int k = 0; k < fg.nexp; ++k) { iExp[k] = tindex(fg.texp[k]); }
+    for (int k = 0; k < fg.ngauss; ++k) { iGauss[k] = tindex(fg.tgauss[k]); }
+
+    // Groups of exponential terms with the same (d, c) exponents, summed on an isotherm
+    std::vector<int> dExpGroup, cExpGroup, gExp(fg.nexp);
+    for (int k = 0; k < fg.nexp; ++k)
+    {
+        std::size_t g = 0;
+        while (g < dExpGroup.size() && (dExpGroup[g] != fg.dexp[k] || cExpGroup[g] != fg.cexp[k])) { ++g; }
+        if (g == dExpGroup.size())
+        {
+            dExpGroup.push_back(fg.dexp[k]);
+            cExpGroup.push_back(fg.cexp[k]);
+        }
+        gExp[k] = (int)g;
+    }
+
+    // exp(g) of the departure terms is folded into their coefficients
+    std::vector<double> aGauss(fg.ngauss);
+    for (int k = 0; k < fg.ngauss; ++k) { aGauss[k] = fg.agauss[k] * std::exp(fg.ggauss[k]); }
+
+    FILE *f = fopen(argv[2], "w");
+    if (!f)
+    {
+        fprintf(stderr, "Cannot write %s\n", argv[2]);
+        return 1;
+    }
+    const char *g = "%.17g";
+    fprintf(f, "// Generated by aga8-fixedgas from the GERG-2008 coefficients, do not edit.\n");
+    fprintf(f, "// Composition (mole fractions):");
+    for (int i = 1; i <= 21; ++i)
+    {
+        if (x[i] != 0) { fprintf(f, " %s=%.17g", ComponentNames[i], x[i]); }
+    }
+    fprintf(f, "\n#ifndef AGA8_FIXEDGAS_%s_H_\n#define AGA8_FIXEDGAS_%s_H_\n\n", name.c_str(), name.c_str());
+    fprintf(f, "#include \"FixedGasGERG.h\"\n\nnamespace %s\n{\n\nstruct Gas\n{\n", name.c_str());
+    fprintf(f, "    static constexpr double R = %.17g, Mm = %.17g;\n", fg.R, fg.Mm);
+    fprintf(f, "    static constexpr double Tr = %.17g, Dr = %.17g, Tcx = %.17g, Dcx = %.17g;\n", fg.Tr, fg.Dr, fg.Tcx, fg.Dcx);
+    fprintf(f, "    static constexpr double Sumx = %.17g, SumxLnx = %.17g;\n", fg.Sumx, fg.SumxLnx);
+    fprintf(f, "    static constexpr double n01 = %.17g, n02 = %.17g, n03 = %.17g;\n", fg.n01, fg.n02, fg.n03);
+    fprintf(f, "    static constexpr int NHyp = %d;\n", fg.nhyp);
+    WriteArray(f, "int", "sinhHyp", fg.sinhhyp, fg.nhyp, "%d");
+    WriteArray(f, "double", "aHyp", fg.ahyp, fg.nhyp, g);
+    WriteArray(f, "double", "thHyp", fg.thhyp, fg.nhyp, g);
+    fprintf(f, "    static constexpr int NTau = %d;\n", (int)tTau.size());
+    WriteArray(f, "double", "tTau", tTau.data(), (int)tTau.size(), g);
+    fprintf(f, "    static constexpr int NPol = %d;\n", fg.npol);
+    WriteArray(f, "int", "dPol", fg.dpol, fg.npol, "%d");
+    WriteArray(f, "int", "iPol", iPol.data(), fg.npol, "%d");
+    WriteArray(f, "double", "aPol", fg.apol, fg.npol, g);
+    fprintf(f, "    static constexpr int NExp = %d;\n", fg.nexp);
+    WriteArray(f, "int", "dExp", fg.dexp, fg.nexp, "%d");
+    WriteArray(f, "int", "cExp", fg.cexp, fg.nexp, "%d");
+    WriteArray(f, "int", "iExp", iExp.data(), fg.nexp, "%d");
+    WriteArray(f, "int", "gExp", gExp.data(), fg.nexp, "%d");
+    WriteArray(f, "double", "aExp", fg.aexp, fg.nexp, g);
+    fprintf(f, "    static constexpr int NExpGroup = %d;\n", (int)dExpGroup.size());
+    WriteArray(f, "int", "dExpGroup", dExpGroup.data(), (int)dExpGroup.size(), "%d");
+    WriteArray(f, "int", "cExpGroup", cExpGroup.data(), (int)cExpGroup.size(), "%d");
+    fprintf(f, "    static constexpr int NGauss = %d;\n", fg.ngauss);
+    WriteArray(f, "int", "dGauss", fg.dgauss, fg.ngauss, "%d");
+    WriteArray(f, "int", "iGauss", iGauss.data(), fg.ngauss, "%d");
+    WriteArray(f, "double", "cGauss", fg.cgauss, fg.ngauss, g);
+    WriteArray(f, "double", "eGauss", fg.egauss, fg.ngauss, g);
+    WriteArray(f, "double", "aGauss", aGauss.data(), fg.ngauss, g);
+    fprintf(f, "};\n\n");
+
+    fprintf(f, "inline void MolarMassFixedGas(double &Mm) { Mm = Gas::Mm; }\n\n");
+    fprintf(f, "inline void DensityFixedGas(const double T, const double P, double &D, int &ierr, const char *&herr)\n{\n");
+    fprintf(f, "    DensityFixedGasGERG<Gas>(T, P, D, ierr, herr);\n}\n\n");
+    fprintf(f, "inline void PressureFixedGas(const double T, const double D, double &P, double &Z)\n{\n");
+    fprintf(f, "    FixedGasTauGERG<Gas> tt;\n    FixedGasIsothermGERG<Gas> iso;\n    double dPdD;\n");
+    fprintf(f, "    TauTermsFixedGasGERG<Gas>(T, tt);\n    IsothermFixedGasGERG<Gas>(tt, iso);\n");
+    fprintf(f, "    PressureFixedGasGERG<Gas>(iso, D, P, Z, dPdD);\n}\n\n");
+    fprintf(f, "inline void PropertiesFixedGas(const double T, const double D, double &P, double &Z, double &dPdD, double &d2PdD2, double &d2PdTD, double &dPdT, double &U, double &H, double &S, double &Cv, double &Cp, double &W, double &G, double &JT, double &Kappa, double &A, double &Cf)\n{\n");
+    fprintf(f, "    PropertiesFixedGasGERG<Gas>(T, D, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf);\n}\n\n");
+    fprintf(f, "} // namespace %s\n\n#endif\n", name.c_str());
+    fclose(f);
+    return 0;
+}
@@ -0,0 +1,238 @@
+/**
+ * @file float32report.cpp
+ * @brief aga8-float32-report: error of the single-precision batch mode against the double functions
+ *
+ * Usage: aga8-float32-report <compositions.csv> [report.md]
+ *
+ * The compositions are read from a CSV file in the format of src/examples/NG_Compositions.csv (a
+ * header line, then the 21 mole percents of each gas in the order of GERG2008.cpp) and normalized.
+ * Each one is evaluated on a grid of temperatures and pressures with PropertiesBatchFloatGERG and
+ * PropertiesBatchFloatDetail, at the densities from DensityGERG and DensityDetail, and compared
+ * with PropertiesGERG and PropertiesDetail. The report, written in Markdown to the given file or to
+ * the standard output, gives the median, 99th percentile and maximum error of each property, and
+ * the state of the maximum. See the float32-report target in CMakeLists.txt.
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "Detail.h"
+#include "Float32.h"
+#include "GERG2008.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Grid of each composition: NT temperatures from Tmin to Tmax, NP pressures from Pmin to Pmax (logarithmic)
+static const int NT = 11, NP = 12;
+static const double Tmin = 200, Tmax = 450, Pmin = 100, Pmax = 30000;
+
+// Scale of the errors: relative, divided by R*T (energies), by R (entropy), or by max(|JT|, 1e-4 K/kPa)
+enum ErrorScale { Relative, PerRT, PerR, JouleThomson };
+
+struct ReportProperty
+{
+    const char *name;
+    ErrorScale scale;
+    bool detail;                 // Also an output of PropertiesDetail
+};
+
+static const ReportProperty Properties[] = {
+    {"P", Relative, true}, {"Z", Relative, true}, {"dPdD", Relative, true}, {"dPdT", Relative, true},
+    {"U", PerRT, true}, {"H", PerRT, true}, {"S", PerR, true}, {"G", PerRT, true}, {"A", PerRT, false},
+    {"Cv", Relative, true}, {"Cp", Relative, true}, {"W", Relative, true}, {"JT", JouleThomson, true},
+    {"Kappa", Relative, true}, {"Cf", Relative, true}};
+static const int NProps = sizeof(Properties) / sizeof(Properties[0]);
+
+static const char *ScaleNames[] = {"relative", "/ RT", "/ R", "relative, to at least 1e-4 K/kPa"};
+
+// Largest error of a property so far, and where it occurred
+struct WorstCase
+{
+    double err = -1, T = 0, P = 0;
+    int composition = 0;
+};
+
+static bool ReadCompositions(const char *path, std::vector<std::vector<double>> &xs)
+{
+    FILE *f = std::fopen(path, "r");
+    if (!f) { return false; }
+    char line[4096];
+    bool header = true;
+    while (std::fgets(line, sizeof(line), f))
+    {
+        if (header) { header = false; continue; }
+        std::vector<double> x(21 + 1, 0);
+        char *p = line, *end;
+        double sum = 0;
+        int i = 1;
+        for (; i <= 21; ++i)
+        {
+            x[i] = std::strtod(p, &end);
+            if (end == p || x[i] < 0) { break; }
+            sum += x[i];
+            p = end;
+            if (*p == ',') { ++p; }
+        }
+        if (i <= 21 || sum <= 0) { continue; }
+        for (i = 1; i <= 21; ++i) { x[i] /= sum; }
+        xs.push_back(x);
+    }
+    std::fclose(f);
+    return true;
+}
+
+static double Scaled(const ErrorScale scale, const double f, const double d, const double T)
+{
+    const double err = std::abs(f - d);
+    switch (scale)
+    {
+    case PerRT: return err / (8.314 * T);
+    case PerR: return err / 8.314;
+    case JouleThomson: return err / std::max(std::abs(d), 1e-4);
+    default: return err / std::max(std::abs(d), 1e-300);
+    }
+}
+
+static double Percentile(std::vector<double> &v, const double q)
+{
+    if (v.empty()) { return 0; }
+    const std::size_t k = std::min(v.size() - 1, (std::size_t)(q * (v.size() - 1) + 0.5));
+    std::nth_element(v.begin(), v.begin() + k, v.end());
+    return v[k];
+}
+
+// Evaluate all the compositions with one equation and write its section of the report
+static void ReportEquation(FILE *out, const bool detail, const std::vector<std::vector<double>> &xs)
+{
+    std::vector<std::vector<double>> errors(NProps);
+    std::vector<WorstCase> worst(NProps);
+    std::vector<float> Tf, Df;
+    std::vector<double> Ts, Ps, Ds;
+    PropertiesFloat pf;
+    long long failed = 0, unstable = 0;
+
+    for (std::size_t c = 0; c < xs.size(); ++c)
+    {
+        const std::vector<double> &x = xs[c];
+        Tf.clear();
+        Df.clear();
+        Ts.clear();
+        Ps.clear();
+        Ds.clear();
+        for (int iT = 0; iT < NT; ++iT)
+        {
+            for (int iP = 0; iP < NP; ++iP)
+            {
+                const double T = Tmin + (Tmax - Tmin) * iT / (NT - 1);
+                const double P = Pmin * std::pow(Pmax / Pmin, (double)iP / (NP - 1));
+                double D = 0;
+                int ierr;
+                const char *herr;
+                if (detail) { DensityDetail(T, P, x, D, ierr, herr); }
+                else { DensityGERG(0, T, P, x, D, ierr, herr); }
+                if (ierr != 0) { ++failed; continue; }
+                Ts.push_back(T);
+                Ps.push_back(P);
+                Ds.push_back(D);
+                Tf.push_back((float)T);
+                Df.push_back((float)D);
+            }
+        }
+
+        if (detail) { PropertiesBatchFloatDetail(Tf, Df, x, pf); }
+        else { PropertiesBatchFloatGERG(Tf, Df, x, pf); }
+
+        for (std::size_t k = 0; k < Ts.size(); ++k)
+        {
+            const double T = Ts[k], D = Ds[k];
+            double v[NProps], d2PdD2, d2PdTD, A = 0;
+            if (detail) { PropertiesDetail(T, D, x, v[0], v[1], v[2], d2PdD2, d2PdTD, v[3], v[4], v[5], v[6], v[9], v[10], v[11], v[7], v[12], v[13], v[14]); }
+            else { PropertiesGERG(T, D, x, v[0], v[1], v[2], d2PdD2, d2PdTD, v[3], v[4], v[5], v[6], v[9], v[10], v[11], v[7], v[12], v[13], A, v[14]); }
+            v[8] = A;
+            if (!(v[2] > 0 && v[9] > 0 && v[10] > 0)) { ++unstable; continue; }
+            const float f[NProps] = {pf.P[k], pf.Z[k], pf.dPdD[k], pf.dPdT[k], pf.U[k], pf.H[k], pf.S[k], pf.G[k], pf.A[k],
+                                     pf.Cv[k], pf.Cp[k], pf.W[k], pf.JT[k], pf.Kappa[k], pf.Cf[k]};
+            for (int p = 0; p < NProps; ++p)
+            {
+                if (detail && !Properties[p].detail) { continue; }
+                const double err = Scaled(Properties[p].scale, f[p], v[p], T);
+                errors[p].push_back(err);
+                if (!(err <= worst[p].err))
+                {
+                    worst[p].err = err;
+                    worst[p].T = T;
+                    worst[p].P = Ps[k];
+                    worst[p].composition = (int)c + 1;
+                }
+            }
+        }
+    }
+
+    const std::size_t n = errors[0].size();
+    fprintf(out, "## %s\n\n", detail ? "DETAIL" : "GERG-2008");
+    fprintf(out, "%zu states. Skipped: %lld without a converged density, %lld inside the 2-phase region ", n, failed, unstable);
+    fprintf(out, "(dP/dD, Cv or Cp <= 0 in double).\n\n");
+    fprintf(out, "| Property | Error | Median | 99th percentile | Maximum | At T (K) | At P (kPa) | Composition |\n");
+    fprintf(out, "|---|---|---|---|---|---|---|---|\n");
+    for (int p = 0; p < NProps; ++p)
+    {
+        if (detail && !Properties[p].detail) { continue; }
+        const double median = Percentile(errors[p], 0.5), p99 = Percentile(errors[p], 0.99);
+        fprintf(out, "| %s | %s | %.1e | %.1e | %.1e | %g | %.4g | %d |\n", Properties[p].name, ScaleNames[Properties[p].scale],
+                median, p99, worst[p].err, worst[p].T, worst[p].P, worst[p].composition);
+    }
+    fprintf(out, "\n");
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 2 && argc != 3)
+    {
+        fprintf(stderr, "Usage: %s <compositions.csv> [report.md]\n", argv[0]);
+        return 2;
+    }
+    std::vector<std::vector<double>> xs;
+    if (!ReadCompositions(argv[1], xs) || xs.empty())
+    {
+        fprintf(stderr, "No composition read from %s\n", argv[1]);
+        return 2;
+    }
+    FILE *out = argc == 3 ? std::fopen(argv[2], "w") : stdout;
+    if (!out)
+    {
+        fprintf(stderr, "Cannot write %s\n", argv[2]);
+        return 2;
+    }
+
+    SetupGERG();
+    SetupDetail();
+    fprintf(out, "# Single-precision batch mode: error against the double functions\n\n");
+    fprintf(out, "%zu compositions from %s, %d temperatures from %g to %g K and %d pressures from %g to %g kPa (logarithmic), ",
+            xs.size(), argv[1], NT, Tmin, Tmax, NP, Pmin, Pmax);
+    fprintf(out, "at the densities of DensityGERG (iFlag 0) and DensityDetail. Composition is the line number in the file, ");
+    fprintf(out, "header excluded.\n\n");
+    ReportEquation(out, false, xs);
+    ReportEquation(out, true, xs);
+    if (out != stdout) { std::fclose(out); }
+    return 0;
+}
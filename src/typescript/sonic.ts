@@ -29,6 +29,7 @@ import type {
   BmixResult,
   GrossMethod1Result,
   GrossMethod2Result,
+  SonicNozzleResult,
 } from "./aga8.js";
 import _AGA8wasm from "./aga8.js";
 import { Polyfit, type NumberArray } from "@sctg/polyfitjs";
@@ -332,6 +333,8 @@ export type MassFlowRate = {
   M: number; // Molar mass
   kappa: number; // Isentropic exponent
   Cf: number; //	Critical Flow coefficient
+  Cstar: number; // Real-gas critical flow function C* (ISO 9300), NaN if the throat solve failed
+  CstarErr: number; // Error code of the throat solve (0 = successful), the row has no flow rate otherwise
 };
 /**
  * Compute the discharge coefficient for a toroidal nozzle given the Reynolds number
@@ -359,6 +362,68 @@ export function getMaximalOutletPressure(
   return p_crit;
 }
 
+/**
+ * Compute the throat diameter of a toroidal sonic nozzle passing a target mass flow rate
+ * The discharge coefficient is the one of getThoroidalNozzleDischargeCoefficient at the throat Reynolds number,
+ * and the critical flow function the real-gas C* at the inlet state (ISO 9300)
+ * @param propertiesMethod - Method to compute properties ("DETAIL" or "GERG-2008")
+ * @param gasMixture - Gas mixture composition
+ * @param massFlowRate - Target mass flow rate in kg/s
+ * @param inletPressure - Inlet pressure in kPa
+ * @param outletPressure - Outlet pressure in kPa, the flow must be choked
+ * @param temperature - Inlet temperature in K
+ * @param viscosity - Dynamic viscosity of the gas at the inlet in Pa·s
+ * @param AGA8 - AGA8 module or undefined to load it
+ * @returns {SonicNozzleResult} - Throat diameter in mm (d), Cd, Re, C* and error flag
+ */
+export async function getSonicNozzleDiameter(
+  propertiesMethod: Method,
+  gasMixture: GasMixture,
+  massFlowRate: number,
+  inletPressure: number,
+  outletPressure: number,
+  temperature: number,
+  viscosity: number,
+  AGA8?: MainModule
+): Promise<SonicNozzleResult> {
+  if (AGA8 === undefined) {
+    AGA8 = await AGA8wasm();
+  }
+  const method = propertiesMethod === "DETAIL" ? 1 : 0;
+  if (method === 1) { AGA8.SetupDetail(); } else { AGA8.SetupGERG(); }
+  return AGA8.SonicNozzleDiameter(method, gasMixture, massFlowRate, temperature, inletPressure, outletPressure, viscosity);
+}
+
+/**
+ * Compute the inlet pressure of a toroidal sonic nozzle of known diameter passing a target mass flow rate
+ * @param propertiesMethod - Method to compute properties ("DETAIL" or "GERG-2008")
+ * @param gasMixture - Gas mixture composition
+ * @param massFlowRate - Target mass flow rate in kg/s
+ * @param orificeDiameter - Throat diameter in mm
+ * @param outletPressure - Outlet pressure in kPa, the flow must be choked
+ * @param temperature - Inlet temperature in K
+ * @param viscosity - Dynamic viscosity of the gas at the inlet in Pa·s
+ * @param AGA8 - AGA8 module or undefined to load it
+ * @returns {SonicNozzleResult} - Inlet pressure in kPa (P0), Cd, Re, C* and error flag
+ */
+export async function getSonicNozzleInletPressure(
+  propertiesMethod: Method,
+  gasMixture: GasMixture,
+  massFlowRate: number,
+  orificeDiameter: number,
+  outletPressure: number,
+  temperature: number,
+  viscosity: number,
+  AGA8?: MainModule
+): Promise<SonicNozzleResult> {
+  if (AGA8 === undefined) {
+    AGA8 = await AGA8wasm();
+  }
+  const method = propertiesMethod === "DETAIL" ? 1 : 0;
+  if (method === 1) { AGA8.SetupDetail(); } else { AGA8.SetupGERG(); }
+  return AGA8.SonicNozzlePressure(method, gasMixture, massFlowRate, temperature, orificeDiameter, outletPressure, viscosity);
+}
+
 /**
 * Compute the mass flow rate through a sonic nozzle at sonic conditions
 * @param propertiesMethod - Method to compute properties
@@ -425,40 +490,57 @@ export async function getMassFlowRateDataset(
       ? AGA8.DensityDetail(temperature, 101.325, gasMixture)
       : AGA8.DensityGERG(2, temperature, 101.325, gasMixture); // mol/l
   const rho_1atm = D_1atm * 1000 * molarMassSI; // kg/m³
+  const pressures = new Float64Array(datasetSteps);
+  for (let i = 0; i < datasetSteps; i++) {
+    pressures[i] = minPressure + (i * (maxPressure - minPressure)) / datasetSteps;
+  }
+  // Real-gas critical flow functions C* (ISO 9300) of the whole curve, each throat solve starting from the previous one
+  const CriticalFlowBatchFunction =
+    propertiesMethod === "DETAIL" ? AGA8.CriticalFlowBatchDetail : AGA8.CriticalFlowBatchGERG;
+  const criticalFlow = CriticalFlowBatchFunction(
+    new Float64Array(datasetSteps).fill(temperature),
+    pressures,
+    gasMixture
+  );
   for (let i = 0; i < datasetSteps; i++) {
-    const P = minPressure + (i * (maxPressure - minPressure)) / datasetSteps;
+    const P = pressures[i];
     const { D } =
       propertiesMethod === "DETAIL"
         ? AGA8.DensityDetail(temperature, P, gasMixture)
         : AGA8.DensityGERG(2, temperature, P, gasMixture); // mol/l
     properties = PropertiesFunction(temperature, D, gasMixture);
-    // Extract critical flow factor (Cf)
-    const Cf = properties.Cf;
+    // Real-gas critical flow function and throat pressure, NaN where the throat solve failed
+    const CstarErr = criticalFlow.ierr[i];
+    const Cstar = CstarErr === 0 ? criticalFlow.Cstar[i] : NaN;
+    const Pt = CstarErr === 0 ? criticalFlow.P[i] : NaN; // kPa
     /** Specific gas constant */
     const Rs = R / molarMassSI; // J/(kg·K)
     // Nozzle specific coefficient
-    const Kn = (Cd * Cf * (P * 1000)) / Math.sqrt(Rs * temperature);
+    const Kn = (Cd * Cstar * (P * 1000)) / Math.sqrt(Rs * temperature);
     // Calculate mass flow rate
-    // Q = Cd * Cf * A * P / sqrt(Rs * T)
+    // Q = Cd * C* * A * P / sqrt(Rs * T)
     // Q = Kn * A
 
-    const massFlow = getMaximalOutletPressure(P, Cf) < outletPressure ? NaN : Kn * A; // kg/s
+    // The flow is choked while the outlet pressure stays below the throat pressure
+    const massFlow = !(Pt >= outletPressure) ? NaN : Kn * A; // kg/s
     output.push({
       massFlowRate: massFlow,
       volumeFlowRateAtOutputPressure: massFlow / rho_out,
       volumeFlowRateAt1atm: massFlow / rho_1atm,
       temperature,
       pressure: P,
-      crticalPresure: getMaximalOutletPressure(P, Cf),
+      crticalPresure: Pt,
       specificNozzleCoefficient: Kn,
       kappa: properties.Kappa,
       Cf: properties.Cf,
+      Cstar,
+      CstarErr,
       M: molarMassSI
     });
     //Kn is used for computing the diameter knowing the mass flow rate
     // A = Q / Kn
     // ∏ * (D/2)^2 = Q / Kn
-    // D = sqrt(4 * Q / (Kn * ∏))
+    // D = sqrt(4 * Q / (Kn * ∏)), see getSonicNozzleDiameter for the Reynolds-dependent Cd
   }
   console.warn(
     `Mass flow rate at mid range: ${output[
@@ -528,6 +610,7 @@ export type {
   BmixResult,
   GrossMethod1Result,
   GrossMethod2Result,
+  SonicNozzleResult,
 };
 
 export function AGA8wasm() { return _AGA8wasm(); };
\ No newline at end of file
@@ -0,0 +1,92 @@
+/**
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+import { describe, expect, test } from '@jest/globals';
+import { AGA8wasm, type GasMixture } from '../dist/index.js';
+import { testGas } from './fixtures.js';
+
+describe('Columnar binary datasets', () => {
+  const x: GasMixture = testGas;
+  const components = Object.keys(x) as (keyof GasMixture)[];
+  const n = 20;
+
+  function dataset() {
+    const names = [...components, 'T', 'P'];
+    const columns = names.map(() => new Float64Array(n));
+    for (let k = 0; k < n; k++) {
+      components.forEach((c, i) => (columns[i][k] = x[c]));
+      columns[21][k] = 260 + 5 * k;
+      columns[22][k] = 500 + 400 * k;
+    }
+    return { names, columns };
+  }
+
+  test('WriteColumnar and ReadColumnar round trip with the documented header', async () => {
+    const AGA8 = await AGA8wasm();
+    const { names, columns } = dataset();
+    const { bytes, ierr } = AGA8.WriteColumnar(names, columns);
+    expect(ierr).toBe(0);
+    expect(bytes).toBeInstanceOf(Uint8Array);
+
+    const header = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+    expect(new TextDecoder().decode(bytes.subarray(0, 7))).toBe('AGA8COL');
+    expect(header.getUint32(8, true)).toBe(1);
+    expect(header.getUint32(12, true)).toBe(23);
+    expect(Number(header.getBigUint64(16, true))).toBe(n);
+    const offset = Number(header.getBigUint64(24, true));
+    expect(offset % 64).toBe(0);
+    expect(bytes.length).toBe(offset + 23 * n * 8);
+    expect(new Float64Array(bytes.buffer, bytes.byteOffset + offset + 22 * n * 8, n)).toEqual(columns[22]);
+
+    const table = AGA8.ReadColumnar(bytes);
+    expect(table.ierr).toBe(0);
+    expect(table.rows).toBe(n);
+    expect(table.names).toEqual(names);
+    expect(table.columns.T).toEqual(columns[21]);
+    expect(table.columns.hydrogen_sulfide).toEqual(columns[18]);
+
+    expect(AGA8.ReadColumnar(bytes.subarray(0, bytes.length - 8)).ierr).toBe(4);
+    expect(AGA8.WriteColumnar(names, columns.slice(1)).ierr).toBe(1);
+  });
+
+  test('BatchColumnarGERG matches DensityGERG and PropertiesGERG', async () => {
+    const AGA8 = await AGA8wasm();
+    AGA8.SetupGERG();
+    const { names, columns } = dataset();
+    const input = AGA8.WriteColumnar(names, columns).bytes;
+    const r = AGA8.BatchColumnarGERG(input, ['D', 'W', 'Cf']);
+    expect(r.ierr).toBe(0);
+    expect(r.rows).toBe(n);
+    expect(r.failed).toBe(0);
+
+    const out = AGA8.ReadColumnar(r.bytes);
+    expect(out.names.slice(23)).toEqual(['D', 'W', 'Cf', 'ierr']);
+    for (let k = 0; k < n; k++) {
+      const D = AGA8.DensityGERG(0, columns[21][k], columns[22][k], x).D;
+      const ref = AGA8.PropertiesGERG(columns[21][k], D, x);
+      expect(out.columns.D[k]).toBeCloseTo(D, 12);
+      expect(out.columns.W[k]).toBeCloseTo(ref.W, 9);
+      expect(out.columns.Cf[k]).toBeCloseTo(ref.Cf, 12);
+      expect(out.columns.ierr[k]).toBe(0);
+    }
+
+    // A result evaluated again keeps its other outputs and replaces the recalculated ones
+    const again = AGA8.ReadColumnar(AGA8.BatchColumnarGERG(r.bytes, ['D']).bytes);
+    expect(again.names.slice(23)).toEqual(['W', 'Cf', 'D', 'ierr']);
+    expect(again.columns.D).toEqual(out.columns.D);
+
+    expect(AGA8.BatchColumnarGross(input, ['W']).ierr).toBe(7);
+  });
+});
@@ -0,0 +1,62 @@
+/**
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+import { describe, expect, test } from '@jest/globals';
+import { AGA8wasm, type GasMixture } from '../dist/index.js';
+import { testGas } from './fixtures.js';
+
+describe('CompositionDerivatives', () => {
+  const x: GasMixture = testGas;
+
+  test('GERG-2008 derivatives match finite differences of DensityGERG and PropertiesGERG', async () => {
+    const AGA8 = await AGA8wasm();
+    AGA8.SetupGERG();
+
+    const T = 300, P = 8000, h = 1e-6;
+    const r = AGA8.CompositionDerivativesGERG(T, P, x);
+    expect(r.ierr).toBe(0);
+    expect(r.dZdx.length).toBe(21);
+    expect(Math.abs(r.Z / AGA8.PropertiesGERG(T, r.D, x).Z - 1)).toBeLessThan(1e-13);
+
+    // Replacing methane by nitrogen and by ethane
+    for (const [component, i] of [['nitrogen', 1], ['ethane', 3]] as const) {
+      const xp = { ...x, [component]: x[component] + h };
+      const xm = { ...x, [component]: x[component] - h };
+      const Dp = AGA8.DensityGERG(0, T, P, xp).D, Dm = AGA8.DensityGERG(0, T, P, xm).D;
+      const Wp = AGA8.PropertiesGERG(T, Dp, xp).W, Wm = AGA8.PropertiesGERG(T, Dm, xm).W;
+      expect(Math.abs(r.dDdx[i] - (Dp - Dm) / (2 * h))).toBeLessThan(1e-4 * Math.abs(r.dDdx[i]));
+      expect(Math.abs(r.dWdx[i] - (Wp - Wm) / (2 * h))).toBeLessThan(1e-4 * Math.abs(r.dWdx[i]));
+    }
+  });
+
+  test('DETAIL batch matches the single-state derivatives', async () => {
+    const AGA8 = await AGA8wasm();
+    AGA8.SetupDetail();
+
+    const T = new Float64Array([250, 280, 300, 320]);
+    const P = new Float64Array([1000, 5000, 10000, 20000]);
+    const r = AGA8.CompositionDerivativesBatchDetail(T, P, x);
+    expect(r.dZdx.length).toBe(21 * T.length);
+    for (let k = 0; k < T.length; k++) {
+      const single = AGA8.CompositionDerivativesDetail(T[k], P[k], x);
+      expect(r.ierr[k]).toBe(0);
+      expect(r.D[k]).toBe(single.D);
+      for (let i = 0; i < 21; i++) {
+        expect(r.dZdx[21 * k + i]).toBe(single.dZdx[i]);
+        expect(r.dWdx[21 * k + i]).toBe(single.dWdx[i]);
+      }
+    }
+  });
+});
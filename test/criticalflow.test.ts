@@ -0,0 +1,56 @@
+/**
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+import { describe, expect, test } from '@jest/globals';
+import { AGA8wasm, type GasMixture } from '../dist/index.js';
+import { testGas } from './fixtures.js';
+
+describe('CriticalFlowFunction', () => {
+  const x: GasMixture = testGas;
+
+  test('GERG-2008 C* is above the ideal gas critical flow factor at high pressure', async () => {
+    const AGA8 = await AGA8wasm();
+    AGA8.SetupGERG();
+
+    const T0 = 293.15, P0 = 10000;
+    const r = AGA8.CriticalFlowFunctionGERG(T0, P0, x);
+    expect(r.ierr).toBe(0);
+    expect(r.P).toBeGreaterThan(0.4 * P0);
+    expect(r.P).toBeLessThan(0.7 * P0);
+
+    // The velocity from the enthalpy drop equals the speed of sound at the throat
+    const M = AGA8.MolarMassGERG(x);
+    const D0 = AGA8.DensityGERG(0, T0, P0, x).D;
+    const stagnation = AGA8.PropertiesGERG(T0, D0, x);
+    const throat = AGA8.PropertiesGERG(r.T, r.D, x);
+    const w = Math.sqrt((2000 * (stagnation.H - throat.H)) / M);
+    expect(Math.abs(w / throat.W - 1)).toBeLessThan(1e-6);
+    expect(r.Cstar).toBeGreaterThan(stagnation.Cf);
+  });
+
+  test('DETAIL pressure sweep as a batch matches the single throat solves', async () => {
+    const AGA8 = await AGA8wasm();
+    AGA8.SetupDetail();
+
+    const P0 = new Float64Array([500, 1000, 2000, 4000, 8000]);
+    const r = AGA8.CriticalFlowBatchDetail(new Float64Array(P0.length).fill(293.15), P0, x);
+    for (let i = 0; i < P0.length; i++) {
+      const single = AGA8.CriticalFlowFunctionDetail(293.15, P0[i], x);
+      expect(r.ierr[i]).toBe(0);
+      expect(Math.abs(r.Cstar[i] / single.Cstar - 1)).toBeLessThan(1e-9);
+      if (i > 0) expect(r.Cstar[i]).toBeGreaterThan(r.Cstar[i - 1]);
+    }
+  });
+});
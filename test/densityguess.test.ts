@@ -0,0 +1,47 @@
+/**
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+import { describe, expect, test } from '@jest/globals';
+import { AGA8wasm, type GasMixture } from '../dist/index.js';
+import { testGas } from './fixtures.js';
+
+describe('DensityGuess', () => {
+  const x: GasMixture = testGas;
+
+  test('GERG-2008 densities started from the grid match DensityGERG', async () => {
+    const AGA8 = await AGA8wasm();
+    AGA8.SetupGERG();
+
+    const built = AGA8.BuildDensityGuess(0, 0, x, 250, 350, 500, 12000, 32, 32);
+    expect(built.ierr).toBe(0);
+
+    // The last state is outside the grid
+    const T = new Float64Array([255.5, 280, 300.1, 333.3, 400]);
+    const P = new Float64Array([600, 2500, 7000, 11000, 5000]);
+    AGA8.ResetDensityGuessStats();
+    const r = AGA8.DensityGuessBatch(built.handle, T, P);
+    for (let i = 0; i < T.length; i++) {
+      const single = AGA8.DensityGERG(0, T[i], P[i], x);
+      expect(r.ierr[i]).toBe(single.ierr);
+      expect(Math.abs(Math.log(r.D[i] / single.D))).toBeLessThanOrEqual(1e-7);
+    }
+
+    const stats = AGA8.GetDensityGuessStats();
+    expect(stats.calls).toBe(5);
+    expect(stats.hits).toBe(4);
+    expect(stats.iterationsSaved).toBeGreaterThan(0);
+    AGA8.FreeDensityGuess(built.handle);
+  });
+});
@@ -0,0 +1,43 @@
+/**
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+import { type GasMixture } from '../dist/index.js';
+
+/**
+ * The 21-component natural gas of the tests, with every component present
+ */
+export const testGas: GasMixture = {
+  methane: 0.77824,
+  nitrogen: 0.02,
+  carbon_dioxide: 0.06,
+  ethane: 0.08,
+  propane: 0.03,
+  isobutane: 0.0015,
+  n_butane: 0.003,
+  isopentane: 0.0005,
+  n_pentane: 0.00165,
+  n_hexane: 0.00215,
+  n_heptane: 0.00088,
+  n_octane: 0.00024,
+  n_nonane: 0.00015,
+  n_decane: 0.00009,
+  hydrogen: 0.004,
+  oxygen: 0.005,
+  carbon_monoxide: 0.002,
+  water: 0.0001,
+  hydrogen_sulfide: 0.0025,
+  helium: 0.007,
+  argon: 0.001,
+};
@@ -0,0 +1,60 @@
+/**
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+import { describe, expect, test } from '@jest/globals';
+import { AGA8wasm, type GasMixture } from '../dist/index.js';
+import { testGas } from './fixtures.js';
+
+describe('Flash', () => {
+  const x: GasMixture = testGas;
+
+  test('GERG-2008 flashes recover the temperature and density of a state', async () => {
+    const AGA8 = await AGA8wasm();
+    AGA8.SetupGERG();
+
+    const T = 300, P = 5000;
+    const D = AGA8.DensityGERG(0, T, P, x).D;
+    const p = AGA8.PropertiesGERG(T, D, x);
+    const inputs: [number, number, number][] = [
+      [0, P, p.H], [1, P, p.S], [2, P, p.U], [3, T, p.H],
+      [4, T, p.S], [5, D, p.H], [6, D, p.S], [7, p.U, 1 / D],
+    ];
+    for (const [pair, v1, v2] of inputs) {
+      const r = AGA8.FlashGERG(pair, v1, v2, x, 0, 0);
+      expect(r.ierr).toBe(0);
+      expect(r.T).toBeCloseTo(T, 6);
+      expect(r.D).toBeCloseTo(D, 8);
+    }
+  });
+
+  test('DETAIL isentropic compression as a batch of PS flashes', async () => {
+    const AGA8 = await AGA8wasm();
+    AGA8.SetupDetail();
+
+    const T0 = 290, P0 = 2000;
+    const D0 = AGA8.DensityDetail(T0, P0, x).D;
+    const S0 = AGA8.PropertiesDetail(T0, D0, x).S;
+    const P = new Float64Array([2000, 3000, 4500, 6000, 8000]);
+    const r = AGA8.FlashBatchDetail(1, P, new Float64Array(P.length).fill(S0), x);
+    expect(r.T[0]).toBeCloseTo(T0, 6);
+    for (let i = 0; i < P.length; i++) {
+      expect(r.ierr[i]).toBe(0);
+      if (i > 0) expect(r.T[i]).toBeGreaterThan(r.T[i - 1]);
+      const single = AGA8.FlashDetail(1, P[i], S0, x, 0, 0);
+      expect(r.T[i]).toBeCloseTo(single.T, 6);
+      expect(r.D[i]).toBeCloseTo(single.D, 8);
+    }
+  });
+});
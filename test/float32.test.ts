@@ -0,0 +1,57 @@
+/**
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+import { describe, expect, test } from '@jest/globals';
+import { AGA8wasm, type GasMixture } from '../dist/index.js';
+import { testGas } from './fixtures.js';
+
+describe('Single-precision batch mode', () => {
+  const x: GasMixture = testGas;
+
+  test('PropertiesBatchFloatGERG stays close to PropertiesGERG', async () => {
+    const AGA8 = await AGA8wasm();
+    AGA8.SetupGERG();
+
+    const n = 37;
+    const T = new Float32Array(n), D = new Float32Array(n);
+    for (let k = 0; k < n; k++) {
+      T[k] = 250 + 5 * k;
+      D[k] = AGA8.DensityGERG(0, T[k], 1000 + 500 * k, x).D;
+    }
+    const r = AGA8.PropertiesBatchFloatGERG(T, D, x);
+    expect(r.P).toBeInstanceOf(Float32Array);
+    expect(r.P.length).toBe(n);
+    for (let k = 0; k < n; k++) {
+      const ref = AGA8.PropertiesGERG(T[k], D[k], x);
+      expect(Math.abs(r.P[k] / ref.P - 1)).toBeLessThan(5e-5);
+      expect(Math.abs(r.W[k] / ref.W - 1)).toBeLessThan(1e-4);
+      expect(Math.abs(r.H[k] - ref.H) / (8.314 * T[k])).toBeLessThan(1e-4);
+    }
+  });
+
+  test('PressureBatchFloatDetail gives the pressures of PropertiesBatchFloatDetail', async () => {
+    const AGA8 = await AGA8wasm();
+    AGA8.SetupDetail();
+
+    const T = new Float32Array([250, 280, 300, 320, 350]);
+    const D = new Float32Array([0.5, 2, 4, 6, 8]);
+    const p = AGA8.PressureBatchFloatDetail(T, D, x);
+    const r = AGA8.PropertiesBatchFloatDetail(T, D, x);
+    for (let k = 0; k < T.length; k++) {
+      expect(Math.abs(p.P[k] / r.P[k] - 1)).toBeLessThan(1e-6);
+      expect(Math.abs(r.Z[k] / AGA8.PressureDetail(T[k], D[k], x).Z - 1)).toBeLessThan(5e-5);
+    }
+  });
+});
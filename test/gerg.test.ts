@@ -73,4 +73,43 @@ describe('GERG2008', () => {
     expect(props.H).toBeCloseTo(1160.280160510973, 10);
     expect(props.S).toBeCloseTo(-38.57590392409089, 10);
   });
+
+  test('GERG isotherm matches PressureGERG', async () => {
+    const AGA8 = await AGA8wasm();
+    AGA8.SetupGERG();
+
+    const x: GasMixture = {
+      methane: 0.77824,
+      nitrogen: 0.02,
+      carbon_dioxide: 0.06,
+      ethane: 0.08,
+      propane: 0.03,
+      isobutane: 0.0015,
+      n_butane: 0.003,
+      isopentane: 0.0005,
+      n_pentane: 0.00165,
+      n_hexane: 0.00215,
+      n_heptane: 0.00088,
+      n_octane: 0.00024,
+      n_nonane: 0.00015,
+      n_decane: 0.00009,
+      hydrogen: 0.004,
+      oxygen: 0.005,
+      carbon_monoxide: 0.002,
+      water: 0.0001,
+      hydrogen_sulfide: 0.0025,
+      helium: 0.007,
+      argon: 0.001
+    };
+
+    const T = 400;
+    const densities = [0.1, 1, 5, 10, 12.79828626082062, 15];
+    const pressures = AGA8.IsothermGERG(T, x, densities);
+
+    expect(pressures.length).toBe(densities.length);
+    densities.forEach((D, i) => {
+      const { P } = AGA8.PressureGERG(T, D, x);
+      expect(Math.abs(pressures[i] / P - 1)).toBeLessThan(1e-12);
+    });
+  });
 });
\ No newline at end of file
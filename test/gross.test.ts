@@ -77,4 +77,106 @@ describe('Gross', () => {
     expect(Math.abs(P_reference - pp)).toBeLessThan(EPSILON);
     expect(Math.abs(Z_reference - Z)).toBeLessThan(EPSILON);
   });
-});
\ No newline at end of file
+
+  test('Gross closed-form density matches the iterative solver', async () => {
+    const AGA8 = await AGA8wasm();
+    AGA8.SetupGross();
+
+    const x: GasMixture = {
+      methane: 0.77824,
+      nitrogen: 0.02,
+      carbon_dioxide: 0.06,
+      ethane: 0.08,
+      propane: 0.03,
+      isobutane: 0.0015,
+      n_butane: 0.003,
+      isopentane: 0.0005,
+      n_pentane: 0.00165,
+      n_hexane: 0.00215,
+      n_heptane: 0.00088,
+      n_octane: 0.00024,
+      n_nonane: 0.00015,
+      n_decane: 0.00009,
+      hydrogen: 0.004,
+      oxygen: 0.005,
+      carbon_monoxide: 0.002,
+      water: 0.0001,
+      hydrogen_sulfide: 0.0025,
+      helium: 0.007,
+      argon: 0.001
+    };
+
+    const { xGrs, HCH } = AGA8.GrossHv(x);
+    for (const T of [250, 300, 350]) {
+      for (const P of [100, 1000, 10000, 20000]) {
+        const closed = AGA8.DensityGross(T, P, xGrs, HCH);
+        const iterative = AGA8.DensityGrossIterative(T, P, xGrs, HCH);
+        expect(closed.ierr).toBe(0);
+        expect(iterative.ierr).toBe(0);
+        expect(Math.abs(closed.D / iterative.D - 1)).toBeLessThan(1e-12);
+      }
+    }
+  });
+
+  test('Gross batch density matches DensityGross', async () => {
+    const AGA8 = await AGA8wasm();
+    AGA8.SetupGross();
+
+    const T = new Float64Array([300, 273.15, 300, 350, 273.15, 300]);
+    const P = new Float64Array([10000, 101.325, 5000, 20000, 0, 1000]);
+    const xCH = new Float64Array([0.92, 0.95, 0.8, 0.9, 0.92, 0.99]);
+    const xN2 = new Float64Array([0.02, 0.01, 0.15, 0.05, 0.02, 0]);
+    const xCO2 = new Float64Array([0.06, 0.04, 0.05, 0.05, 0.06, 0.01]);
+    const HCH = new Float64Array([1000, 950, 1100, 900, 1000, 890.63]);
+
+    const { D, Z, ierr } = AGA8.DensityGrossBatch(T, P, xCH, xN2, xCO2, HCH);
+
+    expect(D.length).toBe(T.length);
+    for (let i = 0; i < T.length; i++) {
+      const xGrs = { hydrocarbon: xCH[i], nitrogen: xN2[i], carbon_dioxide: xCO2[i] };
+      const single = AGA8.DensityGross(T[i], P[i], xGrs, HCH[i]);
+      const pressure = AGA8.PressureGross(T[i], single.D, xGrs, HCH[i]);
+      expect(ierr[i]).toBe(single.ierr);
+      expect(D[i]).toBe(single.D);
+      expect(Math.abs(Z[i] - pressure.Z)).toBeLessThan(1e-14);
+    }
+  });
+
+  test('Gross batch methods 1 and 2 match the single-row setup', async () => {
+    const AGA8 = await AGA8wasm();
+    AGA8.SetupGross();
+
+    const Th = 298.15;
+    const Td = 273.15;
+    const Pd = 101.325;
+    const Gr = new Float64Array([0.6, 0.65, 0.7, 0]);
+    const Hv = new Float64Array([38, 40, 42, 40]);
+    const xN2 = new Float64Array([0.02, 0.05, 0.01, 0.02]);
+    const xCO2 = new Float64Array([0.01, 0.02, 0.06, 0.01]);
+
+    const m1 = AGA8.GrossMethod1Batch(Th, Td, Pd, Gr, Hv, xCO2);
+    const m2 = AGA8.GrossMethod2Batch(Th, Td, Pd, Gr, xN2, xCO2);
+
+    for (let i = 0; i < Gr.length; i++) {
+      const r1 = AGA8.GrossMethod1(Th, Td, Pd, { hydrocarbon: 0, nitrogen: 0, carbon_dioxide: xCO2[i] }, Gr[i], Hv[i]);
+      expect(m1.ierr[i]).toBe(r1.ierr);
+      if (r1.ierr === 0) {
+        expect(m1.xCH[i]).toBe(r1.xGrs.hydrocarbon);
+        expect(m1.xN2[i]).toBe(r1.xGrs.nitrogen);
+        expect(m1.Mm[i]).toBe(r1.Mm);
+        expect(m1.HCH[i]).toBe(r1.HCH);
+        expect(m1.HN[i]).toBe(r1.HN);
+      }
+
+      const r2 = AGA8.GrossMethod2(Th, Td, Pd, { hydrocarbon: 0, nitrogen: xN2[i], carbon_dioxide: xCO2[i] }, Gr[i]);
+      expect(m2.ierr[i]).toBe(r2.ierr);
+      if (r2.ierr === 0) {
+        expect(m2.xCH[i]).toBe(r2.xGrs.hydrocarbon);
+        expect(m2.Hv[i]).toBe(r2.Hv);
+        expect(m2.Mm[i]).toBe(r2.Mm);
+        expect(m2.HCH[i]).toBe(r2.HCH);
+        expect(m2.HN[i]).toBe(r2.HN);
+      }
+    }
+  });
+});
@@ -0,0 +1,152 @@
+/**
+ * @file allocations.cpp
+ * @brief Native test: the density and property evaluations must not allocate on the heap
+ *
+ * Global operator new is replaced by a counting version. Every routine is called once to let
+ * the static caches and batch buffers reach their size, then the calls are repeated at other
+ * states and the number of allocations must stay at zero.
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "Detail.h"
+#include "GERG2008.h"
+#include "Gross.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+static std::atomic<long> allocations(0);
+
+void *operator new(std::size_t n)
+{
+    ++allocations;
+    void *p = std::malloc(n ? n : 1);
+    if (!p) { throw std::bad_alloc(); }
+    return p;
+}
+void *operator new[](std::size_t n) { return operator new(n); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+
+static int failures = 0;
+
+static void Check(const char *name, long count)
+{
+    if (count != 0)
+    {
+        printf("FAIL %s: %ld allocation(s)\n", name, count);
+        ++failures;
+    }
+    else
+    {
+        printf("ok   %s\n", name);
+    }
+}
+
+// Runs f for each (T, P) state and returns the number of allocations made
+template <typename F>
+static long Count(F f)
+{
+    const double T[] = {250, 300, 350, 400};
+    const double P[] = {100, 1000, 10000, 30000};
+    long before = allocations.load();
+    for (double Ti : T)
+    {
+        for (double Pi : P) { f(Ti, Pi); }
+    }
+    return allocations.load() - before;
+}
+
+int main()
+{
+    SetupDetail();
+    SetupGERG();
+    SetupGross();
+
+    std::vector<double> x = {0, 0.77824, 0.02, 0.06, 0.08, 0.03, 0.0015, 0.003, 0.0005, 0.00165, 0.00215,
+                             0.00088, 0.00024, 0.00015, 0.00009, 0.004, 0.005, 0.002, 0.0001, 0.0025, 0.007, 0.001};
+    std::vector<double> xGrs(4);
+    double HN, HCH, D, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf, Gr, Mm, B, C;
+    int ierr;
+    const char *herr;
+    std::string herrs;
+    GrossHv(x, xGrs, HN, HCH);
+
+    const std::size_t n = 64;
+    std::vector<double> Tb(n), Pb(n), xCH(n, xGrs[1]), xN2(n, xGrs[2]), xCO2(n, xGrs[3]), HCHb(n, HCH), Grb(n, 0.65), Hvb(n, 40);
+    std::vector<double> Db, Zb, xCHo, xN2o, Mmb, HCHo, HNb, Hvo;
+    std::vector<int> ierrb;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        Tb[i] = 250 + 50 * (i % 4);
+        Pb[i] = 100 + 500 * i;
+    }
+
+    // Warm up the static caches and batch buffers
+    DensityDetail(300, 1000, x, D, ierr, herr);
+    PropertiesDetail(300, D, x, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, Cf);
+    DensityGERG(0, 300, 1000, x, D, ierr, herr);
+    PropertiesGERG(300, D, x, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf);
+    DensityGross(300, 1000, xGrs, HCH, D, ierr, herr);
+    DensityGrossBatch(Tb, Pb, xCH, xN2, xCO2, HCHb, Db, Zb, ierrb);
+    GrossMethod1Batch(298.15, 273.15, 101.325, Grb, Hvb, xCO2, xCHo, xN2o, Mmb, HCHo, HNb, ierrb);
+    GrossMethod2Batch(298.15, 273.15, 101.325, Grb, xN2, xCO2, xCHo, Hvo, Mmb, HCHo, HNb, ierrb);
+
+    Check("DensityDetail", Count([&](double T, double Pi) {
+        DensityDetail(T, Pi, x, D, ierr, herr);
+        PropertiesDetail(T, D, x, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, Cf);
+    }));
+    Check("DensityGERG", Count([&](double T, double Pi) {
+        DensityGERG(0, T, Pi, x, D, ierr, herr);
+        PropertiesGERG(T, D, x, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf);
+    }));
+    Check("DensityGross", Count([&](double T, double Pi) {
+        GrossHv(x, xGrs, HN, HCH);
+        DensityGross(T, Pi, xGrs, HCH, D, ierr, herr);
+        PressureGross(T, D, xGrs, HCH, P, Z, ierr, herr);
+        GrossInputs(T, Pi, x, xGrs, Gr, HN, HCH, ierr, herr);
+    }));
+    Check("GrossMethod1/2", Count([&](double T, double) {
+        xGrs[3] = 0.06;
+        GrossMethod1(298.15, T, 101.325, xGrs, 0.65, 40, Mm, HCH, HN, ierr, herr);
+        GrossMethod2(298.15, T, 101.325, xGrs, 0.65, Z, Mm, HCH, HN, ierr, herr);
+        GrossMethod1(298.15, T, 101.325, xGrs, 0, 40, Mm, HCH, HN, ierr, herr); // error path
+        Bmix(T, xGrs, HCH, B, C, ierr, herr);
+    }));
+    Check("std::string overloads", Count([&](double T, double Pi) {
+        DensityDetail(T, Pi, x, D, ierr, herrs);
+        DensityGERG(0, T, Pi, x, D, ierr, herrs);
+        DensityGross(T, Pi, xGrs, HCH, D, ierr, herrs);
+    }));
+    Check("Batch", Count([&](double T, double Pi) {
+        for (std::size_t i = 0; i < n; ++i) { Tb[i] = T + (double)(i % 4); Pb[i] = Pi; }
+        DensityGrossBatch(Tb, Pb, xCH, xN2, xCO2, HCHb, Db, Zb, ierrb);
+        GrossMethod1Batch(298.15, T, 101.325, Grb, Hvb, xCO2, xCHo, xN2o, Mmb, HCHo, HNb, ierrb);
+        GrossMethod2Batch(298.15, T, 101.325, Grb, xN2, xCO2, xCHo, Hvo, Mmb, HCHo, HNb, ierrb);
+    }));
+
+    return failures == 0 ? 0 : 1;
+}
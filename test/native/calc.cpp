@@ -0,0 +1,186 @@
+/**
+ * @file calc.cpp
+ * @brief Native test: the aga8-calc streaming CSV calculator
+ *
+ * Writes a CSV of compositions in mole percent with T and P columns, a CRLF line, a line with a
+ * missing field and an unreadable number, then runs aga8-calc (path given as the argument) with one
+ * thread and large blocks, and with four threads and blocks of a few lines. Both outputs must be
+ * identical, in input order, and their values must be those of DensityGERG and PropertiesGERG on the
+ * normalized compositions. The same file converted to a columnar dataset must hold the same values, and
+ * must give them again when evaluated in place.
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "Columnar.h"
+#include "GERG2008.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+static void Check(const bool ok, const char *what)
+{
+    printf("%s %s\n", ok ? "ok  " : "FAIL", what);
+    if (!ok) { ++failures; }
+}
+
+static std::string ReadFile(const char *name)
+{
+    std::ifstream f(name, std::ios::binary);
+    std::ostringstream s;
+    s << f.rdbuf();
+    return s.str();
+}
+
+static std::vector<std::string> Split(const std::string &s, const char sep)
+{
+    std::vector<std::string> fields;
+    std::size_t start = 0;
+    for (std::size_t k = 0; k <= s.size(); ++k)
+    {
+        if (k == s.size() || s[k] == sep)
+        {
+            fields.push_back(s.substr(start, k - start));
+            start = k + 1;
+        }
+    }
+    return fields;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        printf("Usage: %s aga8-calc\n", argv[0]);
+        return 2;
+    }
+    SetupGERG();
+
+    // Methane, nitrogen, carbon dioxide, ethane and propane in mole percent, the other components absent
+    const int NRows = 300;
+    std::vector<std::vector<double>> xs;
+    std::vector<double> Ts, Ps;
+    {
+        std::ofstream f("calc-input.csv", std::ios::binary);
+        f << "T,methane,nitrogen,carbon_dioxide,ethane,propane,P,tag\n";
+        for (int k = 0; k < NRows; ++k)
+        {
+            const double T = 250 + (k % 17) * 7.5, P = 100 + (k % 23) * 600;
+            std::vector<double> x(22, 0);
+            x[1] = 80 + (k % 9);
+            x[2] = 1 + (k % 5) * 0.5;
+            x[3] = 0.5 + (k % 3) * 0.25;
+            x[4] = 5 + (k % 7) * 0.5;
+            x[5] = 100 - x[1] - x[2] - x[3] - x[4];
+            char line[256];
+            snprintf(line, sizeof(line), "%.17g,%.17g,%.17g,%.17g,%.17g,%.17g,%.17g,row%d%s", T, x[1], x[2], x[3], x[4], x[5], P, k,
+                     k == 7 ? "\r\n" : "\n");
+            f << line;
+            for (int i = 1; i <= 21; ++i) { x[i] /= 100; }
+            xs.push_back(x);
+            Ts.push_back(T);
+            Ps.push_back(P);
+        }
+        f << "300,90,10,,,,x,bad1\n";
+        f << "300,90,10\n";
+    }
+
+    const std::string calc = std::string("\"") + argv[1] + "\"";
+    const std::string props = " -p D,Z,H,W,Cf";
+    const int r1 = std::system((calc + props + " -j 1 calc-input.csv calc-output-1.csv").c_str());
+    const int r4 = std::system((calc + props + " -j 4 --chunk-size 300 calc-input.csv calc-output-4.csv").c_str());
+    Check(r1 == 0 && r4 == 0, "aga8-calc exit status");
+    const std::string out1 = ReadFile("calc-output-1.csv"), out4 = ReadFile("calc-output-4.csv");
+    Check(!out1.empty() && out1 == out4, "1 thread and 4 threads with small blocks give the same file");
+
+    std::vector<std::string> lines = Split(out1, '\n');
+    if (!lines.empty() && lines.back().empty()) { lines.pop_back(); }
+    if (lines.size() != (std::size_t)NRows + 3)
+    {
+        printf("FAIL %zu output lines\n", lines.size());
+        return 1;
+    }
+    Check(lines[0] == "T,methane,nitrogen,carbon_dioxide,ethane,propane,P,tag,D,Z,H,W,Cf,ierr", "header");
+
+    // Values against the library, in input order
+    double e = 0;
+    bool ordered = true;
+    for (int k = 0; k < NRows; ++k)
+    {
+        const std::vector<std::string> f = Split(lines[k + 1], ',');
+        if (f.size() != 14 || f[7] != "row" + std::to_string(k) || f[13] != "0")
+        {
+            ordered = false;
+            continue;
+        }
+        double D, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf;
+        int ierr;
+        const char *herr;
+        DensityGERG(0, Ts[k], Ps[k], xs[k], D, ierr, herr);
+        PropertiesGERG(Ts[k], D, xs[k], P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf);
+        const double v[5] = {D, Z, H, W, Cf};
+        for (int p = 0; p < 5; ++p)
+        {
+            e = std::max(e, std::abs(std::strtod(f[8 + p].c_str(), nullptr) - v[p]) / std::max(std::abs(v[p]), 1.0));
+        }
+    }
+    Check(ordered, "lines in input order, without error, CRLF line included");
+    printf("     largest difference from DensityGERG and PropertiesGERG %.3g\n", e);
+    Check(e < 1e-12, "values of DensityGERG and PropertiesGERG");
+    Check(lines[NRows + 1] == "300,90,10,,,,x,bad1,,,,,,-1" && lines[NRows + 2] == "300,90,10,,,,,,-1", "unreadable lines flagged with ierr -1");
+
+    // Columnar output of the CSV file, then the columnar dataset evaluated in place with 4 threads
+    const int rc = std::system((calc + props + " -j 2 -f columnar calc-input.csv calc-output.a8c").c_str());
+    const int rcc = std::system((calc + " -p D,W -j 4 calc-output.a8c calc-output-2.a8c").c_str());
+    ColumnarFile c1, c2;
+    int ierr;
+    const char *herr;
+    OpenColumnar("calc-output.a8c", c1, ierr, herr);
+    const int ierr1 = ierr;
+    OpenColumnar("calc-output-2.a8c", c2, ierr, herr);
+    const ColumnarTable &t1 = c1.table, &t2 = c2.table;
+    Check(rc == 0 && rcc == 0 && ierr1 == 0 && ierr == 0 && t1.rows == (uint64_t)NRows + 2 && t2.rows == t1.rows, "columnar output and input");
+    if (failures > 0) { return 1; }
+    bool same = t1.names.size() == 23 + 6 && t1.names[23] == "D" && t1.names[28] == "ierr";
+    for (int k = 0; same && k < NRows; ++k)
+    {
+        const std::vector<std::string> f = Split(lines[k + 1], ',');
+        same = t1.columns[ColumnarT][k] == Ts[k] && t1.columns[ColumnarP][k] == Ps[k] && t1.x(k)[1] == xs[k][1] && t1.columns[28][k] == 0;
+        for (int p = 0; p < 5; ++p) { same = same && t1.columns[23 + p][k] == std::strtod(f[8 + p].c_str(), nullptr); }
+    }
+    same = same && t1.columns[28][NRows] == -1 && std::isnan(t1.columns[ColumnarT][NRows]);
+    Check(same, "columnar output holds the inputs and the values of the CSV output");
+    const int D2 = t2.Find("D"), W2 = t2.Find("W"), H2 = t2.Find("H");
+    same = D2 >= 0 && W2 >= 0 && H2 >= 0 && t2.names.size() == t1.names.size();
+    for (int k = 0; same && k < NRows; ++k)
+    {
+        same = t2.columns[D2][k] == t1.columns[23][k] && t2.columns[W2][k] == t1.columns[26][k] && t2.columns[H2][k] == t1.columns[25][k];
+    }
+    Check(same, "columnar input evaluated in place gives the same values, other outputs kept");
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,174 @@
+/**
+ * @file columnar.cpp
+ * @brief Native test: the columnar binary datasets of Columnar.h
+ *
+ * A dataset of the NIST compositions on a grid of states must have the documented header, be the
+ * same bytes from WriteColumnar and SerializeColumnar, and be read back in place by OpenColumnar and
+ * ViewColumnar. BatchColumnar must give the values of DensityGERG, PropertiesGERG and GrossInputs
+ * for 1 and 4 threads, and invalid datasets must be rejected.
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "Columnar.h"
+#include "GERG2008.h"
+#include "Gross.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+static void Check(const bool ok, const char *what)
+{
+    printf("%s %s\n", ok ? "ok  " : "FAIL", what);
+    if (!ok) { ++failures; }
+}
+
+static uint64_t LoadLE(const unsigned char *p, const int n)
+{
+    uint64_t v = 0;
+    for (int k = n - 1; k >= 0; --k) { v = (v << 8) | p[k]; }
+    return v;
+}
+
+int main()
+{
+    SetupGERG();
+    SetupGross();
+
+    const std::vector<std::vector<double>> gases = {
+        {0, 0.77824, 0.02, 0.06, 0.08, 0.03, 0.0015, 0.003, 0.0005, 0.00165, 0.00215, 0.00088, 0.00024, 0.00015, 0.00009, 0.004, 0.005, 0.002, 0, 0.0026, 0.007, 0.001},
+        {0, 0.965, 0.003, 0.006, 0.018, 0.0045, 0.001, 0.001, 0.0005, 0.0003, 0.0007, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+        {0, 0.9, 0.03, 0.02, 0.05, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}};
+
+    // Inputs of 3 gases x 40 states, in columns; the last row has an invalid temperature
+    const uint64_t rows = 121;
+    std::vector<std::vector<double>> in(NInputsColumnar, std::vector<double>(rows));
+    for (uint64_t k = 0; k < rows; ++k)
+    {
+        const std::vector<double> &x = gases[k % 3];
+        for (int i = 1; i <= 21; ++i) { in[i - 1][k] = x[i]; }
+        in[ColumnarT][k] = k + 1 == rows ? -1.0 : 260.0 + (k / 3 % 8) * 10;
+        in[ColumnarP][k] = 200.0 + (k / 24) * 2000;
+    }
+    std::vector<std::string> names(InputNamesColumnar, InputNamesColumnar + NInputsColumnar);
+    std::vector<const double *> columns;
+    for (const std::vector<double> &c : in) { columns.push_back(c.data()); }
+    int ierr;
+    const char *herr;
+    WriteColumnar("columnar-input.a8c", names, columns, rows, ierr, herr);
+    Check(ierr == 0, "WriteColumnar");
+
+    // Header and bytes
+    std::ifstream f("columnar-input.a8c", std::ios::binary);
+    const std::vector<unsigned char> file((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    std::vector<unsigned char> bytes;
+    SerializeColumnar(names, columns, rows, bytes);
+    Check(file == bytes, "WriteColumnar and SerializeColumnar write the same bytes");
+    const uint64_t offset = LoadLE(&bytes[24], 8);
+    Check(std::memcmp(&bytes[0], "AGA8COL", 8) == 0 && LoadLE(&bytes[8], 4) == 1 && LoadLE(&bytes[12], 4) == 23 && LoadLE(&bytes[16], 8) == rows &&
+              offset == 64 * 13 && bytes.size() == offset + 23 * rows * 8 && std::strcmp((const char *)&bytes[64 + 32 * 18], "hydrogen_sulfide") == 0,
+          "header: magic, version, columns, rows, offset, names");
+    double P0;
+    std::memcpy(&P0, &bytes[offset + ColumnarP * rows * 8], 8);
+    Check(P0 == 200, "column P at offset + 22 * rows * 8");
+
+    // Read back in place
+    ColumnarFile mapped;
+    OpenColumnar("columnar-input.a8c", mapped, ierr, herr);
+    bool same = ierr == 0 && mapped.table.rows == rows && mapped.table.names == names;
+    for (int c = 0; same && c < NInputsColumnar; ++c) { same = std::memcmp(mapped.table.columns[c], in[c].data(), rows * 8) == 0; }
+    Check(same, "OpenColumnar reads the columns back");
+    Check(mapped.table.x(4)[1] == gases[1][1] && mapped.table.x(4)[5] == gases[1][5] && mapped.table.x(5)[21] == gases[2][21], "composition of a row viewed in place");
+    ColumnarTable view;
+    ViewColumnar(bytes.data(), bytes.size(), view, ierr, herr);
+    Check(ierr == 0 && view.columns[ColumnarT] == (const double *)(bytes.data() + offset) + ColumnarT * rows, "ViewColumnar points into the bytes");
+
+    // Evaluation against the library
+    const std::vector<int> props = {FindPropertyColumnar(ColumnarGERG, "D"), FindPropertyColumnar(ColumnarGERG, "H"), FindPropertyColumnar(ColumnarGERG, "W"),
+                                    FindPropertyColumnar(ColumnarGERG, "A")};
+    std::vector<std::vector<double>> out1, out4;
+    std::vector<double> ierr1, ierr4;
+    BatchColumnar(ColumnarGERG, mapped.table, props, 1, out1, ierr1);
+    BatchColumnar(ColumnarGERG, mapped.table, props, 4, out4, ierr4);
+    bool identical = ierr1 == ierr4;
+    for (std::size_t o = 0; identical && o < props.size(); ++o)
+    {
+        identical = std::memcmp(out1[o].data(), out4[o].data(), rows * 8) == 0;
+    }
+    Check(identical, "1 and 4 threads give the same bits");
+    double e = 0;
+    bool errors = true;
+    for (uint64_t k = 0; k < rows; ++k)
+    {
+        if (k + 1 == rows)
+        {
+            errors = ierr1[k] == -1 && std::isnan(out1[0][k]);
+            continue;
+        }
+        std::vector<double> x = gases[k % 3];
+        const double T = in[ColumnarT][k], P = in[ColumnarP][k];
+        double D, P2, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf;
+        DensityGERG(0, T, P, x, D, ierr, herr);
+        PropertiesGERG(T, D, x, P2, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf);
+        const double v[4] = {D, H, W, A};
+        for (int o = 0; o < 4; ++o) { e = std::max(e, std::abs(out1[o][k] - v[o]) / std::max(std::abs(v[o]), 1.0)); }
+        if (ierr1[k] != 0) { e = 1; }
+    }
+    printf("     largest difference from DensityGERG and PropertiesGERG %.3g\n", e);
+    Check(e < 1e-12, "BatchColumnar gives the values of DensityGERG and PropertiesGERG");
+    Check(errors, "invalid row flagged with ierr -1 and NaN outputs");
+
+    std::vector<std::vector<double>> outGross;
+    std::vector<double> ierrGross;
+    BatchColumnar(ColumnarGross, view, {FindPropertyColumnar(ColumnarGross, "Gr"), FindPropertyColumnar(ColumnarGross, "Z")}, 2, outGross, ierrGross);
+    std::vector<double> xGrs(4);
+    double Gr, HN, HCH;
+    GrossInputs(in[ColumnarT][0], in[ColumnarP][0], gases[0], xGrs, Gr, HN, HCH, ierr, herr);
+    Check(ierrGross[0] == 0 && outGross[0][0] == Gr && outGross[1][0] > 0.9 && outGross[1][0] < 1, "GROSS batch");
+    Check(FindPropertyColumnar(ColumnarGross, "W") < 0 && FindPropertyColumnar(ColumnarDetail, "A") < 0 && FindPropertyColumnar(ColumnarGERG, "Q") < 0,
+          "properties not calculated by a method are rejected");
+
+    // Invalid datasets
+    std::vector<unsigned char> bad = bytes;
+    bad[0] = 'B';
+    ViewColumnar(bad.data(), bad.size(), view, ierr, herr);
+    const int ierrMagic = ierr;
+    bad = bytes;
+    bad[8] = 2;
+    ViewColumnar(bad.data(), bad.size(), view, ierr, herr);
+    const int ierrVersion = ierr;
+    ViewColumnar(bytes.data(), bytes.size() - 8, view, ierr, herr);
+    const int ierrTruncated = ierr;
+    bad = bytes;
+    bad[64 + 32 * 21] = 't';
+    ViewColumnar(bad.data(), bad.size(), view, ierr, herr);
+    const int ierrNames = ierr;
+    OpenColumnar("columnar-missing.a8c", mapped, ierr, herr);
+    Check(ierrMagic == 2 && ierrVersion == 3 && ierrTruncated == 4 && ierrNames == 5 && ierr == 1 && view.rows == 0,
+          "invalid magic, version, size and names, missing file");
+
+    return failures == 0 ? 0 : 1;
+}
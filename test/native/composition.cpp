@@ -0,0 +1,184 @@
+/**
+ * @file composition.cpp
+ * @brief Native test: the Composition and CompositionView overloads must give the same results as
+ * the std::vector ones
+ *
+ * The mixture is read from a std::vector, from a Composition and from a column of a column-major
+ * matrix holding several mixtures (stride > 1). All results must be bit-identical, those of the
+ * equations of state as well as those of the composition derivatives, flashes, critical flow
+ * functions, sonic nozzles and density estimate grids built on them.
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "CriticalFlow.h"
+#include "DensityGuess.h"
+#include "Detail.h"
+#include "Flash.h"
+#include "GERG2008.h"
+#include "Gross.h"
+#include "SonicNozzle.h"
+
+#include <cstdio>
+#include <vector>
+
+static int failures = 0;
+
+static void Check(const char *name, const double *a, const double *b, int n)
+{
+    for (int i = 0; i < n; ++i)
+    {
+        if (a[i] != b[i])
+        {
+            printf("FAIL %s: value %d is %.17g instead of %.17g\n", name, i, b[i], a[i]);
+            ++failures;
+            return;
+        }
+    }
+    printf("ok   %s\n", name);
+}
+
+// Molar mass, density and properties from the DETAIL and GERG-2008 routines, then GROSS inputs
+template <typename X>
+static std::vector<double> Evaluate(const X &x)
+{
+    double Mm, D, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf, Gr, HN, HCH;
+    int ierr;
+    const char *herr;
+    std::vector<double> r, xGrs(4);
+
+    MolarMassDetail(x, Mm);
+    DensityDetail(320, 8000, x, D, ierr, herr);
+    PropertiesDetail(320, D, x, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, Cf);
+    r.insert(r.end(), {Mm, D, (double)ierr, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, Cf});
+    PressureDetail(320, 5, x, P, Z);
+    r.insert(r.end(), {P, Z});
+
+    MolarMassGERG(x, Mm);
+    DensityGERG(0, 320, 8000, x, D, ierr, herr);
+    PropertiesGERG(320, D, x, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf);
+    r.insert(r.end(), {Mm, D, (double)ierr, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf});
+    PressureGERG(320, 5, x, P, Z);
+    r.insert(r.end(), {P, Z});
+
+    MolarMassGross(x, Mm);
+    GrossHv(x, xGrs, HN, HCH);
+    r.insert(r.end(), {Mm, xGrs[1], xGrs[2], xGrs[3], HN, HCH});
+    GrossInputs(300, 5000, x, xGrs, Gr, HN, HCH, ierr, herr);
+    r.insert(r.end(), {xGrs[1], xGrs[2], xGrs[3], Gr, HN, HCH, (double)ierr});
+    return r;
+}
+
+// Derivative outputs: a std::vector for a std::vector composition, a Composition otherwise
+template <typename X> struct DerivativesOf { using type = Composition; };
+template <> struct DerivativesOf<std::vector<double>> { using type = std::vector<double>; };
+
+// Composition derivatives, flashes, critical flow functions, sonic nozzles and density estimates
+template <typename X>
+static std::vector<double> EvaluateSolvers(const X &x)
+{
+    typename DerivativesOf<X>::type dZdx, dDdx, dWdx;
+    std::vector<double> r, T = {300, 320}, P = {5000, 8000}, Dv, Zv, Wv, dZv, dDv, dWv, Tb, Db, Cstar, Tt, Pt, Dt;
+    std::vector<int> ierrs;
+    double Tcx, Dcx, D, Z, W, Pc, Tf = 0, Df = 0, C = 0, Tc = 0, Dc = 0;
+    int ierr;
+    const char *herr;
+
+    CompositionDerivativesGERG(320, 8, x, Pc, Z, W, dZdx, dDdx, dWdx);
+    r.insert(r.end(), {Pc, Z, W});
+    for (int i = 1; i <= NcComposition; ++i) { r.insert(r.end(), {dZdx[i], dDdx[i], dWdx[i]}); }
+    CompositionDerivativesDetail(320, 8, x, Pc, Z, W, dZdx, dDdx, dWdx);
+    r.insert(r.end(), {Pc, Z, W});
+    for (int i = 1; i <= NcComposition; ++i) { r.insert(r.end(), {dZdx[i], dDdx[i], dWdx[i]}); }
+    CompositionDerivativesBatchGERG(T, P, x, Dv, Zv, Wv, dZv, dDv, dWv, ierrs);
+    r.insert(r.end(), dZv.begin(), dZv.end());
+    CompositionDerivativesBatchDetail(T, P, x, Dv, Zv, Wv, dZv, dDv, dWv, ierrs);
+    r.insert(r.end(), dWv.begin(), dWv.end());
+    PseudoCriticalPointGERG(x, Tcx, Dcx);
+    r.insert(r.end(), {Tcx, Dcx});
+
+    FlashGERG(FlashPS, 5000, -40, x, Tf, Df, ierr, herr);
+    r.insert(r.end(), {Tf, Df, (double)ierr});
+    FlashDetail(FlashPH, 5000, 1000, x, Tf, Df, ierr, herr);
+    r.insert(r.end(), {Tf, Df, (double)ierr});
+    FlashBatchGERG(FlashTS, T, {-40, -45}, x, Tb, Db, ierrs);
+    r.insert(r.end(), Db.begin(), Db.end());
+    FlashBatchDetail(FlashPS, P, {-40, -45}, x, Tb, Db, ierrs);
+    r.insert(r.end(), Tb.begin(), Tb.end());
+
+    CriticalFlowFunctionGERG(293.15, 5000, x, C, Tc, Pc, Dc, ierr, herr);
+    r.insert(r.end(), {C, Tc, Pc, Dc, (double)ierr});
+    CriticalFlowFunctionDetail(293.15, 5000, x, C, Tc, Pc, Dc, ierr, herr);
+    r.insert(r.end(), {C, Tc, Pc, Dc, (double)ierr});
+    CriticalFlowBatchGERG(T, P, x, Cstar, Tt, Pt, Dt, ierrs);
+    r.insert(r.end(), Cstar.begin(), Cstar.end());
+    CriticalFlowBatchDetail(T, P, x, Cstar, Tt, Pt, Dt, ierrs);
+    r.insert(r.end(), Pt.begin(), Pt.end());
+
+    SonicNozzle nozzle;
+    SonicNozzleDiameter(SonicNozzleGERG, x, 0.05, 293.15, 5000, 101.325, 1.1e-5, nozzle, ierr, herr);
+    r.insert(r.end(), {nozzle.d, nozzle.Cstar, nozzle.Poutmax, (double)ierr});
+    SonicNozzlePressure(SonicNozzleDetail, x, 0.05, 293.15, 2.5, 101.325, 1.1e-5, nozzle, ierr, herr);
+    r.insert(r.end(), {nozzle.P0, nozzle.Cstar, nozzle.Poutmax, (double)ierr});
+
+    DensityGuessGrid grid;
+    BuildDensityGuess(DensityGuessGERG, 0, x, 250, 350, 100, 10000, 4, 4, grid, ierr, herr);
+    r.insert(r.end(), grid.lnv.begin(), grid.lnv.end());
+    DensityGuess(grid, 310, 3000, D, ierr, herr);
+    r.insert(r.end(), {D, (double)ierr});
+    return r;
+}
+
+int main()
+{
+    SetupDetail();
+    SetupGERG();
+    SetupGross();
+
+    const std::vector<double> x = {0, 0.77824, 0.02, 0.06, 0.08, 0.03, 0.0015, 0.003, 0.0005, 0.00165, 0.00215,
+                                   0.00088, 0.00024, 0.00015, 0.00009, 0.004, 0.005, 0.002, 0.0001, 0.0025, 0.007, 0.001};
+
+    // Column-major matrix of 3 mixtures, the tested mixture in the middle column
+    const int n = 3;
+    std::vector<double> m(NcComposition * n, 0);
+    for (int i = 1; i <= NcComposition; ++i)
+    {
+        m[(i - 1) * n] = (i == 1) ? 1 : 0;
+        m[(i - 1) * n + 1] = x[i];
+        m[(i - 1) * n + 2] = (i == 2) ? 1 : 0;
+    }
+
+    // The other mixtures are evaluated in between so that the composition caches are rebuilt
+    const std::vector<double> expected = Evaluate(x);
+    Evaluate(CompositionView(&m[0], n));
+    const std::vector<double> fixed = Evaluate(Composition(x));
+    Evaluate(CompositionView(&m[2], n));
+    const std::vector<double> strided = Evaluate(CompositionView(&m[1], n));
+    Check("Composition", expected.data(), fixed.data(), (int)expected.size());
+    Check("CompositionView", expected.data(), strided.data(), (int)expected.size());
+
+    const std::vector<double> expectedSolvers = EvaluateSolvers(x);
+    EvaluateSolvers(CompositionView(&m[0], n));
+    const std::vector<double> fixedSolvers = EvaluateSolvers(Composition(x));
+    const std::vector<double> stridedSolvers = EvaluateSolvers(CompositionView(&m[1], n));
+    Check("Composition solvers", expectedSolvers.data(), fixedSolvers.data(), (int)expectedSolvers.size());
+    Check("CompositionView solvers", expectedSolvers.data(), stridedSolvers.data(), (int)expectedSolvers.size());
+
+    return failures == 0 ? 0 : 1;
+}
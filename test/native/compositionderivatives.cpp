@@ -0,0 +1,177 @@
+/**
+ * @file compositionderivatives.cpp
+ * @brief Native test: analytic composition derivatives must match finite differences
+ *
+ * For a natural gas (with water absent), a hydrogen-rich gas and pure methane, at gas, dense and
+ * supercritical states, dZ/dx_i, dD/dx_i and dW/dx_i of CompositionDerivativesGERG and
+ * CompositionDerivativesDetail are compared with finite differences of DensityGERG and PropertiesGERG
+ * (DETAIL) at constant T and P. Central differences are used, and a one-sided second order formula
+ * for the absent components. Z and W must be those of PropertiesGERG (DETAIL). The batch forms must
+ * give the values of the single-state functions, and zeros for a state whose density solve fails.
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "Detail.h"
+#include "GERG2008.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+static int failures = 0;
+
+// Z, D and W at (T, P), the density being polished by Newton steps beyond the tolerance of the solver
+static void State(const bool detail, const double T, const double P, const std::vector<double> &x, double &Z, double &D, double &W)
+{
+    double P2, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, G, JT, Kappa, A, Cf;
+    int ierr;
+    const char *herr;
+    D = 0;
+    if (detail) { DensityDetail(T, P, x, D, ierr, herr); }
+    else { DensityGERG(0, T, P, x, D, ierr, herr); }
+    for (int it = 0; it <= 3; ++it)
+    {
+        if (detail) { PropertiesDetail(T, D, x, P2, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, Cf); }
+        else { PropertiesGERG(T, D, x, P2, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf); }
+        if (it < 3) { D -= (P2 - P) / dPdD; }
+    }
+}
+
+static void CheckDerivatives(const char *name, const bool detail, const std::vector<double> &x, const double T, const double P)
+{
+    const double h = 1e-6;
+    double Z, D, W, P2, Z2, W2;
+    std::vector<double> dZdx, dDdx, dWdx;
+
+    State(detail, T, P, x, Z, D, W);
+    if (detail) { CompositionDerivativesDetail(T, D, x, P2, Z2, W2, dZdx, dDdx, dWdx); }
+    else { CompositionDerivativesGERG(T, D, x, P2, Z2, W2, dZdx, dDdx, dWdx); }
+    if (std::abs(P2 / P - 1) > 1e-12 || std::abs(Z2 / Z - 1) > 1e-13 || std::abs(W2 / W - 1) > 1e-13)
+    {
+        printf("FAIL %s, T=%g P=%g: P=%.17g Z=%.17g W=%.17g instead of %.17g %.17g %.17g\n", name, T, P, P2, Z2, W2, P, Z, W);
+        ++failures;
+        return;
+    }
+
+    // Errors relative to the largest derivative of each property
+    double scale[3] = {0, 0, 0}, err[3] = {0, 0, 0};
+    for (int i = 1; i <= 21; ++i)
+    {
+        scale[0] = std::max(scale[0], std::abs(dZdx[i]));
+        scale[1] = std::max(scale[1], std::abs(dDdx[i]));
+        scale[2] = std::max(scale[2], std::abs(dWdx[i]));
+    }
+    for (int i = 1; i <= 21; ++i)
+    {
+        std::vector<double> x1 = x, x2 = x;
+        double Z1, D1, W1, D2, fd[3];
+        const bool absent = x[i] < 2 * h;
+        x1[i] += h;
+        x2[i] += absent ? 2 * h : -h;
+        State(detail, T, P, x1, Z1, D1, W1);
+        State(detail, T, P, x2, Z2, D2, W2);
+        if (absent)
+        {
+            fd[0] = (-3 * Z + 4 * Z1 - Z2) / (2 * h);
+            fd[1] = (-3 * D + 4 * D1 - D2) / (2 * h);
+            fd[2] = (-3 * W + 4 * W1 - W2) / (2 * h);
+        }
+        else
+        {
+            fd[0] = (Z1 - Z2) / (2 * h);
+            fd[1] = (D1 - D2) / (2 * h);
+            fd[2] = (W1 - W2) / (2 * h);
+        }
+        err[0] = std::max(err[0], std::abs(dZdx[i] - fd[0]) / scale[0]);
+        err[1] = std::max(err[1], std::abs(dDdx[i] - fd[1]) / scale[1]);
+        err[2] = std::max(err[2], std::abs(dWdx[i] - fd[2]) / scale[2]);
+    }
+    if (err[0] > 1e-6 || err[1] > 1e-6 || err[2] > 1e-6)
+    {
+        printf("FAIL %s, T=%g P=%g: relative errors %.2e (Z), %.2e (D), %.2e (W)\n", name, T, P, err[0], err[1], err[2]);
+        ++failures;
+        return;
+    }
+    printf("ok   %s, T=%g P=%g (relative errors %.1e, %.1e, %.1e)\n", name, T, P, err[0], err[1], err[2]);
+}
+
+// The batch form must give the values of DensityGERG/DensityDetail and CompositionDerivatives* state by state
+static void CheckBatch(const char *name, const bool detail, const std::vector<double> &x)
+{
+    const std::vector<double> T = {250, 300, 400, 300}, P = {20000, 8000, 50000, -1};
+    std::vector<double> D, Z, W, dZdx, dDdx, dWdx, dZ(22, 0), dD(22, 0), dW(22, 0);
+    std::vector<int> ierr;
+    if (detail) { CompositionDerivativesBatchDetail(T, P, x, D, Z, W, dZdx, dDdx, dWdx, ierr); }
+    else { CompositionDerivativesBatchGERG(T, P, x, D, Z, W, dZdx, dDdx, dWdx, ierr); }
+    bool same = D.size() == T.size() && dZdx.size() == T.size() * 21;
+    for (std::size_t k = 0; same && k < T.size(); ++k)
+    {
+        double Dk = 0, P2, Zk = 0, Wk = 0;
+        int ierrk;
+        const char *herr;
+        if (detail) { DensityDetail(T[k], P[k], x, Dk, ierrk, herr); }
+        else { DensityGERG(0, T[k], P[k], x, Dk, ierrk, herr); }
+        if (ierrk != 0) { Dk = 0; dZ.assign(22, 0); dD.assign(22, 0); dW.assign(22, 0); }
+        else if (detail) { CompositionDerivativesDetail(T[k], Dk, x, P2, Zk, Wk, dZ, dD, dW); }
+        else { CompositionDerivativesGERG(T[k], Dk, x, P2, Zk, Wk, dZ, dD, dW); }
+        same = ierr[k] == ierrk && D[k] == Dk && Z[k] == Zk && W[k] == Wk;
+        for (int i = 1; same && i <= 21; ++i)
+        {
+            same = dZdx[k * 21 + i - 1] == dZ[i] && dDdx[k * 21 + i - 1] == dD[i] && dWdx[k * 21 + i - 1] == dW[i];
+        }
+    }
+    printf("%s %s batch\n", same ? "ok  " : "FAIL", name);
+    if (!same) { ++failures; }
+}
+
+int main()
+{
+    SetupDetail();
+    SetupGERG();
+
+    std::vector<double> x = {0, 0.77834, 0.02, 0.06, 0.08, 0.03, 0.0015, 0.003, 0.0005, 0.00165, 0.00215, 0.00088,
+                             0.00024, 0.00015, 0.00009, 0.004, 0.005, 0.002, 0, 0.0025, 0.007, 0.001};
+    std::vector<double> h2(22, 0), ch4(22, 0);
+    h2[1] = 0.7;
+    h2[2] = 0.05;
+    h2[3] = 0.05;
+    h2[15] = 0.2;
+    ch4[1] = 1;
+
+    for (int detail = 0; detail <= 1; ++detail)
+    {
+        const char *eos = detail ? "DETAIL" : "GERG-2008";
+        char name[64];
+        snprintf(name, sizeof(name), "%s natural gas", eos);
+        CheckDerivatives(name, detail, x, 300, 8000);
+        CheckDerivatives(name, detail, x, 250, 20000);
+        CheckDerivatives(name, detail, x, 400, 50000);
+        CheckDerivatives(name, detail, x, 280, 100);
+        snprintf(name, sizeof(name), "%s hydrogen blend", eos);
+        CheckDerivatives(name, detail, h2, 290, 6000);
+        snprintf(name, sizeof(name), "%s methane", eos);
+        CheckDerivatives(name, detail, ch4, 300, 10000);
+        snprintf(name, sizeof(name), "%s natural gas", eos);
+        CheckBatch(name, detail, x);
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,147 @@
+/**
+ * @file criticalflow.cpp
+ * @brief Native test: the real-gas critical flow function must be the maximum mass flux of the isentrope
+ *
+ * C* of argon at low pressure must match the perfect gas value sqrt(5/3)*(3/4)^2. For a natural gas,
+ * C* must equal the largest rho*w*sqrt(R*T0/M)/P0 found by a golden section search along the
+ * isentrope, and a batch over a pressure sweep must match the single throat solves.
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "CriticalFlow.h"
+#include "Detail.h"
+#include "Flash.h"
+#include "GERG2008.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+static int failures = 0;
+
+static void CheckPerfectGas(const char *name, const bool detail, const std::vector<double> &x)
+{
+    const double expected = std::sqrt(5.0 / 3) * 0.5625;
+    double Cstar, Tt = 0, Pt = 0, Dt = 0;
+    int ierr;
+    const char *herr;
+    if (detail) { CriticalFlowFunctionDetail(300, 1, x, Cstar, Tt, Pt, Dt, ierr, herr); }
+    else { CriticalFlowFunctionGERG(300, 1, x, Cstar, Tt, Pt, Dt, ierr, herr); }
+    if (ierr != 0 || std::abs(Cstar / expected - 1) > 1e-5 || std::abs(Tt / 225 - 1) > 1e-5)
+    {
+        printf("FAIL %s: C*=%.10g Tt=%.10g (ierr %d %s) instead of %.10g and 225 K\n", name, Cstar, Tt, ierr, herr, expected);
+        ++failures;
+        return;
+    }
+    printf("ok   %s (C*=%.6f)\n", name, Cstar);
+}
+
+// rho*w*sqrt(R*T0/M)/P0 on the isentrope (S0, H0) at pressure P
+static double FluxGERG(const double P, const double T0, const double P0, const double S0, const double H0, const double Mm, const std::vector<double> &x, double &T, double &D)
+{
+    double Pk, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf;
+    int ierr;
+    const char *herr;
+    D = -D;
+    FlashGERG(FlashPS, P, S0, x, T, D, ierr, herr);
+    PropertiesGERG(T, D, x, Pk, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf);
+    const double w = std::sqrt(2000 * (H0 - H) / Mm);
+    return D * Mm * w * std::sqrt(8.314472 * T0 / (Mm / 1000)) / (P0 * 1000);
+}
+
+static void CheckMaximumFlux(const std::vector<double> &x)
+{
+    double Mm;
+    MolarMassGERG(x, Mm);
+    const double T0 = 293.15;
+    for (double P0 : {100.0, 1000.0, 5000.0, 10000.0, 20000.0})
+    {
+        double D0 = 0, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H0, S0, Cv, Cp, W, G, JT, Kappa, A, Cf;
+        double Cstar, Tt = 0, Pt = 0, Dt = 0;
+        int ierr;
+        const char *herr;
+        DensityGERG(0, T0, P0, x, D0, ierr, herr);
+        PropertiesGERG(T0, D0, x, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H0, S0, Cv, Cp, W, G, JT, Kappa, A, Cf);
+        CriticalFlowFunctionGERG(T0, P0, x, Cstar, Tt, Pt, Dt, ierr, herr);
+
+        // Golden section search of the largest flux between 0.3*P0 and 0.8*P0
+        const double phi = (std::sqrt(5.0) - 1) / 2;
+        double a = 0.3 * P0, b = 0.8 * P0, T = Tt, D = Dt;
+        double c = b - phi * (b - a), d = a + phi * (b - a);
+        double fc = FluxGERG(c, T0, P0, S0, H0, Mm, x, T, D), fd = FluxGERG(d, T0, P0, S0, H0, Mm, x, T, D);
+        for (int it = 0; it < 60; ++it)
+        {
+            if (fc > fd) { b = d; d = c; fd = fc; c = b - phi * (b - a); fc = FluxGERG(c, T0, P0, S0, H0, Mm, x, T, D); }
+            else { a = c; c = d; fc = fd; d = a + phi * (b - a); fd = FluxGERG(d, T0, P0, S0, H0, Mm, x, T, D); }
+        }
+        const double fmax = std::max(fc, fd);
+        if (ierr != 0 || std::abs(Cstar / fmax - 1) > 1e-9 || std::abs(Pt / ((a + b) / 2) - 1) > 1e-3)
+        {
+            printf("FAIL natural gas P0=%g: C*=%.12g Pt=%.10g (ierr %d %s), largest flux %.12g at %.10g\n", P0, Cstar, Pt, ierr, herr, fmax, (a + b) / 2);
+            ++failures;
+            return;
+        }
+        printf("ok   natural gas P0=%g kPa (C*=%.6f, ideal gas formula %.6f)\n", P0, Cstar, Cf);
+    }
+}
+
+static void CheckBatch(const char *name, const bool detail, const std::vector<double> &x)
+{
+    const int n = 100;
+    std::vector<double> T0(n, 293.15), P0(n), Cstar, Tt, Pt, Dt;
+    std::vector<int> ierrk;
+    for (int k = 0; k < n; ++k) { P0[k] = 200 + 200.0 * k; }
+    if (detail) { CriticalFlowBatchDetail(T0, P0, x, Cstar, Tt, Pt, Dt, ierrk); }
+    else { CriticalFlowBatchGERG(T0, P0, x, Cstar, Tt, Pt, Dt, ierrk); }
+    for (int k = 0; k < n; ++k)
+    {
+        double C, T = 0, P = 0, D = 0;
+        int ierr;
+        const char *herr;
+        if (detail) { CriticalFlowFunctionDetail(T0[k], P0[k], x, C, T, P, D, ierr, herr); }
+        else { CriticalFlowFunctionGERG(T0[k], P0[k], x, C, T, P, D, ierr, herr); }
+        if (ierrk[k] != 0 || ierr != 0 || std::abs(Cstar[k] / C - 1) > 1e-9 || std::abs(Pt[k] / P - 1) > 1e-6)
+        {
+            printf("FAIL %s: P0=%g, C*=%.15g Pt=%.10g (ierr %d) instead of %.15g and %.10g (ierr %d)\n", name, P0[k], Cstar[k], Pt[k], ierrk[k], C, P, ierr);
+            ++failures;
+            return;
+        }
+    }
+    printf("ok   %s\n", name);
+}
+
+int main()
+{
+    SetupDetail();
+    SetupGERG();
+
+    const std::vector<double> x = {0, 0.77824, 0.02, 0.06, 0.08, 0.03, 0.0015, 0.003, 0.0005, 0.00165, 0.00215, 0.00088,
+                                   0.00024, 0.00015, 0.00009, 0.004, 0.005, 0.002, 0.0001, 0.0025, 0.007, 0.001};
+    std::vector<double> argon(22, 0);
+    argon[21] = 1;
+
+    CheckPerfectGas("GERG-2008 argon at 1 kPa", false, argon);
+    CheckPerfectGas("DETAIL argon at 1 kPa", true, argon);
+    CheckMaximumFlux(x);
+    CheckBatch("GERG-2008 pressure sweep", false, x);
+    CheckBatch("DETAIL pressure sweep", true, x);
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,117 @@
+/**
+ * @file densityguess.cpp
+ * @brief Native test: densities started from a grid estimate must match the solver started from its own
+ *
+ * DensityGuess is compared with DensityGERG (iFlag 0 and 2) and DensityDetail at pseudo-random
+ * states of a natural gas and of carbon dioxide across its saturation line. The counters must
+ * account for every call and show fewer iterations than the solver without estimate.
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "DensityGuess.h"
+#include "Detail.h"
+#include "GERG2008.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+static int failures = 0;
+static unsigned seed = 12345;
+
+static double Uniform()
+{
+    seed = seed * 1103515245u + 12345u;
+    return (seed >> 8) / 16777216.0;
+}
+
+static void CheckGrid(const char *name, const int method, const int iFlag, const std::vector<double> &x,
+                      const double Tmin, const double Tmax, const double Pmin, const double Pmax)
+{
+    DensityGuessGrid grid;
+    int ierr, ierru;
+    const char *herr;
+    BuildDensityGuess(method, iFlag, x, Tmin, Tmax, Pmin, Pmax, 32, 32, grid, ierr, herr);
+    if (ierr != 0)
+    {
+        printf("FAIL %s: %s\n", name, herr);
+        ++failures;
+        return;
+    }
+
+    const int n = 5000;
+    long long unseeded = 0;
+    ResetDensityGuessStats();
+    for (int k = 0; k < n; ++k)
+    {
+        // Some of the states fall outside the grid
+        const double T = Tmin - 10 + (Tmax - Tmin + 20) * Uniform();
+        const double P = std::exp(std::log(Pmin) - 0.1 + (std::log(Pmax) - std::log(Pmin) + 0.2) * Uniform());
+        double D, Du = 0;
+        if (method == DensityGuessDetail)
+        {
+            DensityDetail(T, P, x, Du, ierru, herr);
+            unseeded += DensityIterationsDetail();
+        }
+        else
+        {
+            DensityGERG(iFlag, T, P, x, Du, ierru, herr);
+            unseeded += DensityIterationsGERG();
+        }
+        DensityGuess(grid, T, P, D, ierr, herr);
+        if (ierr != ierru || (ierr == 0 && std::abs(std::log(D / Du)) > 1e-7))
+        {
+            printf("FAIL %s: T=%g P=%g, D=%.17g (ierr %d) instead of %.17g (ierr %d)\n", name, T, P, D, ierr, Du, ierru);
+            ++failures;
+            return;
+        }
+    }
+
+    DensityGuessStats stats;
+    GetDensityGuessStats(stats);
+    if (stats.calls != n || stats.hits == 0 || stats.iterations >= unseeded || stats.iterationsSaved <= 0)
+    {
+        printf("FAIL %s: %lld calls, %lld hits, %lld iterations (%lld without estimate), %.0f saved\n", name,
+               stats.calls, stats.hits, stats.iterations, unseeded, stats.iterationsSaved);
+        ++failures;
+        return;
+    }
+    printf("ok   %s (%lld hits, %.2f iterations per call instead of %.2f)\n", name, stats.hits,
+           (double)stats.iterations / n, (double)unseeded / n);
+}
+
+int main()
+{
+    SetupDetail();
+    SetupGERG();
+
+    const std::vector<double> x = {0, 0.77824, 0.02, 0.06, 0.08, 0.03, 0.0015, 0.003, 0.0005, 0.00165, 0.00215, 0.00088,
+                                   0.00024, 0.00015, 0.00009, 0.004, 0.005, 0.002, 0.0001, 0.0025, 0.007, 0.001};
+    std::vector<double> co2(22, 0);
+    co2[3] = 1;
+
+    CheckGrid("GERG-2008 natural gas", DensityGuessGERG, 0, x, 220, 450, 100, 30000);
+    CheckGrid("GERG-2008 natural gas, iFlag 2", DensityGuessGERG, 2, x, 220, 450, 100, 30000);
+    CheckGrid("DETAIL natural gas", DensityGuessDetail, 0, x, 220, 450, 100, 30000);
+    CheckGrid("GERG-2008 carbon dioxide", DensityGuessGERG, 0, co2, 250, 350, 1000, 15000);
+    CheckGrid("DETAIL carbon dioxide", DensityGuessDetail, 0, co2, 250, 350, 1000, 15000);
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,105 @@
+/**
+ * @file fixedgas.cpp
+ * @brief Native test: the kernels generated by aga8-fixedgas must agree with the generic GERG-2008 routines
+ *
+ * FixedGasMixture.h and FixedGasNitrogen.h are generated at build time (see CMakeLists.txt) for the
+ * compositions below. Densities and properties are compared with DensityGERG and PropertiesGERG
+ * over a grid of gas and supercritical states.
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "GERG2008.h"
+#include "FixedGasMixture.h"
+#include "FixedGasNitrogen.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+static int failures = 0;
+static double worst = 0;
+
+// Relative differences, with |a| replaced by scale[k] when larger (energies whose origin is arbitrary)
+static void Check(const char *name, double T, double P, const double *a, const double *b, const double *scale, int n)
+{
+    for (int k = 0; k < n; ++k)
+    {
+        double err = std::abs(a[k] - b[k]) / std::max(std::abs(a[k]), scale[k]);
+        if (err > worst) { worst = err; }
+        if (err > 1e-12)
+        {
+            printf("FAIL %s at T = %g K, P = %g kPa: value %d is %.17g instead of %.17g\n", name, T, P, k, b[k], a[k]);
+            ++failures;
+            return;
+        }
+    }
+}
+
+template <typename Density, typename Properties>
+static void Compare(const char *name, const std::vector<double> &x, Density density, Properties properties)
+{
+    double D, Df, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf, Mm;
+    int ierr, ierrf;
+    const char *herr;
+    MolarMassGERG(x, Mm);
+    for (double T = 200; T <= 450; T += 25)
+    {
+        for (double P0 = 100; P0 <= 35000; P0 *= 1.7)
+        {
+            DensityGERG(0, T, P0, x, D, ierr, herr);
+            density(T, P0, Df, ierrf, herr);
+            double dens[] = {D, (double)ierr}, densf[] = {Df, (double)ierrf}, scale[] = {1e-300, 1};
+            Check(name, T, P0, dens, densf, scale, 2);
+
+            PropertiesGERG(T, D, x, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf);
+            double ref[] = {P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf};
+            properties(T, D, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf);
+            double fixed[] = {P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf};
+            const double RT = 8.314472 * T, f = 1e-300;
+            double scales[] = {f, f, f, f, f, f, RT, RT, RT / T, f, f, f, RT, f, f, RT, f};
+            Check(name, T, P0, ref, fixed, scales, 17);
+        }
+    }
+}
+
+int main()
+{
+    SetupGERG();
+
+    // Same compositions as in the aga8_fixedgas_header() calls of CMakeLists.txt
+    const std::vector<double> mixture = {0, 0.77824, 0.02, 0.06, 0.08, 0.03, 0.0015, 0.003, 0.0005, 0.00165, 0.00215,
+                                         0.00088, 0.00024, 0.00015, 0.00009, 0.004, 0.005, 0.002, 0.0001, 0.0025, 0.007, 0.001};
+    std::vector<double> nitrogen(22, 0);
+    nitrogen[2] = 1;
+
+    double Mm;
+    MolarMassGERG(mixture, Mm);
+    if (Mm != FixedGasMixture::Gas::Mm)
+    {
+        printf("FAIL molar mass %.17g instead of %.17g\n", FixedGasMixture::Gas::Mm, Mm);
+        ++failures;
+    }
+    Compare("mixture", mixture, FixedGasMixture::DensityFixedGas, FixedGasMixture::PropertiesFixedGas);
+    Compare("nitrogen", nitrogen, FixedGasNitrogen::DensityFixedGas, FixedGasNitrogen::PropertiesFixedGas);
+    printf("%s fixed gas kernels, largest relative difference %.3g\n", failures == 0 ? "ok  " : "FAIL", worst);
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,163 @@
+/**
+ * @file flash.cpp
+ * @brief Native test: the flashes must recover the temperature and density of known states
+ *
+ * At pseudo-random (T, P) states of a natural gas (GERG-2008 and DETAIL) and of dense carbon
+ * dioxide (GERG-2008), the properties of each flash pair are calculated from DensityGERG and
+ * PropertiesGERG (or DETAIL) and solved back to (T, D), without and with an initial estimate.
+ * A batch along an isentropic compression must take fewer iterations than the single flashes.
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "Flash.h"
+#include "Detail.h"
+#include "GERG2008.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+static int failures = 0;
+static unsigned seed = 12345;
+static const char *pairNames[8] = {"PH", "PS", "PU", "TH", "TS", "DH", "DS", "UV"};
+
+static double Uniform()
+{
+    seed = seed * 1103515245u + 12345u;
+    return (seed >> 8) / 16777216.0;
+}
+
+static void Flash(const bool detail, const int pair, const double v1, const double v2, const std::vector<double> &x, double &T, double &D, int &ierr, const char *&herr)
+{
+    if (detail) { FlashDetail(pair, v1, v2, x, T, D, ierr, herr); }
+    else { FlashGERG(pair, v1, v2, x, T, D, ierr, herr); }
+}
+
+static void CheckFlash(const char *name, const bool detail, const std::vector<double> &x, const double Tmin, const double Tmax, const double Pmin, const double Pmax)
+{
+    const int n = 500;
+    int ierr, iterations = 0, flashes = 0;
+    const char *herr;
+    for (int k = 0; k < n; ++k)
+    {
+        const double T0 = Tmin + (Tmax - Tmin) * Uniform();
+        const double P0 = std::exp(std::log(Pmin) + (std::log(Pmax) - std::log(Pmin)) * Uniform());
+        double D0 = 0, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf;
+        if (detail)
+        {
+            DensityDetail(T0, P0, x, D0, ierr, herr);
+            PropertiesDetail(T0, D0, x, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, Cf);
+        }
+        else
+        {
+            DensityGERG(0, T0, P0, x, D0, ierr, herr);
+            PropertiesGERG(T0, D0, x, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf);
+        }
+        if (ierr != 0 || dPdD <= 0) { continue; }
+
+        const double v[8][2] = {{P, H}, {P, S}, {P, U}, {T0, H}, {T0, S}, {D0, H}, {D0, S}, {U, 1 / D0}};
+        for (int pair = FlashPH; pair <= FlashUV; ++pair)
+        {
+            // Without estimate, then from a state 5 % away
+            for (int warm = 0; warm <= 1; ++warm)
+            {
+                double T = warm ? T0 * 1.05 : 0, D = warm ? -D0 * 0.95 : 0;
+                Flash(detail, pair, v[pair][0], v[pair][1], x, T, D, ierr, herr);
+                iterations += FlashIterations();
+                ++flashes;
+                if (ierr != 0 || std::abs(T / T0 - 1) > 1e-8 || std::abs(D / D0 - 1) > 1e-8)
+                {
+                    printf("FAIL %s %s%s: T=%.17g D=%.17g, T=%.17g D=%.17g (ierr %d %s)\n", name, pairNames[pair], warm ? " from an estimate" : "",
+                           T0, D0, T, D, ierr, herr);
+                    ++failures;
+                    return;
+                }
+            }
+        }
+    }
+    printf("ok   %s (%.2f iterations per flash)\n", name, (double)iterations / flashes);
+}
+
+// Isentropic compression in 200 steps, solved as a batch of PS flashes
+static void CheckBatch(const char *name, const bool detail, const std::vector<double> &x)
+{
+    const int n = 200;
+    const double T0 = 290, P0 = 2000;
+    double D0 = 0, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf;
+    int ierr;
+    const char *herr;
+    if (detail)
+    {
+        DensityDetail(T0, P0, x, D0, ierr, herr);
+        PropertiesDetail(T0, D0, x, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, Cf);
+    }
+    else
+    {
+        DensityGERG(0, T0, P0, x, D0, ierr, herr);
+        PropertiesGERG(T0, D0, x, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf);
+    }
+    std::vector<double> Pk(n), Sk(n, S), Tk, Dk;
+    std::vector<int> ierrk;
+    for (int k = 0; k < n; ++k) { Pk[k] = P0 * std::pow(10.0, 1.0 * k / (n - 1)); }
+    if (detail) { FlashBatchDetail(FlashPS, Pk, Sk, x, Tk, Dk, ierrk); }
+    else { FlashBatchGERG(FlashPS, Pk, Sk, x, Tk, Dk, ierrk); }
+
+    int iterBatch = 0, iterSingle = 0;
+    for (int k = 0; k < n; ++k)
+    {
+        double Tw = Tk[k - (k > 0)], Dw = -Dk[k - (k > 0)], T = 0, D = 0;
+        Flash(detail, FlashPS, Pk[k], S, x, Tw, Dw, ierr, herr);
+        iterBatch += FlashIterations();
+        Flash(detail, FlashPS, Pk[k], S, x, T, D, ierr, herr);
+        iterSingle += FlashIterations();
+        if (ierrk[k] != 0 || ierr != 0 || std::abs(Tk[k] / T - 1) > 1e-9 || std::abs(Dk[k] / D - 1) > 1e-9 || Tk[k] <= Tk[k - (k > 0)] - 1e-9)
+        {
+            printf("FAIL %s: P=%g, T=%.17g D=%.17g instead of T=%.17g D=%.17g (ierr %d)\n", name, Pk[k], Tk[k], Dk[k], T, D, ierrk[k]);
+            ++failures;
+            return;
+        }
+    }
+    if (iterBatch >= iterSingle)
+    {
+        printf("FAIL %s: %d iterations from the previous states, %d without estimate\n", name, iterBatch, iterSingle);
+        ++failures;
+        return;
+    }
+    printf("ok   %s (%.2f iterations per state instead of %.2f)\n", name, (double)iterBatch / n, (double)iterSingle / n);
+}
+
+int main()
+{
+    SetupDetail();
+    SetupGERG();
+
+    const std::vector<double> x = {0, 0.77824, 0.02, 0.06, 0.08, 0.03, 0.0015, 0.003, 0.0005, 0.00165, 0.00215, 0.00088,
+                                   0.00024, 0.00015, 0.00009, 0.004, 0.005, 0.002, 0.0001, 0.0025, 0.007, 0.001};
+    std::vector<double> co2(22, 0);
+    co2[3] = 1;
+
+    CheckFlash("GERG-2008 natural gas", false, x, 220, 450, 100, 30000);
+    CheckFlash("DETAIL natural gas", true, x, 220, 450, 100, 30000);
+    CheckFlash("GERG-2008 supercritical carbon dioxide", false, co2, 320, 450, 1000, 30000);
+    CheckBatch("GERG-2008 isentropic compression", false, x);
+    CheckBatch("DETAIL isentropic compression", true, x);
+
+    return failures == 0 ? 0 : 1;
+}
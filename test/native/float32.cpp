@@ -0,0 +1,199 @@
+/**
+ * @file float32.cpp
+ * @brief Native test: the single-precision batch mode of Float32.h
+ *
+ * On a grid of states of a few compositions, PropertiesBatchFloatGERG (Detail) must stay within the
+ * error envelope of the float32 report against PropertiesGERG (Detail), PressureBatchFloat must give
+ * the pressures of PropertiesBatchFloat, and a state must give the same result alone and inside a
+ * batch whose length is not a multiple of LanesFloat. Batches of different compositions run at once
+ * on several threads must give the results of the same batches run one after the other.
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "Detail.h"
+#include "Float32.h"
+#include "GERG2008.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+static int failures = 0;
+
+static double RelativeError(const double a, const double b)
+{
+    return std::abs(a - b) / std::max(std::abs(b), 1e-300);
+}
+
+static void PropertiesBatch(const bool detail, const std::vector<float> &T, const std::vector<float> &D, const std::vector<double> &x, PropertiesFloat &pf)
+{
+    if (detail) { PropertiesBatchFloatDetail(T, D, x, pf); }
+    else { PropertiesBatchFloatGERG(T, D, x, pf); }
+}
+
+static void CheckComposition(const char *name, const bool detail, const std::vector<double> &x)
+{
+    const int failed = failures;
+
+    // 37 states: two full groups of LanesFloat and a partial one
+    std::vector<float> Tf, Df;
+    std::vector<double> Ts, Ps, Ds;
+    for (int iT = 0; iT < 5 && Ts.size() < 37; ++iT)
+    {
+        for (int iP = 0; iP < 8 && Ts.size() < 37; ++iP)
+        {
+            const double T = 250 + 40 * iT, P = 100 * std::pow(2.0, iP);
+            double D = 0;
+            int ierr;
+            const char *herr;
+            if (detail) { DensityDetail(T, P, x, D, ierr, herr); }
+            else { DensityGERG(0, T, P, x, D, ierr, herr); }
+            if (ierr != 0) { continue; }
+            Ts.push_back(T);
+            Ps.push_back(P);
+            Ds.push_back(D);
+            Tf.push_back((float)T);
+            Df.push_back((float)D);
+        }
+    }
+    if (Ts.size() != 37)
+    {
+        printf("FAIL %s: %zu converged densities\n", name, Ts.size());
+        ++failures;
+        return;
+    }
+
+    PropertiesFloat pf;
+    PropertiesBatch(detail, Tf, Df, x, pf);
+    if (pf.P.size() != Ts.size() || pf.Cf.size() != Ts.size())
+    {
+        printf("FAIL %s: %zu outputs for %zu states\n", name, pf.P.size(), Ts.size());
+        ++failures;
+        return;
+    }
+
+    // Envelope against the double functions
+    double eP = 0, eE = 0, eC = 0;
+    for (std::size_t k = 0; k < Ts.size(); ++k)
+    {
+        const double T = Ts[k], D = Ds[k];
+        double P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf;
+        if (detail) { PropertiesDetail(T, D, x, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, Cf); }
+        else { PropertiesGERG(T, D, x, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf); }
+        eP = std::max({eP, RelativeError(pf.P[k], P), RelativeError(pf.Z[k], Z), RelativeError(pf.dPdD[k], dPdD),
+                       RelativeError(pf.dPdT[k], dPdT)});
+        eE = std::max({eE, std::abs(pf.U[k] - U) / (8.314 * T), std::abs(pf.H[k] - H) / (8.314 * T),
+                       std::abs(pf.G[k] - G) / (8.314 * T), std::abs(pf.S[k] - S) / 8.314});
+        eC = std::max({eC, RelativeError(pf.Cv[k], Cv), RelativeError(pf.Cp[k], Cp), RelativeError(pf.W[k], W),
+                       RelativeError(pf.Kappa[k], Kappa), RelativeError(pf.Cf[k], Cf)});
+    }
+    if (eP > 5e-5) { printf("FAIL %s: P, Z, dP/dD, dP/dT error %.3g\n", name, eP); ++failures; }
+    if (eE > 1e-4) { printf("FAIL %s: U, H, G / RT, S / R error %.3g\n", name, eE); ++failures; }
+    if (eC > 1e-4) { printf("FAIL %s: Cv, Cp, W, Kappa, Cf error %.3g\n", name, eC); ++failures; }
+
+    // PressureBatchFloat gives the pressures of PropertiesBatchFloat
+    std::vector<float> P, Z;
+    if (detail) { PressureBatchFloatDetail(Tf, Df, x, P, Z); }
+    else { PressureBatchFloatGERG(Tf, Df, x, P, Z); }
+    double eB = 0;
+    for (std::size_t k = 0; k < Ts.size(); ++k)
+    {
+        eB = std::max({eB, RelativeError(P[k], pf.P[k]), RelativeError(Z[k], pf.Z[k])});
+    }
+    if (eB > 1e-6) { printf("FAIL %s: PressureBatchFloat error %.3g\n", name, eB); ++failures; }
+
+    // Each lane is independent of the others: the last state alone gives the same result
+    PropertiesFloat one;
+    PropertiesBatch(detail, {Tf.back()}, {Df.back()}, x, one);
+    const std::size_t last = Ts.size() - 1;
+    if (one.P[0] != pf.P[last] || one.H[0] != pf.H[last] || one.W[0] != pf.W[last] || one.JT[0] != pf.JT[last])
+    {
+        printf("FAIL %s: state alone differs from the same state in the batch\n", name);
+        ++failures;
+    }
+
+    if (failures == failed)
+    {
+        printf("ok   %s (%zu states: P %.1e, energies %.1e, heat capacities and W %.1e)\n", name, Ts.size(), eP, eE, eC);
+    }
+}
+
+// Threads alternating between two compositions, each checked against the result of a single thread
+static void CheckThreads(const bool detail, const std::vector<double> &x1, const std::vector<double> &x2)
+{
+    std::vector<float> T, D;
+    for (int k = 0; k < 37; ++k)
+    {
+        T.push_back(250.0f + 5 * k);
+        D.push_back(0.5f + 0.25f * k);
+    }
+    PropertiesFloat ref[2];
+    PropertiesBatch(detail, T, D, x1, ref[0]);
+    PropertiesBatch(detail, T, D, x2, ref[1]);
+
+    bool same[4] = {true, true, true, true};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&, t]() {
+            PropertiesFloat pf;
+            for (int k = 0; k < 200; ++k)
+            {
+                const int c = (k + t) % 2;
+                PropertiesBatch(detail, T, D, c == 0 ? x1 : x2, pf);
+                same[t] = same[t] && pf.P == ref[c].P && pf.H == ref[c].H && pf.W == ref[c].W;
+            }
+        });
+    }
+    for (std::thread &th : threads) { th.join(); }
+    const bool ok = same[0] && same[1] && same[2] && same[3];
+    printf("%s %s batches on 4 threads\n", ok ? "ok  " : "FAIL", detail ? "DETAIL" : "GERG-2008");
+    if (!ok) { ++failures; }
+}
+
+int main()
+{
+    SetupGERG();
+    SetupDetail();
+
+    const std::vector<double> x = {0, 0.77824, 0.02, 0.06, 0.08, 0.03, 0.0015, 0.003, 0.0005, 0.00165, 0.00215, 0.00088,
+                                   0.00024, 0.00015, 0.00009, 0.004, 0.005, 0.002, 0, 0.0026, 0.007, 0.001};
+    std::vector<double> methane(22, 0);
+    methane[1] = 1;
+    std::vector<double> rich(22, 0);
+    rich[1] = 0.85;
+    rich[2] = 0.01;
+    rich[3] = 0.02;
+    rich[4] = 0.08;
+    rich[5] = 0.04;
+
+    CheckComposition("GERG-2008 natural gas", false, x);
+    CheckComposition("DETAIL natural gas", true, x);
+    CheckComposition("GERG-2008 methane", false, methane);
+    CheckComposition("DETAIL methane", true, methane);
+    CheckComposition("GERG-2008 rich gas", false, rich);
+    CheckComposition("DETAIL rich gas", true, rich);
+    CheckThreads(false, x, rich);
+    CheckThreads(true, x, rich);
+
+    return failures == 0 ? 0 : 1;
+}
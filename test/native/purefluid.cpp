@@ -0,0 +1,120 @@
+/**
+ * @file purefluid.cpp
+ * @brief Native test: the pure fluid kernels must agree with the mixture kernels
+ *
+ * Each of the 21 components is evaluated as a pure fluid (x[i] = 1) and as a "mixture" where a
+ * second component has a negligible but non-zero fraction, which disables the pure fluid path.
+ * The results must agree to rounding. The pure fluid is evaluated again after the mixture to
+ * check the switch between the two paths.
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "Detail.h"
+#include "GERG2008.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+static int failures = 0;
+
+static void Check(const char *name, int i, const std::vector<double> &a, const std::vector<double> &b)
+{
+    for (std::size_t k = 0; k < a.size(); ++k)
+    {
+        if (std::abs(a[k] - b[k]) > 1e-13 * std::abs(a[k]) + 1e-300)
+        {
+            printf("FAIL %s component %d: value %d is %.17g instead of %.17g\n", name, i, (int)k, b[k], a[k]);
+            ++failures;
+            return;
+        }
+    }
+}
+
+// Density and properties at a few gas and liquid-like states
+static std::vector<double> EvaluateGERG(const std::vector<double> &x)
+{
+    double D, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf;
+    int ierr;
+    const char *herr;
+    std::vector<double> r;
+    for (double T : {200.0, 300.0, 450.0})
+    {
+        for (double P0 : {500.0, 20000.0})
+        {
+            DensityGERG(2, T, P0, x, D, ierr, herr);
+            PropertiesGERG(T, D, x, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf);
+            r.insert(r.end(), {D, (double)ierr, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, A});
+        }
+    }
+    return r;
+}
+
+static std::vector<double> EvaluateDetail(const std::vector<double> &x)
+{
+    double D, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, Cf;
+    int ierr;
+    const char *herr;
+    std::vector<double> r;
+    for (double T : {200.0, 300.0, 450.0})
+    {
+        for (double P0 : {500.0, 20000.0})
+        {
+            DensityDetail(T, P0, x, D, ierr, herr);
+            PropertiesDetail(T, D, x, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, Cf);
+            r.insert(r.end(), {D, (double)ierr, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT});
+        }
+    }
+    return r;
+}
+
+int main()
+{
+    SetupDetail();
+    SetupGERG();
+
+    for (int i = 1; i <= 21; ++i)
+    {
+        std::vector<double> pure(22, 0), mixture(22, 0), other(22, 0);
+        pure[i] = 1;
+        mixture[i] = 1;
+        mixture[i == 1 ? 2 : 1] = 1e-300;
+        other[i == 1 ? 2 : 1] = 0.5;
+        other[i == 3 ? 4 : 3] = 0.5;
+
+        // The compositions differ by less than the cache tolerance, so another mixture is evaluated in between
+        std::vector<double> g = EvaluateGERG(pure), d = EvaluateDetail(pure);
+        EvaluateGERG(other);
+        EvaluateDetail(other);
+        std::vector<double> gm = EvaluateGERG(mixture), dm = EvaluateDetail(mixture);
+        EvaluateGERG(other);
+        EvaluateDetail(other);
+        Check("GERG", i, gm, g);
+        Check("DETAIL", i, dm, d);
+        Check("GERG after a mixture", i, g, EvaluateGERG(pure));
+        Check("DETAIL after a mixture", i, d, EvaluateDetail(pure));
+    }
+    if (failures == 0)
+    {
+        printf("ok   pure fluids\n");
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,161 @@
+/**
+ * @file scalartypes.cpp
+ * @brief Native test: the scalar templates of PressureGERG/PropertiesGERG and PressureDetail/PropertiesDetail
+ *
+ * The double instantiation must match the cached double functions, the Dual<2> derivatives with
+ * respect to T and D must match dP/dT, dP/dD, d2P/dD2 and Cv, the Dual<23> derivatives with respect
+ * to T, D and the mole fractions must give the dZ/dx, dD/dx and dW/dx at constant T and P of
+ * CompositionDerivativesGERG (DETAIL), and the float instantiation must stay close to double.
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "Detail.h"
+#include "GERG2008.h"
+#include "Scalar.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+static int failures = 0;
+
+// Outputs of PropertiesGERG or PropertiesDetail used by the checks
+template <typename V>
+struct Props
+{
+    V P, Z, dPdD, d2PdD2, dPdT, U, H, S, Cv, Cp, W, JT;
+};
+
+template <typename V>
+static Props<V> Evaluate(const bool detail, const V &T, const V &D, const std::vector<V> &x)
+{
+    Props<V> p;
+    V d2PdTD, G, Kappa, A, Cf;
+    if (detail) { PropertiesDetail(T, D, x, p.P, p.Z, p.dPdD, p.d2PdD2, d2PdTD, p.dPdT, p.U, p.H, p.S, p.Cv, p.Cp, p.W, G, p.JT, Kappa, Cf); }
+    else { PropertiesGERG(T, D, x, p.P, p.Z, p.dPdD, p.d2PdD2, d2PdTD, p.dPdT, p.U, p.H, p.S, p.Cv, p.Cp, p.W, G, p.JT, Kappa, A, Cf); }
+    return p;
+}
+
+static double RelativeError(const double a, const double b)
+{
+    return std::abs(a - b) / std::max(std::abs(b), 1e-300);
+}
+
+static void Fail(const char *name, const char *what, const double T, const double P, const double err)
+{
+    printf("FAIL %s, T=%g P=%g: %s error %.3g\n", name, T, P, what, err);
+    ++failures;
+}
+
+static void CheckState(const char *name, const bool detail, const std::vector<double> &x, const double T, const double P)
+{
+    double D;
+    const int failed = failures;
+    int ierr;
+    const char *herr;
+    D = 0;
+    if (detail) { DensityDetail(T, P, x, D, ierr, herr); }
+    else { DensityGERG(0, T, P, x, D, ierr, herr); }
+
+    // Cached double functions
+    Props<double> ref;
+    double d2PdTD, G, Kappa, A, Cf;
+    if (detail) { PropertiesDetail(T, D, x, ref.P, ref.Z, ref.dPdD, ref.d2PdD2, d2PdTD, ref.dPdT, ref.U, ref.H, ref.S, ref.Cv, ref.Cp, ref.W, G, ref.JT, Kappa, Cf); }
+    else { PropertiesGERG(T, D, x, ref.P, ref.Z, ref.dPdD, ref.d2PdD2, d2PdTD, ref.dPdT, ref.U, ref.H, ref.S, ref.Cv, ref.Cp, ref.W, G, ref.JT, Kappa, A, Cf); }
+
+    // double instantiation
+    const Props<double> pd = Evaluate<double>(detail, T, D, x);
+    double Pt, Zt;
+    if (detail) { PressureDetail<double>(T, D, x, Pt, Zt); }
+    else { PressureGERG<double>(T, D, x, Pt, Zt); }
+    const double ed = std::max({RelativeError(pd.P, ref.P), RelativeError(pd.Z, ref.Z), RelativeError(Pt, ref.P),
+                                RelativeError(Zt, ref.Z), RelativeError(pd.W, ref.W), RelativeError(pd.Cp, ref.Cp),
+                                RelativeError(pd.JT, ref.JT), std::abs(pd.H - ref.H) / (8.314 * T),
+                                std::abs(pd.S - ref.S) / 8.314});
+    if (ed > 1e-12) { Fail(name, "double", T, P, ed); }
+
+    // Dual<2>: derivatives with respect to T and D
+    std::vector<Dual<2>> x2(x.begin(), x.end());
+    const Props<Dual<2>> p2 = Evaluate(detail, Dual<2>::Variable(T, 0), Dual<2>::Variable(D, 1), x2);
+    const double e2 = std::max({RelativeError(p2.P.d[0], ref.dPdT), RelativeError(p2.P.d[1], ref.dPdD),
+                                RelativeError(p2.dPdD.d[1], ref.d2PdD2), RelativeError(p2.U.d[0], ref.Cv)});
+    if (e2 > 1e-12) { Fail(name, "Dual<2>", T, P, e2); }
+
+    // Dual<23>: derivatives with respect to T, D and the mole fractions, brought to constant T and P
+    double P3, Z3, W3;
+    std::vector<double> dZdx, dDdx, dWdx;
+    if (detail) { CompositionDerivativesDetail(T, D, x, P3, Z3, W3, dZdx, dDdx, dWdx); }
+    else { CompositionDerivativesGERG(T, D, x, P3, Z3, W3, dZdx, dDdx, dWdx); }
+    std::vector<Dual<23>> x23(x.size());
+    for (int i = 1; i <= 21; ++i) { x23[i] = Dual<23>::Variable(x[i], i + 1); }
+    const Props<Dual<23>> p23 = Evaluate(detail, Dual<23>::Variable(T, 0), Dual<23>::Variable(D, 1), x23);
+    double e23 = 0, sZ = 0, sD = 0, sW = 0;
+    for (int i = 1; i <= 21; ++i)
+    {
+        sZ = std::max(sZ, std::abs(dZdx[i]));
+        sD = std::max(sD, std::abs(dDdx[i]));
+        sW = std::max(sW, std::abs(dWdx[i]));
+    }
+    for (int i = 1; i <= 21; ++i)
+    {
+        if (x[i] > 0)
+        {
+            const double dD = -p23.P.d[i + 1] / p23.P.d[1];
+            e23 = std::max({e23, std::abs(dD - dDdx[i]) / sD, std::abs(p23.Z.d[i + 1] + p23.Z.d[1] * dD - dZdx[i]) / sZ,
+                            std::abs(p23.W.d[i + 1] + p23.W.d[1] * dD - dWdx[i]) / sW});
+        }
+    }
+    if (e23 > 1e-12) { Fail(name, "Dual<23>", T, P, e23); }
+
+    // float instantiation
+    std::vector<float> xf(x.begin(), x.end());
+    const Props<float> pf = Evaluate<float>(detail, (float)T, (float)D, xf);
+    const double ef = std::max({RelativeError(pf.P, ref.P), RelativeError(pf.Z, ref.Z), RelativeError(pf.W, ref.W),
+                                RelativeError(pf.Cp, ref.Cp)});
+    if (ef > 1e-5) { Fail(name, "float", T, P, ef); }
+
+    if (failures == failed)
+    {
+        printf("ok   %s, T=%g P=%g (double %.1e, Dual<2> %.1e, Dual<23> %.1e, float %.1e)\n", name, T, P, ed, e2, e23, ef);
+    }
+}
+
+int main()
+{
+    SetupGERG();
+    SetupDetail();
+
+    const std::vector<double> x = {0, 0.77824, 0.02, 0.06, 0.08, 0.03, 0.0015, 0.003, 0.0005, 0.00165, 0.00215, 0.00088,
+                                   0.00024, 0.00015, 0.00009, 0.004, 0.005, 0.002, 0, 0.0026, 0.007, 0.001};
+    std::vector<double> methane(22, 0);
+    methane[1] = 1;
+
+    const double states[][2] = {{300, 8000}, {250, 20000}, {400, 50000}, {280, 100}};
+    for (const auto &st : states)
+    {
+        CheckState("GERG-2008 natural gas", false, x, st[0], st[1]);
+        CheckState("DETAIL natural gas", true, x, st[0], st[1]);
+    }
+    CheckState("GERG-2008 methane", false, methane, 300, 10000);
+    CheckState("DETAIL methane", true, methane, 300, 10000);
+
+    return failures == 0 ? 0 : 1;
+}
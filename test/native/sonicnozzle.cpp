@@ -0,0 +1,126 @@
+/**
+ * @file sonicnozzle.cpp
+ * @brief Native test: sized sonic nozzles must pass the target mass flow rate
+ *
+ * For a natural gas, the throat diameter found by SonicNozzleDiameter must give back the mass flow
+ * rate with the discharge coefficient at its own Reynolds number, and SonicNozzlePressure must
+ * find the inlet pressure of that nozzle again. Outlet pressures above P0*C* must be rejected.
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "SonicNozzle.h"
+#include "Detail.h"
+#include "GERG2008.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+static int failures = 0;
+
+static void CheckNozzle(const char *name, const int method, const std::vector<double> &x, const double qm, const double T0, const double P0)
+{
+    const double mu = 1.1e-5, Pout = 101.325;
+    SonicNozzle nozzle, back;
+    int ierr;
+    const char *herr;
+    SonicNozzleDiameter(method, x, qm, T0, P0, Pout, mu, nozzle, ierr, herr);
+    if (ierr != 0)
+    {
+        printf("FAIL %s: %s\n", name, herr);
+        ++failures;
+        return;
+    }
+
+    double Mm;
+    if (method == SonicNozzleDetail) { MolarMassDetail(x, Mm); }
+    else { MolarMassGERG(x, Mm); }
+    const double R = method == SonicNozzleDetail ? 8.31451 : 8.314472;
+    const double dm = nozzle.d / 1000, Re = 4 * qm / (3.14159265358979323846 * dm * mu);
+    const double Cd = ToroidalNozzleDischargeCoefficient(Re);
+    const double q = 3.14159265358979323846 * dm * dm / 4 * Cd * nozzle.Cstar * P0 * 1000 / std::sqrt(R * T0 / (Mm / 1000));
+    if (std::abs(q / qm - 1) > 1e-11 || std::abs(nozzle.Cd / Cd - 1) > 1e-11 || nozzle.Pt <= 0 || nozzle.Pt >= P0)
+    {
+        printf("FAIL %s: d=%.12g mm passes %.15g kg/s instead of %.15g (Cd %.12g, %.12g at Re %.6g)\n", name, nozzle.d, q, qm, nozzle.Cd, Cd, Re);
+        ++failures;
+        return;
+    }
+
+    SonicNozzlePressure(method, x, qm, T0, nozzle.d, Pout, mu, back, ierr, herr);
+    if (ierr != 0 || std::abs(back.P0 / P0 - 1) > 1e-8 || std::abs(back.Cstar / nozzle.Cstar - 1) > 1e-8)
+    {
+        printf("FAIL %s: inlet pressure %.12g kPa instead of %.12g (ierr %d %s)\n", name, back.P0, P0, ierr, herr);
+        ++failures;
+        return;
+    }
+
+    SonicNozzleDiameter(method, x, qm, T0, P0, 0.99 * P0, mu, back, ierr, herr);
+    if (ierr != 2)
+    {
+        printf("FAIL %s: outlet pressure 0.99*P0 accepted (ierr %d)\n", name, ierr);
+        ++failures;
+        return;
+    }
+    printf("ok   %s (d=%.4f mm, Cd=%.5f, C*=%.5f)\n", name, nozzle.d, nozzle.Cd, nozzle.Cstar);
+}
+
+// An outlet pressure between the throat pressure and P0*C* does not choke the flow, one just below Pt does
+static void CheckChokingLimit(const char *name, const int method, const std::vector<double> &x, const double T0, const double P0, const double Pout)
+{
+    SonicNozzle nozzle, below;
+    int ierr, ierrBelow;
+    const char *herr;
+    SonicNozzleDiameter(method, x, 0.05, T0, P0, Pout, 1.1e-5, nozzle, ierr, herr);
+    const bool between = nozzle.Pt < Pout && Pout < P0 * nozzle.Cstar;
+    SonicNozzleDiameter(method, x, 0.05, T0, P0, 0.99 * nozzle.Pt, 1.1e-5, below, ierrBelow, herr);
+    if (!between || ierr != 2 || ierrBelow != 0 || below.Poutmax != below.Pt)
+    {
+        printf("FAIL %s: Pt=%.6g kPa, P0*C*=%.6g kPa, outlet %.6g kPa gives ierr %d, 0.99*Pt gives ierr %d\n", name, nozzle.Pt,
+               P0 * nozzle.Cstar, Pout, ierr, ierrBelow);
+        ++failures;
+        return;
+    }
+    printf("ok   %s (Pt=%.2f kPa < %.2f kPa < P0*C*=%.2f kPa)\n", name, nozzle.Pt, Pout, P0 * nozzle.Cstar);
+}
+
+int main()
+{
+    SetupDetail();
+    SetupGERG();
+
+    const std::vector<double> x = {0, 0.77824, 0.02, 0.06, 0.08, 0.03, 0.0015, 0.003, 0.0005, 0.00165, 0.00215, 0.00088,
+                                   0.00024, 0.00015, 0.00009, 0.004, 0.005, 0.002, 0.0001, 0.0025, 0.007, 0.001};
+
+    CheckNozzle("GERG-2008 0.05 kg/s at 5 MPa", SonicNozzleGERG, x, 0.05, 293.15, 5000);
+    CheckNozzle("GERG-2008 2 kg/s at 12 MPa", SonicNozzleGERG, x, 2, 283.15, 12000);
+    CheckNozzle("GERG-2008 1 g/s at 200 kPa", SonicNozzleGERG, x, 0.001, 293.15, 200);
+    CheckNozzle("DETAIL 0.05 kg/s at 5 MPa", SonicNozzleDetail, x, 0.05, 293.15, 5000);
+
+    std::vector<double> lean(22, 0);
+    lean[1] = 0.9;
+    lean[2] = 0.03;
+    lean[3] = 0.02;
+    lean[4] = 0.04;
+    lean[5] = 0.01;
+    CheckChokingLimit("GERG-2008 outlet at 3 MPa from 5 MPa", SonicNozzleGERG, lean, 293.15, 5000, 3000);
+    CheckChokingLimit("DETAIL outlet at 3 MPa from 5 MPa", SonicNozzleDetail, lean, 293.15, 5000, 3000);
+
+    return failures == 0 ? 0 : 1;
+}
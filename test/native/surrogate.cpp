@@ -0,0 +1,199 @@
+/**
+ * @file surrogate.cpp
+ * @brief Native test: surrogate tables must stay within their tolerance of the equation of state
+ *
+ * A GERG-2008 and a DETAIL table of the same mixture are compared with DensityGERG/PropertiesGERG
+ * (and DensityDetail/PropertiesDetail) at pseudo-random states, inside and outside the domain.
+ * A saved and loaded table must give the same results, and damaged bytes must be rejected.
+ * A CO2 table across the saturation line must keep exact cells along the phase boundary.
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "Detail.h"
+#include "GERG2008.h"
+#include "Surrogate.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+static int failures = 0;
+
+// Z, H, S, W and Cf from the equation of state, iFlag = 2 starting DensityGERG from a liquid-like density
+static void Exact(const int method, const int iFlag, const std::vector<double> &x, const double T, const double P, double v[5])
+{
+    double D = 0, Pc, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf;
+    int ierr;
+    const char *herr;
+    if (method == SurrogateDetail)
+    {
+        DensityDetail(T, P, x, D, ierr, herr);
+        PropertiesDetail(T, D, x, Pc, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, Cf);
+    }
+    else
+    {
+        DensityGERG(iFlag, T, P, x, D, ierr, herr);
+        PropertiesGERG(T, D, x, Pc, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf);
+    }
+    v[0] = Z;
+    v[1] = H;
+    v[2] = S;
+    v[3] = W;
+    v[4] = Cf;
+}
+
+// Largest relative error of Z, H, S, W and Cf
+static double Error(const double T, const double s[5], const double e[5])
+{
+    const double R = 8.314472;
+    double err = 0;
+    for (int p = 0; p < 5; ++p)
+    {
+        const double scale = p == 1 ? std::max(std::abs(e[p]), R * T) : p == 2 ? std::max(std::abs(e[p]), R) : std::abs(e[p]);
+        err = std::max(err, std::abs(s[p] - e[p]) / scale);
+    }
+    return err;
+}
+
+static unsigned seed = 12345;
+
+static double Uniform()
+{
+    seed = seed * 1103515245u + 12345u;
+    return (seed >> 8) / 16777216.0;
+}
+
+// States drawn over [T0, T1] x [P0, P1], the table domain being [Tmin, Tmax] x [Pmin, Pmax]
+static void CheckTable(const char *name, const std::vector<double> &x, const SurrogateTable &tab, const SurrogateTable &loaded,
+                       const double T0, const double T1, const double P0, const double P1,
+                       const double Tmin, const double Tmax, const double Pmin, const double Pmax)
+{
+    int hits = 0, exactCells = 0;
+    double worst = 0;
+    for (int v : tab.node) { exactCells += v == 0; }
+    for (int k = 0; k < 2000; ++k)
+    {
+        const double T = T0 + (T1 - T0) * Uniform();
+        const double P = std::exp(std::log(P0) + (std::log(P1) - std::log(P0)) * Uniform());
+        double s[5], l[5], e[5], el[5];
+        int ierr;
+        const char *herr;
+        const int src = EvaluateSurrogate(tab, T, P, s[0], s[1], s[2], s[3], s[4], ierr, herr);
+        const int srcl = EvaluateSurrogate(loaded, T, P, l[0], l[1], l[2], l[3], l[4], ierr, herr);
+        Exact(tab.method, 0, x, T, P, e);
+        const bool inside = T >= Tmin && T <= Tmax && P >= Pmin && P <= Pmax;
+        if (!inside && src == 0)
+        {
+            printf("FAIL %s: table used outside the domain at T=%g P=%g\n", name, T, P);
+            ++failures;
+            return;
+        }
+        hits += src == 0;
+        double err = Error(T, s, e);
+        if (src == 0 && err > tab.tol && tab.method == SurrogateGERG)
+        {
+            // In the liquid, DensityGERG from the ideal gas density may stop on another root than the table samples
+            Exact(tab.method, 2, x, T, P, el);
+            err = std::min(err, Error(T, s, el));
+        }
+        worst = std::max(worst, err);
+        bool same = srcl == src;
+        for (int p = 0; p < 5; ++p) { same = same && l[p] == s[p] && (src == 0 || s[p] == e[p]); }
+        if (err > tab.tol || !same)
+        {
+            printf("FAIL %s: T=%g P=%g, relative error %.3g, loaded table %s\n", name, T, P, err, same ? "identical" : "different");
+            ++failures;
+            return;
+        }
+    }
+    printf("ok   %s (%d nodes, %d exact cells, %d table hits, max relative error %.2g)\n", name, (int)tab.node.size(), exactCells, hits, worst);
+}
+
+static void CheckSaveLoad(const char *name, const SurrogateTable &tab, SurrogateTable &loaded)
+{
+    std::vector<unsigned char> bytes;
+    int ierr;
+    const char *herr;
+    SaveSurrogate(tab, bytes);
+    LoadSurrogate(bytes.data(), bytes.size() - 1, loaded, ierr, herr);
+    if (ierr == 0)
+    {
+        printf("FAIL %s: truncated bytes accepted\n", name);
+        ++failures;
+    }
+    bytes[0] = 'X';
+    LoadSurrogate(bytes.data(), bytes.size(), loaded, ierr, herr);
+    if (ierr == 0)
+    {
+        printf("FAIL %s: bytes without the magic number accepted\n", name);
+        ++failures;
+    }
+    bytes[0] = 'A';
+    LoadSurrogate(bytes.data(), bytes.size(), loaded, ierr, herr);
+    if (ierr != 0)
+    {
+        printf("FAIL %s: %s\n", name, herr);
+        ++failures;
+    }
+}
+
+int main()
+{
+    SetupDetail();
+    SetupGERG();
+
+    const std::vector<double> x = {0, 0.77824, 0.02, 0.06, 0.08, 0.03, 0.0015, 0.003, 0.0005, 0.00165, 0.00215, 0.00088,
+                                   0.00024, 0.00015, 0.00009, 0.004, 0.005, 0.002, 0.0001, 0.0025, 0.007, 0.001};
+    for (int method : {SurrogateGERG, SurrogateDetail})
+    {
+        const char *name = method == SurrogateGERG ? "GERG-2008 table" : "DETAIL table";
+        SurrogateTable tab, loaded;
+        int ierr;
+        const char *herr;
+        BuildSurrogate(method, x, 270, 340, 1000, 10000, 1e-6, tab, ierr, herr);
+        if (ierr != 0)
+        {
+            printf("FAIL %s: %s\n", name, herr);
+            ++failures;
+            continue;
+        }
+        CheckSaveLoad(name, tab, loaded);
+        // About 40% of the states fall outside the domain
+        CheckTable(name, x, tab, loaded, 260, 350, 500, 12000, 270, 340, 1000, 10000);
+    }
+
+    // Carbon dioxide from the vapor to the dense phase, across the saturation line below 304 K
+    std::vector<double> co2(22, 0);
+    co2[3] = 1;
+    SurrogateTable tab, loaded;
+    int ierr;
+    const char *herr;
+    BuildSurrogate(SurrogateGERG, co2, 250, 350, 1000, 15000, 1e-6, tab, ierr, herr);
+    CheckSaveLoad("CO2 table", tab, loaded);
+    if (std::count(tab.node.begin(), tab.node.end(), 0) == 0)
+    {
+        printf("FAIL CO2 table: no exact cells along the saturation line\n");
+        ++failures;
+    }
+    CheckTable("CO2 table", co2, tab, loaded, 250, 350, 1000, 15000, 250, 350, 1000, 15000);
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,112 @@
+/**
+ * @file threads.cpp
+ * @brief Native test: the per-thread caches of GERG2008.cpp, Detail.cpp and Gross.cpp
+ *
+ * Once the Setup functions have run on the main thread, DensityGERG, DensityDetail and Bmix called
+ * on other threads, alone and at once, must give the bits of the same calls on the main thread,
+ * including on a fresh thread whose caches were never filled (Bmix at T = 0 must not find an empty
+ * temperature slot).
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "Detail.h"
+#include "GERG2008.h"
+#include "Gross.h"
+
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+static int failures = 0;
+
+static void Check(const bool ok, const char *what)
+{
+    printf("%s %s\n", ok ? "ok  " : "FAIL", what);
+    if (!ok) { ++failures; }
+}
+
+// Densities of two compositions at a few states, and Bmix at a few temperatures, in one vector
+static std::vector<double> Evaluate(const std::vector<std::vector<double>> &gases)
+{
+    std::vector<double> v;
+    int ierr;
+    const char *herr;
+    const std::vector<double> xGrs = {0, 0.9, 0.05, 0.05};
+    for (const double T : {0.0, 250.0, 300.0})
+    {
+        double B, C;
+        Bmix(T, xGrs, 900, B, C, ierr, herr);
+        v.insert(v.end(), {B, C, (double)ierr});
+    }
+    for (int k = 0; k < 40; ++k)
+    {
+        const std::vector<double> &x = gases[k % gases.size()];
+        const double T = 250 + 5 * (k % 8), P = 500 + 1000 * (k / 8);
+        double D = 0;
+        DensityGERG(0, T, P, x, D, ierr, herr);
+        v.insert(v.end(), {D, (double)ierr});
+        DensityDetail(T, P, x, D, ierr, herr);
+        v.insert(v.end(), {D, (double)ierr});
+    }
+    return v;
+}
+
+int main()
+{
+    SetupGERG();
+    SetupDetail();
+    SetupGross();
+
+    std::vector<double> x = {0, 0.77824, 0.02, 0.06, 0.08, 0.03, 0.0015, 0.003, 0.0005, 0.00165, 0.00215, 0.00088,
+                             0.00024, 0.00015, 0.00009, 0.004, 0.005, 0.002, 0.0001, 0.0025, 0.007, 0.001};
+    std::vector<double> rich(22, 0);
+    rich[1] = 0.85;
+    rich[2] = 0.01;
+    rich[3] = 0.02;
+    rich[4] = 0.08;
+    rich[5] = 0.04;
+    const std::vector<std::vector<double>> gases = {x, rich};
+
+    const std::vector<double> ref = Evaluate(gases);
+
+    std::vector<double> fresh;
+    std::thread([&]() { fresh = Evaluate(gases); }).join();
+    Check(fresh == ref, "a fresh thread gives the results of the main thread");
+
+    std::vector<std::vector<double>> results(4);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&, t]() {
+            for (int k = 0; k < 20; ++k)
+            {
+                // Each thread alternates the order of the compositions, so that the caches of the threads differ
+                std::vector<double> v = Evaluate((k + t) % 2 ? gases : std::vector<std::vector<double>>{rich, x});
+                if ((k + t) % 2 && results[t].empty()) { results[t] = v; }
+            }
+        });
+    }
+    for (std::thread &th : threads) { th.join(); }
+    bool same = true;
+    for (const std::vector<double> &v : results) { same = same && v == ref; }
+    Check(same, "4 threads at once give the results of the main thread");
+
+    return failures == 0 ? 0 : 1;
+}
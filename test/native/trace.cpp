@@ -0,0 +1,183 @@
+/**
+ * @file trace.cpp
+ * @brief Native test: the trace spans of Trace.h, in a library compiled with AGA8_TRACE
+ *
+ * DensityGERG and DensityDetail must record spans, counted by TraceEventCount and written by
+ * TraceDump as valid Chrome trace JSON with the reducing parameters, temperature terms and solver
+ * iterations. A dump taken while other threads record spans must be valid JSON too.
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "Detail.h"
+#include "GERG2008.h"
+#include "Trace.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef AGA8_TRACE
+#error "test_trace must be compiled with AGA8_TRACE"
+#endif
+
+static int failures = 0;
+
+static void Check(const bool ok, const char *what)
+{
+    printf("%s %s\n", ok ? "ok  " : "FAIL", what);
+    if (!ok) { ++failures; }
+}
+
+// Minimal JSON syntax check: recursive descent over objects, arrays, strings, numbers and literals
+static bool JsonValue(const char *&p);
+
+static void JsonSpace(const char *&p)
+{
+    while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r') { ++p; }
+}
+
+static bool JsonString(const char *&p)
+{
+    if (*p != '"') { return false; }
+    for (++p; *p != '"'; ++p)
+    {
+        if (*p == '\0' || (unsigned char)*p < 0x20) { return false; }
+        if (*p == '\\' && *++p == '\0') { return false; }
+    }
+    ++p;
+    return true;
+}
+
+static bool JsonNumber(const char *&p)
+{
+    const char *start = p;
+    if (*p == '-') { ++p; }
+    if (*p < '0' || *p > '9') { return false; }
+    while ((*p >= '0' && *p <= '9') || *p == '.' || *p == 'e' || *p == 'E' || *p == '+' || *p == '-') { ++p; }
+    return p > start;
+}
+
+static bool JsonValue(const char *&p)
+{
+    JsonSpace(p);
+    if (*p == '{' || *p == '[')
+    {
+        const char close = *p == '{' ? '}' : ']';
+        const bool object = *p == '{';
+        ++p;
+        JsonSpace(p);
+        if (*p == close) { ++p; return true; }
+        for (;;)
+        {
+            if (object)
+            {
+                JsonSpace(p);
+                if (!JsonString(p)) { return false; }
+                JsonSpace(p);
+                if (*p++ != ':') { return false; }
+            }
+            if (!JsonValue(p)) { return false; }
+            JsonSpace(p);
+            if (*p == close) { ++p; return true; }
+            if (*p++ != ',') { return false; }
+        }
+    }
+    if (*p == '"') { return JsonString(p); }
+    for (const char *literal : {"true", "false", "null"})
+    {
+        if (std::strncmp(p, literal, std::strlen(literal)) == 0) { p += std::strlen(literal); return true; }
+    }
+    return JsonNumber(p);
+}
+
+static bool ValidJson(const std::string &json)
+{
+    const char *p = json.c_str();
+    if (!JsonValue(p)) { return false; }
+    JsonSpace(p);
+    return *p == '\0';
+}
+
+static bool HasSpan(const std::string &json, const char *name)
+{
+    return json.find(std::string("\"name\":\"") + name + "\"") != std::string::npos;
+}
+
+int main()
+{
+    SetupGERG();
+    SetupDetail();
+    std::vector<double> x = {0, 0.77824, 0.02, 0.06, 0.08, 0.03, 0.0015, 0.003, 0.0005, 0.00165, 0.00215, 0.00088,
+                             0.00024, 0.00015, 0.00009, 0.004, 0.005, 0.002, 0.0001, 0.0025, 0.007, 0.001};
+    int ierr;
+    const char *herr;
+    double D;
+
+    TraceReset();
+    Check(TraceEventCount() == 0, "TraceReset empties the buffer");
+    DensityGERG(0, 400, 50000, x, D, ierr, herr);
+    Check(ierr == 0, "DensityGERG");
+    const int countGERG = TraceEventCount();
+    Check(countGERG > 0, "DensityGERG records spans");
+    DensityDetail(400, 50000, x, D, ierr, herr);
+    Check(ierr == 0, "DensityDetail");
+    Check(TraceEventCount() > countGERG, "DensityDetail records spans");
+
+    std::string json;
+    TraceDump(json);
+    Check(ValidJson(json), "TraceDump writes valid JSON");
+    Check(HasSpan(json, "ReducingParametersGERG") && HasSpan(json, "tTermsGERG") && HasSpan(json, "DensityGERG iteration"),
+          "GERG-2008 reducing parameters, temperature terms and iterations");
+    Check(HasSpan(json, "xTermsDetail") && HasSpan(json, "DensityDetail iteration"), "DETAIL composition terms and iterations");
+    Check(json.find("\"args\":{\"it\":1}") != std::string::npos, "iteration number of the solver spans");
+
+    // Dumps while other threads record spans, wrapping the ring buffer
+    std::atomic<bool> stop(false);
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 3; ++t)
+    {
+        writers.emplace_back([&, t]() {
+            std::vector<double> xt = x;
+            int ierrt;
+            const char *herrt;
+            double Dt;
+            for (int k = 0; !stop.load(); ++k)
+            {
+                DensityGERG(0, 250 + (k + t) % 200, 1000 + 100 * (k % 50), xt, Dt, ierrt, herrt);
+            }
+        });
+    }
+    bool valid = true;
+    for (int k = 0; k < 20; ++k)
+    {
+        TraceDump(json);
+        valid = valid && ValidJson(json);
+        const int count = TraceEventCount();
+        valid = valid && count >= 0 && count <= AGA8_TRACE_CAPACITY;
+    }
+    stop = true;
+    for (std::thread &w : writers) { w.join(); }
+    Check(valid, "TraceDump and TraceEventCount while other threads record spans");
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,174 @@
+/**
+ * @file uncertainty.cpp
+ * @brief Native test: Monte Carlo propagation of the T, P and composition uncertainties
+ *
+ * For small uncertainties, the standard deviation of each output must match the linear propagation
+ * sqrt(Sum((c[j]*u[j])^2)) of its sensitivity coefficients, and the coefficients must match finite
+ * differences of DensityGERG and PropertiesGERG. The results must be identical with 1 and 4 threads,
+ * and a diagonal covariance must give the same samples as the standard uncertainties. Samples that
+ * fail must be reported by the warning ierr -1.
+ *
+ * @copyright (C) 2025 Ronan LE MEILLAT
+ * @license GNU Affero General Public License v3.0
+ */
+/*
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "Detail.h"
+#include "GERG2008.h"
+#include "Uncertainty.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+static int failures = 0;
+
+static const char *Names[NOutputsUncertainty] = {"D", "Z", "Rho", "W", "Cf", "H", "S", "Cp", "JT"};
+
+static void Check(const bool ok, const char *name, const char *what, const double value)
+{
+    if (ok) { printf("ok   %s: %s %.3g\n", name, what, value); }
+    else { printf("FAIL %s: %s %.3g\n", name, what, value); ++failures; }
+}
+
+static bool SameResults(const UncertaintyResult &a, const UncertaintyResult &b)
+{
+    if (a.samples != b.samples || a.failed != b.failed) { return false; }
+    for (int o = 0; o < NOutputsUncertainty; ++o)
+    {
+        if (a.outputs[o].mean != b.outputs[o].mean || a.outputs[o].u != b.outputs[o].u || a.outputs[o].percentiles != b.outputs[o].percentiles)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void CheckStudy(const char *name, UncertaintyStudy study)
+{
+    int ierr;
+    const char *herr;
+    UncertaintyResult r1, r4;
+    study.threads = 1;
+    MonteCarloUncertainty(study, r1, ierr, herr);
+    if (ierr != 0)
+    {
+        printf("FAIL %s: ierr %d %s\n", name, ierr, herr);
+        ++failures;
+        return;
+    }
+    study.threads = 4;
+    MonteCarloUncertainty(study, r4, ierr, herr);
+    Check(ierr == 0 && SameResults(r1, r4), name, "1 and 4 threads identical, failed samples", (double)r1.failed);
+
+    // Standard deviations against the linear propagation, means against the nominal values, within about 4 times
+    // the sampling errors 1/sqrt(2*samples) and 1/sqrt(samples)
+    double eu = 0, em = 0;
+    for (int o = 0; o < NOutputsUncertainty; ++o)
+    {
+        const UncertaintyOutput &out = r1.outputs[o];
+        double var = 0;
+        for (int j = 0; j < NInputsUncertainty; ++j) { var += out.c[j] * study.u[j] * out.c[j] * study.u[j]; }
+        const double err = std::abs(out.u / std::sqrt(var) - 1);
+        if (err > 0.05) { printf("     %s: u %.6g, linear %.6g\n", Names[o], out.u, std::sqrt(var)); }
+        eu = std::max(eu, err);
+        em = std::max(em, std::abs(out.mean - out.nominal) / out.u);
+        if (!(out.percentiles[0] < out.percentiles[1] && out.percentiles[1] < out.percentiles[2])) { em = 1e300; }
+    }
+    Check(eu < 0.05, name, "standard deviations against the linear propagation", eu);
+    Check(em < 0.07, name, "means against the nominal values, in standard deviations", em);
+
+    // Covariance diag(u^2): same deviates, so the same samples
+    UncertaintyStudy sc = study;
+    sc.covariance.assign(NInputsUncertainty * NInputsUncertainty, 0);
+    for (int j = 0; j < NInputsUncertainty; ++j) { sc.covariance[j * NInputsUncertainty + j] = study.u[j] * study.u[j]; }
+    UncertaintyResult rc;
+    MonteCarloUncertainty(sc, rc, ierr, herr);
+    double ec = 0;
+    for (int o = 0; o < NOutputsUncertainty; ++o) { ec = std::max(ec, std::abs(rc.outputs[o].u / r1.outputs[o].u - 1)); }
+    Check(ierr == 0 && ec < 1e-9, name, "diagonal covariance against the standard uncertainties", ec);
+}
+
+int main()
+{
+    SetupGERG();
+    SetupDetail();
+
+    const std::vector<double> x = {0, 0.77824, 0.02, 0.06, 0.08, 0.03, 0.0015, 0.003, 0.0005, 0.00165, 0.00215, 0.00088,
+                                   0.00024, 0.00015, 0.00009, 0.004, 0.005, 0.002, 0, 0.0026, 0.007, 0.001};
+    UncertaintyStudy study;
+    study.T = 300;
+    study.P = 8000;
+    study.x = x;
+    study.samples = 4000;
+    study.seed = 2025;
+    study.u.assign(NInputsUncertainty, 0);
+    study.u[0] = 0.05;
+    study.u[1] = 4;
+    for (int i = 1; i <= 21; ++i) { study.u[i + 1] = 0.002 * x[i]; }
+    CheckStudy("GERG-2008 natural gas", study);
+    study.method = UncertaintyDetail;
+    CheckStudy("DETAIL natural gas", study);
+
+    // Sensitivity coefficients against central differences, nitrogen replacing the other components on renormalization
+    study.method = UncertaintyGERG;
+    study.samples = 2;
+    UncertaintyResult r;
+    int ierr;
+    const char *herr;
+    MonteCarloUncertainty(study, r, ierr, herr);
+    const double h[3] = {1e-3, 1e-2, 1e-6};
+    double ec = 0;
+    for (int j = 0; j < 3; ++j)
+    {
+        double y[2][NOutputsUncertainty];
+        for (int s = 0; s < 2; ++s)
+        {
+            double T = study.T, P = study.P, D, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf, Mm;
+            std::vector<double> xs = x;
+            const double d = s == 0 ? h[j] : -h[j];
+            if (j == 0) { T += d; }
+            else if (j == 1) { P += d; }
+            else
+            {
+                xs[2] += d;
+                for (int i = 1; i <= 21; ++i) { xs[i] /= 1 + d; }
+            }
+            DensityGERG(0, T, P, xs, D, ierr, herr);
+            PropertiesGERG(T, D, xs, P, Z, dPdD, d2PdD2, d2PdTD, dPdT, U, H, S, Cv, Cp, W, G, JT, Kappa, A, Cf);
+            MolarMassGERG(xs, Mm);
+            const double v[NOutputsUncertainty] = {D, Z, D * Mm, W, Cf, H, S, Cp, JT};
+            for (int o = 0; o < NOutputsUncertainty; ++o) { y[s][o] = v[o]; }
+        }
+        const int in = j < 2 ? j : 2 + 1;
+        for (int o = 0; o < NOutputsUncertainty; ++o)
+        {
+            const double fd = (y[0][o] - y[1][o]) / (2 * h[j]);
+            ec = std::max(ec, std::abs(r.outputs[o].c[in] - fd) / std::max(std::abs(fd), 1e-3 * std::abs(r.outputs[o].nominal)));
+        }
+    }
+    Check(ec < 1e-5, "GERG-2008 natural gas", "sensitivity coefficients of T, P and x(nitrogen) against central differences", ec);
+
+    // A temperature uncertainty of half the temperature: the samples with T <= 0 fail
+    study.samples = 1000;
+    study.u[0] = 150;
+    MonteCarloUncertainty(study, r, ierr, herr);
+    Check(ierr == -1 && r.failed > 0 && r.samples + r.failed == 1000 && r.outputs[UncertaintyD].u > 0, "GERG-2008 natural gas",
+          "warning for the failed samples", (double)r.failed);
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,42 @@
+/**
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+import { describe, expect, test } from '@jest/globals';
+import { AGA8wasm, getSonicNozzleDiameter, getSonicNozzleInletPressure, getThoroidalNozzleDischargeCoefficient, type GasMixture } from '../dist/index.js';
+import { testGas } from './fixtures.js';
+
+describe('SonicNozzle', () => {
+  const x: GasMixture = testGas;
+
+  test('The sized nozzle passes the mass flow rate at its inlet pressure', async () => {
+    const AGA8 = await AGA8wasm();
+    const qm = 0.05, T0 = 293.15, P0 = 5000, mu = 1.1e-5;
+
+    const nozzle = await getSonicNozzleDiameter("GERG-2008", x, qm, P0, 101.325, T0, mu, AGA8);
+    expect(nozzle.ierr).toBe(0);
+    expect(nozzle.Cd).toBeCloseTo(getThoroidalNozzleDischargeCoefficient(nozzle.Re), 12);
+    expect(nozzle.Re).toBeCloseTo((4 * qm) / (Math.PI * (nozzle.d / 1000) * mu), 3);
+
+    const back = await getSonicNozzleInletPressure("GERG-2008", x, qm, nozzle.d, 101.325, T0, mu, AGA8);
+    expect(back.ierr).toBe(0);
+    expect(back.P0).toBeCloseTo(P0, 4);
+  });
+
+  test('A flow that is not choked is rejected', async () => {
+    const AGA8 = await AGA8wasm();
+    const nozzle = await getSonicNozzleDiameter("DETAIL", x, 0.05, 5000, 4900, 293.15, 1.1e-5, AGA8);
+    expect(nozzle.ierr).toBe(2);
+  });
+});
@@ -0,0 +1,56 @@
+/**
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+import { describe, expect, test } from '@jest/globals';
+import { AGA8wasm, type GasMixture } from '../dist/index.js';
+import { testGas } from './fixtures.js';
+
+describe('Surrogate', () => {
+  const x: GasMixture = testGas;
+
+  test('GERG-2008 table within tolerance and saved/loaded', async () => {
+    const AGA8 = await AGA8wasm();
+    AGA8.SetupGERG();
+    const tol = 1e-6;
+
+    const built = AGA8.BuildSurrogate(0, x, 270, 340, 1000, 10000, tol);
+    expect(built.ierr).toBe(0);
+
+    // The last state is outside the domain and evaluated exactly
+    const T = new Float64Array([275.3, 300, 312.7, 339.9, 400]);
+    const P = new Float64Array([1200, 5000, 8765, 9999, 5000]);
+    const r = AGA8.EvaluateSurrogate(built.handle, T, P);
+    expect(Array.from(r.exact)).toEqual([0, 0, 0, 0, 1]);
+
+    for (let i = 0; i < T.length; i++) {
+      const { D } = AGA8.DensityGERG(0, T[i], P[i], x);
+      const e = AGA8.PropertiesGERG(T[i], D, x);
+      expect(Math.abs(r.Z[i] - e.Z) / e.Z).toBeLessThanOrEqual(tol);
+      expect(Math.abs(r.H[i] - e.H) / Math.max(Math.abs(e.H), 8.314472 * T[i])).toBeLessThanOrEqual(tol);
+      expect(Math.abs(r.W[i] - e.W) / e.W).toBeLessThanOrEqual(tol);
+      expect(Math.abs(r.Cf[i] - e.Cf) / e.Cf).toBeLessThanOrEqual(tol);
+    }
+
+    const loaded = AGA8.LoadSurrogate(AGA8.SaveSurrogate(built.handle));
+    expect(loaded.ierr).toBe(0);
+    const l = AGA8.EvaluateSurrogate(loaded.handle, T, P);
+    expect(Array.from(l.Z)).toEqual(Array.from(r.Z));
+    expect(Array.from(l.S)).toEqual(Array.from(r.S));
+
+    AGA8.FreeSurrogate(built.handle);
+    AGA8.FreeSurrogate(loaded.handle);
+    expect(AGA8.LoadSurrogate(new Uint8Array([1, 2, 3])).ierr).not.toBe(0);
+  });
+});
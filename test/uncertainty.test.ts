@@ -0,0 +1,61 @@
+/**
+ * Copyright (C) 2025 Ronan LE MEILLAT
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+import { describe, expect, test } from '@jest/globals';
+import { AGA8wasm, type GasMixture } from '../dist/index.js';
+import { testGas } from './fixtures.js';
+
+describe('Uncertainty', () => {
+  const x: GasMixture = testGas;
+
+  const components = Object.keys(x) as (keyof GasMixture)[];
+  const u = new Float64Array(23);
+  u[0] = 0.05; // K
+  u[1] = 4; // kPa
+  components.forEach((c, i) => { u[i + 2] = 0.002 * x[c]; });
+
+  test('GERG-2008 standard deviations match the linear propagation of the sensitivity coefficients', async () => {
+    const AGA8 = await AGA8wasm();
+    AGA8.SetupGERG();
+
+    const r = AGA8.UncertaintyGERG(300, 8000, x, u, [], 4000, 2025);
+    expect(r.ierr).toBe(0);
+    expect(r.samples + r.failed).toBe(4000);
+    for (const name of ['D', 'Z', 'W', 'Cf']) {
+      const out = r.outputs[name];
+      let variance = 0;
+      for (let j = 0; j < 23; j++) variance += (out.c[j] * u[j]) ** 2;
+      expect(Math.abs(out.u / Math.sqrt(variance) - 1)).toBeLessThan(0.05);
+      expect(out.percentiles[0]).toBeLessThan(out.percentiles[2]);
+    }
+    expect(r.outputs.Z.nominal).toBeCloseTo(AGA8.PropertiesGERG(300, AGA8.DensityGERG(0, 300, 8000, x).D, x).Z, 12);
+  });
+
+  test('DETAIL results only depend on the seed, and a diagonal covariance gives the same samples', async () => {
+    const AGA8 = await AGA8wasm();
+    AGA8.SetupDetail();
+
+    const r1 = AGA8.UncertaintyDetail(300, 8000, x, u, [], 1000, 7);
+    const r2 = AGA8.UncertaintyDetail(300, 8000, x, u, [], 1000, 7);
+    const r3 = AGA8.UncertaintyDetail(300, 8000, x, u, [], 1000, 8);
+    expect(r2.outputs.Z.u).toBe(r1.outputs.Z.u);
+    expect(r3.outputs.Z.u).not.toBe(r1.outputs.Z.u);
+
+    const covariance = new Float64Array(23 * 23);
+    for (let j = 0; j < 23; j++) covariance[23 * j + j] = u[j] * u[j];
+    const rc = AGA8.UncertaintyCovarianceDetail(300, 8000, x, covariance, 1000, 7);
+    expect(Math.abs(rc.outputs.Z.u / r1.outputs.Z.u - 1)).toBeLessThan(1e-9);
+  });
+});